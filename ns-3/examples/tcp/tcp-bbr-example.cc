@@ -65,10 +65,10 @@ Time prevTime;
 static void
 TraceThroughput(Ptr<FlowMonitor> monitor)
 {
-    FlowMonitor::FlowStatsContainer stats = monitor->GetFlowStats();
-    if (!stats.empty())
+    const auto& stats = monitor->GetFlowStats();
+    // flow 1 is the BBR flow
+    if (auto itr = stats.find(1); itr != stats.end())
     {
-        auto itr = stats.begin();
         Time curTime = Now();
 
         // Convert (curTime - prevTime) to microseconds so that throughput is in bits per
@@ -0,0 +1,159 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "flow-workload-helper.h"
+
+#include "ns3/abort.h"
+#include "ns3/flow-workload-application.h"
+#include "ns3/pointer.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/string.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace ns3
+{
+
+FlowWorkloadHelper::FlowWorkloadHelper(const std::string& protocol, const Address& address)
+    : ApplicationHelper("ns3::FlowWorkloadApplication")
+{
+    m_factory.Set("Protocol", StringValue(protocol));
+    m_factory.Set("Remote", AddressValue(address));
+}
+
+void
+FlowWorkloadHelper::AddRemote(const Address& address)
+{
+    m_remotes.push_back(address);
+}
+
+void
+FlowWorkloadHelper::SetWorkload(const FlowSizeCdf& cdf, double load, DataRate linkRate)
+{
+    NS_ABORT_MSG_IF(load <= 0, "The load must be positive");
+    NS_ABORT_MSG_IF(linkRate.GetBitRate() == 0, "The link rate must be positive");
+    m_cdf = cdf;
+    double meanInterArrival = GetMeanFlowSize(cdf) * 8 / (load * linkRate.GetBitRate());
+    std::ostringstream oss;
+    oss << "ns3::ExponentialRandomVariable[Mean=" << meanInterArrival << "|Bound=0]";
+    m_factory.Set("InterArrivalTime", StringValue(oss.str()));
+}
+
+FlowWorkloadHelper::FlowSizeCdf
+FlowWorkloadHelper::GetWebSearchCdf()
+{
+    return {{0, 0},
+            {10000, 0.15},
+            {20000, 0.2},
+            {30000, 0.3},
+            {50000, 0.4},
+            {80000, 0.53},
+            {200000, 0.6},
+            {1000000, 0.7},
+            {2000000, 0.8},
+            {5000000, 0.9},
+            {10000000, 0.97},
+            {30000000, 1}};
+}
+
+FlowWorkloadHelper::FlowSizeCdf
+FlowWorkloadHelper::GetDataMiningCdf()
+{
+    // flow sizes are reported in packets of 1460 bytes
+    FlowSizeCdf cdf{{1, 0},
+                    {1, 0.5},
+                    {2, 0.6},
+                    {3, 0.7},
+                    {7, 0.8},
+                    {267, 0.9},
+                    {2107, 0.95},
+                    {66667, 0.99},
+                    {666667, 1}};
+    for (auto& point : cdf)
+    {
+        point.first *= 1460;
+    }
+    return cdf;
+}
+
+FlowWorkloadHelper::FlowSizeCdf
+FlowWorkloadHelper::LoadCdf(const std::string& filename)
+{
+    std::ifstream file(filename);
+    NS_ABORT_MSG_IF(!file.is_open(), "Cannot open flow size distribution file " << filename);
+
+    FlowSizeCdf cdf;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream iss(line);
+        double size;
+        double probability;
+        if (line.empty() || line[0] == '#' || !(iss >> size))
+        {
+            continue;
+        }
+        NS_ABORT_MSG_IF(!(iss >> probability), "Malformed line in " << filename << ": " << line);
+        NS_ABORT_MSG_IF(!cdf.empty() &&
+                            (size < cdf.back().first || probability < cdf.back().second),
+                        "Flow sizes and probabilities must be non-decreasing in " << filename);
+        cdf.emplace_back(size, probability);
+    }
+    NS_ABORT_MSG_IF(cdf.empty(), "No flow size found in " << filename);
+
+    if (cdf.back().second == 100)
+    {
+        for (auto& point : cdf)
+        {
+            point.second /= 100;
+        }
+    }
+    NS_ABORT_MSG_IF(cdf.back().second != 1,
+                    "The last cumulative probability in " << filename << " must be 1 (or 100)");
+    return cdf;
+}
+
+double
+FlowWorkloadHelper::GetMeanFlowSize(const FlowSizeCdf& cdf)
+{
+    NS_ABORT_MSG_IF(cdf.empty(), "Empty flow size distribution");
+    // the sizes are uniformly distributed between consecutive points
+    double mean = cdf[0].first * cdf[0].second;
+    for (std::size_t i = 1; i < cdf.size(); i++)
+    {
+        mean += (cdf[i].second - cdf[i - 1].second) * (cdf[i].first + cdf[i - 1].first) / 2;
+    }
+    return mean;
+}
+
+Ptr<EmpiricalRandomVariable>
+FlowWorkloadHelper::CreateFlowSizeVariable(const FlowSizeCdf& cdf)
+{
+    auto variable = CreateObject<EmpiricalRandomVariable>();
+    variable->SetInterpolate(true);
+    for (const auto& [size, probability] : cdf)
+    {
+        variable->CDF(size, probability);
+    }
+    return variable;
+}
+
+Ptr<Application>
+FlowWorkloadHelper::DoInstall(Ptr<Node> node)
+{
+    auto app = ApplicationHelper::DoInstall(node)->GetObject<FlowWorkloadApplication>();
+    for (const auto& remote : m_remotes)
+    {
+        app->AddRemote(remote);
+    }
+    if (!m_cdf.empty())
+    {
+        // each application has its own random variable
+        app->SetAttribute("FlowSize", PointerValue(CreateFlowSizeVariable(m_cdf)));
+    }
+    return app;
+}
+
+} // namespace ns3
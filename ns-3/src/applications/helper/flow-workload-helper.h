@@ -0,0 +1,120 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef FLOW_WORKLOAD_HELPER_H
+#define FLOW_WORKLOAD_HELPER_H
+
+#include "ns3/application-helper.h"
+#include "ns3/data-rate.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+class EmpiricalRandomVariable;
+
+/**
+ * @ingroup flowworkload
+ * @brief A helper to make it easier to instantiate an ns3::FlowWorkloadApplication
+ * on a set of nodes.
+ *
+ * Besides setting the attributes of the applications, this helper provides
+ * the flow size distributions commonly used in data center studies and sets
+ * the flow arrival rate corresponding to a given load:
+ *
+ * \code
+ *   FlowWorkloadHelper workload("ns3::TcpSocketFactory", InetSocketAddress(dst, port));
+ *   workload.SetWorkload(FlowWorkloadHelper::GetWebSearchCdf(), 0.5, DataRate("10Gbps"));
+ *   workload.SetAttribute("FctCollector", PointerValue(collector));
+ *   auto apps = workload.Install(hosts);
+ * \endcode
+ */
+class FlowWorkloadHelper : public ApplicationHelper
+{
+  public:
+    /**
+     * A flow size distribution, as a list of (size in bytes, cumulative
+     * probability) pairs sorted by size. Sizes are linearly interpolated
+     * between consecutive points.
+     */
+    using FlowSizeCdf = std::vector<std::pair<double, double>>;
+
+    /**
+     * Create a FlowWorkloadHelper to make it easier to work with FlowWorkloadApplications
+     *
+     * @param protocol the name of the protocol to use to send traffic
+     *        by the applications. This string identifies the socket
+     *        factory type used to create sockets for the applications.
+     *        A typical value would be ns3::TcpSocketFactory.
+     * @param address the address of the remote node to send traffic to.
+     */
+    FlowWorkloadHelper(const std::string& protocol, const Address& address);
+
+    /**
+     * Add a remote address the installed applications can send flows to.
+     * @param address the remote address
+     */
+    void AddRemote(const Address& address);
+
+    /**
+     * Configure the applications to draw the flow sizes from the given
+     * distribution and to start flows according to a Poisson process whose
+     * rate is such that the average offered load of each application equals
+     * the given fraction of the given link rate.
+     *
+     * @param cdf the flow size distribution
+     * @param load the offered load, as a fraction of the link rate
+     * @param linkRate the link rate
+     */
+    void SetWorkload(const FlowSizeCdf& cdf, double load, DataRate linkRate);
+
+    /**
+     * @return the web search flow size distribution (Alizadeh et al., "Data
+     * Center TCP (DCTCP)", SIGCOMM 2010)
+     */
+    static FlowSizeCdf GetWebSearchCdf();
+
+    /**
+     * @return the data mining flow size distribution (Greenberg et al., "VL2: a
+     * scalable and flexible data center network", SIGCOMM 2009)
+     */
+    static FlowSizeCdf GetDataMiningCdf();
+
+    /**
+     * Load a flow size distribution from a text file. Each line contains a
+     * flow size in bytes followed by the corresponding cumulative probability;
+     * empty lines and lines starting with '#' are ignored. Cumulative
+     * probabilities may also be expressed as percentages, in which case the
+     * last one must be 100.
+     *
+     * @param filename the name of the file
+     * @return the flow size distribution
+     */
+    static FlowSizeCdf LoadCdf(const std::string& filename);
+
+    /**
+     * @param cdf a flow size distribution
+     * @return the mean flow size of the distribution, in bytes
+     */
+    static double GetMeanFlowSize(const FlowSizeCdf& cdf);
+
+    /**
+     * @param cdf a flow size distribution
+     * @return a random variable drawing flow sizes from the distribution
+     */
+    static Ptr<EmpiricalRandomVariable> CreateFlowSizeVariable(const FlowSizeCdf& cdf);
+
+  private:
+    Ptr<Application> DoInstall(Ptr<Node> node) override;
+
+    std::vector<Address> m_remotes; //!< additional remote addresses
+    FlowSizeCdf m_cdf;              //!< flow size distribution, if set
+};
+
+} // namespace ns3
+
+#endif /* FLOW_WORKLOAD_HELPER_H */
@@ -0,0 +1,187 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "fct-collector.h"
+
+#include "ns3/abort.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("FctCollector");
+
+NS_OBJECT_ENSURE_REGISTERED(FctCollector);
+
+TypeId
+FctCollector::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::FctCollector")
+            .SetParent<Object>()
+            .SetGroupName("Applications")
+            .AddConstructor<FctCollector>()
+            .AddAttribute("RelativeAccuracy",
+                          "The relative accuracy of the estimated percentiles. Changing "
+                          "this value clears the flows recorded so far.",
+                          DoubleValue(0.01),
+                          MakeDoubleAccessor(&FctCollector::m_accuracy),
+                          MakeDoubleChecker<double>(1e-6, 0.5))
+            .AddAttribute("BaseRtt",
+                          "The round trip time of the idle network, used to compute "
+                          "the ideal FCT of a flow.",
+                          TimeValue(MicroSeconds(10)),
+                          MakeTimeAccessor(&FctCollector::m_baseRtt),
+                          MakeTimeChecker())
+            .AddAttribute("LinkRate",
+                          "The bottleneck rate of the idle network, used to compute "
+                          "the ideal FCT of a flow.",
+                          DataRateValue(DataRate("10Gbps")),
+                          MakeDataRateAccessor(&FctCollector::m_linkRate),
+                          MakeDataRateChecker());
+    return tid;
+}
+
+FctCollector::FctCollector()
+    : m_boundaries{100000, 10000000}
+{
+    NS_LOG_FUNCTION(this);
+}
+
+FctCollector::~FctCollector()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+FctCollector::SetSizeClasses(const std::vector<uint64_t>& boundaries)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(!std::is_sorted(boundaries.begin(), boundaries.end()) ||
+                        std::adjacent_find(boundaries.begin(), boundaries.end()) !=
+                            boundaries.end(),
+                    "The size class boundaries must be strictly increasing");
+    m_boundaries = boundaries;
+    m_classes.clear();
+}
+
+uint32_t
+FctCollector::GetNSizeClasses() const
+{
+    return m_boundaries.size() + 1;
+}
+
+uint32_t
+FctCollector::GetSizeClass(uint64_t size) const
+{
+    return std::lower_bound(m_boundaries.begin(), m_boundaries.end(), size) - m_boundaries.begin();
+}
+
+void
+FctCollector::Reset()
+{
+    m_classes.assign(GetNSizeClasses() + 1,
+                     SizeClass{QuantileSketch(m_accuracy), QuantileSketch(m_accuracy)});
+}
+
+Time
+FctCollector::GetIdealFct(uint64_t size) const
+{
+    if (m_linkRate.GetBitRate() == 0)
+    {
+        return m_baseRtt;
+    }
+    return m_baseRtt + Seconds(size * 8.0 / m_linkRate.GetBitRate());
+}
+
+void
+FctCollector::RecordFlow(uint64_t size, Time fct)
+{
+    NS_LOG_FUNCTION(this << size << fct);
+
+    if (m_classes.empty() || m_classes[0].fct.GetRelativeAccuracy() != m_accuracy)
+    {
+        Reset();
+    }
+
+    double seconds = std::max(fct.GetSeconds(), 0.0);
+    double ideal = GetIdealFct(size).GetSeconds();
+    double slowdown = ideal > 0 ? seconds / ideal : 1;
+
+    for (auto index : {GetSizeClass(size), GetNSizeClasses()})
+    {
+        m_classes[index].fct.Add(seconds);
+        m_classes[index].slowdown.Add(slowdown);
+    }
+}
+
+const FctCollector::SizeClass&
+FctCollector::GetClass(uint32_t sizeClass) const
+{
+    NS_ABORT_MSG_IF(sizeClass > GetNSizeClasses(), "Invalid size class " << sizeClass);
+    static const SizeClass empty{};
+    return m_classes.empty() ? empty : m_classes[sizeClass];
+}
+
+uint64_t
+FctCollector::GetNFlows(uint32_t sizeClass) const
+{
+    return GetClass(sizeClass).fct.GetCount();
+}
+
+Time
+FctCollector::GetMeanFct(uint32_t sizeClass) const
+{
+    return Seconds(GetClass(sizeClass).fct.GetMean());
+}
+
+Time
+FctCollector::GetFctQuantile(uint32_t sizeClass, double q) const
+{
+    return Seconds(GetClass(sizeClass).fct.GetQuantile(q));
+}
+
+double
+FctCollector::GetMeanSlowdown(uint32_t sizeClass) const
+{
+    return GetClass(sizeClass).slowdown.GetMean();
+}
+
+double
+FctCollector::GetSlowdownQuantile(uint32_t sizeClass, double q) const
+{
+    return GetClass(sizeClass).slowdown.GetQuantile(q);
+}
+
+void
+FctCollector::Print(std::ostream& os) const
+{
+    for (uint32_t i = 0; i <= GetNSizeClasses(); i++)
+    {
+        if (i == GetNSizeClasses())
+        {
+            os << "all flows";
+        }
+        else
+        {
+            os << "size class " << i << " (" << (i == 0 ? 0 : m_boundaries[i - 1] + 1) << "-";
+            if (i < m_boundaries.size())
+            {
+                os << m_boundaries[i];
+            }
+            os << " bytes)";
+        }
+        os << ": flows=" << GetNFlows(i) << " fct(mean/p50/p95/p99)=" << GetMeanFct(i).As(Time::US)
+           << "/" << GetFctQuantile(i, 0.5).As(Time::US) << "/"
+           << GetFctQuantile(i, 0.95).As(Time::US) << "/" << GetFctQuantile(i, 0.99).As(Time::US)
+           << " slowdown(mean/p50/p95/p99)=" << GetMeanSlowdown(i) << "/"
+           << GetSlowdownQuantile(i, 0.5) << "/" << GetSlowdownQuantile(i, 0.95) << "/"
+           << GetSlowdownQuantile(i, 0.99) << std::endl;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,148 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef FCT_COLLECTOR_H
+#define FCT_COLLECTOR_H
+
+#include "ns3/data-rate.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/quantile-sketch.h"
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup applications
+ * @brief Collect the flow completion times (FCT) of a workload
+ *
+ * Flows are grouped in size classes, whose boundaries are set by means of
+ * SetSizeClasses(): with boundaries b_0 < b_1 < ... < b_(n-1), class 0 holds
+ * the flows of at most b_0 bytes, class i holds the flows larger than b_(i-1)
+ * bytes and of at most b_i bytes and class n holds the flows larger than
+ * b_(n-1) bytes. By default, flows are classified as small (up to 100 KB),
+ * medium (up to 10 MB) and large.
+ *
+ * For each class, the FCT and the slowdown of the flows are stored in
+ * streaming quantile sketches, hence the memory used does not depend on the
+ * number of flows and any percentile can be retrieved at the end of the
+ * simulation with the configured relative accuracy. The slowdown of a flow
+ * is its FCT normalized to the FCT the flow would achieve on an idle network,
+ * which is computed as BaseRtt plus the flow size divided by LinkRate.
+ *
+ * A single collector can be shared by all the FlowWorkloadApplication
+ * instances of a simulation.
+ */
+class FctCollector : public Object
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    FctCollector();
+    ~FctCollector() override;
+
+    /**
+     * Set the boundaries of the size classes. Clears the flows recorded so far.
+     * @param boundaries the increasing upper bounds (in bytes) of all the classes but the last one
+     */
+    void SetSizeClasses(const std::vector<uint64_t>& boundaries);
+
+    /**
+     * @return the number of size classes
+     */
+    uint32_t GetNSizeClasses() const;
+
+    /**
+     * @param size the flow size in bytes
+     * @return the index of the size class of a flow of the given size
+     */
+    uint32_t GetSizeClass(uint64_t size) const;
+
+    /**
+     * Record a completed flow.
+     * @param size the flow size in bytes
+     * @param fct the flow completion time
+     */
+    void RecordFlow(uint64_t size, Time fct);
+
+    /**
+     * @param size the flow size in bytes
+     * @return the FCT of a flow of the given size on an idle network
+     */
+    Time GetIdealFct(uint64_t size) const;
+
+    /**
+     * @param sizeClass the index of a size class, or GetNSizeClasses () for all the flows
+     * @return the number of flows recorded in the given class
+     */
+    uint64_t GetNFlows(uint32_t sizeClass) const;
+
+    /**
+     * @param sizeClass the index of a size class, or GetNSizeClasses () for all the flows
+     * @return the mean FCT of the flows of the given class
+     */
+    Time GetMeanFct(uint32_t sizeClass) const;
+
+    /**
+     * @param sizeClass the index of a size class, or GetNSizeClasses () for all the flows
+     * @param q the quantile, in [0, 1] (e.g., 0.99 for the 99th percentile)
+     * @return the estimated quantile of the FCT of the flows of the given class
+     */
+    Time GetFctQuantile(uint32_t sizeClass, double q) const;
+
+    /**
+     * @param sizeClass the index of a size class, or GetNSizeClasses () for all the flows
+     * @return the mean slowdown of the flows of the given class
+     */
+    double GetMeanSlowdown(uint32_t sizeClass) const;
+
+    /**
+     * @param sizeClass the index of a size class, or GetNSizeClasses () for all the flows
+     * @param q the quantile, in [0, 1] (e.g., 0.99 for the 99th percentile)
+     * @return the estimated quantile of the slowdown of the flows of the given class
+     */
+    double GetSlowdownQuantile(uint32_t sizeClass, double q) const;
+
+    /**
+     * Print, for each size class and for all the flows, the number of flows and
+     * the mean, median, 95th and 99th percentile of the FCT and of the slowdown.
+     * @param os the output stream
+     */
+    void Print(std::ostream& os) const;
+
+  private:
+    /// The statistics of a size class
+    struct SizeClass
+    {
+        QuantileSketch fct;      //!< FCT, in seconds
+        QuantileSketch slowdown; //!< slowdown
+    };
+
+    /**
+     * @param sizeClass the index of a size class, or GetNSizeClasses () for all the flows
+     * @return the statistics of the given class
+     */
+    const SizeClass& GetClass(uint32_t sizeClass) const;
+
+    /// Reset the statistics of all the classes
+    void Reset();
+
+    std::vector<uint64_t> m_boundaries; //!< upper bounds of the size classes
+    std::vector<SizeClass> m_classes;   //!< statistics of each class, followed by all the flows
+    double m_accuracy;                  //!< relative accuracy of the quantile estimates
+    Time m_baseRtt;                     //!< RTT of the idle network
+    DataRate m_linkRate;                //!< bottleneck rate of the idle network
+};
+
+} // namespace ns3
+
+#endif /* FCT_COLLECTOR_H */
@@ -0,0 +1,341 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "flow-workload-application.h"
+
+#include "fct-collector.h"
+
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+#include "ns3/tcp-socket-factory.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("FlowWorkloadApplication");
+
+NS_OBJECT_ENSURE_REGISTERED(FlowWorkloadApplication);
+
+TypeId
+FlowWorkloadApplication::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::FlowWorkloadApplication")
+            .SetParent<SourceApplication>()
+            .SetGroupName("Applications")
+            .AddConstructor<FlowWorkloadApplication>()
+            .AddAttribute("FlowSize",
+                          "A RandomVariableStream used to pick the size of the flows, in bytes.",
+                          StringValue("ns3::ConstantRandomVariable[Constant=100000]"),
+                          MakePointerAccessor(&FlowWorkloadApplication::m_flowSize),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("InterArrivalTime",
+                          "A RandomVariableStream used to pick the time between the start "
+                          "of consecutive flows, in seconds.",
+                          StringValue("ns3::ExponentialRandomVariable[Mean=0.01]"),
+                          MakePointerAccessor(&FlowWorkloadApplication::m_interArrival),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("MaxFlows",
+                          "The number of flows to start. The value zero means that "
+                          "flows are started until the application is stopped.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&FlowWorkloadApplication::m_maxFlows),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("SendSize",
+                          "The maximum amount of data handed to a socket at once.",
+                          UintegerValue(65536),
+                          MakeUintegerAccessor(&FlowWorkloadApplication::m_sendSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("Protocol",
+                          "The type of protocol to use.",
+                          TypeIdValue(TcpSocketFactory::GetTypeId()),
+                          MakeTypeIdAccessor(&FlowWorkloadApplication::m_tid),
+                          MakeTypeIdChecker())
+            .AddAttribute("FctCollector",
+                          "The collector of the flow completion times, if any.",
+                          PointerValue(),
+                          MakePointerAccessor(&FlowWorkloadApplication::m_collector),
+                          MakePointerChecker<FctCollector>())
+            .AddTraceSource("FlowStart",
+                            "A new flow has started",
+                            MakeTraceSourceAccessor(&FlowWorkloadApplication::m_flowStartTrace),
+                            "ns3::FlowWorkloadApplication::FlowStartCallback")
+            .AddTraceSource("FlowComplete",
+                            "All the bytes of a flow have been acknowledged",
+                            MakeTraceSourceAccessor(&FlowWorkloadApplication::m_flowCompleteTrace),
+                            "ns3::FlowWorkloadApplication::FlowCompleteCallback");
+    return tid;
+}
+
+FlowWorkloadApplication::FlowWorkloadApplication()
+    : m_remoteChoice(CreateObject<UniformRandomVariable>()),
+      m_nextFlowId(0),
+      m_completed(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+FlowWorkloadApplication::~FlowWorkloadApplication()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+FlowWorkloadApplication::AddRemote(const Address& addr)
+{
+    NS_LOG_FUNCTION(this << addr);
+    m_remotes.push_back(addr);
+}
+
+void
+FlowWorkloadApplication::SetFctCollector(Ptr<FctCollector> collector)
+{
+    NS_LOG_FUNCTION(this << collector);
+    m_collector = collector;
+}
+
+uint64_t
+FlowWorkloadApplication::GetNStartedFlows() const
+{
+    return m_nextFlowId;
+}
+
+uint64_t
+FlowWorkloadApplication::GetNCompletedFlows() const
+{
+    return m_completed;
+}
+
+uint32_t
+FlowWorkloadApplication::GetNActiveFlows() const
+{
+    return m_flows.size();
+}
+
+int64_t
+FlowWorkloadApplication::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    auto currentStream = stream;
+    m_flowSize->SetStream(currentStream++);
+    m_interArrival->SetStream(currentStream++);
+    m_remoteChoice->SetStream(currentStream++);
+    currentStream += Application::AssignStreams(currentStream);
+    return (currentStream - stream);
+}
+
+void
+FlowWorkloadApplication::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_flows.clear();
+    m_collector = nullptr;
+    // chain up
+    SourceApplication::DoDispose();
+}
+
+// Application Methods
+void
+FlowWorkloadApplication::StartApplication() // Called at time specified by Start
+{
+    NS_LOG_FUNCTION(this);
+
+    NS_ABORT_MSG_IF(m_peer.IsInvalid() && m_remotes.empty(), "No remote address has been set");
+    if (!m_peer.IsInvalid() &&
+        std::find(m_remotes.begin(), m_remotes.end(), m_peer) == m_remotes.end())
+    {
+        m_remotes.push_back(m_peer);
+    }
+
+    if (m_maxFlows == 0 || m_nextFlowId < m_maxFlows)
+    {
+        m_nextFlowEvent = Simulator::Schedule(Seconds(m_interArrival->GetValue()),
+                                              &FlowWorkloadApplication::StartFlow,
+                                              this);
+    }
+}
+
+void
+FlowWorkloadApplication::StopApplication() // Called at time specified by Stop
+{
+    NS_LOG_FUNCTION(this);
+
+    m_nextFlowEvent.Cancel();
+    for (auto& [flowId, flow] : m_flows)
+    {
+        NS_LOG_LOGIC("Flow " << flowId << " stopped after sending " << flow.sent << " of "
+                             << flow.size << " bytes");
+        flow.socket->Close();
+    }
+    m_flows.clear();
+}
+
+// Private helpers
+
+void
+FlowWorkloadApplication::StartFlow()
+{
+    NS_LOG_FUNCTION(this);
+
+    auto flowId = m_nextFlowId++;
+    auto size = static_cast<uint64_t>(std::max(std::round(m_flowSize->GetValue()), 1.0));
+    const auto& remote =
+        m_remotes[m_remoteChoice->GetInteger(0, static_cast<uint32_t>(m_remotes.size() - 1))];
+
+    auto socket = Socket::CreateSocket(GetNode(), m_tid);
+
+    // Fatal error if socket type is not NS3_SOCK_STREAM or NS3_SOCK_SEQPACKET
+    if (socket->GetSocketType() != Socket::NS3_SOCK_STREAM &&
+        socket->GetSocketType() != Socket::NS3_SOCK_SEQPACKET)
+    {
+        NS_FATAL_ERROR("Using FlowWorkload with an incompatible socket type. "
+                       "FlowWorkload requires SOCK_STREAM or SOCK_SEQPACKET. "
+                       "In other words, use TCP instead of UDP.");
+    }
+
+    int ret = -1;
+    if (!m_local.IsInvalid())
+    {
+        NS_ABORT_MSG_IF((Inet6SocketAddress::IsMatchingType(remote) &&
+                         InetSocketAddress::IsMatchingType(m_local)) ||
+                            (InetSocketAddress::IsMatchingType(remote) &&
+                             Inet6SocketAddress::IsMatchingType(m_local)),
+                        "Incompatible peer and local address IP version");
+        // the port of the local address is not used, as each flow needs its own port
+        ret = InetSocketAddress::IsMatchingType(m_local)
+                  ? socket->Bind(InetSocketAddress(
+                        InetSocketAddress::ConvertFrom(m_local).GetIpv4()))
+                  : socket->Bind(
+                        Inet6SocketAddress(Inet6SocketAddress::ConvertFrom(m_local).GetIpv6()));
+    }
+    else if (Inet6SocketAddress::IsMatchingType(remote))
+    {
+        ret = socket->Bind6();
+    }
+    else if (InetSocketAddress::IsMatchingType(remote))
+    {
+        ret = socket->Bind();
+    }
+
+    if (ret == -1)
+    {
+        NS_FATAL_ERROR("Failed to bind socket");
+    }
+
+    if (InetSocketAddress::IsMatchingType(remote))
+    {
+        socket->SetIpTos(m_tos); // Affects only IPv4 sockets.
+    }
+
+    m_flows[flowId] = Flow{socket, size, 0, socket->GetTxAvailable(), Simulator::Now(), false};
+
+    // the flow identifier is bound to the callbacks, so that no lookup by socket is needed
+    socket->SetConnectCallback(
+        MakeCallback(&FlowWorkloadApplication::ConnectionSucceeded, this, flowId),
+        MakeCallback(&FlowWorkloadApplication::ConnectionFailed, this, flowId));
+    socket->SetSendCallback(MakeCallback(&FlowWorkloadApplication::DataSend, this, flowId));
+    socket->Connect(remote);
+    socket->ShutdownRecv();
+
+    NS_LOG_DEBUG("Flow " << flowId << " of " << size << " bytes started");
+    m_flowStartTrace(flowId, size, remote);
+
+    if (m_maxFlows == 0 || m_nextFlowId < m_maxFlows)
+    {
+        m_nextFlowEvent = Simulator::Schedule(Seconds(m_interArrival->GetValue()),
+                                              &FlowWorkloadApplication::StartFlow,
+                                              this);
+    }
+}
+
+void
+FlowWorkloadApplication::ConnectionSucceeded(uint64_t flowId, Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << flowId << socket);
+
+    auto it = m_flows.find(flowId);
+    if (it == m_flows.end())
+    {
+        return;
+    }
+    it->second.connected = true;
+    SendData(flowId);
+}
+
+void
+FlowWorkloadApplication::ConnectionFailed(uint64_t flowId, Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << flowId << socket);
+    NS_LOG_LOGIC("FlowWorkloadApplication, connection of flow " << flowId << " failed");
+    m_flows.erase(flowId);
+}
+
+void
+FlowWorkloadApplication::DataSend(uint64_t flowId, Ptr<Socket> socket, uint32_t)
+{
+    NS_LOG_FUNCTION(this << flowId << socket);
+    SendData(flowId);
+}
+
+void
+FlowWorkloadApplication::SendData(uint64_t flowId)
+{
+    NS_LOG_FUNCTION(this << flowId);
+
+    auto it = m_flows.find(flowId);
+    if (it == m_flows.end() || !it->second.connected)
+    {
+        return;
+    }
+    auto& flow = it->second;
+
+    while (flow.sent < flow.size)
+    {
+        uint64_t toSend = std::min<uint64_t>(
+            {m_sendSize, flow.size - flow.sent, flow.socket->GetTxAvailable()});
+        if (toSend == 0)
+        {
+            // wait for the send callback to signal that buffer space has freed up
+            break;
+        }
+        int actual = flow.socket->Send(Create<Packet>(toSend));
+        if (actual <= 0)
+        {
+            break;
+        }
+        flow.sent += actual;
+    }
+
+    if (flow.sent == flow.size && flow.socket->GetTxAvailable() == flow.txBuffer)
+    {
+        // all the bytes have been acknowledged
+        auto fct = Simulator::Now() - flow.start;
+        auto size = flow.size;
+        NS_LOG_DEBUG("Flow " << flowId << " of " << size << " bytes completed in " << fct);
+        flow.socket->Close();
+        m_flows.erase(it);
+        m_completed++;
+        if (m_collector)
+        {
+            m_collector->RecordFlow(size, fct);
+        }
+        m_flowCompleteTrace(flowId, size, fct);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,190 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef FLOW_WORKLOAD_APPLICATION_H
+#define FLOW_WORKLOAD_APPLICATION_H
+
+#include "source-application.h"
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+class FctCollector;
+class RandomVariableStream;
+class Socket;
+class UniformRandomVariable;
+
+/**
+ * @ingroup applications
+ * @defgroup flowworkload FlowWorkloadApplication
+ *
+ * This traffic generator starts flows at random times, each flow sending a
+ * random number of bytes over its own connection to one of a set of
+ * remote addresses, and measures the flow completion times.
+ */
+
+/**
+ * @ingroup flowworkload
+ *
+ * @brief Generate a workload of flows and measure their completion time.
+ *
+ * Each flow opens a new connection to a remote address chosen uniformly at
+ * random among the Remote attribute and the addresses added by means of
+ * AddRemote(), sends a number of bytes drawn from the FlowSize random
+ * variable as fast as possible (like the BulkSendApplication) and closes the
+ * connection. The time between the start of consecutive flows is drawn from
+ * the InterArrivalTime random variable; an exponential random variable yields
+ * Poisson arrivals. The FlowWorkloadHelper provides the flow size
+ * distributions commonly used in data center studies and computes the mean
+ * inter-arrival time corresponding to a given network load.
+ *
+ * All the flows are handled by a single application instance, which keeps a
+ * small record per active flow, hence thousands of concurrent flows can be
+ * generated without instantiating an application per flow.
+ *
+ * A flow is complete when all its bytes have been acknowledged by the
+ * receiver, i.e., when the transmit buffer of its socket is empty again. The
+ * flow completion time (FCT) is measured from the creation of the socket, so
+ * it includes the connection setup. Completed flows are reported through the
+ * FlowComplete trace source and, if the FctCollector attribute is set, are
+ * recorded by the collector. Only SOCK_STREAM and SOCK_SEQPACKET sockets
+ * are supported; the remote nodes are expected to run a PacketSink.
+ */
+class FlowWorkloadApplication : public SourceApplication
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    FlowWorkloadApplication();
+    ~FlowWorkloadApplication() override;
+
+    /**
+     * @brief Add a remote address flows can be sent to.
+     * @param addr the remote address
+     */
+    void AddRemote(const Address& addr);
+
+    /**
+     * @brief Set the collector of the flow completion times.
+     * @param collector the collector
+     */
+    void SetFctCollector(Ptr<FctCollector> collector);
+
+    /**
+     * @return the number of flows started so far
+     */
+    uint64_t GetNStartedFlows() const;
+
+    /**
+     * @return the number of flows completed so far
+     */
+    uint64_t GetNCompletedFlows() const;
+
+    /**
+     * @return the number of flows currently active
+     */
+    uint32_t GetNActiveFlows() const;
+
+    int64_t AssignStreams(int64_t stream) override;
+
+    /**
+     * TracedCallback signature for the start of a flow.
+     * @param [in] flowId the identifier of the flow (unique for this application)
+     * @param [in] size the number of bytes to send
+     * @param [in] remote the remote address
+     */
+    typedef void (*FlowStartCallback)(uint64_t flowId, uint64_t size, const Address& remote);
+
+    /**
+     * TracedCallback signature for the completion of a flow.
+     * @param [in] flowId the identifier of the flow (unique for this application)
+     * @param [in] size the number of bytes sent
+     * @param [in] fct the flow completion time
+     */
+    typedef void (*FlowCompleteCallback)(uint64_t flowId, uint64_t size, Time fct);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    void StartApplication() override;
+    void StopApplication() override;
+
+    /// Start a new flow and schedule the start of the next one
+    void StartFlow();
+
+    /**
+     * @brief Send data of the given flow until the L4 transmission buffer is
+     * full, and check whether the flow is complete.
+     * @param flowId the flow identifier
+     */
+    void SendData(uint64_t flowId);
+
+    /**
+     * @brief Connection succeeded callback.
+     * @param flowId the flow identifier
+     * @param socket the connected socket
+     */
+    void ConnectionSucceeded(uint64_t flowId, Ptr<Socket> socket);
+
+    /**
+     * @brief Connection failed callback.
+     * @param flowId the flow identifier
+     * @param socket the socket
+     */
+    void ConnectionFailed(uint64_t flowId, Ptr<Socket> socket);
+
+    /**
+     * @brief Send more data as soon as some tx buffer space becomes available.
+     * @param flowId the flow identifier
+     * @param socket the socket
+     * @param available the amount of available tx buffer space
+     */
+    void DataSend(uint64_t flowId, Ptr<Socket> socket, uint32_t available);
+
+    /// An active flow
+    struct Flow
+    {
+        Ptr<Socket> socket;   //!< the socket of the flow
+        uint64_t size;        //!< the number of bytes to send
+        uint64_t sent;        //!< the number of bytes handed to the socket
+        uint32_t txBuffer;    //!< the size of the transmit buffer of the socket
+        Time start;           //!< the start time of the flow
+        bool connected;       //!< whether the connection has been established
+    };
+
+    std::unordered_map<uint64_t, Flow> m_flows; //!< active flows, indexed by identifier
+    std::vector<Address> m_remotes;             //!< additional remote addresses
+    Ptr<RandomVariableStream> m_flowSize;       //!< flow size, in bytes
+    Ptr<RandomVariableStream> m_interArrival;   //!< time between flow starts, in seconds
+    Ptr<UniformRandomVariable> m_remoteChoice;  //!< selection of the remote address
+    Ptr<FctCollector> m_collector;              //!< collector of the flow completion times
+    EventId m_nextFlowEvent;                    //!< event to start the next flow
+    uint32_t m_sendSize;                        //!< maximum amount of data handed at once
+    uint64_t m_maxFlows;                        //!< number of flows to start (0 for no limit)
+    uint64_t m_nextFlowId;                      //!< identifier of the next flow
+    uint64_t m_completed;                       //!< number of completed flows
+    TypeId m_tid;                               //!< the type of protocol to use
+
+    /// Traced Callback: a flow has started
+    TracedCallback<uint64_t, uint64_t, const Address&> m_flowStartTrace;
+    /// Traced Callback: a flow has completed
+    TracedCallback<uint64_t, uint64_t, Time> m_flowCompleteTrace;
+};
+
+} // namespace ns3
+
+#endif /* FLOW_WORKLOAD_APPLICATION_H */
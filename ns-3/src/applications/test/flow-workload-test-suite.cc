@@ -0,0 +1,303 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/application-container.h"
+#include "ns3/data-rate.h"
+#include "ns3/double.h"
+#include "ns3/fct-collector.h"
+#include "ns3/flow-workload-application.h"
+#include "ns3/flow-workload-helper.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-interface-container.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/pointer.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <fstream>
+
+using namespace ns3;
+
+/**
+ * @ingroup applications-test
+ * @ingroup tests
+ *
+ * @brief Check the classification of the flows and the statistics of the FctCollector
+ */
+class FctCollectorTestCase : public TestCase
+{
+  public:
+    FctCollectorTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FctCollectorTestCase::FctCollectorTestCase()
+    : TestCase("Check the FCT collector")
+{
+}
+
+void
+FctCollectorTestCase::DoRun()
+{
+    auto collector = CreateObject<FctCollector>();
+    collector->SetAttribute("BaseRtt", TimeValue(MicroSeconds(10)));
+    collector->SetAttribute("LinkRate", DataRateValue(DataRate("8Gbps")));
+
+    NS_TEST_EXPECT_MSG_EQ(collector->GetNSizeClasses(), 3, "Unexpected number of classes");
+    NS_TEST_EXPECT_MSG_EQ(collector->GetSizeClass(100000), 0, "Unexpected class");
+    NS_TEST_EXPECT_MSG_EQ(collector->GetSizeClass(100001), 1, "Unexpected class");
+    NS_TEST_EXPECT_MSG_EQ(collector->GetSizeClass(20000000), 2, "Unexpected class");
+    NS_TEST_EXPECT_MSG_EQ(collector->GetIdealFct(10000), MicroSeconds(20), "Unexpected ideal FCT");
+
+    // 1000 small flows whose FCT is 1, 2, ..., 1000 times the ideal FCT
+    for (uint32_t i = 1; i <= 1000; i++)
+    {
+        collector->RecordFlow(10000, MicroSeconds(20 * i));
+    }
+    collector->RecordFlow(1000000, MilliSeconds(1));
+
+    NS_TEST_EXPECT_MSG_EQ(collector->GetNFlows(0), 1000, "Unexpected number of small flows");
+    NS_TEST_EXPECT_MSG_EQ(collector->GetNFlows(1), 1, "Unexpected number of medium flows");
+    NS_TEST_EXPECT_MSG_EQ(collector->GetNFlows(2), 0, "Unexpected number of large flows");
+    NS_TEST_EXPECT_MSG_EQ(collector->GetNFlows(3), 1001, "Unexpected number of flows");
+
+    NS_TEST_EXPECT_MSG_EQ_TOL(collector->GetMeanSlowdown(0), 500.5, 1e-6, "Unexpected slowdown");
+    NS_TEST_EXPECT_MSG_EQ_TOL(collector->GetSlowdownQuantile(0, 0.99),
+                              990,
+                              0.01 * 990,
+                              "Unexpected 99th percentile of the slowdown");
+    NS_TEST_EXPECT_MSG_EQ_TOL(collector->GetFctQuantile(0, 0.5).GetSeconds(),
+                              10000e-6,
+                              0.01 * 10000e-6,
+                              "Unexpected median FCT");
+    NS_TEST_EXPECT_MSG_EQ_TOL(collector->GetMeanFct(1).GetSeconds(),
+                              1e-3,
+                              1e-12,
+                              "Unexpected mean FCT");
+
+    collector->SetSizeClasses({1000, 10000, 100000});
+    NS_TEST_EXPECT_MSG_EQ(collector->GetNSizeClasses(), 4, "Unexpected number of classes");
+    NS_TEST_EXPECT_MSG_EQ(collector->GetNFlows(4), 0, "The statistics should have been reset");
+}
+
+/**
+ * @ingroup applications-test
+ * @ingroup tests
+ *
+ * @brief Check the flow size distributions provided by the FlowWorkloadHelper
+ */
+class FlowSizeCdfTestCase : public TestCase
+{
+  public:
+    FlowSizeCdfTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowSizeCdfTestCase::FlowSizeCdfTestCase()
+    : TestCase("Check the flow size distributions")
+{
+}
+
+void
+FlowSizeCdfTestCase::DoRun()
+{
+    auto webSearch = FlowWorkloadHelper::GetWebSearchCdf();
+    NS_TEST_EXPECT_MSG_EQ_TOL(FlowWorkloadHelper::GetMeanFlowSize(webSearch),
+                              1711250,
+                              1e-6,
+                              "Unexpected mean flow size");
+
+    // the sample mean of the flow sizes matches the mean of the distribution
+    auto sizes = FlowWorkloadHelper::CreateFlowSizeVariable(webSearch);
+    sizes->SetStream(1);
+    double sum = 0;
+    const uint32_t n = 100000;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        sum += sizes->GetValue();
+    }
+    NS_TEST_EXPECT_MSG_EQ_TOL(sum / n, 1711250, 0.03 * 1711250, "Unexpected sample mean");
+
+    auto dataMining = FlowWorkloadHelper::GetDataMiningCdf();
+    NS_TEST_EXPECT_MSG_EQ(dataMining.front().first, 1460, "Unexpected minimum flow size");
+    NS_TEST_EXPECT_MSG_EQ(dataMining.back().first, 666667.0 * 1460, "Unexpected max flow size");
+
+    auto fileName = CreateTempDirFilename("flow-size-cdf.txt");
+    {
+        std::ofstream file(fileName);
+        file << "# size cdf(%)\n"
+             << "1000 0\n"
+             << "\n"
+             << "2000 50\n"
+             << "4000 100\n";
+    }
+    auto loaded = FlowWorkloadHelper::LoadCdf(fileName);
+    NS_TEST_ASSERT_MSG_EQ(loaded.size(), 3, "Unexpected number of points");
+    NS_TEST_EXPECT_MSG_EQ(loaded[1].second, 0.5, "Percentages should have been converted");
+    NS_TEST_EXPECT_MSG_EQ_TOL(FlowWorkloadHelper::GetMeanFlowSize(loaded),
+                              2250,
+                              1e-9,
+                              "Unexpected mean flow size");
+}
+
+/**
+ * @ingroup applications-test
+ * @ingroup tests
+ *
+ * @brief Run a workload of many concurrent TCP flows generated by a single
+ * application and check that all of them complete and are recorded.
+ */
+class FlowWorkloadTestCase : public TestCase
+{
+  public:
+    FlowWorkloadTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Record the start of a flow.
+     * @param flowId the flow identifier
+     * @param size the flow size
+     * @param remote the remote address
+     */
+    void FlowStart(uint64_t flowId, uint64_t size, const Address& remote);
+
+    /**
+     * Record the completion of a flow.
+     * @param flowId the flow identifier
+     * @param size the flow size
+     * @param fct the flow completion time
+     */
+    void FlowComplete(uint64_t flowId, uint64_t size, Time fct);
+
+    Ptr<FlowWorkloadApplication> m_app; //!< the application
+    uint32_t m_started{0};              //!< number of started flows
+    uint64_t m_completedBytes{0};       //!< number of bytes of the completed flows
+    uint32_t m_maxActive{0};            //!< maximum number of concurrent flows
+    Time m_minFct{Time::Max()};         //!< smallest FCT
+};
+
+FlowWorkloadTestCase::FlowWorkloadTestCase()
+    : TestCase("Check a workload of concurrent flows")
+{
+}
+
+void
+FlowWorkloadTestCase::FlowStart(uint64_t flowId, uint64_t size, const Address& remote)
+{
+    NS_TEST_EXPECT_MSG_EQ(flowId, m_started, "Unexpected flow identifier");
+    m_started++;
+    m_maxActive = std::max(m_maxActive, m_app->GetNActiveFlows());
+}
+
+void
+FlowWorkloadTestCase::FlowComplete(uint64_t flowId, uint64_t size, Time fct)
+{
+    m_completedBytes += size;
+    m_minFct = std::min(m_minFct, fct);
+}
+
+void
+FlowWorkloadTestCase::DoRun()
+{
+    NodeContainer nodes(3);
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+    simpleHelper.SetChannelAttribute("Delay", StringValue("10us"));
+    auto devices = simpleHelper.Install(nodes);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    auto interfaces = ipv4.Assign(devices);
+
+    uint16_t port = 9;
+    PacketSinkHelper sinkHelper("ns3::TcpSocketFactory",
+                                InetSocketAddress(Ipv4Address::GetAny(), port));
+    auto sinkApps = sinkHelper.Install(NodeContainer(nodes.Get(1), nodes.Get(2)));
+    sinkApps.Start(Seconds(0));
+
+    auto collector = CreateObject<FctCollector>();
+    collector->SetAttribute("LinkRate", DataRateValue(DataRate("1Gbps")));
+
+    // 500 flows of 20 KB starting every 2 us on average, much faster than they complete
+    const uint32_t nFlows = 500;
+    const uint32_t size = 20000;
+    FlowWorkloadHelper workload("ns3::TcpSocketFactory",
+                                InetSocketAddress(interfaces.GetAddress(1), port));
+    workload.AddRemote(InetSocketAddress(interfaces.GetAddress(2), port));
+    workload.SetAttribute("FlowSize", StringValue("ns3::ConstantRandomVariable[Constant=20000]"));
+    workload.SetAttribute("InterArrivalTime",
+                          StringValue("ns3::ExponentialRandomVariable[Mean=2e-6]"));
+    workload.SetAttribute("MaxFlows", UintegerValue(nFlows));
+    workload.SetAttribute("FctCollector", PointerValue(collector));
+    auto apps = workload.Install(nodes.Get(0));
+    workload.AssignStreams(nodes, 1);
+    apps.Start(Seconds(0));
+
+    m_app = DynamicCast<FlowWorkloadApplication>(apps.Get(0));
+    m_app->TraceConnectWithoutContext("FlowStart",
+                                      MakeCallback(&FlowWorkloadTestCase::FlowStart, this));
+    m_app->TraceConnectWithoutContext("FlowComplete",
+                                      MakeCallback(&FlowWorkloadTestCase::FlowComplete, this));
+
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_started, nFlows, "Unexpected number of started flows");
+    NS_TEST_EXPECT_MSG_EQ(m_app->GetNCompletedFlows(), nFlows, "Not all the flows completed");
+    NS_TEST_EXPECT_MSG_EQ(m_app->GetNActiveFlows(), 0, "No flow should be active");
+    NS_TEST_EXPECT_MSG_GT(m_maxActive, 100, "Flows should have been concurrent");
+    NS_TEST_EXPECT_MSG_EQ(m_completedBytes, nFlows * size, "Unexpected number of bytes");
+    NS_TEST_EXPECT_MSG_EQ(collector->GetNFlows(collector->GetNSizeClasses()),
+                          nFlows,
+                          "Unexpected number of recorded flows");
+    NS_TEST_EXPECT_MSG_GT(m_minFct,
+                          collector->GetIdealFct(size) - MicroSeconds(10),
+                          "A flow cannot complete faster than the link rate allows");
+
+    uint64_t received = 0;
+    for (uint32_t i = 0; i < sinkApps.GetN(); i++)
+    {
+        auto sink = DynamicCast<PacketSink>(sinkApps.Get(i));
+        NS_TEST_EXPECT_MSG_GT(sink->GetTotalRx(), 0, "Each remote should receive flows");
+        received += sink->GetTotalRx();
+    }
+    NS_TEST_EXPECT_MSG_EQ(received, nFlows * size, "Unexpected number of received bytes");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup applications-test
+ * @ingroup tests
+ *
+ * @brief Flow workload TestSuite
+ */
+class FlowWorkloadTestSuite : public TestSuite
+{
+  public:
+    FlowWorkloadTestSuite()
+        : TestSuite("applications-flow-workload", Type::UNIT)
+    {
+        AddTestCase(new FctCollectorTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new FlowSizeCdfTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new FlowWorkloadTestCase(), TestCase::Duration::QUICK);
+    }
+};
+
+static FlowWorkloadTestSuite g_flowWorkloadTestSuite; //!< Static variable for test initialization
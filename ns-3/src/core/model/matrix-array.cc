@@ -8,6 +8,10 @@
 
 #include "matrix-array.h"
 
+#include <algorithm>
+#include <complex>
+#include <vector>
+
 #ifdef HAVE_EIGEN3
 
 #if defined(__GNUC__) && !defined(__clang__)
@@ -40,6 +44,223 @@ template <class T>
 using ConstEigenMatrix = Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>>;
 #endif
 
+namespace
+{
+
+/// Number of rows of the blocks of the lhs matrix processed at once by MultiplyPage()
+constexpr size_t MULTIPLY_BLOCK_ROWS = 64;
+/// Number of columns of the blocks of the lhs matrix processed at once by MultiplyPage()
+constexpr size_t MULTIPLY_BLOCK_INNER = 32;
+/// Number of rows of the lhs matrix below which MultiplyPage() computes dot products
+constexpr size_t MULTIPLY_MIN_BLOCK_ROWS = 4;
+/// Size of the square blocks processed at once by TransposePage()
+constexpr size_t TRANSPOSE_BLOCK_SIZE = 16;
+
+/**
+ * Add the product of the given column and the given factor to the given column,
+ * i.e., res[i] += col[i] * factor for i = 0, ..., size - 1.
+ *
+ * @tparam T the type of the elements
+ * @param res the column to update
+ * @param col the column to multiply
+ * @param factor the factor
+ * @param size the number of elements of the columns
+ */
+template <class T>
+inline void
+MultiplyAdd(T* res, const T* col, T factor, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        res[i] += col[i] * factor;
+    }
+}
+
+/**
+ * Specialization of MultiplyAdd() for complex numbers. The product of std::complex values
+ * checks whether the result is NaN (to comply with Annex G of C99), which prevents the loop
+ * from being vectorized. Here, the product is expanded into real operations, which give the
+ * same result for finite values.
+ *
+ * @param res the column to update
+ * @param col the column to multiply
+ * @param factor the factor
+ * @param size the number of elements of the columns
+ */
+template <>
+inline void
+MultiplyAdd(std::complex<double>* res,
+            const std::complex<double>* col,
+            std::complex<double> factor,
+            size_t size)
+{
+    // std::complex<double> is guaranteed to be laid out as an array of two doubles
+    auto resValues = reinterpret_cast<double*>(res);
+    auto colValues = reinterpret_cast<const double*>(col);
+    const double factorReal = factor.real();
+    const double factorImag = factor.imag();
+    for (size_t i = 0; i < size; ++i)
+    {
+        const double colReal = colValues[2 * i];
+        const double colImag = colValues[2 * i + 1];
+        resValues[2 * i] += colReal * factorReal - colImag * factorImag;
+        resValues[2 * i + 1] += colReal * factorImag + colImag * factorReal;
+    }
+}
+
+/**
+ * Compute the dot product of the given row of a column-major matrix and the given column,
+ * summing the products in increasing order of index.
+ *
+ * @tparam T the type of the elements
+ * @param row the first element of the row
+ * @param stride the distance between consecutive elements of the row
+ * @param col the column
+ * @param size the number of elements of the row and of the column
+ * @return the dot product
+ */
+template <class T>
+inline T
+DotProduct(const T* row, size_t stride, const T* col, size_t size)
+{
+    T res{};
+    for (size_t i = 0; i < size; ++i)
+    {
+        res += row[i * stride] * col[i];
+    }
+    return res;
+}
+
+/**
+ * Specialization of DotProduct() for complex numbers, which expands the products into real
+ * operations (see the specialization of MultiplyAdd()).
+ *
+ * @param row the first element of the row
+ * @param stride the distance between consecutive elements of the row
+ * @param col the column
+ * @param size the number of elements of the row and of the column
+ * @return the dot product
+ */
+template <>
+inline std::complex<double>
+DotProduct(const std::complex<double>* row,
+           size_t stride,
+           const std::complex<double>* col,
+           size_t size)
+{
+    auto rowValues = reinterpret_cast<const double*>(row);
+    auto colValues = reinterpret_cast<const double*>(col);
+    double resReal = 0;
+    double resImag = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        const double rowReal = rowValues[2 * i * stride];
+        const double rowImag = rowValues[2 * i * stride + 1];
+        const double colReal = colValues[2 * i];
+        const double colImag = colValues[2 * i + 1];
+        resReal += rowReal * colReal - rowImag * colImag;
+        resImag += rowReal * colImag + rowImag * colReal;
+    }
+    return {resReal, resImag};
+}
+
+/**
+ * Add the product of two column-major matrices to the given column-major matrix,
+ * i.e., res += lhs * rhs. The lhs matrix is processed in blocks that fit in the cache, and
+ * the innermost loop runs over contiguous elements of a column, so that it can be vectorized.
+ * If lhs has only a few rows, the elements of the result are computed as dot products instead.
+ * For every element of the result, the products are summed in increasing order of the inner
+ * index, as in the textbook algorithm.
+ *
+ * @tparam T the type of the elements
+ * @param lhs the lhs matrix, with numRows rows and numInner columns
+ * @param rhs the rhs matrix, with numInner rows and numCols columns
+ * @param res the result matrix, with numRows rows and numCols columns
+ * @param numRows the number of rows of lhs and res
+ * @param numInner the number of columns of lhs and rows of rhs
+ * @param numCols the number of columns of rhs and res
+ */
+template <class T>
+void
+MultiplyPage(const T* lhs, const T* rhs, T* res, size_t numRows, size_t numInner, size_t numCols)
+{
+    if (numRows < MULTIPLY_MIN_BLOCK_ROWS)
+    {
+        // the columns are too short to be vectorized, e.g., lhs is a row vector
+        for (size_t col = 0; col < numCols; ++col)
+        {
+            for (size_t row = 0; row < numRows; ++row)
+            {
+                res[col * numRows + row] +=
+                    DotProduct(lhs + row, numRows, rhs + col * numInner, numInner);
+            }
+        }
+        return;
+    }
+
+    for (size_t rowBlock = 0; rowBlock < numRows; rowBlock += MULTIPLY_BLOCK_ROWS)
+    {
+        const size_t blockRows = std::min(MULTIPLY_BLOCK_ROWS, numRows - rowBlock);
+        for (size_t innerBlock = 0; innerBlock < numInner; innerBlock += MULTIPLY_BLOCK_INNER)
+        {
+            const size_t innerEnd = std::min(innerBlock + MULTIPLY_BLOCK_INNER, numInner);
+            for (size_t col = 0; col < numCols; ++col)
+            {
+                T* resCol = res + col * numRows + rowBlock;
+                for (size_t inner = innerBlock; inner < innerEnd; ++inner)
+                {
+                    MultiplyAdd(resCol,
+                                lhs + inner * numRows + rowBlock,
+                                rhs[col * numInner + inner],
+                                blockRows);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Store the (conjugate) transpose of a column-major matrix in the given column-major matrix.
+ * The matrix is processed in square blocks, so that both the reads and the writes hit the
+ * cache.
+ *
+ * @tparam T the type of the elements
+ * @tparam Conjugate whether to store the conjugate transpose
+ * @param src the matrix to transpose, with numRows rows and numCols columns
+ * @param dst the transposed matrix, with numCols rows and numRows columns
+ * @param numRows the number of rows of src
+ * @param numCols the number of columns of src
+ */
+template <class T, bool Conjugate>
+void
+TransposePage(const T* src, T* dst, size_t numRows, size_t numCols)
+{
+    for (size_t colBlock = 0; colBlock < numCols; colBlock += TRANSPOSE_BLOCK_SIZE)
+    {
+        const size_t colEnd = std::min(colBlock + TRANSPOSE_BLOCK_SIZE, numCols);
+        for (size_t rowBlock = 0; rowBlock < numRows; rowBlock += TRANSPOSE_BLOCK_SIZE)
+        {
+            const size_t rowEnd = std::min(rowBlock + TRANSPOSE_BLOCK_SIZE, numRows);
+            for (size_t row = rowBlock; row < rowEnd; ++row)
+            {
+                for (size_t col = colBlock; col < colEnd; ++col)
+                {
+                    if constexpr (Conjugate)
+                    {
+                        dst[row * numCols + col] = std::conj(src[col * numRows + row]);
+                    }
+                    else
+                    {
+                        dst[row * numCols + col] = src[col * numRows + row];
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
 template <class T>
 MatrixArray<T>::MatrixArray(size_t numRows, size_t numCols, size_t numPages)
     : ValArray<T>(numRows, numCols, numPages)
@@ -114,19 +335,12 @@ MatrixArray<T>::operator*(const MatrixArray<T>& rhs) const
 
 #else // Eigen not found or Eigen optimizations not enabled
 
-        size_t matrixOffset = page * m_numRows * m_numCols;
-        size_t rhsMatrixOffset = page * rhs.m_numRows * rhs.m_numCols;
-        for (size_t i = 0; i < res.m_numRows; ++i)
-        {
-            for (size_t j = 0; j < res.m_numCols; ++j)
-            {
-                res(i, j, page) = (m_values[std::slice(matrixOffset + i, m_numCols, m_numRows)] *
-                                   rhs.m_values[std::slice(rhsMatrixOffset + j * rhs.m_numRows,
-                                                           rhs.m_numRows,
-                                                           1)])
-                                      .sum();
-            }
-        }
+        MultiplyPage(GetPagePtr(page),
+                     rhs.GetPagePtr(page),
+                     res.GetPagePtr(page),
+                     m_numRows,
+                     m_numCols,
+                     rhs.m_numCols);
 
 #endif
     }
@@ -151,12 +365,7 @@ MatrixArray<T>::Transpose() const
 
 #else // Eigen not found or Eigen optimizations not enabled
 
-        size_t matrixIndex = page * m_numRows * m_numCols;
-        for (size_t i = 0; i < m_numRows; ++i)
-        {
-            res.m_values[std::slice(matrixIndex + i * res.m_numRows, res.m_numRows, 1)] =
-                m_values[std::slice(matrixIndex + i, m_numCols, m_numRows)];
-        }
+        TransposePage<T, false>(GetPagePtr(page), res.GetPagePtr(page), m_numRows, m_numCols);
 
 #endif
     }
@@ -245,6 +454,8 @@ MatrixArray<T>::MultiplyByLeftAndRightMatrix(const MatrixArray<T>& lMatrix,
 
     ConstEigenMatrix<T> lMatrixEigen(lMatrix.GetPagePtr(0), lMatrix.m_numRows, lMatrix.m_numCols);
     ConstEigenMatrix<T> rMatrixEigen(rMatrix.GetPagePtr(0), rMatrix.m_numRows, rMatrix.m_numCols);
+#else
+    std::vector<T> interRes(lMatrix.m_numRows * m_numCols);
 #endif
 
     for (size_t page = 0; page < m_numPages; ++page)
@@ -258,29 +469,20 @@ MatrixArray<T>::MultiplyByLeftAndRightMatrix(const MatrixArray<T>& lMatrix,
 
 #else // Eigen not found or Eigen optimizations not enabled
 
-        size_t matrixOffset = page * m_numRows * m_numCols;
-        for (size_t resRow = 0; resRow < res.m_numRows; ++resRow)
-        {
-            for (size_t resCol = 0; resCol < res.m_numCols; ++resCol)
-            {
-                // create intermediate row result, a multiply of resRow row of lMatrix and each
-                // column of this matrix
-                std::valarray<T> interRes(m_numCols);
-                for (size_t thisCol = 0; thisCol < m_numCols; ++thisCol)
-                {
-                    interRes[thisCol] =
-                        (lMatrix
-                             .m_values[std::slice(resRow, lMatrix.m_numCols, lMatrix.m_numRows)] *
-                         m_values[std::slice(matrixOffset + thisCol * m_numRows, m_numRows, 1)])
-                            .sum();
-                }
-                // multiply intermediate results and resCol column of the rMatrix
-                res(resRow, resCol, page) =
-                    (interRes *
-                     rMatrix.m_values[std::slice(resCol * rMatrix.m_numRows, rMatrix.m_numRows, 1)])
-                        .sum();
-            }
-        }
+        // compute lMatrix * matrix(page) once, then multiply it by rMatrix
+        std::fill(interRes.begin(), interRes.end(), T{});
+        MultiplyPage(lMatrix.GetPagePtr(0),
+                     GetPagePtr(page),
+                     interRes.data(),
+                     lMatrix.m_numRows,
+                     m_numRows,
+                     m_numCols);
+        MultiplyPage(interRes.data(),
+                     rMatrix.GetPagePtr(0),
+                     res.GetPagePtr(page),
+                     lMatrix.m_numRows,
+                     m_numCols,
+                     rMatrix.m_numCols);
 #endif
     }
     return res;
@@ -291,13 +493,24 @@ template <bool EnableBool, typename>
 MatrixArray<T>
 MatrixArray<T>::HermitianTranspose() const
 {
-    MatrixArray<std::complex<double>> retMatrix = this->Transpose();
+    MatrixArray<T> res{m_numCols, m_numRows, m_numPages};
 
-    for (size_t index = 0; index < this->GetSize(); ++index)
+    for (size_t page = 0; page < m_numPages; ++page)
     {
-        retMatrix.m_values[index] = std::conj(retMatrix.m_values[index]);
+#ifdef HAVE_EIGEN3 // Eigen found and Eigen optimizations enabled
+
+        ConstEigenMatrix<T> thisMatrix(GetPagePtr(page), m_numRows, m_numCols);
+        EigenMatrix<T> resEigenMatrix(res.GetPagePtr(page), res.m_numRows, res.m_numCols);
+        resEigenMatrix = thisMatrix.adjoint();
+
+#else // Eigen not found or Eigen optimizations not enabled
+
+        // conjugate the elements while transposing them, rather than in a separate pass
+        TransposePage<T, true>(GetPagePtr(page), res.GetPagePtr(page), m_numRows, m_numCols);
+
+#endif
     }
-    return retMatrix;
+    return res;
 }
 
 template <class T>
@@ -464,10 +464,7 @@ template <class T>
 inline ValArray<T>
 ValArray<T>::operator*(const T& rhs) const
 {
-    return ValArray<T>(m_numRows,
-                       m_numCols,
-                       m_numPages,
-                       m_values * std::valarray<T>(rhs, m_numRows * m_numCols * m_numPages));
+    return ValArray<T>(m_numRows, m_numCols, m_numPages, m_values * rhs);
 }
 
 template <class T>
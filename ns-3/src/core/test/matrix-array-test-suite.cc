@@ -11,6 +11,7 @@
 #include "ns3/test.h"
 
 #include <algorithm>
+#include <cmath>
 
 /**
  * @defgroup matrixArray-tests MatrixArray tests
@@ -680,6 +681,92 @@ ComplexMatrixArrayTestCase::DoRun()
     NS_LOG_INFO("m2 (2, 3, 2):" << m2);
     NS_LOG_INFO("m3 (2, 3, 2):" << m3);
     NS_TEST_ASSERT_MSG_EQ(m2, m3, "m2 and m3 matrices should be equal");
+
+    // test the products and the Hermitian transpose of matrices larger than the blocks
+    // processed at once by the kernels, against the textbook algorithms
+    const size_t numRows = 70;
+    const size_t numInner = 40;
+    const size_t numCols = 3;
+    const size_t numPages = 2;
+    ComplexMatrixArray lhs(numRows, numInner, numPages);
+    ComplexMatrixArray rhs(numInner, numCols, numPages);
+    for (size_t page = 0; page < numPages; ++page)
+    {
+        for (size_t i = 0; i < numRows; ++i)
+        {
+            for (size_t k = 0; k < numInner; ++k)
+            {
+                lhs(i, k, page) = {std::cos(0.1 * (i + 2 * k + page)),
+                                   std::sin(0.3 * (i * k + page))};
+            }
+        }
+        for (size_t k = 0; k < numInner; ++k)
+        {
+            for (size_t j = 0; j < numCols; ++j)
+            {
+                rhs(k, j, page) = {std::sin(0.2 * (k + j + page)), std::cos(0.7 * (k * j))};
+            }
+        }
+    }
+    ComplexMatrixArray expectedProduct(numRows, numCols, numPages);
+    ComplexMatrixArray expectedHermitian(numInner, numRows, numPages);
+    for (size_t page = 0; page < numPages; ++page)
+    {
+        for (size_t i = 0; i < numRows; ++i)
+        {
+            for (size_t j = 0; j < numCols; ++j)
+            {
+                for (size_t k = 0; k < numInner; ++k)
+                {
+                    expectedProduct(i, j, page) += lhs(i, k, page) * rhs(k, j, page);
+                }
+            }
+            for (size_t k = 0; k < numInner; ++k)
+            {
+                expectedHermitian(k, i, page) = std::conj(lhs(i, k, page));
+            }
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ((lhs * rhs).IsAlmostEqual(expectedProduct, 1e-10),
+                          true,
+                          "Unexpected product of large matrices");
+    NS_TEST_ASSERT_MSG_EQ(lhs.HermitianTranspose(),
+                          expectedHermitian,
+                          "Unexpected Hermitian transpose of a large matrix");
+
+    // the row vector (lhs) and the column vector (rhs) of the beamforming gain computation
+    std::valarray<std::complex<double>> leftValues(numRows);
+    std::valarray<std::complex<double>> rightValues(numInner);
+    for (size_t i = 0; i < numRows; ++i)
+    {
+        leftValues[i] = std::conj(lhs(i, 0, 1));
+    }
+    for (size_t k = 0; k < numInner; ++k)
+    {
+        rightValues[k] = rhs(k, 0, 0);
+    }
+    ComplexMatrixArray leftVector(1, numRows, leftValues);
+    ComplexMatrixArray rightVector(numInner, 1, rightValues);
+    ComplexMatrixArray gains = lhs.MultiplyByLeftAndRightMatrix(leftVector, rightVector);
+    NS_TEST_ASSERT_MSG_EQ(gains.GetNumRows(), 1, "Unexpected number of rows");
+    NS_TEST_ASSERT_MSG_EQ(gains.GetNumCols(), 1, "Unexpected number of columns");
+    NS_TEST_ASSERT_MSG_EQ(gains.GetNumPages(), numPages, "Unexpected number of pages");
+    for (size_t page = 0; page < numPages; ++page)
+    {
+        std::complex<double> expectedGain{};
+        for (size_t k = 0; k < numInner; ++k)
+        {
+            std::complex<double> leftTimesPage{};
+            for (size_t i = 0; i < numRows; ++i)
+            {
+                leftTimesPage += leftVector(0, i) * lhs(i, k, page);
+            }
+            expectedGain += leftTimesPage * rightVector(k, 0);
+        }
+        NS_TEST_ASSERT_MSG_LT(std::abs(gains(0, 0, page) - expectedGain),
+                              1e-10,
+                              "Unexpected product by the left and right vectors");
+    }
 }
 
 /**
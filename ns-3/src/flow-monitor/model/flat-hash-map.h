@@ -0,0 +1,406 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include "ns3/assert.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup flow-monitor
+ * @brief Open-addressing hash map storing its entries in a single contiguous array
+ *
+ * Collisions are resolved by linear probing and entries are removed by
+ * shifting back the subsequent entries of the same cluster, so that no
+ * tombstone is needed and lookups never degrade after many removals. The
+ * value returned by the Hash functor is scrambled by a multiplicative
+ * (Fibonacci) hash, hence identity hash functions (such as std::hash for
+ * integers) can be used without causing clustering.
+ *
+ * Pointers to the stored values are invalidated by insertions and removals.
+ *
+ * @tparam Key the key type (must be default constructible and equality comparable)
+ * @tparam T the mapped type (must be default constructible)
+ * @tparam Hash the hash functor
+ */
+template <typename Key, typename T, typename Hash = std::hash<Key>>
+class FlatHashMap
+{
+  public:
+    FlatHashMap();
+
+    /// @return the number of entries
+    std::size_t Size() const;
+
+    /// @return true if there is no entry
+    bool IsEmpty() const;
+
+    /// Remove all the entries, retaining the allocated storage
+    void Clear();
+
+    /**
+     * Make room for the given number of entries without rehashing.
+     * @param n the number of entries
+     */
+    void Reserve(std::size_t n);
+
+    /**
+     * @param key the key
+     * @return a pointer to the value associated with the key, or nullptr if not found
+     */
+    T* Find(const Key& key);
+
+    /**
+     * @param key the key
+     * @return a pointer to the value associated with the key, or nullptr if not found
+     */
+    const T* Find(const Key& key) const;
+
+    /**
+     * Insert an entry with the given key and value, unless the key is already present.
+     * @param key the key
+     * @param value the value
+     * @return a pointer to the value associated with the key and a flag which is true
+     *         if the entry has been inserted
+     */
+    std::pair<T*, bool> Insert(const Key& key, T value);
+
+    /**
+     * @param key the key
+     * @return a reference to the value associated with the key, which is value-initialized
+     *         if the key was not present
+     */
+    T& operator[](const Key& key);
+
+    /**
+     * @param key the key
+     * @return true if an entry has been removed
+     */
+    bool Erase(const Key& key);
+
+    /**
+     * Invoke the given function on all the entries, in no particular order.
+     * @tparam F the type of the function, taking (const Key&, T&) as arguments
+     * @param f the function
+     */
+    template <typename F>
+    void ForEach(F f);
+
+    /**
+     * Invoke the given function on all the entries, in no particular order.
+     * @tparam F the type of the function, taking (const Key&, const T&) as arguments
+     * @param f the function
+     */
+    template <typename F>
+    void ForEach(F f) const;
+
+    /**
+     * Remove the entries for which the given predicate returns true. The
+     * predicate is invoked exactly once for each entry.
+     * @tparam P the type of the predicate, taking (const Key&, T&) as arguments
+     * @param pred the predicate
+     * @return the number of removed entries
+     */
+    template <typename P>
+    std::size_t EraseIf(P pred);
+
+  private:
+    /// A slot of the table
+    struct Slot
+    {
+        Key key{};         //!< the key
+        T value{};         //!< the value
+        bool used{false};  //!< whether the slot is in use
+    };
+
+    /**
+     * @param key the key
+     * @return the index of the home slot of the key
+     */
+    std::size_t Home(const Key& key) const;
+
+    /**
+     * @param key the key
+     * @return the index of the slot storing the key, or the index of the empty
+     *         slot where the key would be stored
+     */
+    std::size_t Probe(const Key& key) const;
+
+    /**
+     * Remove the entry stored in the given slot by shifting back the subsequent
+     * entries of the cluster.
+     * @param index the index of the slot
+     */
+    void EraseAt(std::size_t index);
+
+    /**
+     * Resize the table to the given number of slots and reinsert all the entries.
+     * @param capacity the new number of slots (a power of two)
+     */
+    void Rehash(std::size_t capacity);
+
+    static constexpr std::size_t MIN_CAPACITY = 16; //!< minimum number of slots
+
+    std::vector<Slot> m_slots; //!< the slots
+    std::size_t m_size{0};     //!< the number of entries
+    uint32_t m_shift{64};      //!< 64 minus the base 2 logarithm of the number of slots
+    Hash m_hash;               //!< the hash functor
+};
+
+/***************************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************************/
+
+template <typename Key, typename T, typename Hash>
+FlatHashMap<Key, T, Hash>::FlatHashMap()
+{
+}
+
+template <typename Key, typename T, typename Hash>
+std::size_t
+FlatHashMap<Key, T, Hash>::Size() const
+{
+    return m_size;
+}
+
+template <typename Key, typename T, typename Hash>
+bool
+FlatHashMap<Key, T, Hash>::IsEmpty() const
+{
+    return m_size == 0;
+}
+
+template <typename Key, typename T, typename Hash>
+void
+FlatHashMap<Key, T, Hash>::Clear()
+{
+    for (auto& slot : m_slots)
+    {
+        slot = Slot{};
+    }
+    m_size = 0;
+}
+
+template <typename Key, typename T, typename Hash>
+void
+FlatHashMap<Key, T, Hash>::Reserve(std::size_t n)
+{
+    // keep the load factor below 3/4
+    std::size_t capacity = m_slots.empty() ? MIN_CAPACITY : m_slots.size();
+    while (n * 4 >= capacity * 3)
+    {
+        capacity *= 2;
+    }
+    if (capacity > m_slots.size())
+    {
+        Rehash(capacity);
+    }
+}
+
+template <typename Key, typename T, typename Hash>
+std::size_t
+FlatHashMap<Key, T, Hash>::Home(const Key& key) const
+{
+    auto h = static_cast<uint64_t>(m_hash(key));
+    return static_cast<std::size_t>((h * 0x9e3779b97f4a7c15ULL) >> m_shift);
+}
+
+template <typename Key, typename T, typename Hash>
+std::size_t
+FlatHashMap<Key, T, Hash>::Probe(const Key& key) const
+{
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t index = Home(key);
+    while (m_slots[index].used && !(m_slots[index].key == key))
+    {
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+template <typename Key, typename T, typename Hash>
+T*
+FlatHashMap<Key, T, Hash>::Find(const Key& key)
+{
+    if (m_size == 0)
+    {
+        return nullptr;
+    }
+    auto& slot = m_slots[Probe(key)];
+    return slot.used ? &slot.value : nullptr;
+}
+
+template <typename Key, typename T, typename Hash>
+const T*
+FlatHashMap<Key, T, Hash>::Find(const Key& key) const
+{
+    if (m_size == 0)
+    {
+        return nullptr;
+    }
+    const auto& slot = m_slots[Probe(key)];
+    return slot.used ? &slot.value : nullptr;
+}
+
+template <typename Key, typename T, typename Hash>
+std::pair<T*, bool>
+FlatHashMap<Key, T, Hash>::Insert(const Key& key, T value)
+{
+    Reserve(m_size + 1);
+    auto& slot = m_slots[Probe(key)];
+    if (slot.used)
+    {
+        return {&slot.value, false};
+    }
+    slot.key = key;
+    slot.value = std::move(value);
+    slot.used = true;
+    m_size++;
+    return {&slot.value, true};
+}
+
+template <typename Key, typename T, typename Hash>
+T&
+FlatHashMap<Key, T, Hash>::operator[](const Key& key)
+{
+    return *Insert(key, T{}).first;
+}
+
+template <typename Key, typename T, typename Hash>
+bool
+FlatHashMap<Key, T, Hash>::Erase(const Key& key)
+{
+    if (m_size == 0)
+    {
+        return false;
+    }
+    auto index = Probe(key);
+    if (!m_slots[index].used)
+    {
+        return false;
+    }
+    EraseAt(index);
+    return true;
+}
+
+template <typename Key, typename T, typename Hash>
+void
+FlatHashMap<Key, T, Hash>::EraseAt(std::size_t index)
+{
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t hole = index;
+    std::size_t next = (hole + 1) & mask;
+
+    while (m_slots[next].used)
+    {
+        // an entry can fill the hole if its home slot is not in (hole, next]
+        std::size_t home = Home(m_slots[next].key);
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            m_slots[hole] = std::move(m_slots[next]);
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    m_slots[hole] = Slot{};
+    m_size--;
+}
+
+template <typename Key, typename T, typename Hash>
+template <typename F>
+void
+FlatHashMap<Key, T, Hash>::ForEach(F f)
+{
+    for (auto& slot : m_slots)
+    {
+        if (slot.used)
+        {
+            f(slot.key, slot.value);
+        }
+    }
+}
+
+template <typename Key, typename T, typename Hash>
+template <typename F>
+void
+FlatHashMap<Key, T, Hash>::ForEach(F f) const
+{
+    for (const auto& slot : m_slots)
+    {
+        if (slot.used)
+        {
+            f(slot.key, slot.value);
+        }
+    }
+}
+
+template <typename Key, typename T, typename Hash>
+template <typename P>
+std::size_t
+FlatHashMap<Key, T, Hash>::EraseIf(P pred)
+{
+    if (m_size == 0)
+    {
+        return 0;
+    }
+
+    // Start the scan right after an empty slot, so that no cluster wraps around
+    // the end of the scan: entries are then only shifted back into the slot
+    // being examined and each entry is examined exactly once.
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t start = 0;
+    while (m_slots[start].used)
+    {
+        start++;
+    }
+
+    std::size_t erased = 0;
+    std::size_t index = (start + 1) & mask;
+    for (std::size_t count = 1; count < m_slots.size(); count++)
+    {
+        while (m_slots[index].used && pred(m_slots[index].key, m_slots[index].value))
+        {
+            EraseAt(index);
+            erased++;
+        }
+        index = (index + 1) & mask;
+    }
+    return erased;
+}
+
+template <typename Key, typename T, typename Hash>
+void
+FlatHashMap<Key, T, Hash>::Rehash(std::size_t capacity)
+{
+    NS_ASSERT((capacity & (capacity - 1)) == 0);
+
+    std::vector<Slot> old(capacity);
+    old.swap(m_slots);
+    m_shift = 64;
+    for (std::size_t c = capacity; c > 1; c >>= 1)
+    {
+        m_shift--;
+    }
+
+    for (auto& slot : old)
+    {
+        if (slot.used)
+        {
+            m_slots[Probe(slot.key)] = std::move(slot);
+        }
+    }
+}
+
+} // namespace ns3
+
+#endif /* FLAT_HASH_MAP_H */
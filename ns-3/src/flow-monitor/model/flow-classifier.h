@@ -57,6 +57,11 @@ class FlowClassifier : public SimpleRefCount<FlowClassifier>
     /// @param indent number of spaces to use as base indentation level
     virtual void SerializeToXmlStream(std::ostream& os, uint16_t indent) const = 0;
 
+    /// Remove the data of a flow, e.g., because the FlowMonitor exported it.
+    /// The default implementation does nothing.
+    /// @param flowId the FlowId of the flow to remove
+    virtual void RemoveFlow(FlowId flowId);
+
   protected:
     /// Returns a new, unique Flow Identifier
     /// @returns a new FlowId
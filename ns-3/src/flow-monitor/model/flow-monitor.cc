@@ -8,10 +8,14 @@
 
 #include "flow-monitor.h"
 
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <fstream>
 #include <limits>
 #include <sstream>
@@ -70,12 +74,38 @@ FlowMonitor::GetTypeId()
                 ("The minimum inter-arrival time that is considered a flow interruption."),
                 TimeValue(Seconds(0.5)),
                 MakeTimeAccessor(&FlowMonitor::m_flowInterruptionsMinTime),
-                MakeTimeChecker());
+                MakeTimeChecker())
+            .AddAttribute("SamplingInterval",
+                          ("Only one every SamplingInterval packets of each flow (starting "
+                           "with the first one) is accounted for."),
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&FlowMonitor::m_samplingInterval),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("ExportFileName",
+                          ("If not empty, the name of the file where the flows idle for "
+                           "FlowIdleTimeout are periodically written (and then removed from "
+                           "memory)."),
+                          StringValue(""),
+                          MakeStringAccessor(&FlowMonitor::m_exportFileName),
+                          MakeStringChecker())
+            .AddAttribute("FlowIdleTimeout",
+                          ("The time after which a flow with no packet in flight and no new "
+                           "packet transmitted or received is exported."),
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&FlowMonitor::m_flowIdleTimeout),
+                          MakeTimeChecker())
+            .AddAttribute("ExportHistograms",
+                          ("Whether the histograms are included in the exported flows."),
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&FlowMonitor::m_exportHistograms),
+                          MakeBooleanChecker());
     return tid;
 }
 
 FlowMonitor::FlowMonitor()
-    : m_enabled(false)
+    : m_enabled(false),
+      m_samplingInterval(1),
+      m_nExportedFlows(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -95,38 +125,39 @@ FlowMonitor::DoDispose()
         m_flowProbes[i]->Dispose();
         m_flowProbes[i] = nullptr;
     }
+    if (m_exportStream.is_open())
+    {
+        m_exportStream << "  </FlowStats>\n</FlowMonitor>\n";
+        m_exportStream.close();
+    }
     Object::DoDispose();
 }
 
-inline FlowMonitor::FlowStats&
-FlowMonitor::GetStatsForFlow(FlowId flowId)
+FlowMonitor::FlowRecord&
+FlowMonitor::GetFlowRecord(FlowId flowId)
 {
     NS_LOG_FUNCTION(this);
-    auto iter = m_flowStats.find(flowId);
-    if (iter == m_flowStats.end())
-    {
-        FlowMonitor::FlowStats& ref = m_flowStats[flowId];
-        ref.delaySum = Seconds(0);
-        ref.jitterSum = Seconds(0);
-        ref.lastDelay = Seconds(0);
-        ref.maxDelay = Seconds(0);
-        ref.minDelay = Time::Max();
-        ref.txBytes = 0;
-        ref.rxBytes = 0;
-        ref.txPackets = 0;
-        ref.rxPackets = 0;
-        ref.lostPackets = 0;
-        ref.timesForwarded = 0;
-        ref.delayHistogram.SetDefaultBinWidth(m_delayBinWidth);
-        ref.jitterHistogram.SetDefaultBinWidth(m_jitterBinWidth);
-        ref.packetSizeHistogram.SetDefaultBinWidth(m_packetSizeBinWidth);
-        ref.flowInterruptionsHistogram.SetDefaultBinWidth(m_flowInterruptionsBinWidth);
-        return ref;
-    }
-    else
+    if (auto record = m_flowIndex.Find(flowId))
     {
-        return iter->second;
+        return *record;
     }
+    FlowMonitor::FlowStats& ref = m_flowStats[flowId];
+    ref.delaySum = Seconds(0);
+    ref.jitterSum = Seconds(0);
+    ref.lastDelay = Seconds(0);
+    ref.maxDelay = Seconds(0);
+    ref.minDelay = Time::Max();
+    ref.txBytes = 0;
+    ref.rxBytes = 0;
+    ref.txPackets = 0;
+    ref.rxPackets = 0;
+    ref.lostPackets = 0;
+    ref.timesForwarded = 0;
+    ref.delayHistogram.SetDefaultBinWidth(m_delayBinWidth);
+    ref.jitterHistogram.SetDefaultBinWidth(m_jitterBinWidth);
+    ref.packetSizeHistogram.SetDefaultBinWidth(m_packetSizeBinWidth);
+    ref.flowInterruptionsHistogram.SetDefaultBinWidth(m_flowInterruptionsBinWidth);
+    return *m_flowIndex.Insert(flowId, {&ref, 0}).first;
 }
 
 void
@@ -141,17 +172,28 @@ FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
+    if (!IsSampled(packetId))
+    {
+        return;
+    }
     Time now = Simulator::Now();
-    TrackedPacket& tracked = m_trackedPackets[std::make_pair(flowId, packetId)];
-    tracked.firstSeenTime = now;
-    tracked.lastSeenTime = tracked.firstSeenTime;
-    tracked.timesForwarded = 0;
+    FlowRecord& record = GetFlowRecord(flowId);
+    auto [tracked, inserted] =
+        m_trackedPackets.Insert(GetTrackedPacketKey(flowId, packetId), {now, now, 0});
+    if (inserted)
+    {
+        record.inFlight++;
+    }
+    else
+    {
+        *tracked = {now, now, 0};
+    }
     NS_LOG_DEBUG("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId="
                                                                  << packetId << ").");
 
     probe->AddPacketStats(flowId, packetSize, Seconds(0));
 
-    FlowStats& stats = GetStatsForFlow(flowId);
+    FlowStats& stats = *record.stats;
     stats.txBytes += packetSize;
     stats.txPackets++;
     if (stats.txPackets == 1)
@@ -173,19 +215,22 @@ FlowMonitor::ReportForwarding(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    std::pair<FlowId, FlowPacketId> key(flowId, packetId);
-    auto tracked = m_trackedPackets.find(key);
-    if (tracked == m_trackedPackets.end())
+    if (!IsSampled(packetId))
+    {
+        return;
+    }
+    auto tracked = m_trackedPackets.Find(GetTrackedPacketKey(flowId, packetId));
+    if (!tracked)
     {
         NS_LOG_WARN("Received packet forward report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
         return;
     }
 
-    tracked->second.timesForwarded++;
-    tracked->second.lastSeenTime = Simulator::Now();
+    tracked->timesForwarded++;
+    tracked->lastSeenTime = Simulator::Now();
 
-    Time delay = (Simulator::Now() - tracked->second.firstSeenTime);
+    Time delay = (Simulator::Now() - tracked->firstSeenTime);
     probe->AddPacketStats(flowId, packetSize, delay);
 }
 
@@ -201,8 +246,13 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked == m_trackedPackets.end())
+    if (!IsSampled(packetId))
+    {
+        return;
+    }
+    auto key = GetTrackedPacketKey(flowId, packetId);
+    auto tracked = m_trackedPackets.Find(key);
+    if (!tracked)
     {
         NS_LOG_WARN("Received packet last-tx report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
@@ -210,10 +260,13 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
     }
 
     Time now = Simulator::Now();
-    Time delay = (now - tracked->second.firstSeenTime);
+    Time delay = (now - tracked->firstSeenTime);
     probe->AddPacketStats(flowId, packetSize, delay);
 
-    FlowStats& stats = GetStatsForFlow(flowId);
+    FlowRecord& record = GetFlowRecord(flowId);
+    NS_ASSERT(record.inFlight > 0);
+    record.inFlight--;
+    FlowStats& stats = *record.stats;
     stats.delaySum += delay;
     stats.delayHistogram.AddValue(delay.GetSeconds());
     if (stats.rxPackets > 0)
@@ -257,12 +310,12 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         }
     }
     stats.timeLastRxPacket = now;
-    stats.timesForwarded += tracked->second.timesForwarded;
+    stats.timesForwarded += tracked->timesForwarded;
 
     NS_LOG_DEBUG("ReportLastTx: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                   << packetId << ").");
 
-    m_trackedPackets.erase(tracked); // we don't need to track this packet anymore
+    m_trackedPackets.Erase(key); // we don't need to track this packet anymore
 }
 
 void
@@ -278,10 +331,23 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
+    if (!IsSampled(packetId))
+    {
+        return;
+    }
+
+    auto record = m_flowIndex.Find(flowId);
+    if (!record)
+    {
+        // either the flow has been exported or the transmission of the packet
+        // has not been reported (the FlowMonitor was not enabled yet)
+        NS_LOG_DEBUG("Ignoring the drop of a packet of unknown flow " << flowId);
+        return;
+    }
 
     probe->AddPacketDropStats(flowId, packetSize, reasonCode);
 
-    FlowStats& stats = GetStatsForFlow(flowId);
+    FlowStats& stats = *record->stats;
     stats.lostPackets++;
     if (stats.packetsDropped.size() < reasonCode + 1)
     {
@@ -293,14 +359,14 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
     NS_LOG_DEBUG("++stats.packetsDropped["
                  << reasonCode << "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked != m_trackedPackets.end())
+    if (m_trackedPackets.Erase(GetTrackedPacketKey(flowId, packetId)))
     {
         // we don't need to track this packet anymore
         // FIXME: this will not necessarily be true with broadcast/multicast
         NS_LOG_DEBUG("ReportDrop: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                     << packetId << ").");
-        m_trackedPackets.erase(tracked);
+        NS_ASSERT(record->inFlight > 0);
+        record->inFlight--;
     }
 }
 
@@ -316,23 +382,20 @@ FlowMonitor::CheckForLostPackets(Time maxDelay)
     NS_LOG_FUNCTION(this << maxDelay.As(Time::S));
     Time now = Simulator::Now();
 
-    for (auto iter = m_trackedPackets.begin(); iter != m_trackedPackets.end();)
-    {
-        if (now - iter->second.lastSeenTime >= maxDelay)
-        {
-            // packet is considered lost, add it to the loss statistics
-            auto flow = m_flowStats.find(iter->first.first);
-            NS_ASSERT(flow != m_flowStats.end());
-            flow->second.lostPackets++;
-
-            // we won't track it anymore
-            m_trackedPackets.erase(iter++);
-        }
-        else
+    m_trackedPackets.EraseIf([&](uint64_t key, const TrackedPacket& tracked) {
+        if (now - tracked.lastSeenTime < maxDelay)
         {
-            iter++;
+            return false;
         }
-    }
+        // packet is considered lost, add it to the loss statistics
+        auto record = m_flowIndex.Find(static_cast<FlowId>(key >> 32));
+        NS_ASSERT(record && record->inFlight > 0);
+        record->stats->lostPackets++;
+        record->inFlight--;
+
+        // we won't track it anymore
+        return true;
+    });
 }
 
 void
@@ -341,10 +404,26 @@ FlowMonitor::CheckForLostPackets()
     CheckForLostPackets(m_maxPerHopDelay);
 }
 
+bool
+FlowMonitor::IsSampled(FlowPacketId packetId) const
+{
+    return m_samplingInterval == 1 || packetId % m_samplingInterval == 0;
+}
+
+uint64_t
+FlowMonitor::GetTrackedPacketKey(FlowId flowId, FlowPacketId packetId)
+{
+    return (static_cast<uint64_t>(flowId) << 32) | packetId;
+}
+
 void
 FlowMonitor::PeriodicCheckForLostPackets()
 {
     CheckForLostPackets();
+    if (!m_exportFileName.empty())
+    {
+        ExportIdleFlows();
+    }
     Simulator::Schedule(PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
 }
 
@@ -434,57 +513,17 @@ FlowMonitor::SerializeToXmlStream(std::ostream& os,
     indent += 2;
     os << std::string(indent, ' ') << "<FlowStats>\n";
     indent += 2;
+    // serialize the flows in increasing order of flow identifier
+    std::vector<FlowId> flowIds;
+    flowIds.reserve(m_flowStats.size());
     for (const auto& [flowId, flowStats] : m_flowStats)
     {
-        os << std::string(indent, ' ');
-#define ATTRIB(name) " " #name "=\"" << flowStats.name << "\""
-#define ATTRIB_TIME(name) " " #name "=\"" << flowStats.name.As(Time::NS) << "\""
-        os << "<Flow";
-        os << " flowId=\"" << flowId << "\"";
-        os << ATTRIB_TIME(timeFirstTxPacket);
-        os << ATTRIB_TIME(timeFirstRxPacket);
-        os << ATTRIB_TIME(timeLastTxPacket);
-        os << ATTRIB_TIME(timeLastRxPacket);
-        os << ATTRIB_TIME(delaySum);
-        os << ATTRIB_TIME(jitterSum);
-        os << ATTRIB_TIME(lastDelay);
-        os << ATTRIB_TIME(maxDelay);
-        os << ATTRIB_TIME(minDelay);
-        os << ATTRIB(txBytes);
-        os << ATTRIB(rxBytes);
-        os << ATTRIB(txPackets);
-        os << ATTRIB(rxPackets);
-        os << ATTRIB(lostPackets);
-        os << ATTRIB(timesForwarded);
-        os << ">\n";
-#undef ATTRIB_TIME
-#undef ATTRIB
-
-        indent += 2;
-        for (uint32_t reasonCode = 0; reasonCode < flowStats.packetsDropped.size(); reasonCode++)
-        {
-            os << std::string(indent, ' ');
-            os << "<packetsDropped reasonCode=\"" << reasonCode << "\""
-               << " number=\"" << flowStats.packetsDropped[reasonCode] << "\" />\n";
-        }
-        for (uint32_t reasonCode = 0; reasonCode < flowStats.bytesDropped.size(); reasonCode++)
-        {
-            os << std::string(indent, ' ');
-            os << "<bytesDropped reasonCode=\"" << reasonCode << "\""
-               << " bytes=\"" << flowStats.bytesDropped[reasonCode] << "\" />\n";
-        }
-        if (enableHistograms)
-        {
-            flowStats.delayHistogram.SerializeToXmlStream(os, indent, "delayHistogram");
-            flowStats.jitterHistogram.SerializeToXmlStream(os, indent, "jitterHistogram");
-            flowStats.packetSizeHistogram.SerializeToXmlStream(os, indent, "packetSizeHistogram");
-            flowStats.flowInterruptionsHistogram.SerializeToXmlStream(os,
-                                                                      indent,
-                                                                      "flowInterruptionsHistogram");
-        }
-        indent -= 2;
-
-        os << std::string(indent, ' ') << "</Flow>\n";
+        flowIds.push_back(flowId);
+    }
+    std::sort(flowIds.begin(), flowIds.end());
+    for (auto flowId : flowIds)
+    {
+        SerializeFlowToXmlStream(os, indent, flowId, m_flowStats.at(flowId), enableHistograms);
     }
     indent -= 2;
     os << std::string(indent, ' ') << "</FlowStats>\n";
@@ -510,6 +549,105 @@ FlowMonitor::SerializeToXmlStream(std::ostream& os,
     os << std::string(indent, ' ') << "</FlowMonitor>\n";
 }
 
+void
+FlowMonitor::SerializeFlowToXmlStream(std::ostream& os,
+                                      uint16_t indent,
+                                      FlowId flowId,
+                                      const FlowStats& flowStats,
+                                      bool enableHistograms) const
+{
+    os << std::string(indent, ' ');
+#define ATTRIB(name) " " #name "=\"" << flowStats.name << "\""
+#define ATTRIB_TIME(name) " " #name "=\"" << flowStats.name.As(Time::NS) << "\""
+    os << "<Flow";
+    os << " flowId=\"" << flowId << "\"";
+    os << ATTRIB_TIME(timeFirstTxPacket);
+    os << ATTRIB_TIME(timeFirstRxPacket);
+    os << ATTRIB_TIME(timeLastTxPacket);
+    os << ATTRIB_TIME(timeLastRxPacket);
+    os << ATTRIB_TIME(delaySum);
+    os << ATTRIB_TIME(jitterSum);
+    os << ATTRIB_TIME(lastDelay);
+    os << ATTRIB_TIME(maxDelay);
+    os << ATTRIB_TIME(minDelay);
+    os << ATTRIB(txBytes);
+    os << ATTRIB(rxBytes);
+    os << ATTRIB(txPackets);
+    os << ATTRIB(rxPackets);
+    os << ATTRIB(lostPackets);
+    os << ATTRIB(timesForwarded);
+    os << ">\n";
+#undef ATTRIB_TIME
+#undef ATTRIB
+
+    indent += 2;
+    for (uint32_t reasonCode = 0; reasonCode < flowStats.packetsDropped.size(); reasonCode++)
+    {
+        os << std::string(indent, ' ');
+        os << "<packetsDropped reasonCode=\"" << reasonCode << "\""
+           << " number=\"" << flowStats.packetsDropped[reasonCode] << "\" />\n";
+    }
+    for (uint32_t reasonCode = 0; reasonCode < flowStats.bytesDropped.size(); reasonCode++)
+    {
+        os << std::string(indent, ' ');
+        os << "<bytesDropped reasonCode=\"" << reasonCode << "\""
+           << " bytes=\"" << flowStats.bytesDropped[reasonCode] << "\" />\n";
+    }
+    if (enableHistograms)
+    {
+        flowStats.delayHistogram.SerializeToXmlStream(os, indent, "delayHistogram");
+        flowStats.jitterHistogram.SerializeToXmlStream(os, indent, "jitterHistogram");
+        flowStats.packetSizeHistogram.SerializeToXmlStream(os, indent, "packetSizeHistogram");
+        flowStats.flowInterruptionsHistogram.SerializeToXmlStream(os,
+                                                                  indent,
+                                                                  "flowInterruptionsHistogram");
+    }
+    indent -= 2;
+
+    os << std::string(indent, ' ') << "</Flow>\n";
+}
+
+void
+FlowMonitor::ExportIdleFlows()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_exportStream.is_open())
+    {
+        m_exportStream.open(m_exportFileName, std::ios::out);
+        if (!m_exportStream.is_open())
+        {
+            NS_FATAL_ERROR("Could not open the flow export file " << m_exportFileName);
+        }
+        m_exportStream << "<?xml version=\"1.0\" ?>\n<FlowMonitor>\n  <FlowStats>\n";
+    }
+
+    Time now = Simulator::Now();
+    auto exported = m_flowIndex.EraseIf([&](FlowId flowId, const FlowRecord& record) {
+        const auto& stats = *record.stats;
+        if (record.inFlight > 0 ||
+            now - Max(stats.timeLastTxPacket, stats.timeLastRxPacket) < m_flowIdleTimeout)
+        {
+            return false;
+        }
+        NS_LOG_DEBUG("Exporting idle flow " << flowId);
+        SerializeFlowToXmlStream(m_exportStream, 4, flowId, stats, m_exportHistograms);
+        m_flowStats.erase(flowId);
+        // the classifiers then assign a new FlowId to the next packet of the flow
+        for (const auto& classifier : m_classifiers)
+        {
+            classifier->RemoveFlow(flowId);
+        }
+        for (const auto& probe : m_flowProbes)
+        {
+            probe->RemoveFlow(flowId);
+        }
+        return true;
+    });
+    m_nExportedFlows += exported;
+    m_exportStream.flush();
+}
+
 std::string
 FlowMonitor::SerializeToXmlString(uint16_t indent, bool enableHistograms, bool enableProbes)
 {
@@ -529,6 +667,12 @@ FlowMonitor::SerializeToXmlFile(std::string fileName, bool enableHistograms, boo
     os.close();
 }
 
+uint32_t
+FlowMonitor::GetNExportedFlows() const
+{
+    return m_nExportedFlows;
+}
+
 void
 FlowMonitor::ResetAllStats()
 {
@@ -9,6 +9,7 @@
 #ifndef FLOW_MONITOR_H
 #define FLOW_MONITOR_H
 
+#include "flat-hash-map.h"
 #include "flow-classifier.h"
 #include "flow-probe.h"
 
@@ -18,7 +19,11 @@
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
+#include <fstream>
+#include <list>
 #include <map>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -36,6 +41,22 @@ namespace ns3
  * The FlowMonitor class is responsible for coordinating efforts
  * regarding probes, and collects end-to-end flow statistics.
  *
+ * Flows and in-flight packets are looked up in open-addressing hash tables
+ * (see FlatHashMap). Two mechanisms are provided to bound the cost of
+ * monitoring large numbers of flows:
+ *
+ * - packet sampling: if the SamplingInterval attribute is set to N > 1, only
+ *   one every N packets of each flow (starting with the first one) is
+ *   accounted for, and all the statistics refer to the sampled packets;
+ * - streaming export: if the ExportFileName attribute is set, the flows that
+ *   have no packet in flight and have been idle for FlowIdleTimeout are
+ *   periodically written to the given file (in the same XML format used by
+ *   SerializeToXmlStream) and removed from memory, together with the data
+ *   kept by the classifiers and the probes. Hence, GetFlowStats() only returns
+ *   the flows that have not been exported yet. The reports about the packets
+ *   of an exported flow that are still in the network (e.g., packets that were
+ *   not sampled, or considered lost) are ignored, whereas a packet of the same
+ *   five-tuple transmitted after the export is classified into a new flow.
  */
 class FlowMonitor : public Object
 {
@@ -219,12 +240,12 @@ class FlowMonitor : public Object
 
     // --- methods to get the results ---
 
-    /// Container: FlowId, FlowStats
-    typedef std::map<FlowId, FlowStats> FlowStatsContainer;
+    /// Container: FlowId, FlowStats (the flows are not sorted by FlowId)
+    typedef std::unordered_map<FlowId, FlowStats> FlowStatsContainer;
     /// Container Iterator: FlowId, FlowStats
-    typedef std::map<FlowId, FlowStats>::iterator FlowStatsContainerI;
+    typedef FlowStatsContainer::iterator FlowStatsContainerI;
     /// Container Const Iterator: FlowId, FlowStats
-    typedef std::map<FlowId, FlowStats>::const_iterator FlowStatsContainerCI;
+    typedef FlowStatsContainer::const_iterator FlowStatsContainerCI;
     /// Container: FlowProbe
     typedef std::vector<Ptr<FlowProbe>> FlowProbeContainer;
     /// Container Iterator: FlowProbe
@@ -269,6 +290,10 @@ class FlowMonitor : public Object
     /// Reset all the statistics
     void ResetAllStats();
 
+    /// @returns the number of flows written to the export file (see the
+    /// ExportFileName attribute) and removed from memory
+    uint32_t GetNExportedFlows() const;
+
   protected:
     void NotifyConstructionCompleted() override;
     void DoDispose() override;
@@ -282,14 +307,24 @@ class FlowMonitor : public Object
         uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
     };
 
+    /// Index entry of a flow
+    struct FlowRecord
+    {
+        FlowStats* stats;  //!< the flow statistics (stored in m_flowStats)
+        uint32_t inFlight; //!< the number of tracked packets of the flow
+    };
+
     /// FlowId --> FlowStats
     FlowStatsContainer m_flowStats;
 
+    /// FlowId --> FlowRecord (index of m_flowStats)
+    FlatHashMap<FlowId, FlowRecord> m_flowIndex;
+
     /// (FlowId,PacketId) --> TrackedPacket
-    typedef std::map<std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
-    TrackedPacketMap m_trackedPackets; //!< Tracked packets
-    Time m_maxPerHopDelay;             //!< Minimum per-hop delay
-    FlowProbeContainer m_flowProbes;   //!< all the FlowProbes
+    FlatHashMap<uint64_t, TrackedPacket> m_trackedPackets;
+
+    Time m_maxPerHopDelay;           //!< Minimum per-hop delay
+    FlowProbeContainer m_flowProbes; //!< all the FlowProbes
 
     // note: this is needed only for serialization
     std::list<Ptr<FlowClassifier>> m_classifiers; //!< the FlowClassifiers
@@ -302,11 +337,42 @@ class FlowMonitor : public Object
     double m_packetSizeBinWidth;        //!< packet size bin width (for histograms)
     double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
     Time m_flowInterruptionsMinTime;    //!< Flow interruptions minimum time
+    uint32_t m_samplingInterval;        //!< One every m_samplingInterval packets is sampled
+    std::string m_exportFileName;       //!< Name of the file where idle flows are exported
+    Time m_flowIdleTimeout;             //!< Time after which an idle flow is exported
+    bool m_exportHistograms;            //!< Whether histograms are exported
+    std::ofstream m_exportStream;       //!< Stream where idle flows are exported
+    uint32_t m_nExportedFlows;          //!< Number of exported flows
+
+    /// Get the index entry (and hence the stats) of a given flow, creating the flow if needed
+    /// @param flowId the Flow identification
+    /// @returns the index entry of the flow
+    FlowRecord& GetFlowRecord(FlowId flowId);
+
+    /// @param packetId the packet identifier
+    /// @returns true if the packet with the given identifier is to be accounted for
+    bool IsSampled(FlowPacketId packetId) const;
 
-    /// Get the stats for a given flow
     /// @param flowId the Flow identification
-    /// @returns the stats of the flow
-    FlowStats& GetStatsForFlow(FlowId flowId);
+    /// @param packetId the packet identifier
+    /// @returns the key of the packet in the table of tracked packets
+    static uint64_t GetTrackedPacketKey(FlowId flowId, FlowPacketId packetId);
+
+    /// Serializes the statistics of a flow to an std::ostream in XML format
+    /// @param os the output stream
+    /// @param indent number of spaces to use as base indentation level
+    /// @param flowId the Flow identification
+    /// @param flowStats the flow statistics
+    /// @param enableHistograms if true, include also the histograms in the output
+    void SerializeFlowToXmlStream(std::ostream& os,
+                                  uint16_t indent,
+                                  FlowId flowId,
+                                  const FlowStats& flowStats,
+                                  bool enableHistograms) const;
+
+    /// Write the flows that have been idle for at least FlowIdleTimeout to the
+    /// export file and remove them from memory
+    void ExportIdleFlows();
 
     /// Periodic function to check for lost packets and prune statistics
     void PeriodicCheckForLostPackets();
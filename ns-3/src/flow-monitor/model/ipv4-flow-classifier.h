@@ -9,11 +9,13 @@
 #ifndef IPV4_FLOW_CLASSIFIER_H
 #define IPV4_FLOW_CLASSIFIER_H
 
+#include "flat-hash-map.h"
 #include "flow-classifier.h"
 
 #include "ns3/ipv4-header.h"
 
 #include <map>
+#include <vector>
 #include <stdint.h>
 
 namespace ns3
@@ -38,6 +40,14 @@ class Ipv4FlowClassifier : public FlowClassifier
         uint16_t destinationPort;       //!< Destination port
     };
 
+    /// Hash function of a FiveTuple
+    struct FiveTupleHash
+    {
+        /// @param tuple the five-tuple
+        /// @return the hash of the five-tuple
+        std::size_t operator()(const FiveTuple& tuple) const;
+    };
+
     Ipv4FlowClassifier();
 
     /// @brief try to classify the packet into flow-id and packet-id
@@ -55,7 +65,8 @@ class Ipv4FlowClassifier : public FlowClassifier
                   uint32_t* out_flowId,
                   uint32_t* out_packetId);
 
-    /// Searches for the FiveTuple corresponding to the given flowId
+    /// Searches for the FiveTuple corresponding to the given flowId. It is a fatal
+    /// error if the flow is unknown or has been removed (see RemoveFlow).
     /// @param flowId the FlowId to search for
     /// @returns the FiveTuple corresponding to flowId
     FiveTuple FindFlow(FlowId flowId) const;
@@ -81,13 +92,24 @@ class Ipv4FlowClassifier : public FlowClassifier
 
     void SerializeToXmlStream(std::ostream& os, uint16_t indent) const override;
 
+    /// Remove the five-tuple and the DSCP counts of a flow. A packet matching the
+    /// five-tuple of the removed flow is then assigned a new FlowId.
+    /// @param flowId the FlowId of the flow to remove
+    void RemoveFlow(FlowId flowId) override;
+
   private:
-    /// Map to Flows Identifiers to FlowIds
-    std::map<FiveTuple, FlowId> m_flowMap;
-    /// Map to FlowIds to FlowPacketId
-    std::map<FlowId, FlowPacketId> m_flowPktIdMap;
-    /// Map FlowIds to (DSCP value, packet count) pairs
-    std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t>> m_flowDscpMap;
+    /// Data of a flow
+    struct FlowInfo
+    {
+        FiveTuple tuple;                                  //!< the five-tuple of the flow
+        FlowPacketId lastPacketId;                        //!< identifier of the last packet
+        std::map<Ipv4Header::DscpType, uint32_t> dscpCounts; //!< (DSCP value, packet count) pairs
+    };
+
+    /// Map Flows Identifiers to FlowIds
+    FlatHashMap<FiveTuple, FlowId, FiveTupleHash> m_flowMap;
+    /// FlowId --> Flow data
+    FlatHashMap<FlowId, FlowInfo> m_flows;
 };
 
 /**
@@ -0,0 +1,370 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/flat-hash-map.h"
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/ipv4-flow-classifier.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/udp-header.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+using namespace ns3;
+
+/**
+ * @ingroup flow-monitor
+ * @defgroup flow-monitor-test flow-monitor module tests
+ */
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * @brief FlatHashMap Test: compare the content of a FlatHashMap with that of a
+ * std::unordered_map after a pseudo-random sequence of insertions and removals.
+ */
+class FlatHashMapTest : public TestCase
+{
+  public:
+    FlatHashMapTest();
+
+  private:
+    void DoRun() override;
+};
+
+FlatHashMapTest::FlatHashMapTest()
+    : TestCase("Check insertions, lookups and removals in the FlatHashMap")
+{
+}
+
+void
+FlatHashMapTest::DoRun()
+{
+    FlatHashMap<uint64_t, uint32_t> map;
+    std::unordered_map<uint64_t, uint32_t> ref;
+
+    // keys sharing the low order bits, which collide with an identity hash
+    uint64_t state = 1;
+    for (uint32_t i = 0; i < 20000; ++i)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint64_t key = ((state >> 33) % 4000) << 32;
+        if ((state >> 20) % 3 == 0)
+        {
+            NS_TEST_ASSERT_MSG_EQ(map.Erase(key), (ref.erase(key) == 1), "Unexpected erase result");
+        }
+        else
+        {
+            auto [value, inserted] = map.Insert(key, i);
+            auto [it, refInserted] = ref.emplace(key, i);
+            NS_TEST_ASSERT_MSG_EQ(inserted, refInserted, "Unexpected insert result");
+            NS_TEST_ASSERT_MSG_EQ(*value, it->second, "Unexpected value");
+        }
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(map.Size(), ref.size(), "Unexpected number of entries");
+    for (const auto& [key, value] : ref)
+    {
+        auto found = map.Find(key);
+        NS_TEST_ASSERT_MSG_NE(found, nullptr, "Entry not found");
+        NS_TEST_ASSERT_MSG_EQ(*found, value, "Unexpected value");
+    }
+
+    // remove the entries with an odd value, each entry must be visited once
+    std::size_t visited = 0;
+    auto size = map.Size();
+    auto erased = map.EraseIf([&visited](uint64_t, uint32_t value) {
+        visited++;
+        return value % 2 == 1;
+    });
+    NS_TEST_EXPECT_MSG_EQ(visited, size, "Each entry should be visited exactly once");
+    std::erase_if(ref, [](const auto& entry) { return entry.second % 2 == 1; });
+    NS_TEST_EXPECT_MSG_EQ(erased, size - ref.size(), "Unexpected number of removed entries");
+
+    std::size_t count = 0;
+    map.ForEach([&](uint64_t key, uint32_t value) {
+        count++;
+        auto it = ref.find(key);
+        NS_TEST_EXPECT_MSG_EQ((it != ref.end() && it->second == value), true, "Unexpected entry");
+    });
+    NS_TEST_EXPECT_MSG_EQ(count, ref.size(), "Unexpected number of entries");
+
+    map.Clear();
+    NS_TEST_EXPECT_MSG_EQ(map.IsEmpty(), true, "The map should be empty");
+    NS_TEST_EXPECT_MSG_EQ(map.Find(0), nullptr, "No entry should be found");
+}
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * @brief Flow probe reporting events to the flow monitor on behalf of the test.
+ */
+class TestFlowProbe : public FlowProbe
+{
+  public:
+    /**
+     * Constructor
+     * @param monitor the flow monitor
+     */
+    TestFlowProbe(Ptr<FlowMonitor> monitor)
+        : FlowProbe(monitor)
+    {
+    }
+};
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * @brief Check packet sampling and the streaming export of idle flows.
+ */
+class FlowMonitorSamplingExportTest : public TestCase
+{
+  public:
+    FlowMonitorSamplingExportTest();
+
+  private:
+    void DoRun() override;
+};
+
+FlowMonitorSamplingExportTest::FlowMonitorSamplingExportTest()
+    : TestCase("Check flow monitor packet sampling and streaming export")
+{
+}
+
+void
+FlowMonitorSamplingExportTest::DoRun()
+{
+    auto fileName = CreateTempDirFilename("flow-monitor-export.xml");
+
+    auto monitor = CreateObject<FlowMonitor>();
+    monitor->SetAttribute("SamplingInterval", UintegerValue(3));
+    monitor->SetAttribute("ExportFileName", StringValue(fileName));
+    monitor->SetAttribute("FlowIdleTimeout", TimeValue(Seconds(1)));
+    Ptr<FlowProbe> probe = CreateObject<TestFlowProbe>(monitor);
+    monitor->StartRightNow();
+
+    // flow 1 is active at the beginning, flow 2 keeps sending packets
+    Simulator::Schedule(MilliSeconds(100), [=]() {
+        for (FlowPacketId id = 0; id < 10; id++)
+        {
+            monitor->ReportFirstTx(probe, 1, id, 100);
+        }
+    });
+    Simulator::Schedule(MilliSeconds(200), [=]() {
+        for (FlowPacketId id = 0; id < 10; id++)
+        {
+            monitor->ReportLastRx(probe, 1, id, 100);
+        }
+    });
+    for (uint32_t i = 0; i < 30; i++)
+    {
+        Simulator::Schedule(MilliSeconds(100 * (i + 1)), [=]() {
+            monitor->ReportFirstTx(probe, 2, i, 100);
+            monitor->ReportLastRx(probe, 2, i, 100);
+        });
+    }
+
+    Simulator::Schedule(MilliSeconds(2500), [=, this]() {
+        const auto& stats = monitor->GetFlowStats();
+        NS_TEST_EXPECT_MSG_EQ(monitor->GetNExportedFlows(), 1, "Flow 1 should have been exported");
+        NS_TEST_EXPECT_MSG_EQ(stats.size(), 1, "Only flow 2 should be in memory");
+        NS_TEST_EXPECT_MSG_EQ(stats.count(2), 1, "Only flow 2 should be in memory");
+    });
+
+    Simulator::Stop(Seconds(3.05));
+    Simulator::Run();
+
+    const auto& stats = monitor->GetFlowStats();
+    auto flow = stats.find(2);
+    NS_TEST_ASSERT_MSG_EQ((flow != stats.end()), true, "Flow 2 not found");
+    NS_TEST_EXPECT_MSG_EQ(flow->second.txPackets, 10, "One every three packets should be sampled");
+    NS_TEST_EXPECT_MSG_EQ(flow->second.rxPackets, 10, "One every three packets should be sampled");
+
+    monitor->Dispose();
+    Simulator::Destroy();
+
+    std::ifstream file(fileName);
+    std::stringstream content;
+    content << file.rdbuf();
+    NS_TEST_EXPECT_MSG_NE(content.str().find("<Flow flowId=\"1\""),
+                          std::string::npos,
+                          "Flow 1 not found in the export file");
+    NS_TEST_EXPECT_MSG_NE(content.str().find("txPackets=\"4\""),
+                          std::string::npos,
+                          "Unexpected number of sampled packets of flow 1");
+    NS_TEST_EXPECT_MSG_NE(content.str().find("</FlowMonitor>"),
+                          std::string::npos,
+                          "The export file has not been closed");
+}
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * @brief Check that the memory used by the flow monitor, the classifier and the
+ * probe does not grow with the number of exported flows, and that the packets of
+ * an exported flow are either ignored or assigned to a new flow.
+ */
+class FlowMonitorExportMemoryTest : public TestCase
+{
+  public:
+    FlowMonitorExportMemoryTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Transmit and receive a few packets of a flow.
+     * @param sourcePort the source port of the flow
+     */
+    void SendFlow(uint16_t sourcePort);
+
+    /// Record the number of flows stored by the monitor, the classifier and the probe
+    void CheckMemory();
+
+    Ptr<FlowMonitor> m_monitor;           //!< the flow monitor
+    Ptr<Ipv4FlowClassifier> m_classifier; //!< the classifier
+    Ptr<FlowProbe> m_probe;               //!< the probe
+    FlowId m_lastFlowId{0};               //!< the identifier of the last classified flow
+    std::size_t m_maxMonitorFlows{0};     //!< max number of flows stored by the monitor
+    std::size_t m_maxClassifierFlows{0};  //!< max number of flows stored by the classifier
+    std::size_t m_maxProbeFlows{0};       //!< max number of flows stored by the probe
+};
+
+FlowMonitorExportMemoryTest::FlowMonitorExportMemoryTest()
+    : TestCase("Check that exported flows are removed from the classifiers and the probes")
+{
+}
+
+void
+FlowMonitorExportMemoryTest::SendFlow(uint16_t sourcePort)
+{
+    Ipv4Header ipHeader;
+    ipHeader.SetSource(Ipv4Address("10.0.0.1"));
+    ipHeader.SetDestination(Ipv4Address("10.0.0.2"));
+    ipHeader.SetProtocol(17); // UDP
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        auto payload = Create<Packet>(100);
+        UdpHeader udpHeader;
+        udpHeader.SetSourcePort(sourcePort);
+        udpHeader.SetDestinationPort(9);
+        payload->AddHeader(udpHeader);
+
+        FlowId flowId;
+        FlowPacketId packetId;
+        NS_TEST_ASSERT_MSG_EQ(m_classifier->Classify(ipHeader, payload, &flowId, &packetId),
+                              true,
+                              "The packet has not been classified");
+        m_lastFlowId = flowId;
+        m_monitor->ReportFirstTx(m_probe, flowId, packetId, payload->GetSize());
+        m_monitor->ReportLastRx(m_probe, flowId, packetId, payload->GetSize());
+    }
+}
+
+void
+FlowMonitorExportMemoryTest::CheckMemory()
+{
+    std::ostringstream os;
+    m_classifier->SerializeToXmlStream(os, 0);
+    std::size_t classifierFlows = 0;
+    for (auto pos = os.str().find("<Flow "); pos != std::string::npos;
+         pos = os.str().find("<Flow ", pos + 1))
+    {
+        classifierFlows++;
+    }
+    m_maxMonitorFlows = std::max(m_maxMonitorFlows, m_monitor->GetFlowStats().size());
+    m_maxClassifierFlows = std::max(m_maxClassifierFlows, classifierFlows);
+    m_maxProbeFlows = std::max(m_maxProbeFlows, m_probe->GetStats().size());
+}
+
+void
+FlowMonitorExportMemoryTest::DoRun()
+{
+    m_monitor = CreateObject<FlowMonitor>();
+    m_monitor->SetAttribute("ExportFileName",
+                            StringValue(CreateTempDirFilename("flow-monitor-short-flows.xml")));
+    m_monitor->SetAttribute("FlowIdleTimeout", TimeValue(MilliSeconds(500)));
+    m_classifier = Create<Ipv4FlowClassifier>();
+    m_monitor->AddFlowClassifier(m_classifier);
+    m_probe = CreateObject<TestFlowProbe>(m_monitor);
+    m_monitor->StartRightNow();
+
+    // a new short flow every 10 ms for 20 seconds; the source ports are reused
+    // every 5 seconds, i.e., after the flows using them have been exported
+    const uint32_t nFlows = 2000;
+    for (uint32_t i = 0; i < nFlows; i++)
+    {
+        Simulator::Schedule(MilliSeconds(10 * i),
+                            &FlowMonitorExportMemoryTest::SendFlow,
+                            this,
+                            1000 + i % 500);
+        Simulator::Schedule(MilliSeconds(10 * i + 5),
+                            &FlowMonitorExportMemoryTest::CheckMemory,
+                            this);
+    }
+
+    // a drop reported for a packet of an exported flow is ignored
+    Simulator::Schedule(Seconds(10), [this]() {
+        NS_TEST_EXPECT_MSG_EQ(m_monitor->GetFlowStats().count(1), 0, "Flow 1 not exported");
+        m_monitor->ReportDrop(m_probe, 1, 0, 100, 0);
+        NS_TEST_EXPECT_MSG_EQ(m_monitor->GetFlowStats().count(1),
+                              0,
+                              "Flow 1 has been created again by a late drop");
+        NS_TEST_EXPECT_MSG_EQ(m_probe->GetStats().count(1),
+                              0,
+                              "Flow 1 has been created again in the probe by a late drop");
+    });
+
+    Simulator::Stop(Seconds(23));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_lastFlowId, nFlows, "Reused five-tuples should start new flows");
+    NS_TEST_EXPECT_MSG_EQ(m_monitor->GetNExportedFlows(), nFlows, "All flows should be exported");
+    CheckMemory();
+    // at most 1.5 seconds of flows (FlowIdleTimeout plus the period of the export) are stored
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(m_maxMonitorFlows, 150, "Monitor memory grows with the flows");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(m_maxClassifierFlows,
+                                150,
+                                "Classifier memory grows with the flows");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(m_maxProbeFlows, 150, "Probe memory grows with the flows");
+
+    m_monitor->Dispose();
+    m_monitor = nullptr;
+    m_classifier = nullptr;
+    m_probe = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup flow-monitor-test
+ * @ingroup tests
+ *
+ * @brief FlowMonitor TestSuite
+ */
+class FlowMonitorTestSuite : public TestSuite
+{
+  public:
+    FlowMonitorTestSuite()
+        : TestSuite("flow-monitor", Type::UNIT)
+    {
+        AddTestCase(new FlatHashMapTest(), TestCase::Duration::QUICK);
+        AddTestCase(new FlowMonitorSamplingExportTest(), TestCase::Duration::QUICK);
+        AddTestCase(new FlowMonitorExportMemoryTest(), TestCase::Duration::QUICK);
+    }
+};
+
+static FlowMonitorTestSuite g_flowMonitorTestSuite; //!< Static variable for test initialization
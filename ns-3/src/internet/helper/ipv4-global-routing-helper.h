@@ -78,6 +78,18 @@ class Ipv4GlobalRoutingHelper : public Ipv4RoutingHelper
      *
      */
     static void RecomputeRoutingTables();
+    /**
+     * @brief Update the routes after a change of the global topology.
+     *
+     * Unlike RecomputeRoutingTables(), no route is computed again if no link
+     * state advertisement changed since the routes were last computed, and the
+     * routes of the stub routers whose link state advertisement and that of
+     * their neighbor did not change are kept as they are. The routes of all
+     * the other routers are computed again in full. Hence, routes removed or
+     * modified by other means than a change of the topology may not be
+     * restored. Users must first call PopulateRoutingTables().
+     */
+    static void UpdateRoutingTables();
 };
 
 } // namespace ns3
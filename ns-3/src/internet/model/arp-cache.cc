@@ -11,6 +11,7 @@
 #include "ipv4-interface.h"
 
 #include "ns3/assert.h"
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/names.h"
 #include "ns3/node.h"
@@ -19,6 +20,10 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
 namespace ns3
 {
 
@@ -64,6 +69,21 @@ ArpCache::GetTypeId()
                                           UintegerValue(3),
                                           MakeUintegerAccessor(&ArpCache::m_pendingQueueSize),
                                           MakeUintegerChecker<uint32_t>())
+                            .AddAttribute("AgingInterval",
+                                          "Interval between two sweeps of the cache removing "
+                                          "the ALIVE and DEAD entries that have expired. "
+                                          "A zero value disables the sweep.",
+                                          TimeValue(Seconds(0)),
+                                          MakeTimeAccessor(&ArpCache::m_agingInterval),
+                                          MakeTimeChecker())
+                            .AddAttribute("Static",
+                                          "If true, the destinations without an entry in the "
+                                          "cache are not resolved and the received packets do "
+                                          "not refresh the entries. This is intended for caches "
+                                          "populated beforehand, e.g., by NeighborCacheHelper.",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&ArpCache::m_static),
+                                          MakeBooleanChecker())
                             .AddTraceSource("Drop",
                                             "Packet dropped due to ArpCache entry "
                                             "in WaitReply expiring.",
@@ -88,17 +108,15 @@ void
 ArpCache::DoDispose()
 {
     NS_LOG_FUNCTION(this);
-    for (auto& iter : m_arpCache)
-    {
-        delete iter.second; /* delete the pointer ArpCache::Entry */
-    }
     m_arpCache.clear();
+    m_waitReplySet.clear();
     m_device = nullptr;
     m_interface = nullptr;
     if (!m_waitReplyTimer.IsPending())
     {
         m_waitReplyTimer.Cancel();
     }
+    m_agingTimer.Cancel();
     Object::DoDispose();
 }
 
@@ -186,15 +204,24 @@ ArpCache::StartWaitReplyTimer()
     }
 }
 
+bool
+ArpCache::IsStatic() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_static;
+}
+
 void
 ArpCache::HandleWaitReplyTimeout()
 {
     NS_LOG_FUNCTION(this);
-    ArpCache::Entry* entry;
     bool restartWaitReplyTimer = false;
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // the entries leave the WAIT_REPLY state while they are visited
+    std::vector<Ipv4Address> waiting(m_waitReplySet.begin(), m_waitReplySet.end());
+    for (const auto& address : waiting)
     {
-        entry = (*i).second;
+        auto i = m_arpCache.find(address);
+        ArpCache::Entry* entry = (i != m_arpCache.end() ? &i->second : nullptr);
         if (entry != nullptr && entry->IsWaitReply())
         {
             if (entry->GetRetries() < m_maxRetries)
@@ -234,16 +261,68 @@ ArpCache::HandleWaitReplyTimeout()
     }
 }
 
+void
+ArpCache::StartAgingTimer()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_agingInterval.IsStrictlyPositive() && !m_agingTimer.IsPending())
+    {
+        m_agingTimer = Simulator::Schedule(m_agingInterval, &ArpCache::HandleAgingTimeout, this);
+    }
+}
+
+void
+ArpCache::HandleAgingTimeout()
+{
+    NS_LOG_FUNCTION(this);
+    bool restartAgingTimer = false;
+    for (auto i = m_arpCache.begin(); i != m_arpCache.end();)
+    {
+        ArpCache::Entry& entry = i->second;
+        if (entry.IsPermanent() || entry.IsAutoGenerated())
+        {
+            i++;
+        }
+        else if ((entry.IsAlive() || entry.IsDead()) && entry.IsExpired())
+        {
+            NS_LOG_LOGIC("Removing expired entry " << entry);
+            i = m_arpCache.erase(i);
+        }
+        else
+        {
+            restartAgingTimer = true;
+            i++;
+        }
+    }
+    if (restartAgingTimer)
+    {
+        StartAgingTimer();
+    }
+}
+
+void
+ArpCache::UpdateWaitReplySet(ArpCache::Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    if (entry->IsWaitReply())
+    {
+        m_waitReplySet.insert(entry->GetIpv4Address());
+    }
+    else
+    {
+        m_waitReplySet.erase(entry->GetIpv4Address());
+    }
+}
+
 void
 ArpCache::Flush()
 {
     NS_LOG_FUNCTION(this);
     for (auto i = m_arpCache.begin(); i != m_arpCache.end();)
     {
-        if (!i->second->IsAutoGenerated())
+        if (!i->second.IsAutoGenerated())
         {
-            i->second->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
-            delete i->second;
+            i->second.ClearPendingPacket(); // clear the pending packets for entry's ipaddress
             i = m_arpCache.erase(i);
         }
         else
@@ -251,6 +330,8 @@ ArpCache::Flush()
             i++;
         }
     }
+    m_waitReplySet.clear();
+    m_agingTimer.Cancel();
     if (m_waitReplyTimer.IsPending())
     {
         NS_LOG_LOGIC("Stopping WaitReplyTimer at " << Simulator::Now().GetSeconds()
@@ -265,7 +346,18 @@ ArpCache::PrintArpCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
+    // print the entries sorted by address
+    std::vector<CacheI> entries;
+    entries.reserve(m_arpCache.size());
     for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    {
+        entries.push_back(i);
+    }
+    std::sort(entries.begin(), entries.end(), [](const CacheI& a, const CacheI& b) {
+        return a->first < b->first;
+    });
+
+    for (const auto& i : entries)
     {
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
@@ -278,21 +370,21 @@ ArpCache::PrintArpCache(Ptr<OutputStreamWrapper> stream)
             *os << static_cast<int>(m_device->GetIfIndex());
         }
 
-        *os << " lladdr " << i->second->GetMacAddress();
+        *os << " lladdr " << i->second.GetMacAddress();
 
-        if (i->second->IsAlive())
+        if (i->second.IsAlive())
         {
             *os << " REACHABLE\n";
         }
-        else if (i->second->IsWaitReply())
+        else if (i->second.IsWaitReply())
         {
             *os << " DELAY\n";
         }
-        else if (i->second->IsPermanent())
+        else if (i->second.IsPermanent())
         {
             *os << " PERMANENT\n";
         }
-        else if (i->second->IsAutoGenerated())
+        else if (i->second.IsAutoGenerated())
         {
             *os << " STATIC_AUTOGENERATED\n";
         }
@@ -309,10 +401,9 @@ ArpCache::RemoveAutoGeneratedEntries()
     NS_LOG_FUNCTION(this);
     for (auto i = m_arpCache.begin(); i != m_arpCache.end();)
     {
-        if (i->second->IsAutoGenerated())
+        if (i->second.IsAutoGenerated())
         {
-            i->second->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
-            delete i->second;
+            i->second.ClearPendingPacket(); // clear the pending packets for entry's ipaddress
             i = m_arpCache.erase(i);
         }
         else
@@ -328,14 +419,16 @@ ArpCache::LookupInverse(Address to)
     NS_LOG_FUNCTION(this << to);
 
     std::list<ArpCache::Entry*> entryList;
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    for (auto& [address, entry] : m_arpCache)
     {
-        ArpCache::Entry* entry = (*i).second;
-        if (entry->GetMacAddress() == to)
+        if (entry.GetMacAddress() == to)
         {
-            entryList.push_back(entry);
+            entryList.push_back(&entry);
         }
     }
+    entryList.sort([](const auto a, const auto b) {
+        return a->GetIpv4Address() < b->GetIpv4Address();
+    });
     return entryList;
 }
 
@@ -346,7 +439,7 @@ ArpCache::Lookup(Ipv4Address to)
     auto it = m_arpCache.find(to);
     if (it != m_arpCache.end())
     {
-        return it->second;
+        return &it->second;
     }
     return nullptr;
 }
@@ -357,9 +450,12 @@ ArpCache::Add(Ipv4Address to)
     NS_LOG_FUNCTION(this << to);
     NS_ASSERT(m_arpCache.find(to) == m_arpCache.end());
 
-    auto entry = new ArpCache::Entry(this);
-    m_arpCache[to] = entry;
+    auto [it, inserted] = m_arpCache.emplace(std::piecewise_construct,
+                                             std::forward_as_tuple(to),
+                                             std::forward_as_tuple(this));
+    ArpCache::Entry* entry = &it->second;
     entry->SetIpv4Address(to);
+    StartAgingTimer();
     return entry;
 }
 
@@ -368,15 +464,13 @@ ArpCache::Remove(ArpCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    auto i = m_arpCache.find(entry->GetIpv4Address());
+    if (i != m_arpCache.end() && &i->second == entry)
     {
-        if ((*i).second == entry)
-        {
-            m_arpCache.erase(i);
-            entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
-            delete entry;
-            return;
-        }
+        entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
+        m_waitReplySet.erase(i->first);
+        m_arpCache.erase(i);
+        return;
     }
     NS_LOG_WARN("Entry not found in this ARP Cache");
 }
@@ -432,6 +526,7 @@ ArpCache::Entry::MarkDead()
     m_state = DEAD;
     ClearRetries();
     UpdateSeen();
+    m_arp->UpdateWaitReplySet(this);
 }
 
 void
@@ -443,6 +538,7 @@ ArpCache::Entry::MarkAlive(Address macAddress)
     m_state = ALIVE;
     ClearRetries();
     UpdateSeen();
+    m_arp->UpdateWaitReplySet(this);
 }
 
 void
@@ -454,6 +550,7 @@ ArpCache::Entry::MarkPermanent()
     m_state = PERMANENT;
     ClearRetries();
     UpdateSeen();
+    m_arp->UpdateWaitReplySet(this);
 }
 
 void
@@ -465,6 +562,7 @@ ArpCache::Entry::MarkAutoGenerated()
     m_state = STATIC_AUTOGENERATED;
     ClearRetries();
     UpdateSeen();
+    m_arp->UpdateWaitReplySet(this);
 }
 
 bool
@@ -495,6 +593,7 @@ ArpCache::Entry::MarkWaitReply(Ipv4PayloadHeaderPair waiting)
     m_state = WAIT_REPLY;
     m_pending.push_back(waiting);
     UpdateSeen();
+    m_arp->UpdateWaitReplySet(this);
     m_arp->StartWaitReplyTimer();
 }
 
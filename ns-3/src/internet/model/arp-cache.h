@@ -21,8 +21,9 @@
 #include "ns3/traced-callback.h"
 
 #include <list>
-#include <map>
+#include <set>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -119,6 +120,16 @@ class ArpCache : public Object
      * in which case this method does nothing.
      */
     void StartWaitReplyTimer();
+    /**
+     * @brief Check if the cache is static.
+     *
+     * A static cache only holds the entries it is given (e.g., by NeighborCacheHelper):
+     * the destinations without an entry are not resolved and the received packets
+     * do not refresh the entries.
+     *
+     * @return true if the cache is static
+     */
+    bool IsStatic() const;
     /**
      * @brief Do lookup in the ARP cache against an IP address
      * @param destination The destination IPv4 address to lookup the MAC address
@@ -321,12 +332,15 @@ class ArpCache : public Object
   private:
     /**
      * @brief ARP Cache container
+     *
+     * The entries are stored in the nodes of the hash table, their address
+     * does not change until they are removed.
      */
-    typedef std::map<Ipv4Address, ArpCache::Entry*> Cache;
+    typedef std::unordered_map<Ipv4Address, ArpCache::Entry, Ipv4AddressHash> Cache;
     /**
      * @brief ARP Cache container iterator
      */
-    typedef std::map<Ipv4Address, ArpCache::Entry*>::iterator CacheI;
+    typedef Cache::iterator CacheI;
 
     void DoDispose() override;
 
@@ -336,6 +350,9 @@ class ArpCache : public Object
     Time m_deadTimeout;             //!< cache dead state timeout
     Time m_waitReplyTimeout;        //!< cache reply state timeout
     EventId m_waitReplyTimer;       //!< cache alive state timer
+    Time m_agingInterval;           //!< interval between two sweeps of the expired entries
+    EventId m_agingTimer;           //!< expired entries sweep timer
+    bool m_static;                  //!< true if the destinations without entry are not resolved
     Callback<void, Ptr<const ArpCache>, Ipv4Address>
         m_arpRequestCallback; //!< reply timeout callback
     uint32_t m_maxRetries;    //!< max retries for a resolution
@@ -346,8 +363,25 @@ class ArpCache : public Object
      * If there are no Arp requests pending, this event is not scheduled.
      */
     void HandleWaitReplyTimeout();
-    uint32_t m_pendingQueueSize; //!< number of packets waiting for a resolution
-    Cache m_arpCache;            //!< the ARP cache
+    /**
+     * This method will schedule a sweep of the expired entries at AgingInterval
+     * in the future, unless the sweep is disabled or already scheduled.
+     */
+    void StartAgingTimer();
+    /**
+     * This function is an event handler for the periodic sweep of the cache.
+     * The ALIVE and DEAD entries that have expired are removed, the sweep is
+     * rescheduled as long as the cache holds entries that can expire.
+     */
+    void HandleAgingTimeout();
+    /**
+     * @brief Update the set of the entries waiting for a reply.
+     * @param entry the entry whose state has changed
+     */
+    void UpdateWaitReplySet(ArpCache::Entry* entry);
+    uint32_t m_pendingQueueSize;          //!< number of packets waiting for a resolution
+    Cache m_arpCache;                     //!< the ARP cache
+    std::set<Ipv4Address> m_waitReplySet; //!< addresses of the entries in WAIT_REPLY state
     TracedCallback<Ptr<const Packet>>
         m_dropTrace; //!< trace for packets dropped by the ARP cache queue
 };
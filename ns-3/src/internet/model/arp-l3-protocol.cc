@@ -371,6 +371,14 @@ ArpL3Protocol::Lookup(Ptr<Packet> packet,
             }
         }
     }
+    else if (cache->IsStatic())
+    {
+        NS_LOG_LOGIC("node=" << m_node->GetId() << ", no entry for " << destination
+                             << " in static cache -- drop");
+        // add the Ipv4 header for tracing purposes
+        packet->AddHeader(ipHeader);
+        m_dropTrace(packet);
+    }
     else
     {
         // This is our first attempt to transmit data to this destination.
@@ -13,6 +13,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <iterator>
 
 namespace ns3
 {
@@ -93,6 +94,7 @@ CandidateQueue::Push(SPFVertex* vNew)
                               vNew,
                               &CandidateQueue::CompareSPFVertex);
     m_candidates.insert(i, vNew);
+    m_index.emplace(vNew->GetVertexId(), vNew);
 }
 
 SPFVertex*
@@ -106,6 +108,8 @@ CandidateQueue::Pop()
 
     SPFVertex* v = m_candidates.front();
     m_candidates.pop_front();
+    auto [first, last] = m_index.equal_range(v->GetVertexId());
+    m_index.erase(std::find_if(first, last, [v](const auto& entry) { return entry.second == v; }));
     return v;
 }
 
@@ -139,18 +143,21 @@ SPFVertex*
 CandidateQueue::Find(const Ipv4Address addr) const
 {
     NS_LOG_FUNCTION(this);
-    auto i = m_candidates.begin();
-
-    for (; i != m_candidates.end(); i++)
+    auto [first, last] = m_index.equal_range(addr);
+    if (first == last)
     {
-        SPFVertex* v = *i;
-        if (v->GetVertexId() == addr)
-        {
-            return v;
-        }
+        return nullptr;
     }
-
-    return nullptr;
+    if (std::next(first) == last)
+    {
+        return first->second;
+    }
+    // several candidates with the same ID (never the case in SPF calculations):
+    // return the first one in the queue
+    auto i = std::find_if(m_candidates.begin(), m_candidates.end(), [addr](const SPFVertex* v) {
+        return v->GetVertexId() == addr;
+    });
+    return *i;
 }
 
 void
@@ -13,6 +13,7 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -164,6 +165,8 @@ class CandidateQueue
 
     typedef std::list<SPFVertex*> CandidateList_t; //!< container of SPFVertex pointers
     CandidateList_t m_candidates;                  //!< SPFVertex candidates
+    /// SPFVertex candidates indexed by vertex ID, for Find ()
+    std::unordered_multimap<Ipv4Address, SPFVertex*, Ipv4AddressHash> m_index;
 
     /**
      * @brief Stream insertion operator.
@@ -463,9 +463,23 @@ GlobalRouteManagerLSDB::Insert(Ipv4Address addr, GlobalRoutingLSA* lsa)
     {
         m_extdatabase.push_back(lsa);
     }
-    else
+    else if (m_database.insert(LSDBPair_t(addr, lsa)).second)
     {
-        m_database.insert(LSDBPair_t(addr, lsa));
+        for (uint32_t i = 0; i < lsa->GetNLinkRecords(); i++)
+        {
+            GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(i);
+            if (lr->GetLinkType() != GlobalRoutingLinkRecord::TransitNetwork)
+            {
+                continue;
+            }
+            // keep the LSA with the lowest address, as a linear search of the
+            // database would do
+            auto [it, inserted] = m_linkDataIndex.emplace(lr->GetLinkData(), LSDBPair_t(addr, lsa));
+            if (!inserted && addr < it->second.first)
+            {
+                it->second = LSDBPair_t(addr, lsa);
+            }
+        }
     }
 }
 
@@ -490,14 +504,8 @@ GlobalRouteManagerLSDB::GetLSA(Ipv4Address addr) const
     //
     // Look up an LSA by its address.
     //
-    for (auto i = m_database.begin(); i != m_database.end(); i++)
-    {
-        if (i->first == addr)
-        {
-            return i->second;
-        }
-    }
-    return nullptr;
+    auto it = m_database.find(addr);
+    return (it != m_database.end()) ? it->second : nullptr;
 }
 
 GlobalRoutingLSA*
@@ -505,23 +513,83 @@ GlobalRouteManagerLSDB::GetLSAByLinkData(Ipv4Address addr) const
 {
     NS_LOG_FUNCTION(this << addr);
     //
-    // Look up an LSA by its address.
+    // Look up an LSA by the link data of its TransitNetwork link records.
     //
-    for (auto i = m_database.begin(); i != m_database.end(); i++)
+    auto it = m_linkDataIndex.find(addr);
+    return (it != m_linkDataIndex.end()) ? it->second.second : nullptr;
+}
+
+/**
+ * @brief Compare two Link State Advertisements, ignoring their SPF status.
+ * @param a the first LSA
+ * @param b the second LSA
+ * @returns true if the LSAs advertise the same links
+ */
+static bool
+IsSameLSA(const GlobalRoutingLSA& a, const GlobalRoutingLSA& b)
+{
+    if (a.GetLSType() != b.GetLSType() || a.GetLinkStateId() != b.GetLinkStateId() ||
+        a.GetAdvertisingRouter() != b.GetAdvertisingRouter() ||
+        a.GetNetworkLSANetworkMask() != b.GetNetworkLSANetworkMask() ||
+        a.GetNLinkRecords() != b.GetNLinkRecords() ||
+        a.GetNAttachedRouters() != b.GetNAttachedRouters())
     {
-        GlobalRoutingLSA* temp = i->second;
-        // Iterate among temp's Link Records
-        for (uint32_t j = 0; j < temp->GetNLinkRecords(); j++)
+        return false;
+    }
+    for (uint32_t i = 0; i < a.GetNLinkRecords(); i++)
+    {
+        GlobalRoutingLinkRecord* la = a.GetLinkRecord(i);
+        GlobalRoutingLinkRecord* lb = b.GetLinkRecord(i);
+        if (la->GetLinkType() != lb->GetLinkType() || la->GetLinkId() != lb->GetLinkId() ||
+            la->GetLinkData() != lb->GetLinkData() || la->GetMetric() != lb->GetMetric())
         {
-            GlobalRoutingLinkRecord* lr = temp->GetLinkRecord(j);
-            if (lr->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork &&
-                lr->GetLinkData() == addr)
-            {
-                return temp;
-            }
+            return false;
         }
     }
-    return nullptr;
+    for (uint32_t i = 0; i < a.GetNAttachedRouters(); i++)
+    {
+        if (a.GetAttachedRouter(i) != b.GetAttachedRouter(i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::set<Ipv4Address>
+GlobalRouteManagerLSDB::GetChangedLSAs(const GlobalRouteManagerLSDB& lsdb) const
+{
+    NS_LOG_FUNCTION(this << &lsdb);
+    std::set<Ipv4Address> changed;
+    for (const auto& [addr, lsa] : m_database)
+    {
+        GlobalRoutingLSA* other = lsdb.GetLSA(addr);
+        if (!other || !IsSameLSA(*lsa, *other))
+        {
+            changed.insert(addr);
+        }
+    }
+    for (const auto& [addr, lsa] : lsdb.m_database)
+    {
+        if (!GetLSA(addr))
+        {
+            changed.insert(addr);
+        }
+    }
+    return changed;
+}
+
+bool
+GlobalRouteManagerLSDB::HasSameExtLSAs(const GlobalRouteManagerLSDB& lsdb) const
+{
+    NS_LOG_FUNCTION(this << &lsdb);
+    return std::equal(m_extdatabase.begin(),
+                      m_extdatabase.end(),
+                      lsdb.m_extdatabase.begin(),
+                      lsdb.m_extdatabase.end(),
+                      [](const GlobalRoutingLSA* a, const GlobalRoutingLSA* b) {
+                          return IsSameLSA(*a, *b);
+                      });
 }
 
 // ---------------------------------------------------------------------------
@@ -562,33 +630,132 @@ GlobalRouteManagerImpl::DeleteGlobalRoutes()
 {
     NS_LOG_FUNCTION(this);
     for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    {
+        DeleteNodeRoutes(*i);
+    }
+    if (m_lsdb)
+    {
+        NS_LOG_LOGIC("Deleting LSDB, creating new one");
+        delete m_lsdb;
+        m_lsdb = new GlobalRouteManagerLSDB();
+    }
+}
+
+void
+GlobalRouteManagerImpl::DeleteNodeRoutes(Ptr<Node> node)
+{
+    NS_LOG_FUNCTION(this << node);
+    Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
+    if (!router)
+    {
+        return;
+    }
+    Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
+    uint32_t j = 0;
+    uint32_t nRoutes = gr->GetNRoutes();
+    NS_LOG_LOGIC("Deleting " << gr->GetNRoutes() << " routes from node " << node->GetId());
+    // Each time we delete route 0, the route index shifts downward
+    // We can delete all routes if we delete the route numbered 0
+    // nRoutes times
+    for (j = 0; j < nRoutes; j++)
+    {
+        NS_LOG_LOGIC("Deleting global route " << j << " from node " << node->GetId());
+        gr->RemoveRoute(0);
+    }
+    NS_LOG_LOGIC("Deleted " << j << " global routes from node " << node->GetId());
+}
+
+//
+// Update the routes after a topology change.  The LSDB is rebuilt and
+// compared with the previous one: if no LSA changed, the routes are assumed
+// to be still valid.  Otherwise, the routes of a stub node (which only has a default
+// route through its single point-to-point neighbor, see CheckForStubNode ())
+// are kept if neither its LSA nor the LSA of its neighbor changed; the routes
+// of all the other nodes are computed again.
+//
+void
+GlobalRouteManagerImpl::UpdateRoutes()
+{
+    NS_LOG_FUNCTION(this);
+    GlobalRouteManagerLSDB* oldLsdb = m_lsdb;
+    m_lsdb = new GlobalRouteManagerLSDB();
+    BuildGlobalRoutingDatabase();
+
+    std::set<Ipv4Address> changed = m_lsdb->GetChangedLSAs(*oldLsdb);
+    bool sameExternals = m_lsdb->HasSameExtLSAs(*oldLsdb);
+    delete oldLsdb;
+    if (changed.empty() && sameExternals)
+    {
+        NS_LOG_LOGIC("No LSA changed, routes are still valid");
+        return;
+    }
+    NS_LOG_LOGIC(changed.size() << " LSAs changed");
+
+    uint32_t systemId = Simulator::GetSystemId();
+    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
     {
         Ptr<Node> node = *i;
-        Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-        if (!router)
+        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        if (!rtr || node->GetSystemId() != systemId)
         {
             continue;
         }
-        Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-        uint32_t j = 0;
-        uint32_t nRoutes = gr->GetNRoutes();
-        NS_LOG_LOGIC("Deleting " << gr->GetNRoutes() << " routes from node " << node->GetId());
-        // Each time we delete route 0, the route index shifts downward
-        // We can delete all routes if we delete the route numbered 0
-        // nRoutes times
-        for (j = 0; j < nRoutes; j++)
+        if (rtr->GetNumLSAs() && IsUnchangedStubNode(rtr->GetRouterId(), changed))
         {
-            NS_LOG_LOGIC("Deleting global route " << j << " from node " << node->GetId());
-            gr->RemoveRoute(0);
+            NS_LOG_LOGIC("Keeping the routes of stub node " << rtr->GetRouterId());
+            continue;
+        }
+        DeleteNodeRoutes(node);
+        if (rtr->GetNumLSAs())
+        {
+            SPFCalculate(rtr->GetRouterId());
         }
-        NS_LOG_LOGIC("Deleted " << j << " global routes from node " << node->GetId());
     }
-    if (m_lsdb)
+}
+
+bool
+GlobalRouteManagerImpl::IsUnchangedStubNode(Ipv4Address root,
+                                            const std::set<Ipv4Address>& changed) const
+{
+    NS_LOG_FUNCTION(this << root);
+    GlobalRoutingLSA* rlsa = m_lsdb->GetLSA(root);
+    if (!rlsa || changed.contains(root))
     {
-        NS_LOG_LOGIC("Deleting LSDB, creating new one");
-        delete m_lsdb;
-        m_lsdb = new GlobalRouteManagerLSDB();
+        return false;
+    }
+    int transits = 0;
+    GlobalRoutingLinkRecord* transitLink = nullptr;
+    for (uint32_t i = 0; i < rlsa->GetNLinkRecords(); i++)
+    {
+        GlobalRoutingLinkRecord* l = rlsa->GetLinkRecord(i);
+        if (l->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork ||
+            l->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint)
+        {
+            transits++;
+            transitLink = l;
+        }
+    }
+    if (transits == 0)
+    {
+        return true;
     }
+    if (transits > 1 || transitLink->GetLinkType() != GlobalRoutingLinkRecord::PointToPoint ||
+        changed.contains(transitLink->GetLinkId()))
+    {
+        return false;
+    }
+    // same test as CheckForStubNode (): the neighbor must have a link back to the node
+    GlobalRoutingLSA* w_lsa = m_lsdb->GetLSA(transitLink->GetLinkId());
+    for (uint32_t j = 0; w_lsa && j < w_lsa->GetNLinkRecords(); ++j)
+    {
+        GlobalRoutingLinkRecord* lr = w_lsa->GetLinkRecord(j);
+        if (lr->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint &&
+            lr->GetLinkId() == root)
+        {
+            return true;
+        }
+    }
+    return false;
 }
 
 //
@@ -19,7 +19,10 @@
 #include <list>
 #include <map>
 #include <queue>
+#include <set>
 #include <stdint.h>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace ns3
@@ -668,6 +671,24 @@ class GlobalRouteManagerLSDB
      */
     uint32_t GetNumExtLSAs() const;
 
+    /**
+     * @brief Compare the Link State Advertisements with those of another database.
+     *
+     * @param lsdb the other database
+     * @returns the link state IDs of the LSAs that differ between the two
+     * databases, including those found in only one of them.
+     */
+    std::set<Ipv4Address> GetChangedLSAs(const GlobalRouteManagerLSDB& lsdb) const;
+
+    /**
+     * @brief Compare the External Link State Advertisements with those of
+     * another database.
+     *
+     * @param lsdb the other database
+     * @returns true if both databases hold the same External LSAs, in the same order.
+     */
+    bool HasSameExtLSAs(const GlobalRouteManagerLSDB& lsdb) const;
+
   private:
     typedef std::map<Ipv4Address, GlobalRoutingLSA*>
         LSDBMap_t; //!< container of IPv4 addresses / Link State Advertisements
@@ -677,6 +698,8 @@ class GlobalRouteManagerLSDB
     LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
     std::vector<GlobalRoutingLSA*>
         m_extdatabase; //!< database of External Link State Advertisements
+    /// index of the database by the link data of the TransitNetwork link records
+    std::unordered_map<Ipv4Address, LSDBPair_t, Ipv4AddressHash> m_linkDataIndex;
 };
 
 /**
@@ -721,6 +744,23 @@ class GlobalRouteManagerImpl
      */
     virtual void InitializeRoutes();
 
+    /**
+     * @brief Rebuild the routing database and update the per-node forwarding
+     * tables accordingly.
+     *
+     * The SPF calculation is skipped if the database has not changed since the
+     * routes were last computed, and so is the calculation of the stub routers
+     * whose Link State Advertisement and that of their neighbor have not
+     * changed: the routes of these routers are kept as they are. The routes of
+     * all the other routers (e.g., all the routers of a network without stub
+     * routers) are deleted and the full SPF calculation is performed for each
+     * of them. Hence, unlike
+     * deleting all the routes, then building the routing database and
+     * computing the routes again, this does not restore the routes that were
+     * removed or modified by other means than a change of the topology.
+     */
+    virtual void UpdateRoutes();
+
     /**
      * @brief Debugging routine; allow client code to supply a pre-built LSDB
      * @param lsdb the pre-built LSDB
@@ -749,6 +789,18 @@ class GlobalRouteManagerImpl
      */
     bool CheckForStubNode(Ipv4Address root);
 
+    /**
+     * @brief Check whether the routes of a stub router depend only on its own
+     * Link State Advertisement and on that of its neighbor.
+     *
+     * @param root the router ID
+     * @param changed the link state IDs of the LSAs changed since the routes
+     * were computed
+     * @returns true if the router is a stub (see CheckForStubNode ()) whose LSA
+     * and whose neighbor's LSA have not changed
+     */
+    bool IsUnchangedStubNode(Ipv4Address root, const std::set<Ipv4Address>& changed) const;
+
     /**
      * @brief Calculate the shortest path first (SPF) tree
      *
@@ -757,6 +809,12 @@ class GlobalRouteManagerImpl
      */
     void SPFCalculate(Ipv4Address root);
 
+    /**
+     * @brief Delete all the routes of the global routing protocol of a node.
+     * @param node the node
+     */
+    void DeleteNodeRoutes(Ptr<Node> node);
+
     /**
      * @brief Process Stub nodes
      *
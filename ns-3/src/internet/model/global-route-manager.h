@@ -60,6 +60,19 @@ class GlobalRouteManager
      */
     static void InitializeRoutes();
 
+    /**
+     * @brief Update the routes after a change of the topology.
+     *
+     * This is equivalent to calling DeleteGlobalRoutes (),
+     * BuildGlobalRoutingDatabase () and InitializeRoutes (), except that no
+     * route is computed again if no Link State Advertisement changed since the
+     * routes were last computed, and that the routes of the stub routers whose
+     * Link State Advertisement and that of their neighbor did not change are
+     * kept as they are. The full SPF calculation is performed for all the
+     * other routers; the SPF trees are not updated incrementally.
+     */
+    static void UpdateRoutingTables();
+
     /**
      * @brief Reset the router ID counter to zero. This should only be called by tests to reset the
      * router ID counter between simulations within the same program. This function should not be
@@ -1788,6 +1788,11 @@ Icmpv6L4Protocol::Lookup(Ptr<Packet> p,
             return false;
         }
     }
+    else if (cache->IsStatic())
+    {
+        NS_LOG_LOGIC("No entry for " << dst << " in static cache -- drop");
+        return false;
+    }
     else
     {
         /* we contact this node for the first time
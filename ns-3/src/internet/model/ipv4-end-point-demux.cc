@@ -13,6 +13,8 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -35,26 +37,27 @@ Ipv4EndPointDemux::~Ipv4EndPointDemux()
         delete endPoint;
     }
     m_endPoints.clear();
+    m_positions.clear();
+    m_connected.clear();
+    m_unconnected.clear();
+    m_localPorts.clear();
 }
 
 bool
 Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
 {
     NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_localPorts.contains(port);
 }
 
 bool
 Ipv4EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv4Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
+    if (!m_localPorts.contains(port))
+    {
+        return false;
+    }
     for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
     {
         if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
@@ -77,7 +80,7 @@ Ipv4EndPointDemux::Allocate()
         return nullptr;
     }
     auto endPoint = new Ipv4EndPoint(Ipv4Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -93,7 +96,7 @@ Ipv4EndPointDemux::Allocate(Ipv4Address address)
         return nullptr;
     }
     auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -116,7 +119,7 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv4Address address,
         return nullptr;
     }
     auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -129,11 +132,11 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << localAddress << localPort << peerAddress << peerPort << boundNetDevice);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    for (auto i : GetCandidates(localPort, peerAddress, peerPort))
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        if (i->GetLocalPort() == localPort && i->GetLocalAddress() == localAddress &&
+            i->GetPeerPort() == peerPort && i->GetPeerAddress() == peerAddress &&
+            (i->GetBoundNetDevice() == boundNetDevice || !i->GetBoundNetDevice()))
         {
             NS_LOG_WARN("Duplicated endpoint.");
             return nullptr;
@@ -141,7 +144,7 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
     }
     auto endPoint = new Ipv4EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
 
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
 
@@ -152,17 +155,118 @@ void
 Ipv4EndPointDemux::DeAllocate(Ipv4EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this << endPoint);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto position = m_positions.find(endPoint);
+    if (position == m_positions.end())
+    {
+        return;
+    }
+    Unindex(endPoint,
+            endPoint->GetLocalPort(),
+            endPoint->GetPeerAddress(),
+            endPoint->GetPeerPort());
+    if (auto port = m_localPorts.find(endPoint->GetLocalPort()); --port->second == 0)
+    {
+        m_localPorts.erase(port);
+    }
+    m_endPoints.erase(position->second);
+    m_positions.erase(position);
+    delete endPoint;
+}
+
+void
+Ipv4EndPointDemux::Insert(Ipv4EndPoint* endPoint)
+{
+    m_endPoints.push_back(endPoint);
+    m_positions[endPoint] = std::prev(m_endPoints.end());
+    m_localPorts[endPoint->GetLocalPort()]++;
+    Index(endPoint, endPoint->GetLocalPort(), endPoint->GetPeerAddress(), endPoint->GetPeerPort());
+    endPoint->SetIndexChangeCallback(MakeCallback(&Ipv4EndPointDemux::NotifyIndexChange, this));
+}
+
+uint64_t
+Ipv4EndPointDemux::GetKey(uint16_t localPort, Ipv4Address peerAddress, uint16_t peerPort)
+{
+    return (uint64_t{peerAddress.Get()} << 32) | (uint64_t{peerPort} << 16) | localPort;
+}
+
+void
+Ipv4EndPointDemux::Index(Ipv4EndPoint* endPoint,
+                         uint16_t localPort,
+                         Ipv4Address peerAddress,
+                         uint16_t peerPort)
+{
+    if (peerPort != 0 && peerAddress != Ipv4Address::GetAny())
+    {
+        m_connected.emplace(GetKey(localPort, peerAddress, peerPort), endPoint);
+    }
+    else
+    {
+        m_unconnected[localPort].push_back(endPoint);
+    }
+}
+
+void
+Ipv4EndPointDemux::Unindex(Ipv4EndPoint* endPoint,
+                           uint16_t localPort,
+                           Ipv4Address peerAddress,
+                           uint16_t peerPort)
+{
+    if (peerPort != 0 && peerAddress != Ipv4Address::GetAny())
+    {
+        auto [begin, end] = m_connected.equal_range(GetKey(localPort, peerAddress, peerPort));
+        auto it = std::find_if(begin, end, [endPoint](const auto& entry) {
+            return entry.second == endPoint;
+        });
+        NS_ASSERT(it != end);
+        m_connected.erase(it);
+    }
+    else
     {
-        if (*i == endPoint)
+        auto it = m_unconnected.find(localPort);
+        NS_ASSERT(it != m_unconnected.end());
+        std::erase(it->second, endPoint);
+        if (it->second.empty())
         {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
+            m_unconnected.erase(it);
         }
     }
 }
 
+void
+Ipv4EndPointDemux::NotifyIndexChange(Ipv4EndPoint* endPoint,
+                                     uint16_t localPort,
+                                     Ipv4Address peerAddress,
+                                     uint16_t peerPort)
+{
+    NS_LOG_FUNCTION(this << endPoint << localPort << peerAddress << peerPort);
+    Unindex(endPoint, localPort, peerAddress, peerPort);
+    if (localPort != endPoint->GetLocalPort())
+    {
+        if (auto port = m_localPorts.find(localPort); --port->second == 0)
+        {
+            m_localPorts.erase(port);
+        }
+        m_localPorts[endPoint->GetLocalPort()]++;
+    }
+    Index(endPoint, endPoint->GetLocalPort(), endPoint->GetPeerAddress(), endPoint->GetPeerPort());
+}
+
+std::vector<Ipv4EndPoint*>
+Ipv4EndPointDemux::GetCandidates(uint16_t dport, Ipv4Address saddr, uint16_t sport)
+{
+    std::vector<Ipv4EndPoint*> candidates;
+    auto [begin, end] = m_connected.equal_range(GetKey(dport, saddr, sport));
+    for (auto it = begin; it != end; it++)
+    {
+        candidates.push_back(it->second);
+    }
+    if (auto it = m_unconnected.find(dport); it != m_unconnected.end())
+    {
+        candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+    }
+    return candidates;
+}
+
 /*
  * return list of all available Endpoints
  */
@@ -200,10 +304,10 @@ Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
     EndPoints retval4; // Exact match on all 4
 
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr << ":" << dport);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    // only the endpoints with the destination port and whose peer is either
+    // the source or unspecified can match
+    for (auto endP : GetCandidates(dport, saddr, sport))
     {
-        Ipv4EndPoint* endP = *i;
-
         NS_LOG_DEBUG("Looking at endpoint dport="
                      << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
                      << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
@@ -15,6 +15,8 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -31,6 +33,12 @@ class Ipv4EndPoint;
  * of endpoints, and has APIs to add and find endpoints in this demux.  This
  * code is shared in common to TCP and UDP protocols in ns3.  This demux
  * sits between ns3's layer four and the socket layer
+ *
+ * The endpoints with a peer address and port (e.g., the established TCP
+ * connections) are indexed by local port, peer address and peer port, and
+ * the other endpoints (e.g., the listening ones) by local port, so that a
+ * lookup only considers the endpoints that can match the packet, however
+ * many connections the node has.
  */
 
 class Ipv4EndPointDemux
@@ -160,6 +168,68 @@ class Ipv4EndPointDemux
     void DeAllocate(Ipv4EndPoint* endPoint);
 
   private:
+    /**
+     * @brief Add an endpoint to the list and to the indexes.
+     * @param endPoint the end point to add
+     */
+    void Insert(Ipv4EndPoint* endPoint);
+
+    /**
+     * @brief Add an endpoint to the index of its local port and peer.
+     * @param endPoint the end point
+     * @param localPort the local port of the end point
+     * @param peerAddress the peer address of the end point
+     * @param peerPort the peer port of the end point
+     */
+    void Index(Ipv4EndPoint* endPoint,
+               uint16_t localPort,
+               Ipv4Address peerAddress,
+               uint16_t peerPort);
+
+    /**
+     * @brief Remove an endpoint from the index of its local port and peer.
+     * @param endPoint the end point
+     * @param localPort the local port of the end point
+     * @param peerAddress the peer address of the end point
+     * @param peerPort the peer port of the end point
+     */
+    void Unindex(Ipv4EndPoint* endPoint,
+                 uint16_t localPort,
+                 Ipv4Address peerAddress,
+                 uint16_t peerPort);
+
+    /**
+     * @brief Move an endpoint in the indexes after a change of its local port or peer.
+     *
+     * Invoked through the index change callback of the endpoint.
+     * @param endPoint the end point
+     * @param localPort the previous local port of the end point
+     * @param peerAddress the previous peer address of the end point
+     * @param peerPort the previous peer port of the end point
+     */
+    void NotifyIndexChange(Ipv4EndPoint* endPoint,
+                           uint16_t localPort,
+                           Ipv4Address peerAddress,
+                           uint16_t peerPort);
+
+    /**
+     * @brief Get the candidate endpoints for a packet.
+     * @param dport destination port
+     * @param saddr source address
+     * @param sport source port
+     * @return the endpoints with the given local port whose peer is either the
+     * given source or unspecified
+     */
+    std::vector<Ipv4EndPoint*> GetCandidates(uint16_t dport, Ipv4Address saddr, uint16_t sport);
+
+    /**
+     * @param localPort local port
+     * @param peerAddress peer address
+     * @param peerPort peer port
+     * @return the key of the connected endpoints index
+     */
+    static uint64_t GetKey(uint16_t localPort, Ipv4Address peerAddress, uint16_t peerPort);
+
     /**
      * @brief Allocate an ephemeral port.
      * @returns the ephemeral port
@@ -185,6 +255,27 @@ class Ipv4EndPointDemux
      * @brief A list of IPv4 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * @brief The position of the end points in the list.
+     */
+    std::unordered_map<Ipv4EndPoint*, EndPointsI> m_positions;
+
+    /**
+     * @brief The end points with a peer address and port, indexed by local
+     * port, peer address and peer port.
+     */
+    std::unordered_multimap<uint64_t, Ipv4EndPoint*> m_connected;
+
+    /**
+     * @brief The other end points, indexed by local port.
+     */
+    std::unordered_map<uint16_t, std::vector<Ipv4EndPoint*>> m_unconnected;
+
+    /**
+     * @brief The number of end points using each local port.
+     */
+    std::unordered_map<uint16_t, uint32_t> m_localPorts;
 };
 
 } // namespace ns3
@@ -78,8 +78,22 @@ void
 Ipv4EndPoint::SetPeer(Ipv4Address address, uint16_t port)
 {
     NS_LOG_FUNCTION(this << address << port);
+    Ipv4Address oldAddress = m_peerAddr;
+    uint16_t oldPort = m_peerPort;
     m_peerAddr = address;
     m_peerPort = port;
+    if (!m_indexChangeCallback.IsNull())
+    {
+        m_indexChangeCallback(this, m_localPort, oldAddress, oldPort);
+    }
+}
+
+void
+Ipv4EndPoint::SetIndexChangeCallback(
+    Callback<void, Ipv4EndPoint*, uint16_t, Ipv4Address, uint16_t> callback)
+{
+    NS_LOG_FUNCTION(this << &callback);
+    m_indexChangeCallback = callback;
 }
 
 void
@@ -85,6 +85,17 @@ class Ipv4EndPoint
      */
     void SetPeer(Ipv4Address address, uint16_t port);
 
+    /**
+     * @brief Set the callback invoked when the fields the endpoint is indexed by (i.e., the
+     * local port and the peer information) change.
+     *
+     * Used by the Ipv4EndPointDemux to keep its index of the endpoints up to date.
+     * @param callback callback function, taking the endpoint and its previous
+     * local port, peer address and peer port
+     */
+    void SetIndexChangeCallback(
+        Callback<void, Ipv4EndPoint*, uint16_t, Ipv4Address, uint16_t> callback);
+
     /**
      * @brief Bind a socket to specific device.
      *
@@ -220,6 +231,11 @@ class Ipv4EndPoint
      */
     Callback<void> m_destroyCallback;
 
+    /**
+     * @brief The index change callback.
+     */
+    Callback<void, Ipv4EndPoint*, uint16_t, Ipv4Address, uint16_t> m_indexChangeCallback;
+
     /**
      * @brief true if the endpoint can receive packets.
      */
@@ -10,7 +10,9 @@
 #include "ipv4-route.h"
 #include "ipv4-routing-table-entry.h"
 
+#include "ns3/abort.h"
 #include "ns3/boolean.h"
+#include "ns3/enum.h"
 #include "ns3/log.h"
 #include "ns3/names.h"
 #include "ns3/net-device.h"
@@ -18,8 +20,13 @@
 #include "ns3/object.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <iomanip>
+#include <numeric>
 #include <vector>
 
 namespace ns3
@@ -29,6 +36,43 @@ NS_LOG_COMPONENT_DEFINE("Ipv4GlobalRouting");
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv4GlobalRouting);
 
+/**
+ * @param address an IPv4 address
+ * @return the key of the address in the prefix trie
+ */
+static std::array<uint8_t, 4>
+TrieKey(Ipv4Address address)
+{
+    std::array<uint8_t, 4> key;
+    address.Serialize(key.data());
+    return key;
+}
+
+/**
+ * @param mask an IPv4 mask
+ * @return the length of the mask in the prefix trie, i.e., the number of its leading ones
+ */
+static uint8_t
+TrieLength(Ipv4Mask mask)
+{
+    return std::countl_one(mask.Get());
+}
+
+/**
+ * @param h a 64-bit value
+ * @return the value with its bits mixed (the finalizer of MurmurHash3)
+ */
+static uint64_t
+Mix64(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
 TypeId
 Ipv4GlobalRouting::GetTypeId()
 {
@@ -42,18 +86,58 @@ Ipv4GlobalRouting::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(&Ipv4GlobalRouting::m_randomEcmpRouting),
                           MakeBooleanChecker())
+            .AddAttribute("EcmpMode",
+                          "The selection of a route among several equal-cost routes. The "
+                          "Random mode is also used if RandomEcmpRouting is true.",
+                          EnumValue(Ipv4GlobalRouting::ECMP_NONE),
+                          MakeEnumAccessor<EcmpMode>(&Ipv4GlobalRouting::m_ecmpMode),
+                          MakeEnumChecker(Ipv4GlobalRouting::ECMP_NONE,
+                                          "None",
+                                          Ipv4GlobalRouting::ECMP_RANDOM,
+                                          "Random",
+                                          Ipv4GlobalRouting::ECMP_FLOW_HASH,
+                                          "FlowHash",
+                                          Ipv4GlobalRouting::ECMP_FLOWLET,
+                                          "Flowlet",
+                                          Ipv4GlobalRouting::ECMP_SPRAY,
+                                          "Spray"))
+            .AddAttribute("FlowletTimeout",
+                          "The maximum time between two packets of the same flowlet, "
+                          "if EcmpMode is Flowlet.",
+                          TimeValue(MicroSeconds(500)),
+                          MakeTimeAccessor(&Ipv4GlobalRouting::m_flowletTimeout),
+                          MakeTimeChecker())
+            .AddAttribute("EcmpHashSeed",
+                          "The seed of the five-tuple hash, if EcmpMode is FlowHash or "
+                          "Flowlet. The hash is also salted with the node ID, so that "
+                          "consecutive routers do not make correlated choices.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&Ipv4GlobalRouting::m_hashSeed),
+                          MakeUintegerChecker<uint32_t>())
             .AddAttribute("RespondToInterfaceEvents",
                           "Set to true if you want to dynamically recompute the global routes upon "
                           "Interface notification events (up/down, or add/remove address)",
                           BooleanValue(false),
                           MakeBooleanAccessor(&Ipv4GlobalRouting::m_respondToInterfaceEvents),
+                          MakeBooleanChecker())
+            .AddAttribute("IncrementalRouteUpdates",
+                          "Set to true if the global routes recomputed upon interface notification "
+                          "events should only be updated where the link state changed, rather than "
+                          "deleted and computed again. In this case, the routes that were removed "
+                          "or modified by other means are not necessarily restored.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&Ipv4GlobalRouting::m_incrementalRouteUpdates),
                           MakeBooleanChecker());
     return tid;
 }
 
 Ipv4GlobalRouting::Ipv4GlobalRouting()
     : m_randomEcmpRouting(false),
-      m_respondToInterfaceEvents(false)
+      m_respondToInterfaceEvents(false),
+      m_incrementalRouteUpdates(false),
+      m_ecmpMode(ECMP_NONE),
+      m_hashSeed(0),
+      m_flowletPurgeSize(1024)
 {
     NS_LOG_FUNCTION(this);
 
@@ -71,16 +155,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, Ipv4Address nextHop, uint32_
     NS_LOG_FUNCTION(this << dest << nextHop << interface);
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, nextHop, interface);
-    for (auto routePointer : m_hostRoutes)
-    {
-        if (*routePointer == *route)
-        {
-            NS_LOG_LOGIC("Route already exists");
-            delete route;
-            return;
-        }
-    }
-    m_hostRoutes.push_back(route);
+    InsertHostRoute(route);
 }
 
 void
@@ -89,16 +164,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, uint32_t interface)
     NS_LOG_FUNCTION(this << dest << interface);
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, interface);
-    for (auto routePointer : m_hostRoutes)
-    {
-        if (*routePointer == *route)
-        {
-            NS_LOG_LOGIC("Route already exists");
-            delete route;
-            return;
-        }
-    }
-    m_hostRoutes.push_back(route);
+    InsertHostRoute(route);
 }
 
 void
@@ -110,7 +176,28 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network,
     NS_LOG_FUNCTION(this << network << networkMask << nextHop << interface);
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
-    for (auto routePointer : m_networkRoutes)
+    InsertNetworkRoute(route);
+}
+
+void
+Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network, Ipv4Mask networkMask, uint32_t interface)
+{
+    NS_LOG_FUNCTION(this << network << networkMask << interface);
+    auto route = new Ipv4RoutingTableEntry();
+    *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
+    InsertNetworkRoute(route);
+}
+
+void
+Ipv4GlobalRouting::AddASExternalRouteTo(Ipv4Address network,
+                                        Ipv4Mask networkMask,
+                                        Ipv4Address nextHop,
+                                        uint32_t interface)
+{
+    NS_LOG_FUNCTION(this << network << networkMask << nextHop << interface);
+    auto route = new Ipv4RoutingTableEntry();
+    *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
+    for (auto routePointer : m_ASexternalRoutes)
     {
         if (*routePointer == *route)
         {
@@ -119,16 +206,14 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network,
             return;
         }
     }
-    m_networkRoutes.push_back(route);
+    m_ASexternalRoutes.push_back(route);
 }
 
 void
-Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network, Ipv4Mask networkMask, uint32_t interface)
+Ipv4GlobalRouting::InsertHostRoute(Ipv4RoutingTableEntry* route)
 {
-    NS_LOG_FUNCTION(this << network << networkMask << interface);
-    auto route = new Ipv4RoutingTableEntry();
-    *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
-    for (auto routePointer : m_networkRoutes)
+    auto& routes = m_hostIndex[route->GetDest().Get()];
+    for (auto routePointer : routes)
     {
         if (*routePointer == *route)
         {
@@ -137,19 +222,17 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network, Ipv4Mask networkMask,
             return;
         }
     }
-    m_networkRoutes.push_back(route);
+    routes.push_back(route);
+    m_hostRoutes.push_back(route);
+    InvalidateNextHopGroups();
 }
 
 void
-Ipv4GlobalRouting::AddASExternalRouteTo(Ipv4Address network,
-                                        Ipv4Mask networkMask,
-                                        Ipv4Address nextHop,
-                                        uint32_t interface)
+Ipv4GlobalRouting::InsertNetworkRoute(Ipv4RoutingTableEntry* route)
 {
-    NS_LOG_FUNCTION(this << network << networkMask << nextHop << interface);
-    auto route = new Ipv4RoutingTableEntry();
-    *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
-    for (auto routePointer : m_ASexternalRoutes)
+    auto& routes = m_networkTrie.Insert(TrieKey(route->GetDestNetwork()),
+                                        TrieLength(route->GetDestNetworkMask()));
+    for (auto routePointer : routes)
     {
         if (*routePointer == *route)
         {
@@ -158,80 +241,77 @@ Ipv4GlobalRouting::AddASExternalRouteTo(Ipv4Address network,
             return;
         }
     }
-    m_ASexternalRoutes.push_back(route);
+    routes.push_back(route);
+    m_networkRoutes.push_back(route);
+    InvalidateNextHopGroups();
 }
 
 Ptr<Ipv4Route>
-Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
+Ipv4GlobalRouting::LookupGlobal(const Ipv4Header& header, Ptr<const Packet> p, Ptr<NetDevice> oif)
 {
+    Ipv4Address dest = header.GetDestination();
     NS_LOG_FUNCTION(this << dest << oif);
     NS_LOG_LOGIC("Looking for route for destination " << dest);
     Ptr<Ipv4Route> rtentry = nullptr;
     // store all available routes that bring packets to their destination
-    typedef std::vector<Ipv4RoutingTableEntry*> RouteVec_t;
-    RouteVec_t allRoutes;
+    RouteVector allRoutes;
+    // the routes to the destination, if all of them are available
+    const RouteVector* candidates = nullptr;
 
     NS_LOG_LOGIC("Number of m_hostRoutes = " << m_hostRoutes.size());
-    for (auto i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i++)
+    if (auto hostRoutes = m_hostIndex.find(dest.Get()); hostRoutes != m_hostIndex.end())
     {
-        NS_ASSERT((*i)->IsHost());
-        if ((*i)->GetDest() == dest)
+        for (auto route : hostRoutes->second)
         {
-            if (oif)
+            NS_ASSERT(route->IsHost());
+            if (oif && oif != m_ipv4->GetNetDevice(route->GetInterface()))
             {
-                if (oif != m_ipv4->GetNetDevice((*i)->GetInterface()))
-                {
-                    NS_LOG_LOGIC("Not on requested interface, skipping");
-                    continue;
-                }
+                NS_LOG_LOGIC("Not on requested interface, skipping");
+                continue;
             }
-            allRoutes.push_back(*i);
-            NS_LOG_LOGIC(allRoutes.size() << "Found global host route" << *i);
+            allRoutes.push_back(route);
+            NS_LOG_LOGIC(allRoutes.size() << "Found global host route" << route);
+        }
+        if (!allRoutes.empty())
+        {
+            candidates = &hostRoutes->second;
         }
     }
     if (allRoutes.empty()) // if no host route is found
     {
         NS_LOG_LOGIC("Number of m_networkRoutes" << m_networkRoutes.size());
-        // store the length of the longest mask.
-        uint16_t longest_mask = 0;
-        for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
-        {
-            Ipv4Mask mask = (*j)->GetDestNetworkMask();
-            uint16_t masklen = mask.GetPrefixLength();
-
-            Ipv4Address entry = (*j)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
+        // visit the matching prefixes from the longest to the shortest, and
+        // stop at the first one having routes on the requested interface
+        m_networkTrie.LongestMatch(TrieKey(dest), [&](uint8_t, const RouteVector& routes) {
+            bool allMatch = true;
+            for (auto route : routes)
             {
-                if (oif)
-                {
-                    if (oif != m_ipv4->GetNetDevice((*j)->GetInterface()))
-                    {
-                        NS_LOG_LOGIC("Not on requested interface, skipping");
-                        continue;
-                    }
-                }
-                NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << *j);
-                if (masklen < longest_mask) // Not interested if got shorter mask
+                // the mask is checked in full, in case it is not contiguous
+                if (!route->GetDestNetworkMask().IsMatch(dest, route->GetDestNetwork()))
                 {
-                    NS_LOG_LOGIC("Previous match longer, skipping");
+                    allMatch = false;
                     continue;
                 }
-                else if (masklen == longest_mask)
-                {
-                    NS_LOG_LOGIC("Equal mask length, adding this to the list");
-                    allRoutes.push_back(*j);
-                }
-                else
+                if (oif && oif != m_ipv4->GetNetDevice(route->GetInterface()))
                 {
-                    NS_LOG_LOGIC("Longer mask length found, clearing the list and adding");
-                    allRoutes.clear();
-                    allRoutes.push_back(*j);
+                    NS_LOG_LOGIC("Not on requested interface, skipping");
+                    continue;
                 }
+                allRoutes.push_back(route);
+                NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << route);
             }
-        }
+            if (allRoutes.empty())
+            {
+                return false;
+            }
+            candidates = allMatch ? &routes : nullptr;
+            return true;
+        });
     }
     if (allRoutes.empty()) // consider external if no host/network found
     {
+        // the external routes are never cached in a next-hop group
+        candidates = nullptr;
         for (auto k = m_ASexternalRoutes.begin(); k != m_ASexternalRoutes.end(); k++)
         {
             Ipv4Mask mask = (*k)->GetDestNetworkMask();
@@ -254,19 +334,17 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     }
     if (!allRoutes.empty()) // if route(s) is found
     {
-        // pick up one of the routes uniformly at random if random
-        // ECMP routing is enabled, or always select the first route
-        // consistently if random ECMP routing is disabled
-        uint32_t selectIndex;
-        if (m_randomEcmpRouting)
-        {
-            selectIndex = m_rand->GetInteger(0, allRoutes.size() - 1);
-        }
-        else
+        Ipv4RoutingTableEntry* route = allRoutes.front();
+        // in the random mode, a random number is drawn at each lookup, even for a
+        // single route, so that the random stream does not depend on the routes
+        bool random = m_ecmpMode == ECMP_RANDOM || (m_ecmpMode == ECMP_NONE && m_randomEcmpRouting);
+        if (allRoutes.size() > 1 || random)
         {
-            selectIndex = 0;
+            // the next-hop group is only cached if its routes do not depend on
+            // the destination, i.e., if all the masks matched
+            NextHopGroup* group = candidates ? &GetNextHopGroup(*candidates, oif) : nullptr;
+            route = SelectRoute(allRoutes, group, header, p);
         }
-        Ipv4RoutingTableEntry* route = allRoutes.at(selectIndex);
         // create a Ipv4Route object from the selected routing table entry
         rtentry = Create<Ipv4Route>();
         rtentry->SetDestination(route->GetDest());
@@ -283,6 +361,164 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     }
 }
 
+Ipv4GlobalRouting::NextHopGroup&
+Ipv4GlobalRouting::GetNextHopGroup(const RouteVector& routes, Ptr<NetDevice> oif)
+{
+    auto [it, inserted] =
+        m_nextHopGroups.try_emplace({&routes, PeekPointer(oif)}, NextHopGroup{0, 0, 0});
+    if (!inserted)
+    {
+        return it->second;
+    }
+
+    RouteVector members;
+    std::vector<uint32_t> weights;
+    uint32_t divisor = 0;
+    for (auto route : routes)
+    {
+        if (oif && oif != m_ipv4->GetNetDevice(route->GetInterface()))
+        {
+            continue;
+        }
+        members.push_back(route);
+        weights.push_back(GetInterfaceWeight(route->GetInterface()));
+        divisor = std::gcd(divisor, weights.back());
+    }
+    auto& group = it->second;
+    group.offset = m_nextHops.size();
+    for (std::size_t i = 0; i < members.size(); i++)
+    {
+        m_nextHops.insert(m_nextHops.end(), weights[i] / divisor, members[i]);
+    }
+    group.size = m_nextHops.size() - group.offset;
+    NS_ASSERT_MSG(group.size > 0, "Next-hop group without any route");
+    NS_LOG_LOGIC("Next-hop group of " << members.size() << " routes and " << group.size
+                                      << " slots");
+    return group;
+}
+
+Ipv4RoutingTableEntry*
+Ipv4GlobalRouting::SelectRoute(const RouteVector& routes,
+                               NextHopGroup* group,
+                               const Ipv4Header& header,
+                               Ptr<const Packet> p)
+{
+    EcmpMode mode = m_ecmpMode;
+    if (mode == ECMP_NONE && m_randomEcmpRouting)
+    {
+        mode = ECMP_RANDOM;
+    }
+    if (mode == ECMP_NONE)
+    {
+        return routes.front();
+    }
+
+    // the weighted slots of the routes, from the next-hop group if any
+    RouteVector uncached;
+    Ipv4RoutingTableEntry* const* slots;
+    uint32_t nSlots;
+    if (group)
+    {
+        slots = m_nextHops.data() + group->offset;
+        nSlots = group->size;
+    }
+    else
+    {
+        for (auto route : routes)
+        {
+            uncached.insert(uncached.end(), GetInterfaceWeight(route->GetInterface()), route);
+        }
+        slots = uncached.data();
+        nSlots = uncached.size();
+    }
+
+    switch (mode)
+    {
+    case ECMP_RANDOM:
+        return slots[m_rand->GetInteger(0, nSlots - 1)];
+    case ECMP_FLOW_HASH:
+        // multiply-shift reduction of the upper bits of the hash
+        return slots[((GetFlowHash(header, p) >> 32) * nSlots) >> 32];
+    case ECMP_SPRAY:
+        if (group)
+        {
+            return slots[group->next++ % nSlots];
+        }
+        return slots[m_rand->GetInteger(0, nSlots - 1)];
+    case ECMP_FLOWLET: {
+        Time now = Simulator::Now();
+        auto& flowlet = m_flowlets[GetFlowHash(header, p)];
+        if (!flowlet.route || now - flowlet.lastSeen > m_flowletTimeout ||
+            std::find(slots, slots + nSlots, flowlet.route) == slots + nSlots)
+        {
+            flowlet.route = slots[m_rand->GetInteger(0, nSlots - 1)];
+            NS_LOG_LOGIC("New flowlet on route " << *flowlet.route);
+        }
+        flowlet.lastSeen = now;
+        auto route = flowlet.route;
+        if (m_flowlets.size() >= m_flowletPurgeSize)
+        {
+            std::erase_if(m_flowlets, [this, now](const auto& entry) {
+                return now - entry.second.lastSeen > m_flowletTimeout;
+            });
+            m_flowletPurgeSize = std::max<std::size_t>(1024, 2 * m_flowlets.size());
+        }
+        return route;
+    }
+    default:
+        return routes.front();
+    }
+}
+
+uint64_t
+Ipv4GlobalRouting::GetFlowHash(const Ipv4Header& header, Ptr<const Packet> p)
+{
+    if (!m_hashSalt)
+    {
+        Ptr<Node> node = m_ipv4->GetObject<Node>();
+        m_hashSalt = Mix64((uint64_t{m_hashSeed} << 32) | (node ? node->GetId() : 0));
+    }
+    uint8_t protocol = header.GetProtocol();
+    uint32_t ports = 0;
+    // the packets being forwarded start with their transport header, the ports
+    // of which are in the first four bytes for both TCP and UDP
+    if (p && (protocol == 6 || protocol == 17) && header.GetFragmentOffset() == 0 &&
+        p->GetSize() >= 4)
+    {
+        uint8_t buffer[4];
+        p->CopyData(buffer, 4);
+        ports = (uint32_t{buffer[0]} << 24) | (uint32_t{buffer[1]} << 16) |
+                (uint32_t{buffer[2]} << 8) | buffer[3];
+    }
+    uint64_t h = Mix64(*m_hashSalt ^ ((uint64_t{header.GetSource().Get()} << 32) |
+                                       header.GetDestination().Get()));
+    return Mix64(h ^ ((uint64_t{protocol} << 32) | ports));
+}
+
+void
+Ipv4GlobalRouting::InvalidateNextHopGroups()
+{
+    m_nextHops.clear();
+    m_nextHopGroups.clear();
+    m_flowlets.clear();
+}
+
+void
+Ipv4GlobalRouting::SetInterfaceWeight(uint32_t interface, uint32_t weight)
+{
+    NS_LOG_FUNCTION(this << interface << weight);
+    NS_ABORT_MSG_IF(weight == 0, "The weight of the routes must be at least one");
+    m_interfaceWeights[interface] = weight;
+    InvalidateNextHopGroups();
+}
+
+uint32_t
+Ipv4GlobalRouting::GetInterfaceWeight(uint32_t interface) const
+{
+    auto it = m_interfaceWeights.find(interface);
+    return (it != m_interfaceWeights.end()) ? it->second : 1;
+}
+
 uint32_t
 Ipv4GlobalRouting::GetNRoutes() const
 {
@@ -350,8 +586,15 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
             if (tmp == index)
             {
                 NS_LOG_LOGIC("Removing route " << index << "; size = " << m_hostRoutes.size());
+                auto routes = m_hostIndex.find((*i)->GetDest().Get());
+                std::erase(routes->second, *i);
+                if (routes->second.empty())
+                {
+                    m_hostIndex.erase(routes);
+                }
                 delete *i;
                 m_hostRoutes.erase(i);
+                InvalidateNextHopGroups();
                 NS_LOG_LOGIC("Done removing host route "
                              << index << "; host route remaining size = " << m_hostRoutes.size());
                 return;
@@ -366,8 +609,17 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
         if (tmp == index)
         {
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_networkRoutes.size());
+            auto key = TrieKey((*j)->GetDestNetwork());
+            auto length = TrieLength((*j)->GetDestNetworkMask());
+            auto routes = m_networkTrie.Find(key, length);
+            std::erase(*routes, *j);
+            if (routes->empty())
+            {
+                m_networkTrie.Erase(key, length);
+            }
             delete *j;
             m_networkRoutes.erase(j);
+            InvalidateNextHopGroups();
             NS_LOG_LOGIC("Done removing network route "
                          << index << "; network route remaining size = " << m_networkRoutes.size());
             return;
@@ -392,6 +644,22 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
     NS_ASSERT(false);
 }
 
+void
+Ipv4GlobalRouting::UpdateGlobalRoutes()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_incrementalRouteUpdates)
+    {
+        GlobalRouteManager::UpdateRoutingTables();
+    }
+    else
+    {
+        GlobalRouteManager::DeleteGlobalRoutes();
+        GlobalRouteManager::BuildGlobalRoutingDatabase();
+        GlobalRouteManager::InitializeRoutes();
+    }
+}
+
 int64_t
 Ipv4GlobalRouting::AssignStreams(int64_t stream)
 {
@@ -417,6 +685,9 @@ Ipv4GlobalRouting::DoDispose()
     {
         delete (*l);
     }
+    m_hostIndex.clear();
+    m_networkTrie.Clear();
+    InvalidateNextHopGroups();
 
     Ipv4RoutingProtocol::DoDispose();
 }
@@ -509,7 +780,8 @@ Ipv4GlobalRouting::RouteOutput(Ptr<Packet> p,
     // See if this is a unicast packet we have a route for.
     //
     NS_LOG_LOGIC("Unicast destination- looking up");
-    Ptr<Ipv4Route> rtentry = LookupGlobal(header.GetDestination(), oif);
+    // the transport header is not yet part of the packet, hence its ports are not hashed
+    Ptr<Ipv4Route> rtentry = LookupGlobal(header, nullptr, oif);
     if (rtentry)
     {
         sockerr = Socket::ERROR_NOTERROR;
@@ -564,7 +836,7 @@ Ipv4GlobalRouting::RouteInput(Ptr<const Packet> p,
     }
     // Next, try to find a route
     NS_LOG_LOGIC("Unicast destination- looking up global route");
-    Ptr<Ipv4Route> rtentry = LookupGlobal(header.GetDestination());
+    Ptr<Ipv4Route> rtentry = LookupGlobal(header, p);
     if (rtentry)
     {
         NS_LOG_LOGIC("Found unicast destination- calling unicast callback");
@@ -585,9 +857,7 @@ Ipv4GlobalRouting::NotifyInterfaceUp(uint32_t i)
     NS_LOG_FUNCTION(this << i);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        UpdateGlobalRoutes();
     }
 }
 
@@ -597,9 +867,7 @@ Ipv4GlobalRouting::NotifyInterfaceDown(uint32_t i)
     NS_LOG_FUNCTION(this << i);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        UpdateGlobalRoutes();
     }
 }
 
@@ -609,9 +877,7 @@ Ipv4GlobalRouting::NotifyAddAddress(uint32_t interface, Ipv4InterfaceAddress add
     NS_LOG_FUNCTION(this << interface << address);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        UpdateGlobalRoutes();
     }
 }
 
@@ -621,9 +887,7 @@ Ipv4GlobalRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
     NS_LOG_FUNCTION(this << interface << address);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        UpdateGlobalRoutes();
     }
 }
 
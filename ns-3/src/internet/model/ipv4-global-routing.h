@@ -10,13 +10,20 @@
 #include "ipv4-header.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
+#include "prefix-trie.h"
 
 #include "ns3/ipv4-address.h"
+#include "ns3/nstime.h"
 #include "ns3/ptr.h"
 #include "ns3/random-variable-stream.h"
 
 #include <list>
+#include <map>
+#include <optional>
 #include <stdint.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -54,6 +61,30 @@ class Node;
  *
  * This class deals with Ipv4 unicast routes only.
  *
+ * When several equal-cost routes lead to a destination, the route used by a
+ * packet is selected according to the EcmpMode attribute:
+ * - None: the first route is always used;
+ * - Random: a route is picked at random for each packet (also enabled by the
+ *   RandomEcmpRouting attribute);
+ * - FlowHash: the route is selected by a hash of the five-tuple of the
+ *   packet (source and destination addresses, protocol and, for the TCP and
+ *   UDP packets being forwarded, the ports), so all the packets of a flow
+ *   follow the same path;
+ * - Flowlet: a route is picked at random for each burst of packets of a
+ *   flow (flowlet), i.e., whenever a packet of the flow arrives more than
+ *   FlowletTimeout after the previous one;
+ * - Spray: the routes are used in turn, packet by packet.
+ *
+ * The routes can be weighted by their output interface (see
+ * SetInterfaceWeight ()), in which case a route of weight w is selected w
+ * times as often as a route of weight one. The next hops of each
+ * destination (the next-hop group) are expanded according to their weights
+ * once, at the first lookup after the routes or the weights changed, and
+ * all the groups are stored in a single array.
+ *
+ * The ports of the locally generated packets are not hashed, because the
+ * transport header is not yet part of the packet when its route is looked up.
+ *
  * @see Ipv4RoutingProtocol
  * @see GlobalRouteManager
  */
@@ -76,6 +107,16 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     Ipv4GlobalRouting();
     ~Ipv4GlobalRouting() override;
 
+    /// Selection of a route among several equal-cost routes
+    enum EcmpMode
+    {
+        ECMP_NONE,      //!< Use the first route
+        ECMP_RANDOM,    //!< Pick a route at random for each packet
+        ECMP_FLOW_HASH, //!< Select the route by a hash of the five-tuple of the packet
+        ECMP_FLOWLET,   //!< Pick a route at random for each flowlet
+        ECMP_SPRAY,     //!< Use the routes in turn, packet by packet
+    };
+
     // These methods inherited from base class
     Ptr<Ipv4Route> RouteOutput(Ptr<Packet> p,
                                const Ipv4Header& header,
@@ -210,6 +251,23 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      */
     void RemoveRoute(uint32_t i);
 
+    /**
+     * @brief Set the weight of the routes through an interface, for the
+     * selection of a route among several equal-cost routes.
+     *
+     * @param interface The network interface index.
+     * @param weight The weight of the routes (at least one, the default).
+     */
+    void SetInterfaceWeight(uint32_t interface, uint32_t weight);
+
+    /**
+     * @brief Get the weight of the routes through an interface.
+     *
+     * @param interface The network interface index.
+     * @return the weight of the routes
+     */
+    uint32_t GetInterfaceWeight(uint32_t interface) const;
+
     /**
      * Assign a fixed random variable stream number to the random variables
      * used by this model.  Return the number of streams (possibly zero) that
@@ -230,8 +288,17 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     /// Set to true if this interface should respond to interface events by globally recomputing
     /// routes
     bool m_respondToInterfaceEvents;
+    /// Set to true if the routes recomputed upon interface events are only updated where the link
+    /// state changed
+    bool m_incrementalRouteUpdates;
     /// A uniform random number generator for randomly routing packets among ECMP
     Ptr<UniformRandomVariable> m_rand;
+    /// Selection of a route among several equal-cost routes
+    EcmpMode m_ecmpMode;
+    /// The maximum time between two packets of the same flowlet
+    Time m_flowletTimeout;
+    /// The seed of the five-tuple hash
+    uint32_t m_hashSeed;
 
     /// container of Ipv4RoutingTableEntry (routes to hosts)
     typedef std::list<Ipv4RoutingTableEntry*> HostRoutes;
@@ -256,16 +323,103 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
 
     /**
      * @brief Lookup in the forwarding table for destination.
-     * @param dest destination address
+     * @param header the IPv4 header of the packet
+     * @param p the packet, starting with its transport header if it is being forwarded
      * @param oif output interface if any (put 0 otherwise)
      * @return Ipv4Route to route the packet to reach dest address
      */
-    Ptr<Ipv4Route> LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif = nullptr);
+    Ptr<Ipv4Route> LookupGlobal(const Ipv4Header& header,
+                                Ptr<const Packet> p,
+                                Ptr<NetDevice> oif = nullptr);
+
+    /**
+     * @brief Compute the hash of the five-tuple of a packet.
+     * @param header the IPv4 header of the packet
+     * @param p the packet, starting with its transport header if it is being forwarded
+     * @return the hash
+     */
+    uint64_t GetFlowHash(const Ipv4Header& header, Ptr<const Packet> p);
+
+    /**
+     * @brief Add a route to a host, unless it is already in the routing table.
+     * @param route the route (deleted if already in the routing table)
+     */
+    void InsertHostRoute(Ipv4RoutingTableEntry* route);
+
+    /**
+     * @brief Add a route to a network, unless it is already in the routing table.
+     * @param route the route (deleted if already in the routing table)
+     */
+    void InsertNetworkRoute(Ipv4RoutingTableEntry* route);
+
+    /// Routes to a destination, in the order of the routing table
+    typedef std::vector<Ipv4RoutingTableEntry*> RouteVector;
+
+    /// A next-hop group, i.e., the routes among which equal-cost routes are selected
+    struct NextHopGroup
+    {
+        uint32_t offset; //!< the index of the first slot of the group in m_nextHops
+        uint32_t size;   //!< the number of slots of the group
+        uint32_t next;   //!< the index of the next slot used by packet spraying
+    };
+
+    /**
+     * @brief Get the next-hop group of a set of equal-cost routes, creating it
+     * if it does not exist yet.
+     * @param routes the routes to a destination
+     * @param oif the output interface the routes are restricted to, if any
+     * @return the next-hop group
+     */
+    NextHopGroup& GetNextHopGroup(const RouteVector& routes, Ptr<NetDevice> oif);
+
+    /**
+     * @brief Select a route among several equal-cost routes.
+     * @param routes the routes (at least two)
+     * @param group the next-hop group of the routes, if any
+     * @param header the IPv4 header of the packet
+     * @param p the packet
+     * @return the selected route
+     */
+    Ipv4RoutingTableEntry* SelectRoute(const RouteVector& routes,
+                                       NextHopGroup* group,
+                                       const Ipv4Header& header,
+                                       Ptr<const Packet> p);
+
+    /// Discard the next-hop groups and the flowlets, after a change of the routes
+    void InvalidateNextHopGroups();
+
+    /// Recompute the global routes after an interface event
+    void UpdateGlobalRoutes();
+
+    /// State of a flowlet
+    struct Flowlet
+    {
+        Time lastSeen;                //!< the time the last packet of the flowlet was routed
+        Ipv4RoutingTableEntry* route; //!< the route of the flowlet
+    };
 
     HostRoutes m_hostRoutes;             //!< Routes to hosts
     NetworkRoutes m_networkRoutes;       //!< Routes to networks
     ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
 
+    /// Routes to hosts, indexed by destination address
+    std::unordered_map<uint32_t, RouteVector> m_hostIndex;
+    /// Routes to networks, indexed by destination prefix for the longest prefix match
+    PrefixTrie<4, RouteVector> m_networkTrie;
+
+    /// The weights of the routes, indexed by interface (1 if not set)
+    std::map<uint32_t, uint32_t> m_interfaceWeights;
+    /// The routes of all the next-hop groups, each route repeated as many times as its weight
+    std::vector<Ipv4RoutingTableEntry*> m_nextHops;
+    /// The next-hop groups, indexed by their routes and output interface
+    std::map<std::pair<const RouteVector*, const NetDevice*>, NextHopGroup> m_nextHopGroups;
+    /// The flowlets, indexed by the hash of their five-tuple
+    std::unordered_map<uint64_t, Flowlet> m_flowlets;
+    /// The number of flowlets above which the expired flowlets are removed
+    std::size_t m_flowletPurgeSize;
+    /// The salt of the five-tuple hash, derived from the seed and the node ID
+    std::optional<uint64_t> m_hashSalt;
+
     Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
 };
 
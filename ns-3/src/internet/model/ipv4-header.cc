@@ -42,11 +42,43 @@ Ipv4Header::EnableChecksum()
     m_calcChecksum = true;
 }
 
+void
+Ipv4Header::TrustChecksum()
+{
+    NS_LOG_FUNCTION(this);
+    m_trustChecksum = true;
+}
+
+void
+Ipv4Header::UpdateChecksum(uint16_t oldWord, uint16_t newWord)
+{
+    if (!m_checksumValid)
+    {
+        return;
+    }
+    // HC' = ~(~HC + ~m + m'), see RFC 1624, eqn. 3
+    uint32_t sum = static_cast<uint16_t>(~m_checksum) + static_cast<uint16_t>(~oldWord) + newWord;
+    while (sum >> 16)
+    {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    m_checksum = ~sum;
+}
+
+void
+Ipv4Header::UpdateTos(uint8_t tos)
+{
+    // the TOS is the second byte of the first 16 bit word, after version and IHL
+    UpdateChecksum(0x45 | (m_tos << 8), 0x45 | (tos << 8));
+    m_tos = tos;
+}
+
 void
 Ipv4Header::SetPayloadSize(uint16_t size)
 {
     NS_LOG_FUNCTION(this << size);
     m_payloadSize = size;
+    m_checksumValid = false;
 }
 
 uint16_t
@@ -68,29 +100,30 @@ Ipv4Header::SetIdentification(uint16_t identification)
 {
     NS_LOG_FUNCTION(this << identification);
     m_identification = identification;
+    m_checksumValid = false;
 }
 
 void
 Ipv4Header::SetTos(uint8_t tos)
 {
     NS_LOG_FUNCTION(this << static_cast<uint32_t>(tos));
-    m_tos = tos;
+    UpdateTos(tos);
 }
 
 void
 Ipv4Header::SetDscp(DscpType dscp)
 {
     NS_LOG_FUNCTION(this << dscp);
-    m_tos &= 0x3; // Clear out the DSCP part, retain 2 bits of ECN
-    m_tos |= (dscp << 2);
+    // Clear out the DSCP part, retain 2 bits of ECN
+    UpdateTos((m_tos & 0x3) | (dscp << 2));
 }
 
 void
 Ipv4Header::SetEcn(EcnType ecn)
 {
     NS_LOG_FUNCTION(this << ecn);
-    m_tos &= 0xFC; // Clear out the ECN part, retain 6 bits of DSCP
-    m_tos |= ecn;
+    // Clear out the ECN part, retain 6 bits of DSCP
+    UpdateTos((m_tos & 0xFC) | ecn);
 }
 
 Ipv4Header::DscpType
@@ -193,6 +226,7 @@ Ipv4Header::SetMoreFragments()
 {
     NS_LOG_FUNCTION(this);
     m_flags |= MORE_FRAGMENTS;
+    m_checksumValid = false;
 }
 
 void
@@ -200,6 +234,7 @@ Ipv4Header::SetLastFragment()
 {
     NS_LOG_FUNCTION(this);
     m_flags &= ~MORE_FRAGMENTS;
+    m_checksumValid = false;
 }
 
 bool
@@ -214,6 +249,7 @@ Ipv4Header::SetDontFragment()
 {
     NS_LOG_FUNCTION(this);
     m_flags |= DONT_FRAGMENT;
+    m_checksumValid = false;
 }
 
 void
@@ -221,6 +257,7 @@ Ipv4Header::SetMayFragment()
 {
     NS_LOG_FUNCTION(this);
     m_flags &= ~DONT_FRAGMENT;
+    m_checksumValid = false;
 }
 
 bool
@@ -237,6 +274,7 @@ Ipv4Header::SetFragmentOffset(uint16_t offsetBytes)
     // check if the user is trying to set an invalid offset
     NS_ABORT_MSG_IF((offsetBytes & 0x7), "offsetBytes must be multiple of 8 bytes");
     m_fragmentOffset = offsetBytes;
+    m_checksumValid = false;
 }
 
 uint16_t
@@ -256,6 +294,8 @@ void
 Ipv4Header::SetTtl(uint8_t ttl)
 {
     NS_LOG_FUNCTION(this << static_cast<uint32_t>(ttl));
+    // TTL and protocol form the fifth 16 bit word
+    UpdateChecksum(m_ttl | (m_protocol << 8), ttl | (m_protocol << 8));
     m_ttl = ttl;
 }
 
@@ -278,6 +318,7 @@ Ipv4Header::SetProtocol(uint8_t protocol)
 {
     NS_LOG_FUNCTION(this << static_cast<uint32_t>(protocol));
     m_protocol = protocol;
+    m_checksumValid = false;
 }
 
 void
@@ -285,6 +326,7 @@ Ipv4Header::SetSource(Ipv4Address source)
 {
     NS_LOG_FUNCTION(this << source);
     m_source = source;
+    m_checksumValid = false;
 }
 
 Ipv4Address
@@ -299,6 +341,7 @@ Ipv4Header::SetDestination(Ipv4Address dst)
 {
     NS_LOG_FUNCTION(this << dst);
     m_destination = dst;
+    m_checksumValid = false;
 }
 
 Ipv4Address
@@ -403,11 +446,12 @@ Ipv4Header::Serialize(Buffer::Iterator start) const
     i.WriteU8(frag);
     i.WriteU8(m_ttl);
     i.WriteU8(m_protocol);
-    i.WriteHtonU16(0);
+    // the checksum of a deserialized header is kept up to date by the setters
+    i.WriteU16((m_calcChecksum && m_checksumValid) ? m_checksum : 0);
     i.WriteHtonU32(m_source.Get());
     i.WriteHtonU32(m_destination.Get());
 
-    if (m_calcChecksum)
+    if (m_calcChecksum && !m_checksumValid)
     {
         i = start;
         uint16_t checksum = i.CalculateIpChecksum(20);
@@ -461,13 +505,25 @@ Ipv4Header::Deserialize(Buffer::Iterator start)
     m_destination.Set(i.ReadNtohU32());
     m_headerSize = headerSize;
 
+    m_checksumValid = false;
     if (m_calcChecksum)
     {
-        i = start;
-        uint16_t checksum = i.CalculateIpChecksum(headerSize);
-        NS_LOG_LOGIC("checksum=" << checksum);
-
-        m_goodChecksum = (checksum == 0);
+        if (m_trustChecksum)
+        {
+            // virtual checksum valid
+            m_goodChecksum = true;
+        }
+        else
+        {
+            i = start;
+            uint16_t checksum = i.CalculateIpChecksum(headerSize);
+            NS_LOG_LOGIC("checksum=" << checksum);
+
+            m_goodChecksum = (checksum == 0);
+        }
+        // the options and the reserved flag are not serialized again: the checksum
+        // must then be recomputed
+        m_checksumValid = m_goodChecksum && headerSize == 5 * 4 && !(flags & (1 << 7));
     }
     return GetSerializedSize();
 }
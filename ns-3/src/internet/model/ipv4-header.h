@@ -30,6 +30,13 @@ class Ipv4Header : public Header
      * @brief Enable checksum calculation for this header.
      */
     void EnableChecksum();
+    /**
+     * @brief Assume that the checksum is valid when deserializing this header,
+     * instead of verifying it ("virtual checksum valid").
+     *
+     * The checksum is only used if checksum calculation is enabled.
+     */
+    void TrustChecksum();
     /**
      * @param size the size of the payload in bytes
      */
@@ -238,7 +245,26 @@ class Ipv4Header : public Header
         MORE_FRAGMENTS = (1 << 1)
     };
 
-    bool m_calcChecksum; //!< true if the checksum must be calculated
+    /**
+     * @brief Update the checksum after a change of a 16 bit word of the header (RFC 1624)
+     *
+     * The words are in the byte order of Buffer::Iterator::ReadU16.
+     *
+     * @param oldWord the previous value of the word
+     * @param newWord the new value of the word
+     */
+    void UpdateChecksum(uint16_t oldWord, uint16_t newWord);
+
+    /**
+     * @brief Set the TOS byte, updating the checksum
+     * @param tos the TOS byte
+     */
+    void UpdateTos(uint8_t tos);
+
+    bool m_calcChecksum;         //!< true if the checksum must be calculated
+    bool m_trustChecksum{false}; //!< true if the checksum is assumed valid on deserialization
+    /// true if m_checksum is the checksum of the header, as deserialized and then updated
+    bool m_checksumValid{false};
 
     uint16_t m_payloadSize;    //!< payload size
     uint16_t m_identification; //!< identification
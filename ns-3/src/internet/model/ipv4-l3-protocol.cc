@@ -31,6 +31,8 @@
 #include "ns3/traffic-control-layer.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -586,6 +588,10 @@ Ipv4L3Protocol::Receive(Ptr<NetDevice> device,
     if (Node::ChecksumEnabled())
     {
         ipHeader.EnableChecksum();
+        if (!Node::ChecksumVerificationEnabled())
+        {
+            ipHeader.TrustChecksum();
+        }
     }
     packet->RemoveHeader(ipHeader);
 
@@ -604,7 +610,7 @@ Ipv4L3Protocol::Receive(Ptr<NetDevice> device,
 
     // the packet is valid, we update the ARP cache entry (if present)
     Ptr<ArpCache> arpCache = ipv4Interface->GetArpCache();
-    if (arpCache)
+    if (arpCache && !arpCache->IsStatic())
     {
         // case one, it's a a direct routing.
         ArpCache::Entry* entry = arpCache->Lookup(ipHeader.GetSource());
@@ -973,7 +979,7 @@ Ipv4L3Protocol::SendRealOut(Ptr<Ipv4Route> route, Ptr<Packet> packet, const Ipv4
         NS_LOG_LOGIC("Send to " << targetLabel << " " << target);
         if (packet->GetSize() + ipHeader.GetSerializedSize() > outInterface->GetDevice()->GetMtu())
         {
-            std::list<Ipv4PayloadHeaderPair> listFragments;
+            std::vector<Ipv4PayloadHeaderPair> listFragments;
             DoFragmentation(packet, ipHeader, outInterface->GetDevice()->GetMtu(), listFragments);
             for (auto it = listFragments.begin(); it != listFragments.end(); it++)
             {
@@ -1431,7 +1437,7 @@ void
 Ipv4L3Protocol::DoFragmentation(Ptr<Packet> packet,
                                 const Ipv4Header& ipv4Header,
                                 uint32_t outIfaceMtu,
-                                std::list<Ipv4PayloadHeaderPair>& listFragments)
+                                std::vector<Ipv4PayloadHeaderPair>& listFragments)
 {
     // BEWARE: here we do assume that the header options are not present.
     // a much more complex handling is necessary in case there are options.
@@ -1440,8 +1446,6 @@ Ipv4L3Protocol::DoFragmentation(Ptr<Packet> packet,
 
     NS_LOG_FUNCTION(this << *packet << outIfaceMtu << &listFragments);
 
-    Ptr<Packet> p = packet->Copy();
-
     NS_ASSERT_MSG((ipv4Header.GetSerializedSize() == 5 * 4),
                   "IPv4 fragmentation implementation only works without option headers.");
 
@@ -1458,11 +1462,15 @@ Ipv4L3Protocol::DoFragmentation(Ptr<Packet> packet,
 
     NS_LOG_LOGIC("Fragmenting - Target Size: " << fragmentSize);
 
+    // the fragments are slices of the packet, which is not modified
+    listFragments.reserve(listFragments.size() + (packet->GetSize() + fragmentSize - 1) /
+                                                     fragmentSize);
+
     do
     {
         Ipv4Header fragmentHeader = ipv4Header;
 
-        if (p->GetSize() > offset + fragmentSize)
+        if (packet->GetSize() > offset + fragmentSize)
         {
             moreFragment = true;
             currentFragmentablePartSize = fragmentSize;
@@ -1471,7 +1479,7 @@ Ipv4L3Protocol::DoFragmentation(Ptr<Packet> packet,
         else
         {
             moreFragment = false;
-            currentFragmentablePartSize = p->GetSize() - offset;
+            currentFragmentablePartSize = packet->GetSize() - offset;
             if (!isLastFragment)
             {
                 fragmentHeader.SetMoreFragments();
@@ -1483,7 +1491,7 @@ Ipv4L3Protocol::DoFragmentation(Ptr<Packet> packet,
         }
 
         NS_LOG_LOGIC("Fragment creation - " << offset << ", " << currentFragmentablePartSize);
-        Ptr<Packet> fragment = p->CreateFragment(offset, currentFragmentablePartSize);
+        Ptr<Packet> fragment = packet->CreateFragment(offset, currentFragmentablePartSize);
         NS_LOG_LOGIC("Fragment created - " << offset << ", " << fragment->GetSize());
 
         fragmentHeader.SetFragmentOffset(offset + originalOffset);
@@ -1497,11 +1505,6 @@ Ipv4L3Protocol::DoFragmentation(Ptr<Packet> packet,
         NS_LOG_LOGIC("Fragment check - " << fragmentHeader.GetFragmentOffset());
 
         NS_LOG_LOGIC("New fragment Header " << fragmentHeader);
-
-        std::ostringstream oss;
-        oss << fragmentHeader;
-        fragment->Print(oss);
-
         NS_LOG_LOGIC("New fragment " << *fragment);
 
         listFragments.emplace_back(fragment, fragmentHeader);
@@ -1522,7 +1525,6 @@ Ipv4L3Protocol::ProcessFragment(Ptr<Packet>& packet, Ipv4Header& ipHeader, uint3
         uint32_t(ipHeader.GetIdentification()) << 16 | uint32_t(ipHeader.GetProtocol());
     FragmentKey_t key;
     bool ret = false;
-    Ptr<Packet> p = packet->Copy();
 
     key.first = addressCombination;
     key.second = idProto;
@@ -1532,11 +1534,8 @@ Ipv4L3Protocol::ProcessFragment(Ptr<Packet>& packet, Ipv4Header& ipHeader, uint3
     auto it = m_fragments.find(key);
     if (it == m_fragments.end())
     {
-        fragments = Create<Fragments>();
-        m_fragments.insert(std::make_pair(key, fragments));
-
-        auto iter = SetTimeout(key, ipHeader, iif);
-        fragments->SetTimeoutIter(iter);
+        fragments = Create<Fragments>(ipHeader, iif, SetTimeout(key));
+        m_fragments.emplace(key, fragments);
     }
     else
     {
@@ -1546,12 +1545,12 @@ Ipv4L3Protocol::ProcessFragment(Ptr<Packet>& packet, Ipv4Header& ipHeader, uint3
     NS_LOG_LOGIC("Adding fragment - Size: " << packet->GetSize()
                                             << " - Offset: " << (ipHeader.GetFragmentOffset()));
 
-    fragments->AddFragment(p, ipHeader.GetFragmentOffset(), !ipHeader.IsLastFragment());
+    // the packet is a copy made by LocalDeliver, it is stored as is
+    fragments->AddFragment(packet, ipHeader.GetFragmentOffset(), !ipHeader.IsLastFragment());
 
     if (fragments->IsEntire())
     {
         packet = fragments->GetPacket();
-        m_timeoutEventList.erase(fragments->GetTimeoutIter());
         fragments = nullptr;
         m_fragments.erase(key);
         ret = true;
@@ -1560,10 +1559,62 @@ Ipv4L3Protocol::ProcessFragment(Ptr<Packet>& packet, Ipv4Header& ipHeader, uint3
     return ret;
 }
 
-Ipv4L3Protocol::Fragments::Fragments()
-    : m_moreFragment(false)
+size_t
+Ipv4L3Protocol::FragmentKeyHash::operator()(const FragmentKey_t& key) const
 {
-    NS_LOG_FUNCTION(this);
+    return std::hash<uint64_t>()(key.first) ^ (std::hash<uint32_t>()(key.second) << 1);
+}
+
+Ipv4L3Protocol::Fragments::Fragments(const Ipv4Header& ipHeader, uint32_t iif, uint64_t id)
+    : m_size(0),
+      m_ipHeader(ipHeader),
+      m_iif(iif),
+      m_id(id)
+{
+    NS_LOG_FUNCTION(this << ipHeader << iif << id);
+}
+
+void
+Ipv4L3Protocol::Fragments::SetBlocks(uint32_t first, uint32_t last)
+{
+    if (first >= last)
+    {
+        return;
+    }
+    if (m_blocks.size() * 64 < last)
+    {
+        m_blocks.resize((last + 63) / 64, 0);
+    }
+    // set the bits a word at a time
+    while (first < last)
+    {
+        uint32_t count = std::min(last - first, 64 - first % 64);
+        uint64_t mask = (count == 64 ? ~uint64_t(0) : ((uint64_t(1) << count) - 1))
+                        << (first % 64);
+        m_blocks[first / 64] |= mask;
+        first += count;
+    }
+}
+
+bool
+Ipv4L3Protocol::Fragments::HasBlocks(uint32_t first, uint32_t last) const
+{
+    if (m_blocks.size() * 64 < last)
+    {
+        return false;
+    }
+    while (first < last)
+    {
+        uint32_t count = std::min(last - first, 64 - first % 64);
+        uint64_t mask = (count == 64 ? ~uint64_t(0) : ((uint64_t(1) << count) - 1))
+                        << (first % 64);
+        if ((m_blocks[first / 64] & mask) != mask)
+        {
+            return false;
+        }
+        first += count;
+    }
+    return true;
 }
 
 void
@@ -1573,22 +1624,36 @@ Ipv4L3Protocol::Fragments::AddFragment(Ptr<Packet> fragment,
 {
     NS_LOG_FUNCTION(this << fragment << fragmentOffset << moreFragment);
 
-    std::list<std::pair<Ptr<Packet>, uint16_t>>::iterator it;
+    // The fragment offsets are multiples of 8 bytes, and so are the sizes of all
+    // the fragments but the last one. A block is received when it is entirely
+    // covered by a fragment, or by the last fragment for the last block.
+    uint32_t fragmentEnd = fragmentOffset + fragment->GetSize();
+    uint32_t first = fragmentOffset / 8;
+    uint32_t last = moreFragment ? fragmentEnd / 8 : (fragmentEnd + 7) / 8;
 
-    for (it = m_fragments.begin(); it != m_fragments.end(); it++)
+    if (first < last && HasBlocks(first, last))
     {
-        if (it->second > fragmentOffset)
+        NS_LOG_LOGIC("Duplicate fragment " << fragmentOffset << " - " << fragmentEnd);
+        if (!moreFragment)
         {
-            break;
+            m_size = fragmentEnd;
         }
+        return;
     }
 
-    if (it == m_fragments.end())
+    SetBlocks(first, last);
+    if (!moreFragment)
     {
-        m_moreFragment = moreFragment;
+        m_size = fragmentEnd;
     }
 
-    m_fragments.insert(it, std::pair<Ptr<Packet>, uint16_t>(fragment, fragmentOffset));
+    auto it = std::upper_bound(m_fragments.begin(),
+                               m_fragments.end(),
+                               fragmentOffset,
+                               [](uint16_t offset, const std::pair<Ptr<Packet>, uint16_t>& f) {
+                                   return offset < f.second;
+                               });
+    m_fragments.emplace(it, fragment, fragmentOffset);
 }
 
 bool
@@ -1596,29 +1661,7 @@ Ipv4L3Protocol::Fragments::IsEntire() const
 {
     NS_LOG_FUNCTION(this);
 
-    bool ret = !m_moreFragment && !m_fragments.empty();
-
-    if (ret)
-    {
-        uint16_t lastEndOffset = 0;
-
-        for (auto it = m_fragments.begin(); it != m_fragments.end(); it++)
-        {
-            // overlapping fragments do exist
-            NS_LOG_LOGIC("Checking overlaps " << lastEndOffset << " - " << it->second);
-
-            if (lastEndOffset < it->second)
-            {
-                ret = false;
-                break;
-            }
-            // fragments might overlap in strange ways
-            uint16_t fragmentEnd = it->first->GetSize() + it->second;
-            lastEndOffset = std::max(lastEndOffset, fragmentEnd);
-        }
-    }
-
-    return ret;
+    return m_size > 0 && HasBlocks(0, (m_size + 7) / 8);
 }
 
 Ptr<Packet>
@@ -1626,37 +1669,46 @@ Ipv4L3Protocol::Fragments::GetPacket() const
 {
     NS_LOG_FUNCTION(this);
 
-    auto it = m_fragments.begin();
-
-    Ptr<Packet> p = it->first->Copy();
-    uint16_t lastEndOffset = p->GetSize();
-    it++;
+    // Collect the pieces of the packet, then concatenate them pairwise, so that
+    // each byte is copied a logarithmic number of times instead of once per
+    // following fragment.
+    std::vector<Ptr<Packet>> pieces;
+    pieces.reserve(m_fragments.size());
+    uint32_t lastEndOffset = 0;
 
-    for (; it != m_fragments.end(); it++)
+    for (const auto& [fragment, offset] : m_fragments)
     {
-        if (lastEndOffset > it->second)
+        if (lastEndOffset > offset)
         {
             // The fragments are overlapping.
             // We do not overwrite the "old" with the "new" because we do not know when each
             // arrived. This is different from what Linux does. It is not possible to emulate a
             // fragmentation attack.
-            uint32_t newStart = lastEndOffset - it->second;
-            if (it->first->GetSize() > newStart)
+            uint32_t newStart = lastEndOffset - offset;
+            if (fragment->GetSize() > newStart)
             {
-                uint32_t newSize = it->first->GetSize() - newStart;
-                Ptr<Packet> tempFragment = it->first->CreateFragment(newStart, newSize);
-                p->AddAtEnd(tempFragment);
+                uint32_t newSize = fragment->GetSize() - newStart;
+                pieces.push_back(fragment->CreateFragment(newStart, newSize));
+                lastEndOffset += newSize;
             }
         }
         else
         {
-            NS_LOG_LOGIC("Adding: " << *(it->first));
-            p->AddAtEnd(it->first);
+            NS_LOG_LOGIC("Adding: " << *fragment);
+            pieces.push_back(fragment->Copy());
+            lastEndOffset += fragment->GetSize();
         }
-        lastEndOffset = p->GetSize();
     }
 
-    return p;
+    for (std::size_t step = 1; step < pieces.size(); step *= 2)
+    {
+        for (std::size_t i = 0; i + step < pieces.size(); i += 2 * step)
+        {
+            pieces[i]->AddAtEnd(pieces[i + step]);
+        }
+    }
+
+    return pieces.front();
 }
 
 Ptr<Packet>
@@ -1694,25 +1746,33 @@ Ipv4L3Protocol::Fragments::GetPartialPacket() const
     return p;
 }
 
-void
-Ipv4L3Protocol::Fragments::SetTimeoutIter(FragmentsTimeoutsListI_t iter)
+const Ipv4Header&
+Ipv4L3Protocol::Fragments::GetIpHeader() const
+{
+    return m_ipHeader;
+}
+
+uint32_t
+Ipv4L3Protocol::Fragments::GetInterface() const
 {
-    m_timeoutIter = iter;
+    return m_iif;
 }
 
-Ipv4L3Protocol::FragmentsTimeoutsListI_t
-Ipv4L3Protocol::Fragments::GetTimeoutIter()
+uint64_t
+Ipv4L3Protocol::Fragments::GetId() const
 {
-    return m_timeoutIter;
+    return m_id;
 }
 
 void
-Ipv4L3Protocol::HandleFragmentsTimeout(FragmentKey_t key, Ipv4Header& ipHeader, uint32_t iif)
+Ipv4L3Protocol::HandleFragmentsTimeout(FragmentKey_t key)
 {
-    NS_LOG_FUNCTION(this << &key << &ipHeader << iif);
+    NS_LOG_FUNCTION(this << &key);
 
     auto it = m_fragments.find(key);
     Ptr<Packet> packet = it->second->GetPartialPacket();
+    Ipv4Header ipHeader = it->second->GetIpHeader();
+    uint32_t iif = it->second->GetInterface();
 
     // if we have at least 8 bytes, we can send an ICMP.
     if (packet->GetSize() > 8)
@@ -1829,21 +1889,19 @@ Ipv4L3Protocol::RemoveDuplicates()
     }
 }
 
-Ipv4L3Protocol::FragmentsTimeoutsListI_t
-Ipv4L3Protocol::SetTimeout(FragmentKey_t key, Ipv4Header ipHeader, uint32_t iif)
+uint64_t
+Ipv4L3Protocol::SetTimeout(FragmentKey_t key)
 {
     Time now = Simulator::Now() + m_fragmentExpirationTimeout;
 
-    if (m_timeoutEventList.empty())
+    if (!m_timeoutEvent.IsPending())
     {
         m_timeoutEvent =
             Simulator::Schedule(m_fragmentExpirationTimeout, &Ipv4L3Protocol::HandleTimeout, this);
     }
-    m_timeoutEventList.emplace_back(now, key, ipHeader, iif);
-
-    auto iter = --m_timeoutEventList.end();
+    m_timeoutEventList.push_back({now, key, ++m_lastFragmentsId});
 
-    return iter;
+    return m_lastFragmentsId;
 }
 
 void
@@ -1851,11 +1909,15 @@ Ipv4L3Protocol::HandleTimeout()
 {
     Time now = Simulator::Now();
 
-    while (!m_timeoutEventList.empty() && std::get<0>(*m_timeoutEventList.begin()) == now)
+    while (!m_timeoutEventList.empty() && m_timeoutEventList.front().expiration <= now)
     {
-        HandleFragmentsTimeout(std::get<1>(*m_timeoutEventList.begin()),
-                               std::get<2>(*m_timeoutEventList.begin()),
-                               std::get<3>(*m_timeoutEventList.begin()));
+        const FragmentsTimeout& timeout = m_timeoutEventList.front();
+        // the packet may have been reassembled, and its key reused
+        auto it = m_fragments.find(timeout.key);
+        if (it != m_fragments.end() && it->second->GetId() == timeout.id)
+        {
+            HandleFragmentsTimeout(timeout.key);
+        }
         m_timeoutEventList.pop_front();
     }
 
@@ -1864,7 +1926,7 @@ Ipv4L3Protocol::HandleTimeout()
         return;
     }
 
-    Time difference = std::get<0>(*m_timeoutEventList.begin()) - now;
+    Time difference = m_timeoutEventList.front().expiration - now;
     m_timeoutEvent = Simulator::Schedule(difference, &Ipv4L3Protocol::HandleTimeout, this);
 }
 
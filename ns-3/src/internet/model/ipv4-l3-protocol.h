@@ -21,9 +21,11 @@
 #include "ns3/simulator.h"
 #include "ns3/traced-callback.h"
 
+#include <deque>
 #include <list>
 #include <map>
 #include <stdint.h>
+#include <unordered_map>
 #include <vector>
 
 class Ipv4L3ProtocolTestCase;
@@ -400,11 +402,14 @@ class Ipv4L3Protocol : public Ipv4
      * @param ipv4Header the IPv4 header
      * @param outIfaceMtu the MTU of the interface
      * @param listFragments the list of fragments
+     *
+     * The fragments are slices of the packet (Packet::CreateFragment), the
+     * payload of the packet is not copied.
      */
     void DoFragmentation(Ptr<Packet> packet,
                          const Ipv4Header& ipv4Header,
                          uint32_t outIfaceMtu,
-                         std::list<Ipv4PayloadHeaderPair>& listFragments);
+                         std::vector<Ipv4PayloadHeaderPair>& listFragments);
 
     /**
      * @brief Process a packet fragment
@@ -499,29 +504,48 @@ class Ipv4L3Protocol : public Ipv4
     /// Key identifying a fragmented packet
     typedef std::pair<uint64_t, uint32_t> FragmentKey_t;
 
+    /**
+     * @brief Hash function of the keys identifying the fragmented packets.
+     */
+    struct FragmentKeyHash
+    {
+        /**
+         * @param key the key
+         * @return the hash of the key
+         */
+        size_t operator()(const FragmentKey_t& key) const;
+    };
+
+    /**
+     * @brief The expiration of a fragmented packet.
+     *
+     * All the fragmented packets expire after the same FragmentExpirationTimeout,
+     * so the expirations are queued in the order the packets were started. The
+     * expirations of the packets reassembled meanwhile are not removed from the
+     * queue, they are discarded when they are reached.
+     */
+    struct FragmentsTimeout
+    {
+        Time expiration;   //!< expiration time
+        FragmentKey_t key; //!< key of the fragmented packet
+        uint64_t id;       //!< identifier of the fragmented packet
+    };
+
     /// Container for fragment timeouts.
-    typedef std::list<std::tuple<Time, FragmentKey_t, Ipv4Header, uint32_t>>
-        FragmentsTimeoutsList_t;
-    /// Container Iterator for fragment timeouts..
-    typedef std::list<std::tuple<Time, FragmentKey_t, Ipv4Header, uint32_t>>::iterator
-        FragmentsTimeoutsListI_t;
+    typedef std::deque<FragmentsTimeout> FragmentsTimeoutsList_t;
 
     /**
      * @brief Process the timeout for packet fragments
      * @param key representing the packet fragments
-     * @param ipHeader the IP header of the original packet
-     * @param iif Input Interface
      */
-    void HandleFragmentsTimeout(FragmentKey_t key, Ipv4Header& ipHeader, uint32_t iif);
+    void HandleFragmentsTimeout(FragmentKey_t key);
 
     /**
      * @brief Set a new timeout "event" for a fragmented packet
      * @param key the fragment identification
-     * @param ipHeader the IPv4 header of the fragmented packet
-     * @param iif input interface of the packet
-     * @return an iterator to the inserted "event"
+     * @return the identifier of the fragmented packet
      */
-    FragmentsTimeoutsListI_t SetTimeout(FragmentKey_t key, Ipv4Header ipHeader, uint32_t iif);
+    uint64_t SetTimeout(FragmentKey_t key);
 
     /**
      * @brief Handles a fragmented packet timeout
@@ -532,6 +556,8 @@ class Ipv4L3Protocol : public Ipv4
 
     EventId m_timeoutEvent; //!< Event for the next scheduled timeout
 
+    uint64_t m_lastFragmentsId{0}; //!< Identifier of the last fragmented packet started
+
     /**
      * @brief A Set of Fragment belonging to the same packet (src, dst, identification and proto)
      */
@@ -540,11 +566,17 @@ class Ipv4L3Protocol : public Ipv4
       public:
         /**
          * @brief Constructor.
+         * @param ipHeader the IPv4 header of the first fragment received
+         * @param iif the input interface of the first fragment received
+         * @param id the identifier of the fragmented packet
          */
-        Fragments();
+        Fragments(const Ipv4Header& ipHeader, uint32_t iif, uint64_t id);
 
         /**
          * @brief Add a fragment.
+         *
+         * A fragment whose data has already been received is discarded.
+         *
          * @param fragment the fragment
          * @param fragmentOffset the offset of the fragment
          * @param moreFragment the bit "More Fragment"
@@ -570,36 +602,72 @@ class Ipv4L3Protocol : public Ipv4
         Ptr<Packet> GetPartialPacket() const;
 
         /**
-         * @brief Set the Timeout iterator.
-         * @param iter The iterator.
+         * @brief Get the IPv4 header of the first fragment received.
+         * @returns The IPv4 header.
+         */
+        const Ipv4Header& GetIpHeader() const;
+
+        /**
+         * @brief Get the input interface of the first fragment received.
+         * @returns The input interface.
          */
-        void SetTimeoutIter(FragmentsTimeoutsListI_t iter);
+        uint32_t GetInterface() const;
 
         /**
-         * @brief Get the Timeout iterator.
-         * @returns The iterator.
+         * @brief Get the identifier of the fragmented packet.
+         * @returns The identifier.
          */
-        FragmentsTimeoutsListI_t GetTimeoutIter();
+        uint64_t GetId() const;
 
       private:
         /**
-         * @brief True if other fragments will be sent.
+         * @brief Mark the 8-byte blocks of the packet as received.
+         * @param first the first block
+         * @param last the block following the last block
+         */
+        void SetBlocks(uint32_t first, uint32_t last);
+
+        /**
+         * @brief Check if the 8-byte blocks of the packet have all been received.
+         * @param first the first block
+         * @param last the block following the last block
+         * @returns true if all the blocks have been received
+         */
+        bool HasBlocks(uint32_t first, uint32_t last) const;
+
+        /**
+         * @brief Size of the packet, zero until the last fragment is received.
+         */
+        uint32_t m_size;
+
+        /**
+         * @brief The current fragments, sorted by offset.
+         */
+        std::vector<std::pair<Ptr<Packet>, uint16_t>> m_fragments;
+
+        /**
+         * @brief Bitmap of the 8-byte blocks of the packet that have been received.
+         */
+        std::vector<uint64_t> m_blocks;
+
+        /**
+         * @brief IPv4 header of the first fragment received.
          */
-        bool m_moreFragment;
+        Ipv4Header m_ipHeader;
 
         /**
-         * @brief The current fragments.
+         * @brief Input interface of the first fragment received.
          */
-        std::list<std::pair<Ptr<Packet>, uint16_t>> m_fragments;
+        uint32_t m_iif;
 
         /**
-         * @brief Timeout iterator to "event" handler
+         * @brief Identifier of the fragmented packet.
          */
-        FragmentsTimeoutsListI_t m_timeoutIter;
+        uint64_t m_id;
     };
 
     /// Container of fragments, stored as pairs(src+dst addr, src+dst port) / fragment
-    typedef std::map<FragmentKey_t, Ptr<Fragments>> MapFragments_t;
+    typedef std::unordered_map<FragmentKey_t, Ptr<Fragments>, FragmentKeyHash> MapFragments_t;
 
     MapFragments_t m_fragments;       //!< Fragmented packets.
     Time m_fragmentExpirationTimeout; //!< Expiration timeout
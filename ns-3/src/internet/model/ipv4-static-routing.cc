@@ -25,6 +25,8 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
+#include <array>
+#include <bit>
 #include <iomanip>
 
 using std::make_pair;
@@ -36,6 +38,28 @@ NS_LOG_COMPONENT_DEFINE("Ipv4StaticRouting");
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv4StaticRouting);
 
+/**
+ * @param address an IPv4 address
+ * @return the key of the address in the prefix trie
+ */
+static std::array<uint8_t, 4>
+TrieKey(Ipv4Address address)
+{
+    std::array<uint8_t, 4> key;
+    address.Serialize(key.data());
+    return key;
+}
+
+/**
+ * @param mask an IPv4 mask
+ * @return the length of the mask in the prefix trie, i.e., the number of its leading ones
+ */
+static uint8_t
+TrieLength(Ipv4Mask mask)
+{
+    return std::countl_one(mask.Get());
+}
+
 TypeId
 Ipv4StaticRouting::GetTypeId()
 {
@@ -67,8 +91,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
 
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv4RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(new Ipv4RoutingTableEntry(route), metric);
     }
 }
 
@@ -84,9 +107,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
         Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv4RoutingTableEntry(route);
-
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(new Ipv4RoutingTableEntry(route), metric);
     }
 }
 
@@ -141,7 +162,7 @@ Ipv4StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv4Address network("224.0.0.0");
     Ipv4Mask networkMask("240.0.0.0");
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
-    m_networkRoutes.emplace_back(route, 0);
+    InsertNetworkRoute(route, 0);
 }
 
 uint32_t
@@ -213,14 +234,18 @@ Ipv4StaticRouting::RemoveMulticastRoute(uint32_t index)
 bool
 Ipv4StaticRouting::LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metric)
 {
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    auto routes = m_routeTrie.Find(TrieKey(route.GetDestNetwork()),
+                                   TrieLength(route.GetDestNetworkMask()));
+    if (!routes)
+    {
+        return false;
+    }
+    for (const auto& [rtentry, rtmetric] : *routes)
     {
-        Ipv4RoutingTableEntry* rtentry = j->first;
-
         if (rtentry->GetDest() == route.GetDest() &&
             rtentry->GetDestNetworkMask() == route.GetDestNetworkMask() &&
             rtentry->GetGateway() == route.GetGateway() &&
-            rtentry->GetInterface() == route.GetInterface() && j->second == metric)
+            rtentry->GetInterface() == route.GetInterface() && rtmetric == metric)
         {
             return true;
         }
@@ -228,13 +253,37 @@ Ipv4StaticRouting::LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metr
     return false;
 }
 
+void
+Ipv4StaticRouting::InsertNetworkRoute(Ipv4RoutingTableEntry* route, uint32_t metric)
+{
+    m_networkRoutes.emplace_back(route, metric);
+    m_routeTrie
+        .Insert(TrieKey(route->GetDestNetwork()), TrieLength(route->GetDestNetworkMask()))
+        .emplace_back(route, metric);
+}
+
+Ipv4StaticRouting::NetworkRoutesI
+Ipv4StaticRouting::EraseNetworkRoute(NetworkRoutesI it)
+{
+    auto route = it->first;
+    auto key = TrieKey(route->GetDestNetwork());
+    auto length = TrieLength(route->GetDestNetworkMask());
+    auto routes = m_routeTrie.Find(key, length);
+    NS_ASSERT(routes);
+    std::erase_if(*routes, [route](const auto& entry) { return entry.first == route; });
+    if (routes->empty())
+    {
+        m_routeTrie.Erase(key, length);
+    }
+    delete route;
+    return m_networkRoutes.erase(it);
+}
+
 Ptr<Ipv4Route>
 Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
 {
     NS_LOG_FUNCTION(this << dest << " " << oif);
     Ptr<Ipv4Route> rtentry = nullptr;
-    uint16_t longest_mask = 0;
-    uint32_t shortest_metric = 0xffffffff;
     /* when sending on local multicast, there have to be interface specified */
     if (dest.IsLocalMulticast())
     {
@@ -250,55 +299,50 @@ Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
         return rtentry;
     }
 
-    for (auto i = m_networkRoutes.begin(); i != m_networkRoutes.end(); i++)
-    {
-        Ipv4RoutingTableEntry* j = i->first;
-        uint32_t metric = i->second;
-        Ipv4Mask mask = (j)->GetDestNetworkMask();
-        uint16_t masklen = mask.GetPrefixLength();
-        Ipv4Address entry = (j)->GetDestNetwork();
-        NS_LOG_LOGIC("Searching for route to " << dest << ", checking against route to " << entry
-                                               << "/" << masklen);
-        if (mask.IsMatch(dest, entry))
+    // Visit the matching prefixes from the longest to the shortest. Among the
+    // routes to the longest prefix that are on the requested interface, select
+    // the one with the smallest metric (the last one added, in case of ties),
+    // or the first one added for host routes.
+    Ipv4RoutingTableEntry* route = nullptr;
+    m_routeTrie.LongestMatch(TrieKey(dest), [&](uint8_t masklen, const PrefixRoutes& routes) {
+        uint32_t shortest_metric = 0xffffffff;
+        for (const auto& [j, metric] : routes)
         {
-            NS_LOG_LOGIC("Found global network route " << j << ", mask length " << masklen
-                                                       << ", metric " << metric);
-            if (oif)
+            // the mask is checked in full, in case it is not contiguous
+            if (!j->GetDestNetworkMask().IsMatch(dest, j->GetDestNetwork()))
             {
-                if (oif != m_ipv4->GetNetDevice(j->GetInterface()))
-                {
-                    NS_LOG_LOGIC("Not on requested interface, skipping");
-                    continue;
-                }
-            }
-            if (masklen < longest_mask) // Not interested if got shorter mask
-            {
-                NS_LOG_LOGIC("Previous match longer, skipping");
                 continue;
             }
-            if (masklen > longest_mask) // Reset metric if longer masklen
+            NS_LOG_LOGIC("Found global network route " << j << ", mask length " << +masklen
+                                                       << ", metric " << metric);
+            if (oif && oif != m_ipv4->GetNetDevice(j->GetInterface()))
             {
-                shortest_metric = 0xffffffff;
+                NS_LOG_LOGIC("Not on requested interface, skipping");
+                continue;
             }
-            longest_mask = masklen;
             if (metric > shortest_metric)
             {
                 NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
                 continue;
             }
             shortest_metric = metric;
-            Ipv4RoutingTableEntry* route = (j);
-            uint32_t interfaceIdx = route->GetInterface();
-            rtentry = Create<Ipv4Route>();
-            rtentry->SetDestination(route->GetDest());
-            rtentry->SetSource(m_ipv4->SourceAddressSelection(interfaceIdx, route->GetDest()));
-            rtentry->SetGateway(route->GetGateway());
-            rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
+            route = j;
             if (masklen == 32)
             {
                 break;
             }
         }
+        return route != nullptr;
+    });
+
+    if (route)
+    {
+        uint32_t interfaceIdx = route->GetInterface();
+        rtentry = Create<Ipv4Route>();
+        rtentry->SetDestination(route->GetDest());
+        rtentry->SetSource(m_ipv4->SourceAddressSelection(interfaceIdx, route->GetDest()));
+        rtentry->SetGateway(route->GetGateway());
+        rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
     }
     if (rtentry)
     {
@@ -446,8 +490,7 @@ Ipv4StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
-            delete j->first;
-            m_networkRoutes.erase(j);
+            EraseNetworkRoute(j);
             return;
         }
         tmp++;
@@ -581,6 +624,7 @@ Ipv4StaticRouting::DoDispose()
     {
         delete (j->first);
     }
+    m_routeTrie.Clear();
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
     {
@@ -620,8 +664,7 @@ Ipv4StaticRouting::NotifyInterfaceDown(uint32_t i)
     {
         if (it->first->GetInterface() == i)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -665,8 +708,7 @@ Ipv4StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkMask() == networkMask)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -13,6 +13,7 @@
 #include "ipv4-header.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
+#include "prefix-trie.h"
 
 #include "ns3/ipv4-address.h"
 #include "ns3/ptr.h"
@@ -21,6 +22,7 @@
 #include <list>
 #include <stdint.h>
 #include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -370,6 +372,9 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
     /// Iterator for container for the multicast routes
     typedef std::list<Ipv4MulticastRoutingTableEntry*>::iterator MulticastRoutesI;
 
+    /// Routes to a destination prefix, with their metric, in the order of the routing table
+    typedef std::vector<std::pair<Ipv4RoutingTableEntry*, uint32_t>> PrefixRoutes;
+
     /**
      * @brief Checks if a route is already present in the forwarding table.
      * @param route route
@@ -378,6 +383,20 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     bool LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metric);
 
+    /**
+     * @brief Append a route to the forwarding table.
+     * @param route the route (ownership is transferred to the forwarding table)
+     * @param metric metric of route
+     */
+    void InsertNetworkRoute(Ipv4RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * @brief Remove and delete a route of the forwarding table.
+     * @param it the route
+     * @return an iterator to the next route
+     */
+    NetworkRoutesI EraseNetworkRoute(NetworkRoutesI it);
+
     /**
      * @brief Lookup in the forwarding table for destination.
      * @param dest destination address
@@ -400,6 +419,12 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * @brief the routes of the forwarding table, indexed by destination prefix
+     * for the longest prefix match.
+     */
+    PrefixTrie<4, PrefixRoutes> m_routeTrie;
+
     /**
      * @brief the forwarding table for multicast.
      */
@@ -12,6 +12,8 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -34,26 +36,27 @@ Ipv6EndPointDemux::~Ipv6EndPointDemux()
         delete endPoint;
     }
     m_endPoints.clear();
+    m_positions.clear();
+    m_connected.clear();
+    m_unconnected.clear();
+    m_localPorts.clear();
 }
 
 bool
 Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
 {
     NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_localPorts.contains(port);
 }
 
 bool
 Ipv6EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv6Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
+    if (!m_localPorts.contains(port))
+    {
+        return false;
+    }
     for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
     {
         if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
@@ -76,7 +79,7 @@ Ipv6EndPointDemux::Allocate()
         return nullptr;
     }
     auto endPoint = new Ipv6EndPoint(Ipv6Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -92,7 +95,7 @@ Ipv6EndPointDemux::Allocate(Ipv6Address address)
         return nullptr;
     }
     auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -115,7 +118,7 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv6Address address,
         return nullptr;
     }
     auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -128,11 +131,11 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << boundNetDevice << localAddress << localPort << peerAddress << peerPort);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    for (auto i : GetCandidates(localPort, peerAddress, peerPort))
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        if (i->GetLocalPort() == localPort && i->GetLocalAddress() == localAddress &&
+            i->GetPeerPort() == peerPort && i->GetPeerAddress() == peerAddress &&
+            (i->GetBoundNetDevice() == boundNetDevice || !i->GetBoundNetDevice()))
         {
             NS_LOG_WARN("Duplicated endpoint.");
             return nullptr;
@@ -140,7 +143,7 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
     }
     auto endPoint = new Ipv6EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
 
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
 
@@ -151,15 +154,117 @@ void
 Ipv6EndPointDemux::DeAllocate(Ipv6EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto position = m_positions.find(endPoint);
+    if (position == m_positions.end())
     {
-        if (*i == endPoint)
+        return;
+    }
+    Unindex(endPoint,
+            endPoint->GetLocalPort(),
+            endPoint->GetPeerAddress(),
+            endPoint->GetPeerPort());
+    if (auto port = m_localPorts.find(endPoint->GetLocalPort()); --port->second == 0)
+    {
+        m_localPorts.erase(port);
+    }
+    m_endPoints.erase(position->second);
+    m_positions.erase(position);
+    delete endPoint;
+}
+
+void
+Ipv6EndPointDemux::Insert(Ipv6EndPoint* endPoint)
+{
+    m_endPoints.push_back(endPoint);
+    m_positions[endPoint] = std::prev(m_endPoints.end());
+    m_localPorts[endPoint->GetLocalPort()]++;
+    Index(endPoint, endPoint->GetLocalPort(), endPoint->GetPeerAddress(), endPoint->GetPeerPort());
+    endPoint->SetIndexChangeCallback(MakeCallback(&Ipv6EndPointDemux::NotifyIndexChange, this));
+}
+
+size_t
+Ipv6EndPointDemux::KeyHash::operator()(const Key& key) const
+{
+    return Ipv6AddressHash()(key.peerAddress) ^
+           std::hash<uint32_t>()((uint32_t{key.localPort} << 16) | key.peerPort);
+}
+
+void
+Ipv6EndPointDemux::Index(Ipv6EndPoint* endPoint,
+                         uint16_t localPort,
+                         Ipv6Address peerAddress,
+                         uint16_t peerPort)
+{
+    if (peerPort != 0 && peerAddress != Ipv6Address::GetAny())
+    {
+        m_connected.emplace(Key{peerAddress, localPort, peerPort}, endPoint);
+    }
+    else
+    {
+        m_unconnected[localPort].push_back(endPoint);
+    }
+}
+
+void
+Ipv6EndPointDemux::Unindex(Ipv6EndPoint* endPoint,
+                           uint16_t localPort,
+                           Ipv6Address peerAddress,
+                           uint16_t peerPort)
+{
+    if (peerPort != 0 && peerAddress != Ipv6Address::GetAny())
+    {
+        auto [begin, end] = m_connected.equal_range(Key{peerAddress, localPort, peerPort});
+        auto it = std::find_if(begin, end, [endPoint](const auto& entry) {
+            return entry.second == endPoint;
+        });
+        NS_ASSERT(it != end);
+        m_connected.erase(it);
+    }
+    else
+    {
+        auto it = m_unconnected.find(localPort);
+        NS_ASSERT(it != m_unconnected.end());
+        std::erase(it->second, endPoint);
+        if (it->second.empty())
+        {
+            m_unconnected.erase(it);
+        }
+    }
+}
+
+void
+Ipv6EndPointDemux::NotifyIndexChange(Ipv6EndPoint* endPoint,
+                                     uint16_t localPort,
+                                     Ipv6Address peerAddress,
+                                     uint16_t peerPort)
+{
+    NS_LOG_FUNCTION(this << endPoint << localPort << peerAddress << peerPort);
+    Unindex(endPoint, localPort, peerAddress, peerPort);
+    if (localPort != endPoint->GetLocalPort())
+    {
+        if (auto port = m_localPorts.find(localPort); --port->second == 0)
         {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
+            m_localPorts.erase(port);
         }
+        m_localPorts[endPoint->GetLocalPort()]++;
     }
+    Index(endPoint, endPoint->GetLocalPort(), endPoint->GetPeerAddress(), endPoint->GetPeerPort());
+}
+
+std::vector<Ipv6EndPoint*>
+Ipv6EndPointDemux::GetCandidates(uint16_t dport, Ipv6Address saddr, uint16_t sport)
+{
+    std::vector<Ipv6EndPoint*> candidates;
+    auto [begin, end] = m_connected.equal_range(Key{saddr, dport, sport});
+    for (auto it = begin; it != end; it++)
+    {
+        candidates.push_back(it->second);
+    }
+    if (auto it = m_unconnected.find(dport); it != m_unconnected.end())
+    {
+        candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+    }
+    return candidates;
 }
 
 /*
@@ -182,10 +287,10 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
     EndPoints retval4; /* Exact match on all 4 */
 
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    // only the end points with the destination port and whose peer is either
+    // the source or unspecified can match
+    for (auto endP : GetCandidates(dport, saddr, sport))
     {
-        Ipv6EndPoint* endP = *i;
-
         NS_LOG_DEBUG("Looking at endpoint dport="
                      << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
                      << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
@@ -15,6 +15,8 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -25,6 +27,12 @@ class Ipv6EndPoint;
  * @ingroup ipv6
  *
  * @brief Demultiplexer for end points.
+ *
+ * The end points with a peer address and port (e.g., the established TCP
+ * connections) are indexed by local port, peer address and peer port, and
+ * the other end points (e.g., the listening ones) by local port, so that a
+ * lookup only considers the end points that can match the packet, however
+ * many connections the node has.
  */
 class Ipv6EndPointDemux
 {
@@ -150,6 +158,88 @@ class Ipv6EndPointDemux
     EndPoints GetEndPoints() const;
 
   private:
+    /**
+     * @brief Key of the index of the end points with a peer address and port.
+     */
+    struct Key
+    {
+        Ipv6Address peerAddress; //!< the peer address
+        uint16_t localPort;      //!< the local port
+        uint16_t peerPort;       //!< the peer port
+
+        /**
+         * @param other another key
+         * @return true if the keys are equal
+         */
+        bool operator==(const Key& other) const = default;
+    };
+
+    /**
+     * @brief Hash function of the keys of the index.
+     */
+    struct KeyHash
+    {
+        /**
+         * @param key the key
+         * @return the hash of the key
+         */
+        size_t operator()(const Key& key) const;
+    };
+
+    /**
+     * @brief Add an end point to the list and to the indexes.
+     * @param endPoint the end point to add
+     */
+    void Insert(Ipv6EndPoint* endPoint);
+
+    /**
+     * @brief Add an end point to the index of its local port and peer.
+     * @param endPoint the end point
+     * @param localPort the local port of the end point
+     * @param peerAddress the peer address of the end point
+     * @param peerPort the peer port of the end point
+     */
+    void Index(Ipv6EndPoint* endPoint,
+               uint16_t localPort,
+               Ipv6Address peerAddress,
+               uint16_t peerPort);
+
+    /**
+     * @brief Remove an end point from the index of its local port and peer.
+     * @param endPoint the end point
+     * @param localPort the local port of the end point
+     * @param peerAddress the peer address of the end point
+     * @param peerPort the peer port of the end point
+     */
+    void Unindex(Ipv6EndPoint* endPoint,
+                 uint16_t localPort,
+                 Ipv6Address peerAddress,
+                 uint16_t peerPort);
+
+    /**
+     * @brief Move an end point in the indexes after a change of its local port or peer.
+     *
+     * Invoked through the index change callback of the end point.
+     * @param endPoint the end point
+     * @param localPort the previous local port of the end point
+     * @param peerAddress the previous peer address of the end point
+     * @param peerPort the previous peer port of the end point
+     */
+    void NotifyIndexChange(Ipv6EndPoint* endPoint,
+                           uint16_t localPort,
+                           Ipv6Address peerAddress,
+                           uint16_t peerPort);
+
+    /**
+     * @brief Get the candidate end points for a packet.
+     * @param dport destination port
+     * @param saddr source address
+     * @param sport source port
+     * @return the end points with the given local port whose peer is either
+     * the given source or unspecified
+     */
+    std::vector<Ipv6EndPoint*> GetCandidates(uint16_t dport, Ipv6Address saddr, uint16_t sport);
+
     /**
      * @brief Allocate a ephemeral port.
      * @return a port
@@ -175,6 +265,27 @@ class Ipv6EndPointDemux
      * @brief A list of IPv6 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * @brief The position of the end points in the list.
+     */
+    std::unordered_map<Ipv6EndPoint*, EndPointsI> m_positions;
+
+    /**
+     * @brief The end points with a peer address and port, indexed by local
+     * port, peer address and peer port.
+     */
+    std::unordered_multimap<Key, Ipv6EndPoint*, KeyHash> m_connected;
+
+    /**
+     * @brief The other end points, indexed by local port.
+     */
+    std::unordered_map<uint16_t, std::vector<Ipv6EndPoint*>> m_unconnected;
+
+    /**
+     * @brief The number of end points using each local port.
+     */
+    std::unordered_map<uint16_t, uint32_t> m_localPorts;
 };
 
 } /* namespace ns3 */
@@ -58,7 +58,12 @@ Ipv6EndPoint::GetLocalPort() const
 void
 Ipv6EndPoint::SetLocalPort(uint16_t port)
 {
+    uint16_t oldPort = m_localPort;
     m_localPort = port;
+    if (!m_indexChangeCallback.IsNull())
+    {
+        m_indexChangeCallback(this, oldPort, m_peerAddr, m_peerPort);
+    }
 }
 
 Ipv6Address
@@ -88,8 +93,21 @@ Ipv6EndPoint::GetBoundNetDevice() const
 void
 Ipv6EndPoint::SetPeer(Ipv6Address addr, uint16_t port)
 {
+    Ipv6Address oldAddr = m_peerAddr;
+    uint16_t oldPort = m_peerPort;
     m_peerAddr = addr;
     m_peerPort = port;
+    if (!m_indexChangeCallback.IsNull())
+    {
+        m_indexChangeCallback(this, m_localPort, oldAddr, oldPort);
+    }
+}
+
+void
+Ipv6EndPoint::SetIndexChangeCallback(
+    Callback<void, Ipv6EndPoint*, uint16_t, Ipv6Address, uint16_t> callback)
+{
+    m_indexChangeCallback = callback;
 }
 
 void
@@ -91,6 +91,17 @@ class Ipv6EndPoint
      */
     void SetPeer(Ipv6Address addr, uint16_t port);
 
+    /**
+     * @brief Set the callback invoked when the fields the endpoint is indexed by (i.e., the
+     * local port and the peer information) change.
+     *
+     * Used by the Ipv6EndPointDemux to keep its index of the endpoints up to date.
+     * @param callback callback function, taking the endpoint and its previous
+     * local port, peer address and peer port
+     */
+    void SetIndexChangeCallback(
+        Callback<void, Ipv6EndPoint*, uint16_t, Ipv6Address, uint16_t> callback);
+
     /**
      * @brief Bind a socket to specific device.
      *
@@ -224,6 +235,11 @@ class Ipv6EndPoint
      */
     Callback<void> m_destroyCallback;
 
+    /**
+     * @brief The index change callback.
+     */
+    Callback<void, Ipv6EndPoint*, uint16_t, Ipv6Address, uint16_t> m_indexChangeCallback;
+
     /**
      * @brief true if the endpoint can receive packets.
      */
@@ -1027,7 +1027,7 @@ Ipv6L3Protocol::Receive(Ptr<NetDevice> device,
 
     // the packet is valid, we update the NDISC cache entry (if present)
     Ptr<NdiscCache> ndiscCache = ipv6Interface->GetNdiscCache();
-    if (ndiscCache)
+    if (ndiscCache && !ndiscCache->IsStatic())
     {
         // case one, it's a a direct routing.
         NdiscCache::Entry* entry = ndiscCache->Lookup(hdr.GetSource());
@@ -18,6 +18,7 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
+#include <array>
 #include <iomanip>
 
 namespace ns3
@@ -27,6 +28,45 @@ NS_LOG_COMPONENT_DEFINE("Ipv6StaticRouting");
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv6StaticRouting);
 
+/**
+ * @param address an IPv6 address
+ * @return the key of the address in the prefix trie
+ */
+static std::array<uint8_t, 16>
+TrieKey(Ipv6Address address)
+{
+    std::array<uint8_t, 16> key;
+    address.GetBytes(key.data());
+    return key;
+}
+
+/**
+ * @param prefix an IPv6 prefix
+ * @return the length of the prefix in the prefix trie, i.e., the number of
+ *         leading ones of the prefix mask
+ */
+static uint8_t
+TrieLength(Ipv6Prefix prefix)
+{
+    uint8_t bytes[16];
+    prefix.GetBytes(bytes);
+    uint8_t length = 0;
+    for (auto byte : bytes)
+    {
+        if (byte != 0xff)
+        {
+            while (byte & 0x80)
+            {
+                byte <<= 1;
+                length++;
+            }
+            break;
+        }
+        length += 8;
+    }
+    return length;
+}
+
 TypeId
 Ipv6StaticRouting::GetTypeId()
 {
@@ -170,8 +210,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
 
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -197,8 +236,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
                                                                               prefixToUse);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -214,8 +252,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
         Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkPrefix, interface);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -257,7 +294,7 @@ Ipv6StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv6Address network = Ipv6Address("ff00::"); /* RFC 3513 */
     Ipv6Prefix networkMask = Ipv6Prefix(8);
     *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
-    m_networkRoutes.emplace_back(route, 0);
+    InsertNetworkRoute(route, 0);
 }
 
 uint32_t
@@ -352,15 +389,19 @@ Ipv6StaticRouting::HasNetworkDest(Ipv6Address network, uint32_t interfaceIndex)
 bool
 Ipv6StaticRouting::LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metric)
 {
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    auto routes = m_routeTrie.Find(TrieKey(route.GetDestNetwork()),
+                                   TrieLength(route.GetDestNetworkPrefix()));
+    if (!routes)
+    {
+        return false;
+    }
+    for (const auto& [rtentry, rtmetric] : *routes)
     {
-        Ipv6RoutingTableEntry* rtentry = j->first;
-
         if (rtentry->GetDest() == route.GetDest() &&
             rtentry->GetDestNetworkPrefix() == route.GetDestNetworkPrefix() &&
             rtentry->GetGateway() == route.GetGateway() &&
             rtentry->GetInterface() == route.GetInterface() &&
-            rtentry->GetPrefixToUse() == route.GetPrefixToUse() && j->second == metric)
+            rtentry->GetPrefixToUse() == route.GetPrefixToUse() && rtmetric == metric)
         {
             return true;
         }
@@ -368,13 +409,37 @@ Ipv6StaticRouting::LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metr
     return false;
 }
 
+void
+Ipv6StaticRouting::InsertNetworkRoute(Ipv6RoutingTableEntry* route, uint32_t metric)
+{
+    m_networkRoutes.emplace_back(route, metric);
+    m_routeTrie
+        .Insert(TrieKey(route->GetDestNetwork()), TrieLength(route->GetDestNetworkPrefix()))
+        .emplace_back(route, metric);
+}
+
+Ipv6StaticRouting::NetworkRoutesI
+Ipv6StaticRouting::EraseNetworkRoute(NetworkRoutesI it)
+{
+    auto route = it->first;
+    auto key = TrieKey(route->GetDestNetwork());
+    auto length = TrieLength(route->GetDestNetworkPrefix());
+    auto routes = m_routeTrie.Find(key, length);
+    NS_ASSERT(routes);
+    std::erase_if(*routes, [route](const auto& entry) { return entry.first == route; });
+    if (routes->empty())
+    {
+        m_routeTrie.Erase(key, length);
+    }
+    delete route;
+    return m_networkRoutes.erase(it);
+}
+
 Ptr<Ipv6Route>
 Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
 {
     NS_LOG_FUNCTION(this << dst << interface);
     Ptr<Ipv6Route> rtentry = nullptr;
-    uint16_t longestMask = 0;
-    uint32_t shortestMetric = 0xffffffff;
 
     /* when sending on link-local multicast, there have to be interface specified */
     if (dst.IsLinkLocalMulticast())
@@ -391,70 +456,65 @@ Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
         return rtentry;
     }
 
-    for (auto it = m_networkRoutes.begin(); it != m_networkRoutes.end(); it++)
-    {
-        Ipv6RoutingTableEntry* j = it->first;
-        uint32_t metric = it->second;
-        Ipv6Prefix mask = j->GetDestNetworkPrefix();
-        uint16_t maskLen = mask.GetPrefixLength();
-        Ipv6Address entry = j->GetDestNetwork();
-
-        NS_LOG_LOGIC("Searching for route to " << dst << ", mask length " << maskLen << ", metric "
-                                               << metric);
-
-        if (mask.IsMatch(dst, entry))
+    // Visit the matching prefixes from the longest to the shortest. Among the
+    // routes to the longest prefix that are on the requested interface, select
+    // the one with the smallest metric (the last one added, in case of ties),
+    // or the first one added for host routes.
+    Ipv6RoutingTableEntry* route = nullptr;
+    m_routeTrie.LongestMatch(TrieKey(dst), [&](uint8_t, const PrefixRoutes& routes) {
+        uint32_t shortestMetric = 0xffffffff;
+        for (const auto& [j, metric] : routes)
         {
+            Ipv6Prefix mask = j->GetDestNetworkPrefix();
+            uint16_t maskLen = mask.GetPrefixLength();
+
+            if (!mask.IsMatch(dst, j->GetDestNetwork()))
+            {
+                continue;
+            }
             NS_LOG_LOGIC("Found global network route " << *j << ", mask length " << maskLen
                                                        << ", metric " << metric);
 
             /* if interface is given, check the route will output on this interface */
-            if (!interface || interface == m_ipv6->GetNetDevice(j->GetInterface()))
+            if (interface && interface != m_ipv6->GetNetDevice(j->GetInterface()))
             {
-                if (maskLen < longestMask)
-                {
-                    NS_LOG_LOGIC("Previous match longer, skipping");
-                    continue;
-                }
-
-                if (maskLen > longestMask)
-                {
-                    shortestMetric = 0xffffffff;
-                }
-
-                longestMask = maskLen;
-                if (metric > shortestMetric)
-                {
-                    NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
-                    continue;
-                }
-
-                shortestMetric = metric;
-                Ipv6RoutingTableEntry* route = j;
-                uint32_t interfaceIdx = route->GetInterface();
-                rtentry = Create<Ipv6Route>();
+                continue;
+            }
+            if (metric > shortestMetric)
+            {
+                NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
+                continue;
+            }
+            shortestMetric = metric;
+            route = j;
+            if (maskLen == 128)
+            {
+                break;
+            }
+        }
+        return route != nullptr;
+    });
 
-                if (route->GetGateway().IsAny() || !route->GetDest().IsAny())
-                {
-                    rtentry->SetSource(
-                        m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
-                }
-                else
-                {
-                    // Default route
-                    rtentry->SetSource(m_ipv6->SourceAddressSelection(
-                        interfaceIdx,
-                        route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
-                }
+    if (route)
+    {
+        uint32_t interfaceIdx = route->GetInterface();
+        rtentry = Create<Ipv6Route>();
 
-                rtentry->SetDestination(route->GetDest());
-                rtentry->SetGateway(route->GetGateway());
-                rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
-                if (maskLen == 128)
-                {
-                    break;
-                }
-            }
+        if (route->GetGateway().IsAny() || !route->GetDest().IsAny())
+        {
+            rtentry->SetSource(m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
         }
+        else
+        {
+            // Default route
+            rtentry->SetSource(m_ipv6->SourceAddressSelection(
+                interfaceIdx,
+                route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
+        }
+
+        rtentry->SetDestination(route->GetDest());
+        rtentry->SetGateway(route->GetGateway());
+        rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
     }
 
     if (rtentry)
@@ -475,6 +535,7 @@ Ipv6StaticRouting::DoDispose()
         delete j->first;
     }
     m_networkRoutes.clear();
+    m_routeTrie.Clear();
 
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
@@ -632,8 +693,7 @@ Ipv6StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
-            delete it->first;
-            m_networkRoutes.erase(it);
+            EraseNetworkRoute(it);
             return;
         }
         tmp++;
@@ -655,8 +715,7 @@ Ipv6StaticRouting::RemoveRoute(Ipv6Address network,
         if (network == rtentry->GetDest() && rtentry->GetInterface() == ifIndex &&
             rtentry->GetPrefixToUse() == prefixToUse)
         {
-            delete it->first;
-            m_networkRoutes.erase(it);
+            EraseNetworkRoute(it);
             return;
         }
     }
@@ -797,8 +856,7 @@ Ipv6StaticRouting::NotifyInterfaceDown(uint32_t i)
     {
         if (it->first->GetInterface() == i)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -835,8 +893,7 @@ Ipv6StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv6InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkPrefix() == networkMask)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -893,8 +950,7 @@ Ipv6StaticRouting::NotifyRemoveRoute(Ipv6Address dst,
 
             if (dst == entry && prefix == mask && rtentry->GetInterface() == interface)
             {
-                delete j->first;
-                j = m_networkRoutes.erase(j);
+                j = EraseNetworkRoute(j);
             }
             else
             {
@@ -12,12 +12,15 @@
 #include "ipv6-header.h"
 #include "ipv6-routing-protocol.h"
 #include "ipv6.h"
+#include "prefix-trie.h"
 
 #include "ns3/ipv6-address.h"
 #include "ns3/ptr.h"
 
 #include <list>
 #include <stdint.h>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -295,6 +298,9 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
     /// Iterator for container for the multicast routes
     typedef std::list<Ipv6MulticastRoutingTableEntry*>::iterator MulticastRoutesI;
 
+    /// Routes to a destination prefix, with their metric, in the order of the routing table
+    typedef std::vector<std::pair<Ipv6RoutingTableEntry*, uint32_t>> PrefixRoutes;
+
     /**
      * @brief Checks if a route is already present in the forwarding table.
      * @param route route
@@ -303,6 +309,20 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
      */
     bool LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metric);
 
+    /**
+     * @brief Append a route to the forwarding table.
+     * @param route the route (ownership is transferred to the forwarding table)
+     * @param metric metric of route
+     */
+    void InsertNetworkRoute(Ipv6RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * @brief Remove and delete a route of the forwarding table.
+     * @param it the route
+     * @return an iterator to the next route
+     */
+    NetworkRoutesI EraseNetworkRoute(NetworkRoutesI it);
+
     /**
      * @brief Lookup in the forwarding table for destination.
      * @param dest destination address
@@ -325,6 +345,12 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * @brief the routes of the forwarding table, indexed by destination prefix
+     * for the longest prefix match.
+     */
+    PrefixTrie<16, PrefixRoutes> m_routeTrie;
+
     /**
      * @brief the forwarding table for multicast.
      */
@@ -12,11 +12,15 @@
 #include "ipv6-interface.h"
 #include "ipv6-l3-protocol.h"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/names.h"
 #include "ns3/node.h"
+#include "ns3/simulator.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -34,11 +38,20 @@ NdiscCache::GetTypeId()
                                           "Size of the queue for packets pending an NA reply.",
                                           UintegerValue(DEFAULT_UNRES_QLEN),
                                           MakeUintegerAccessor(&NdiscCache::m_unresQlen),
-                                          MakeUintegerChecker<uint32_t>());
+                                          MakeUintegerChecker<uint32_t>())
+                            .AddAttribute("Static",
+                                          "If true, the destinations without an entry in the "
+                                          "cache are not resolved and the received packets do "
+                                          "not refresh the entries. This is intended for caches "
+                                          "populated beforehand, e.g., by NeighborCacheHelper.",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&NdiscCache::m_static),
+                                          MakeBooleanChecker());
     return tid;
 }
 
 NdiscCache::NdiscCache()
+    : m_lastNudTimerId(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -58,6 +71,8 @@ NdiscCache::DoDispose()
         delete iter.second; /* delete the pointer NdiscCache::Entry */
     }
     m_ndCache.clear();
+    m_nudTimeouts = {};
+    m_nudEvent.Cancel();
     m_device = nullptr;
     m_interface = nullptr;
     m_icmpv6 = nullptr;
@@ -94,9 +109,10 @@ NdiscCache::Lookup(Ipv6Address dst)
 {
     NS_LOG_FUNCTION(this << dst);
 
-    if (m_ndCache.find(dst) != m_ndCache.end())
+    auto it = m_ndCache.find(dst);
+    if (it != m_ndCache.end())
     {
-        NdiscCache::Entry* entry = m_ndCache[dst];
+        NdiscCache::Entry* entry = it->second;
         NS_LOG_LOGIC("Found an entry: " << *entry);
 
         return entry;
@@ -120,6 +136,9 @@ NdiscCache::LookupInverse(Address dst)
             entryList.push_back(entry);
         }
     }
+    entryList.sort([](const auto a, const auto b) {
+        return a->GetIpv6Address() < b->GetIpv6Address();
+    });
     return entryList;
 }
 
@@ -140,15 +159,12 @@ NdiscCache::Remove(NdiscCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    auto i = m_ndCache.find(entry->GetIpv6Address());
+    if (i != m_ndCache.end() && i->second == entry)
     {
-        if ((*i).second == entry)
-        {
-            m_ndCache.erase(i);
-            entry->ClearWaitingPacket();
-            delete entry;
-            return;
-        }
+        m_ndCache.erase(i);
+        entry->ClearWaitingPacket();
+        delete entry;
     }
 }
 
@@ -186,13 +202,93 @@ NdiscCache::GetUnresQlen()
     return m_unresQlen;
 }
 
+bool
+NdiscCache::IsStatic() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_static;
+}
+
+void
+NdiscCache::StartNudTimer(NdiscCache::Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    entry->m_nudTimerId = ++m_lastNudTimerId;
+    PushNudTimeout({entry->m_nudExpiration, entry->m_nudTimerId, entry->GetIpv6Address()});
+}
+
+void
+NdiscCache::PushNudTimeout(const NudTimeout& timeout)
+{
+    NS_LOG_FUNCTION(this << timeout.expiration << timeout.id << timeout.address);
+    bool earliest = m_nudTimeouts.empty() || m_nudTimeouts.top() > timeout;
+    m_nudTimeouts.push(timeout);
+    if (!m_nudEvent.IsPending() || earliest)
+    {
+        m_nudEvent.Cancel();
+        m_nudEvent = Simulator::Schedule(m_nudTimeouts.top().expiration - Simulator::Now(),
+                                         &NdiscCache::HandleNudTimeout,
+                                         this);
+    }
+}
+
+void
+NdiscCache::HandleNudTimeout()
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<NudTimeout> expired;
+    while (!m_nudTimeouts.empty() && m_nudTimeouts.top().expiration <= Simulator::Now())
+    {
+        expired.push_back(m_nudTimeouts.top());
+        m_nudTimeouts.pop();
+    }
+
+    for (const auto& timeout : expired)
+    {
+        // the entry may have been removed or its timer stopped or restarted
+        auto it = m_ndCache.find(timeout.address);
+        if (it == m_ndCache.end() || it->second->m_nudTimerId != timeout.id)
+        {
+            continue;
+        }
+        NdiscCache::Entry* entry = it->second;
+        if (entry->m_nudExpiration > Simulator::Now())
+        {
+            NS_LOG_LOGIC("NUD timer of " << timeout.address << " postponed to "
+                                         << entry->m_nudExpiration.As(Time::S));
+            PushNudTimeout({entry->m_nudExpiration, timeout.id, timeout.address});
+            continue;
+        }
+        entry->m_nudTimerId = 0;
+        (entry->*(entry->m_nudFunction))();
+    }
+
+    if (!m_nudEvent.IsPending() && !m_nudTimeouts.empty())
+    {
+        m_nudEvent = Simulator::Schedule(m_nudTimeouts.top().expiration - Simulator::Now(),
+                                         &NdiscCache::HandleNudTimeout,
+                                         this);
+    }
+}
+
 void
 NdiscCache::PrintNdiscCache(Ptr<OutputStreamWrapper> stream)
 {
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
+    // print the entries sorted by address
+    std::vector<CacheI> entries;
+    entries.reserve(m_ndCache.size());
     for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    {
+        entries.push_back(i);
+    }
+    std::sort(entries.begin(), entries.end(), [](const CacheI& a, const CacheI& b) {
+        return a->first < b->first;
+    });
+
+    for (const auto& i : entries)
     {
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
@@ -247,7 +343,8 @@ NdiscCache::Entry::Entry(NdiscCache* nd)
     : m_ndCache(nd),
       m_waiting(),
       m_router(false),
-      m_nudTimer(Timer::CANCEL_ON_DESTROY),
+      m_nudFunction(nullptr),
+      m_nudTimerId(0),
       m_lastReachabilityConfirmation(),
       m_nsRetransmit(0)
 {
@@ -465,19 +562,23 @@ NdiscCache::Entry::GetLastReachabilityConfirmation() const
     return m_lastReachabilityConfirmation;
 }
 
+void
+NdiscCache::Entry::StartNudTimer(Time delay, void (Entry::*function)())
+{
+    NS_LOG_FUNCTION(this << delay);
+    m_nudFunction = function;
+    m_nudDelay = delay;
+    m_nudExpiration = Simulator::Now() + delay;
+    m_ndCache->StartNudTimer(this);
+}
+
 void
 NdiscCache::Entry::StartReachableTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
     m_lastReachabilityConfirmation = Simulator::Now();
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionReachableTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetReachableTime());
-    m_nudTimer.Schedule();
+    StartNudTimer(m_ndCache->m_icmpv6->GetReachableTime(),
+                  &NdiscCache::Entry::FunctionReachableTimeout);
 }
 
 void
@@ -488,11 +589,12 @@ NdiscCache::Entry::UpdateReachableTimer()
     if (m_state == REACHABLE)
     {
         m_lastReachabilityConfirmation = Simulator::Now();
-        if (m_nudTimer.IsRunning())
+        // a running timer is not rescheduled, the cache postpones it when it expires
+        m_nudExpiration = Simulator::Now() + m_nudDelay;
+        if (m_nudTimerId == 0 && m_nudFunction)
         {
-            m_nudTimer.Cancel();
+            m_ndCache->StartNudTimer(this);
         }
-        m_nudTimer.Schedule();
     }
 }
 
@@ -500,49 +602,31 @@ void
 NdiscCache::Entry::StartProbeTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionProbeTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetRetransmissionTime());
-    m_nudTimer.Schedule();
+    StartNudTimer(m_ndCache->m_icmpv6->GetRetransmissionTime(),
+                  &NdiscCache::Entry::FunctionProbeTimeout);
 }
 
 void
 NdiscCache::Entry::StartDelayTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionDelayTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetDelayFirstProbe());
-    m_nudTimer.Schedule();
+    StartNudTimer(m_ndCache->m_icmpv6->GetDelayFirstProbe(),
+                  &NdiscCache::Entry::FunctionDelayTimeout);
 }
 
 void
 NdiscCache::Entry::StartRetransmitTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionRetransmitTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetRetransmissionTime());
-    m_nudTimer.Schedule();
+    StartNudTimer(m_ndCache->m_icmpv6->GetRetransmissionTime(),
+                  &NdiscCache::Entry::FunctionRetransmitTimeout);
 }
 
 void
 NdiscCache::Entry::StopNudTimer()
 {
     NS_LOG_FUNCTION(this);
-    m_nudTimer.Cancel();
+    m_nudTimerId = 0;
     m_nsRetransmit = 0;
 }
 
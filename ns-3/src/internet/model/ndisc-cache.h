@@ -15,11 +15,14 @@
 #include "ns3/output-stream-wrapper.h"
 #include "ns3/packet.h"
 #include "ns3/ptr.h"
-#include "ns3/timer.h"
+#include "ns3/simulator.h"
 
+#include <functional>
 #include <list>
-#include <map>
+#include <queue>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -147,6 +150,17 @@ class NdiscCache : public Object
      */
     void RemoveAutoGeneratedEntries();
 
+    /**
+     * @brief Check if the cache is static.
+     *
+     * A static cache only holds the entries it is given (e.g., by NeighborCacheHelper):
+     * the destinations without an entry are not resolved and the received packets
+     * do not refresh the entries.
+     *
+     * @return true if the cache is static
+     */
+    bool IsStatic() const;
+
     /**
      * @brief Pair of a packet and an Ipv4 header.
      */
@@ -159,6 +173,8 @@ class NdiscCache : public Object
      */
     class Entry
     {
+        friend class NdiscCache;
+
       public:
         /**
          * @brief Constructor.
@@ -406,6 +422,13 @@ class NdiscCache : public Object
         NdiscCache* m_ndCache;
 
       private:
+        /**
+         * @brief Start the NUD timer.
+         * @param delay the delay before the timer expires
+         * @param function the function called when the timer expires
+         */
+        void StartNudTimer(Time delay, void (Entry::*function)());
+
         /**
          * @brief The IPv6 address.
          */
@@ -427,9 +450,24 @@ class NdiscCache : public Object
         bool m_router;
 
         /**
-         * @brief Timer (used for NUD).
+         * @brief Function called when the NUD timer expires.
+         */
+        void (Entry::*m_nudFunction)();
+
+        /**
+         * @brief Delay of the NUD timer.
+         */
+        Time m_nudDelay;
+
+        /**
+         * @brief Expiration time of the NUD timer.
          */
-        Timer m_nudTimer;
+        Time m_nudExpiration;
+
+        /**
+         * @brief Identifier of the running NUD timer, zero if the timer is not running.
+         */
+        uint64_t m_nudTimerId;
 
         /**
          * @brief Last time we see a reachability confirmation.
@@ -451,11 +489,11 @@ class NdiscCache : public Object
     /**
      * @brief Neighbor Discovery Cache container
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*> Cache;
+    typedef std::unordered_map<Ipv6Address, NdiscCache::Entry*, Ipv6AddressHash> Cache;
     /**
      * @brief Neighbor Discovery Cache container iterator
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*>::iterator CacheI;
+    typedef Cache::iterator CacheI;
 
     /**
      * @brief A list of Entry.
@@ -463,6 +501,71 @@ class NdiscCache : public Object
     Cache m_ndCache;
 
   private:
+    /**
+     * @brief The expiration of the NUD timer of an entry.
+     */
+    struct NudTimeout
+    {
+        Time expiration;     //!< expiration time of the timer
+        uint64_t id;         //!< identifier of the timer
+        Ipv6Address address; //!< address of the entry
+
+        /**
+         * @brief Order the expirations by time, then by start of the timers.
+         * @param other the other expiration
+         * @return true if this expiration comes after the other one
+         */
+        bool operator>(const NudTimeout& other) const
+        {
+            return expiration > other.expiration ||
+                   (expiration == other.expiration && id > other.id);
+        }
+    };
+
+    /**
+     * @brief Start the NUD timer of an entry, at the expiration time stored in the entry.
+     * @param entry the entry
+     */
+    void StartNudTimer(NdiscCache::Entry* entry);
+
+    /**
+     * @brief Add an expiration to the NUD timers of the cache.
+     *
+     * A single event is scheduled for the cache, at the earliest expiration.
+     *
+     * @param timeout the expiration
+     */
+    void PushNudTimeout(const NudTimeout& timeout);
+
+    /**
+     * @brief Handle the NUD timers that have expired.
+     *
+     * The expirations of the stopped or restarted timers are discarded. The
+     * reachable timer is not rescheduled at each reachability confirmation, its
+     * expiration is postponed when it is found to have been confirmed meanwhile.
+     */
+    void HandleNudTimeout();
+
+    /**
+     * @brief The expirations of the NUD timers, earliest first.
+     */
+    std::priority_queue<NudTimeout, std::vector<NudTimeout>, std::greater<>> m_nudTimeouts;
+
+    /**
+     * @brief The event handling the earliest NUD timer expiration.
+     */
+    EventId m_nudEvent;
+
+    /**
+     * @brief Identifier of the last NUD timer started.
+     */
+    uint64_t m_lastNudTimerId;
+
+    /**
+     * @brief True if the destinations without an entry are not resolved.
+     */
+    bool m_static;
+
     /**
      * @brief The NetDevice.
      */
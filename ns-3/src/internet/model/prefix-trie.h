@@ -0,0 +1,414 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PREFIX_TRIE_H
+#define PREFIX_TRIE_H
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup internet
+ * @brief Path-compressed binary trie (Patricia trie) mapping address prefixes to values
+ *
+ * The trie stores a value for each of a set of prefixes (the first bits of a
+ * key, e.g., an IPv4 or IPv6 address) and supports the longest prefix match
+ * of a key in a number of steps bounded by the number of prefixes that
+ * match the key, independently of the total number of prefixes stored. Chains
+ * of nodes with a single child are collapsed, hence the trie has at most two
+ * nodes per stored prefix. Nodes are kept in a single array and addressed by
+ * index, and the nodes of removed prefixes are recycled.
+ *
+ * Prefixes are inserted and removed incrementally, so that the trie can be
+ * kept in sync with a routing table as routes are added and removed.
+ *
+ * @tparam Bytes the size of the keys, in bytes (4 for IPv4, 16 for IPv6)
+ * @tparam T the type of the values (must be default constructible)
+ */
+template <std::size_t Bytes, typename T>
+class PrefixTrie
+{
+  public:
+    /// The key type (in network byte order)
+    using Key = std::array<uint8_t, Bytes>;
+
+    /// The maximum length of a prefix, in bits
+    static constexpr uint8_t MAX_LENGTH = Bytes * 8;
+
+    PrefixTrie();
+
+    /// Remove all the prefixes
+    void Clear();
+
+    /// @return the number of stored prefixes
+    std::size_t Size() const;
+
+    /**
+     * Get the value associated with a prefix, inserting the prefix with a
+     * default-constructed value if it is not stored yet.
+     * @param key the key (the bits after the prefix length are ignored)
+     * @param length the prefix length, in bits
+     * @return a reference to the value (invalidated by subsequent insertions)
+     */
+    T& Insert(const Key& key, uint8_t length);
+
+    /**
+     * @param key the key (the bits after the prefix length are ignored)
+     * @param length the prefix length, in bits
+     * @return a pointer to the value associated with the prefix, or nullptr if not stored
+     */
+    T* Find(const Key& key, uint8_t length);
+
+    /**
+     * Remove a prefix.
+     * @param key the key (the bits after the prefix length are ignored)
+     * @param length the prefix length, in bits
+     * @return true if the prefix was stored
+     */
+    bool Erase(const Key& key, uint8_t length);
+
+    /**
+     * Visit the values of the stored prefixes that match the given key, from
+     * the longest to the shortest prefix, until the visitor returns true.
+     * @tparam F the type of the visitor, taking (uint8_t length, T& value) as arguments
+     * @param key the key
+     * @param f the visitor
+     * @return true if the visitor returned true
+     */
+    template <typename F>
+    bool LongestMatch(const Key& key, F f);
+
+  private:
+    /// Index of a missing node
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    /// A node of the trie
+    struct Node
+    {
+        Key prefix{};                  //!< the prefix (bits after length are zero)
+        uint8_t length{0};             //!< the prefix length, in bits
+        bool hasValue{false};          //!< whether the prefix is stored
+        uint32_t child[2]{NONE, NONE}; //!< the children, indexed by the next bit
+        T value{};                     //!< the value
+    };
+
+    /**
+     * @param key the key
+     * @param bit the index of a bit (zero is the most significant bit)
+     * @return the value of the bit
+     */
+    static uint8_t GetBit(const Key& key, uint8_t bit);
+
+    /**
+     * @param key the key
+     * @param length the prefix length, in bits
+     * @return the key with all the bits after the prefix length set to zero
+     */
+    static Key Mask(const Key& key, uint8_t length);
+
+    /**
+     * @param a a key
+     * @param b another key
+     * @param max the maximum length to consider, in bits
+     * @return the length of the longest common prefix of the two keys, up to max
+     */
+    static uint8_t CommonLength(const Key& a, const Key& b, uint8_t max);
+
+    /**
+     * Allocate a new node.
+     * @param key the key
+     * @param length the prefix length
+     * @return the index of the node
+     */
+    uint32_t NewNode(const Key& key, uint8_t length);
+
+    /**
+     * Find the node of a prefix.
+     * @param key the key
+     * @param length the prefix length
+     * @param parent set to the index of the parent of the node (NONE for the root)
+     * @return the index of the node, or NONE if there is no such node
+     */
+    uint32_t FindNode(const Key& key, uint8_t length, uint32_t& parent) const;
+
+    std::vector<Node> m_nodes;     //!< the nodes, the first one being the root
+    std::vector<uint32_t> m_free;  //!< the indices of the recycled nodes
+    std::size_t m_size{0};         //!< the number of stored prefixes
+};
+
+/***************************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************************/
+
+template <std::size_t Bytes, typename T>
+PrefixTrie<Bytes, T>::PrefixTrie()
+{
+    Clear();
+}
+
+template <std::size_t Bytes, typename T>
+void
+PrefixTrie<Bytes, T>::Clear()
+{
+    m_nodes.assign(1, Node{});
+    m_free.clear();
+    m_size = 0;
+}
+
+template <std::size_t Bytes, typename T>
+std::size_t
+PrefixTrie<Bytes, T>::Size() const
+{
+    return m_size;
+}
+
+template <std::size_t Bytes, typename T>
+uint8_t
+PrefixTrie<Bytes, T>::GetBit(const Key& key, uint8_t bit)
+{
+    return (key[bit / 8] >> (7 - bit % 8)) & 1;
+}
+
+template <std::size_t Bytes, typename T>
+typename PrefixTrie<Bytes, T>::Key
+PrefixTrie<Bytes, T>::Mask(const Key& key, uint8_t length)
+{
+    Key masked{};
+    for (std::size_t i = 0; i < Bytes && length > 0; i++)
+    {
+        if (length >= 8)
+        {
+            masked[i] = key[i];
+            length -= 8;
+        }
+        else
+        {
+            masked[i] = key[i] & static_cast<uint8_t>(0xff << (8 - length));
+            length = 0;
+        }
+    }
+    return masked;
+}
+
+template <std::size_t Bytes, typename T>
+uint8_t
+PrefixTrie<Bytes, T>::CommonLength(const Key& a, const Key& b, uint8_t max)
+{
+    uint8_t length = 0;
+    for (std::size_t i = 0; i < Bytes && length < max; i++)
+    {
+        uint8_t diff = a[i] ^ b[i];
+        if (diff != 0)
+        {
+            while ((diff & 0x80) == 0)
+            {
+                diff <<= 1;
+                length++;
+            }
+            break;
+        }
+        length += 8;
+    }
+    return length < max ? length : max;
+}
+
+template <std::size_t Bytes, typename T>
+uint32_t
+PrefixTrie<Bytes, T>::NewNode(const Key& key, uint8_t length)
+{
+    Node node;
+    node.prefix = Mask(key, length);
+    node.length = length;
+    if (!m_free.empty())
+    {
+        auto index = m_free.back();
+        m_free.pop_back();
+        m_nodes[index] = std::move(node);
+        return index;
+    }
+    m_nodes.push_back(std::move(node));
+    return m_nodes.size() - 1;
+}
+
+template <std::size_t Bytes, typename T>
+T&
+PrefixTrie<Bytes, T>::Insert(const Key& key, uint8_t length)
+{
+    NS_ASSERT(length <= MAX_LENGTH);
+
+    uint32_t target = NONE;
+    uint32_t current = 0;
+    while (target == NONE)
+    {
+        if (m_nodes[current].length == length)
+        {
+            target = current;
+            break;
+        }
+        auto bit = GetBit(key, m_nodes[current].length);
+        auto next = m_nodes[current].child[bit];
+        if (next == NONE)
+        {
+            target = NewNode(key, length);
+            m_nodes[current].child[bit] = target;
+            break;
+        }
+        auto common =
+            CommonLength(key, m_nodes[next].prefix, std::min(length, m_nodes[next].length));
+        if (common == m_nodes[next].length)
+        {
+            // the prefix of the child is a prefix of the key
+            current = next;
+            continue;
+        }
+        target = NewNode(key, length);
+        if (common == length)
+        {
+            // the new prefix is a prefix of the child
+            m_nodes[target].child[GetBit(m_nodes[next].prefix, length)] = next;
+            m_nodes[current].child[bit] = target;
+        }
+        else
+        {
+            // the new prefix and the child diverge after their common prefix
+            auto branch = NewNode(key, common);
+            m_nodes[branch].child[GetBit(key, common)] = target;
+            m_nodes[branch].child[GetBit(m_nodes[next].prefix, common)] = next;
+            m_nodes[current].child[bit] = branch;
+        }
+    }
+
+    auto& node = m_nodes[target];
+    if (!node.hasValue)
+    {
+        node.hasValue = true;
+        node.value = T{};
+        m_size++;
+    }
+    return node.value;
+}
+
+template <std::size_t Bytes, typename T>
+uint32_t
+PrefixTrie<Bytes, T>::FindNode(const Key& key, uint8_t length, uint32_t& parent) const
+{
+    parent = NONE;
+    uint32_t current = 0;
+    while (current != NONE)
+    {
+        const auto& node = m_nodes[current];
+        if (node.length > length || CommonLength(key, node.prefix, node.length) < node.length)
+        {
+            return NONE;
+        }
+        if (node.length == length)
+        {
+            return current;
+        }
+        parent = current;
+        current = node.child[GetBit(key, node.length)];
+    }
+    return NONE;
+}
+
+template <std::size_t Bytes, typename T>
+T*
+PrefixTrie<Bytes, T>::Find(const Key& key, uint8_t length)
+{
+    uint32_t parent;
+    auto index = FindNode(key, length, parent);
+    if (index == NONE || !m_nodes[index].hasValue)
+    {
+        return nullptr;
+    }
+    return &m_nodes[index].value;
+}
+
+template <std::size_t Bytes, typename T>
+bool
+PrefixTrie<Bytes, T>::Erase(const Key& key, uint8_t length)
+{
+    uint32_t parent;
+    auto index = FindNode(key, length, parent);
+    if (index == NONE || !m_nodes[index].hasValue)
+    {
+        return false;
+    }
+    m_nodes[index].hasValue = false;
+    m_nodes[index].value = T{};
+    m_size--;
+
+    // remove the nodes that are no longer needed, i.e., the nodes with no value
+    // and less than two children (except the root)
+    while (index != 0 && !m_nodes[index].hasValue)
+    {
+        auto& node = m_nodes[index];
+        if (node.child[0] != NONE && node.child[1] != NONE)
+        {
+            break;
+        }
+        auto child = (node.child[0] != NONE) ? node.child[0] : node.child[1];
+        auto& parentNode = m_nodes[parent];
+        parentNode.child[parentNode.child[0] == index ? 0 : 1] = child;
+        node = Node{};
+        m_free.push_back(index);
+        if (child != NONE)
+        {
+            break;
+        }
+        // the parent may now have a single child
+        index = parent;
+        FindNode(m_nodes[index].prefix, m_nodes[index].length, parent);
+    }
+    return true;
+}
+
+template <std::size_t Bytes, typename T>
+template <typename F>
+bool
+PrefixTrie<Bytes, T>::LongestMatch(const Key& key, F f)
+{
+    // collect the matching prefixes from the shortest to the longest
+    std::array<uint32_t, MAX_LENGTH + 1> matches;
+    std::size_t nMatches = 0;
+    uint32_t current = 0;
+    while (current != NONE)
+    {
+        const auto& node = m_nodes[current];
+        if (CommonLength(key, node.prefix, node.length) < node.length)
+        {
+            break;
+        }
+        if (node.hasValue)
+        {
+            matches[nMatches++] = current;
+        }
+        if (node.length == MAX_LENGTH)
+        {
+            break;
+        }
+        current = node.child[GetBit(key, node.length)];
+    }
+
+    while (nMatches > 0)
+    {
+        auto& node = m_nodes[matches[--nMatches]];
+        if (f(node.length, node.value))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace ns3
+
+#endif /* PREFIX_TRIE_H */
@@ -378,7 +378,7 @@ TcpL4Protocol::PacketReceived(Ptr<Packet> packet,
 {
     NS_LOG_FUNCTION(this << packet << incomingTcpHeader << source << destination);
 
-    if (Node::ChecksumEnabled())
+    if (Node::ChecksumEnabled() && Node::ChecksumVerificationEnabled())
     {
         incomingTcpHeader.EnableChecksums();
         incomingTcpHeader.InitializeChecksum(source, destination, PROT_NUMBER);
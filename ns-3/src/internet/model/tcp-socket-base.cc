@@ -184,6 +184,23 @@ TcpSocketBase::GetTypeId()
                           BooleanValue(true),
                           MakeBooleanAccessor(&TcpSocketBase::m_limitedTx),
                           MakeBooleanChecker())
+            .AddAttribute("TsoMaxSegments",
+                          "Maximum number of segments of new data handed down as a single block "
+                          "(segmentation offload emulation, 1 to disable)",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&TcpSocketBase::m_tsoMaxSegments),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("GroTimeout",
+                          "Maximum time an in-order segment is held to be coalesced with the "
+                          "following ones (receive offload emulation, zero to disable)",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&TcpSocketBase::m_groTimeout),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("GroMaxSize",
+                          "Maximum payload size of a coalesced segment",
+                          UintegerValue(65535),
+                          MakeUintegerAccessor(&TcpSocketBase::m_groMaxSize),
+                          MakeUintegerChecker<uint32_t>())
             .AddAttribute("UseEcn",
                           "Parameter to set ECN functionality",
                           EnumValue(TcpSocketState::Off),
@@ -397,6 +414,9 @@ TcpSocketBase::TcpSocketBase(const TcpSocketBase& sock)
       m_recoverActive(sock.m_recoverActive),
       m_retxThresh(sock.m_retxThresh),
       m_limitedTx(sock.m_limitedTx),
+      m_tsoMaxSegments(sock.m_tsoMaxSegments),
+      m_groTimeout(sock.m_groTimeout),
+      m_groMaxSize(sock.m_groMaxSize),
       m_isFirstPartialAck(sock.m_isFirstPartialAck),
       m_txTrace(sock.m_txTrace),
       m_rxTrace(sock.m_rxTrace),
@@ -1226,6 +1246,15 @@ TcpSocketBase::ForwardUp(Ptr<Packet> packet,
         return;
     }
 
+    if (m_groPacket && !CanGroCoalesce(packet, tcpHeader, header.GetEcn()))
+    {
+        GroFlush();
+        if (m_endPoint == nullptr)
+        {
+            return;
+        }
+    }
+
     if (header.GetEcn() == Ipv4Header::ECN_CE && m_ecnCESeq < tcpHeader.GetSequenceNumber())
     {
         NS_LOG_INFO("Received CE flag is valid");
@@ -1240,7 +1269,7 @@ TcpSocketBase::ForwardUp(Ptr<Packet> packet,
         m_congestionControl->CwndEvent(m_tcb, TcpSocketState::CA_EVENT_ECN_NO_CE);
     }
 
-    DoForwardUp(packet, fromAddress, toAddress);
+    GroForwardUp(packet, tcpHeader, header.GetEcn(), fromAddress, toAddress);
 }
 
 void
@@ -1266,6 +1295,15 @@ TcpSocketBase::ForwardUp6(Ptr<Packet> packet,
         return;
     }
 
+    if (m_groPacket && !CanGroCoalesce(packet, tcpHeader, header.GetEcn()))
+    {
+        GroFlush();
+        if (m_endPoint6 == nullptr)
+        {
+            return;
+        }
+    }
+
     if (header.GetEcn() == Ipv6Header::ECN_CE && m_ecnCESeq < tcpHeader.GetSequenceNumber())
     {
         NS_LOG_INFO("Received CE flag is valid");
@@ -1279,7 +1317,7 @@ TcpSocketBase::ForwardUp6(Ptr<Packet> packet,
         m_congestionControl->CwndEvent(m_tcb, TcpSocketState::CA_EVENT_ECN_NO_CE);
     }
 
-    DoForwardUp(packet, fromAddress, toAddress);
+    GroForwardUp(packet, tcpHeader, header.GetEcn(), fromAddress, toAddress);
 }
 
 void
@@ -1338,6 +1376,114 @@ TcpSocketBase::IsValidTcpSegment(const SequenceNumber32 seq,
     return true;
 }
 
+bool
+TcpSocketBase::IsGroCandidate(Ptr<const Packet> packet, const TcpHeader& tcpHeader) const
+{
+    if (m_state != ESTABLISHED || tcpHeader.GetFlags() != TcpHeader::ACK ||
+        packet->GetSize() <= tcpHeader.GetSerializedSize())
+    {
+        return false;
+    }
+    for (const auto& option : tcpHeader.GetOptionList())
+    {
+        if (option->GetKind() != TcpOption::TS && option->GetKind() != TcpOption::END &&
+            option->GetKind() != TcpOption::NOP)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+TcpSocketBase::CanGroCoalesce(Ptr<const Packet> packet,
+                              const TcpHeader& tcpHeader,
+                              uint8_t ecn) const
+{
+    if (!IsGroCandidate(packet, tcpHeader) || tcpHeader.GetSequenceNumber() != m_groNextSeq ||
+        tcpHeader.GetAckNumber() != m_groHeader.GetAckNumber() ||
+        tcpHeader.GetWindowSize() != m_groHeader.GetWindowSize() || ecn != m_groEcn ||
+        tcpHeader.HasOption(TcpOption::TS) != m_groHeader.HasOption(TcpOption::TS))
+    {
+        return false;
+    }
+    uint32_t payloadSize = packet->GetSize() - tcpHeader.GetSerializedSize();
+    uint32_t groSize = static_cast<uint32_t>(m_groNextSeq - m_groHeader.GetSequenceNumber());
+    if (groSize + payloadSize > m_groMaxSize)
+    {
+        return false;
+    }
+    if (tcpHeader.HasOption(TcpOption::TS))
+    {
+        auto ts = DynamicCast<const TcpOptionTS>(tcpHeader.GetOption(TcpOption::TS));
+        auto groTs = DynamicCast<const TcpOptionTS>(m_groHeader.GetOption(TcpOption::TS));
+        return ts->GetTimestamp() == groTs->GetTimestamp() && ts->GetEcho() == groTs->GetEcho();
+    }
+    return true;
+}
+
+void
+TcpSocketBase::GroForwardUp(Ptr<Packet> packet,
+                            const TcpHeader& tcpHeader,
+                            uint8_t ecn,
+                            const Address& fromAddress,
+                            const Address& toAddress)
+{
+    if (m_groPacket)
+    {
+        // ForwardUp already checked that the segment continues the held one
+        uint32_t payloadSize = packet->GetSize() - tcpHeader.GetSerializedSize();
+        packet->RemoveAtStart(tcpHeader.GetSerializedSize());
+        m_groPacket->AddAtEnd(packet);
+        m_groNextSeq += payloadSize;
+        ++m_groSegments;
+        NS_LOG_LOGIC("Coalesced segment " << tcpHeader.GetSequenceNumber() << ", "
+                                          << m_groSegments << " segments held");
+        uint32_t groSize = static_cast<uint32_t>(m_groNextSeq - m_groHeader.GetSequenceNumber());
+        if (groSize + payloadSize > m_groMaxSize)
+        {
+            // another segment of the same size would not fit
+            GroFlush();
+        }
+        return;
+    }
+
+    if (m_groTimeout.IsStrictlyPositive() && IsGroCandidate(packet, tcpHeader) &&
+        tcpHeader.GetSequenceNumber() == m_tcb->m_rxBuffer->NextRxSequence())
+    {
+        NS_LOG_LOGIC("Holding segment " << tcpHeader.GetSequenceNumber() << " for coalescing");
+        m_groPacket = packet;
+        m_groHeader = tcpHeader;
+        m_groEcn = ecn;
+        m_groFromAddress = fromAddress;
+        m_groToAddress = toAddress;
+        m_groNextSeq = tcpHeader.GetSequenceNumber() +
+                       (packet->GetSize() - tcpHeader.GetSerializedSize());
+        m_groSegments = 1;
+        m_groEvent = Simulator::Schedule(m_groTimeout, &TcpSocketBase::GroFlush, this);
+        return;
+    }
+
+    DoForwardUp(packet, fromAddress, toAddress);
+}
+
+void
+TcpSocketBase::GroFlush()
+{
+    NS_LOG_FUNCTION(this);
+    m_groEvent.Cancel();
+    if (!m_groPacket)
+    {
+        return;
+    }
+    Ptr<Packet> packet = m_groPacket;
+    m_groPacket = nullptr;
+    NS_LOG_LOGIC("Forward up " << m_groSegments << " coalesced segments");
+    // m_groSegments is read by ReceivedData to count the segments for the delayed ACK
+    DoForwardUp(packet, m_groFromAddress, m_groToAddress);
+    m_groSegments = 1;
+}
+
 void
 TcpSocketBase::DoForwardUp(Ptr<Packet> packet, const Address& fromAddress, const Address& toAddress)
 {
@@ -3280,49 +3426,78 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
         m_retxEvent = Simulator::Schedule(m_rto, &TcpSocketBase::ReTxTimeout, this);
     }
 
-    m_txTrace(p, header, this);
-    if (isRetransmission)
+    // With segmentation offload, the block is cut into segments of one MSS,
+    // which are handed to TcpL4Protocol one after the other
+    uint32_t segmentSize = sz;
+    uint32_t offset = 0;
+    do
     {
-        if (m_endPoint)
+        Ptr<Packet> segment = p;
+        TcpHeader segmentHeader = header;
+        if (m_tsoMaxSegments > 1 && sz > m_tcb->m_segmentSize)
         {
-            m_retransmissionTrace(p,
-                                  header,
-                                  m_endPoint->GetLocalAddress(),
-                                  m_endPoint->GetPeerAddress(),
-                                  this);
+            segmentSize = std::min(m_tcb->m_segmentSize, sz - offset);
+            segment = p->CreateFragment(offset, segmentSize);
+            uint8_t segmentFlags = flags;
+            if (offset > 0)
+            {
+                segmentFlags &= ~TcpHeader::CWR;
+            }
+            if (offset + segmentSize < sz)
+            {
+                segmentFlags &= ~TcpHeader::FIN;
+            }
+            segmentHeader.SetFlags(segmentFlags);
+            segmentHeader.SetSequenceNumber(seq + SequenceNumber32(offset));
         }
-        else
+
+        m_txTrace(segment, segmentHeader, this);
+        if (isRetransmission)
         {
-            m_retransmissionTrace(p,
-                                  header,
-                                  m_endPoint6->GetLocalAddress(),
-                                  m_endPoint6->GetPeerAddress(),
-                                  this);
+            if (m_endPoint)
+            {
+                m_retransmissionTrace(segment,
+                                      segmentHeader,
+                                      m_endPoint->GetLocalAddress(),
+                                      m_endPoint->GetPeerAddress(),
+                                      this);
+            }
+            else
+            {
+                m_retransmissionTrace(segment,
+                                      segmentHeader,
+                                      m_endPoint6->GetLocalAddress(),
+                                      m_endPoint6->GetPeerAddress(),
+                                      this);
+            }
         }
-    }
 
-    if (m_endPoint)
-    {
-        m_tcp->SendPacket(p,
-                          header,
-                          m_endPoint->GetLocalAddress(),
-                          m_endPoint->GetPeerAddress(),
-                          m_boundnetdevice);
-        NS_LOG_DEBUG("Send segment of size "
-                     << sz << " with remaining data " << remainingData << " via TcpL4Protocol to "
-                     << m_endPoint->GetPeerAddress() << ". Header " << header);
-    }
-    else
-    {
-        m_tcp->SendPacket(p,
-                          header,
-                          m_endPoint6->GetLocalAddress(),
-                          m_endPoint6->GetPeerAddress(),
-                          m_boundnetdevice);
-        NS_LOG_DEBUG("Send segment of size "
-                     << sz << " with remaining data " << remainingData << " via TcpL4Protocol to "
-                     << m_endPoint6->GetPeerAddress() << ". Header " << header);
-    }
+        if (m_endPoint)
+        {
+            m_tcp->SendPacket(segment,
+                              segmentHeader,
+                              m_endPoint->GetLocalAddress(),
+                              m_endPoint->GetPeerAddress(),
+                              m_boundnetdevice);
+            NS_LOG_DEBUG("Send segment of size " << segmentSize << " with remaining data "
+                                                 << remainingData << " via TcpL4Protocol to "
+                                                 << m_endPoint->GetPeerAddress() << ". Header "
+                                                 << segmentHeader);
+        }
+        else
+        {
+            m_tcp->SendPacket(segment,
+                              segmentHeader,
+                              m_endPoint6->GetLocalAddress(),
+                              m_endPoint6->GetPeerAddress(),
+                              m_boundnetdevice);
+            NS_LOG_DEBUG("Send segment of size " << segmentSize << " with remaining data "
+                                                 << remainingData << " via TcpL4Protocol to "
+                                                 << m_endPoint6->GetPeerAddress() << ". Header "
+                                                 << segmentHeader);
+        }
+        offset += segmentSize;
+    } while (offset < sz);
 
     // Signal to congestion control whether the cwnd is fully used
     // This is a simple version of Linux tcp_cwnd_validate() but following
@@ -3464,6 +3639,8 @@ TcpSocketBase::SendPendingData(bool withAck)
             // NextSeg () may have further constrained the segment size
             auto maxSizeToSend = static_cast<uint32_t>(nextHigh - next);
             s = std::min(s, maxSizeToSend);
+            // With segmentation offload, several segments of new data are sent at once
+            s = std::max(s, GetTsoSize(next, availableWindow, availableData));
 
             // (C.2) If any of the data octets sent in (C.1) are below HighData,
             //       HighRxt MUST be set to the highest sequence number of the
@@ -3492,7 +3669,7 @@ TcpSocketBase::SendPendingData(bool withAck)
             NS_LOG_DEBUG("cWnd: " << m_tcb->m_cWnd << " total unAck: " << UnAckDataCount()
                                   << " sent seq " << m_tcb->m_nextTxSequence << " size " << sz);
             m_tcb->m_nextTxSequence += sz;
-            ++nPacketsSent;
+            nPacketsSent += std::max(1U, (sz + m_tcb->m_segmentSize - 1) / m_tcb->m_segmentSize);
             if (IsPacingEnabled())
             {
                 NS_LOG_INFO("Pacing is enabled");
@@ -3538,6 +3715,28 @@ TcpSocketBase::SendPendingData(bool withAck)
     return nPacketsSent;
 }
 
+uint32_t
+TcpSocketBase::GetTsoSize(SequenceNumber32 seq,
+                          uint32_t availableWindow,
+                          uint32_t availableData) const
+{
+    if (m_tsoMaxSegments <= 1 || IsPacingEnabled() || seq != m_tcb->m_highTxMark.Get())
+    {
+        // retransmissions and paced segments are sent one by one
+        return 0;
+    }
+    SequenceNumber32 rWndEnd = m_highRxAckMark.Get() + SequenceNumber32(m_rWnd.Get());
+    if (rWndEnd <= seq)
+    {
+        return 0;
+    }
+    uint32_t size = std::min({availableWindow,
+                              availableData,
+                              static_cast<uint32_t>(rWndEnd - seq),
+                              m_tsoMaxSegments * m_tcb->m_segmentSize});
+    return size - size % m_tcb->m_segmentSize;
+}
+
 uint32_t
 TcpSocketBase::UnAckDataCount() const
 {
@@ -3674,7 +3873,8 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
     }
     else
     { // In-sequence packet: ACK if delayed ack count allows
-        if (++m_delAckCount >= m_delAckMaxCount)
+        m_delAckCount += m_groSegments;
+        if (m_delAckCount >= m_delAckMaxCount)
         {
             m_delAckEvent.Cancel();
             m_delAckCount = 0;
@@ -4123,6 +4323,9 @@ TcpSocketBase::CancelAllTimers()
     m_timewaitEvent.Cancel();
     m_sendPendingDataEvent.Cancel();
     m_pacingTimer.Cancel();
+    // segments held for coalescing have not been acknowledged yet
+    m_groEvent.Cancel();
+    m_groPacket = nullptr;
 }
 
 /* Move TCP to Time_Wait state and schedule a transition to Closed state */
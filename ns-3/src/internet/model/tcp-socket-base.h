@@ -11,6 +11,7 @@
 
 #include "ipv4-header.h"
 #include "ipv6-header.h"
+#include "tcp-header.h"
 #include "tcp-socket-state.h"
 #include "tcp-socket.h"
 
@@ -31,7 +32,6 @@ class Ipv6EndPoint;
 class Node;
 class Packet;
 class TcpL4Protocol;
-class TcpHeader;
 class TcpCongestionOps;
 class TcpRecoveryOps;
 class RttEstimator;
@@ -204,6 +204,29 @@ class RttHistory
  * you need more information. The reference paper is
  * https://dl.acm.org/citation.cfm?id=3067666.
  *
+ * Segmentation and receive offload
+ * --------------------------------
+ *
+ * To reduce the per-segment processing of high-bandwidth flows, the socket
+ * can emulate the TCP segmentation offload (TSO) and generic receive offload
+ * (GRO) of network cards. Both are disabled by default.
+ *
+ * With the TsoMaxSegments attribute greater than one, new data is taken from
+ * the TcpTxBuffer, accounted for (RTT history, rate sampling, congestion
+ * control) and given a header as a single block of up to TsoMaxSegments
+ * segments. The block is then cut into segments of one MSS each, with their
+ * own header, right before being handed to TcpL4Protocol. Hence, the segments
+ * go through IP, the queue discs and the NetDevice exactly as if they had
+ * been sent one by one. Retransmissions and paced flows are never sent as
+ * blocks.
+ *
+ * With a positive GroTimeout attribute, in-order data segments received in
+ * the ESTABLISHED state are held for up to GroTimeout and coalesced with the
+ * following ones, as long as they are contiguous and carry the same
+ * acknowledgment, window, timestamps and ECN codepoint. The coalesced
+ * segment (up to GroMaxSize bytes) is processed once by DoForwardUp, and
+ * counts as many segments as it coalesced for the delayed ACK.
+ *
  */
 class TcpSocketBase : public TcpSocket
 {
@@ -802,6 +825,47 @@ class TcpSocketBase : public TcpSocket
                              const Address& fromAddress,
                              const Address& toAddress);
 
+    /**
+     * @brief Check if a received segment can be coalesced by GRO
+     *
+     * @param packet the incoming packet (with its TCP header)
+     * @param tcpHeader the TCP header of the packet
+     * @returns true if the segment is a data segment received in the
+     *          ESTABLISHED state, with no flag other than ACK and no option
+     *          other than the timestamp
+     */
+    bool IsGroCandidate(Ptr<const Packet> packet, const TcpHeader& tcpHeader) const;
+
+    /**
+     * @brief Check if a received segment can be appended to the coalesced one
+     *
+     * @param packet the incoming packet (with its TCP header)
+     * @param tcpHeader the TCP header of the packet
+     * @param ecn the ECN codepoint of the IP header of the packet
+     * @returns true if the segment continues the coalesced one
+     */
+    bool CanGroCoalesce(Ptr<const Packet> packet, const TcpHeader& tcpHeader, uint8_t ecn) const;
+
+    /**
+     * @brief Coalesce a received segment (GRO) or forward it up
+     *
+     * @param packet the incoming packet (with its TCP header)
+     * @param tcpHeader the TCP header of the packet
+     * @param ecn the ECN codepoint of the IP header of the packet
+     * @param fromAddress the address of the sender of packet
+     * @param toAddress the address of the receiver of packet
+     */
+    void GroForwardUp(Ptr<Packet> packet,
+                      const TcpHeader& tcpHeader,
+                      uint8_t ecn,
+                      const Address& fromAddress,
+                      const Address& toAddress);
+
+    /**
+     * @brief Forward up the coalesced segment, if any
+     */
+    void GroFlush();
+
     /**
      * @brief Called by the L3 protocol when it received an ICMP packet to pass on to TCP.
      *
@@ -853,6 +917,19 @@ class TcpSocketBase : public TcpSocket
      */
     virtual uint32_t SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withAck);
 
+    /**
+     * @brief Get the size of the next block of new data to send at once (TSO)
+     *
+     * @param seq the sequence number of the block
+     * @param availableWindow the available window
+     * @param availableData the data available in the TcpTxBuffer from seq
+     * @returns the size of the block (a multiple of the segment size), or zero
+     *          if segmentation offload is disabled or not possible
+     */
+    uint32_t GetTsoSize(SequenceNumber32 seq,
+                        uint32_t availableWindow,
+                        uint32_t availableData) const;
+
     /**
      * @brief Send a empty packet that carries a flag, e.g., ACK
      *
@@ -1424,6 +1501,19 @@ class TcpSocketBase : public TcpSocket
     uint32_t m_retxThresh{3};    //!< Fast Retransmit threshold
     bool m_limitedTx{true};      //!< perform limited transmit
 
+    // Segmentation and receive offload emulation
+    uint32_t m_tsoMaxSegments{1};     //!< Maximum number of segments sent as a block (TSO)
+    Time m_groTimeout;                //!< Time a segment can be held to be coalesced (GRO)
+    uint32_t m_groMaxSize{0};         //!< Maximum payload size of a coalesced segment
+    Ptr<Packet> m_groPacket;          //!< Coalesced segment, with the first TCP header
+    TcpHeader m_groHeader;            //!< TCP header of the first coalesced segment
+    uint8_t m_groEcn{0};              //!< ECN codepoint of the coalesced segments
+    Address m_groFromAddress;         //!< Source address of the coalesced segments
+    Address m_groToAddress;           //!< Destination address of the coalesced segments
+    SequenceNumber32 m_groNextSeq{0}; //!< Sequence number that follows the coalesced segment
+    uint32_t m_groSegments{1};        //!< Number of segments in the coalesced segment
+    EventId m_groEvent{};             //!< Event to forward up the coalesced segment
+
     // Transmission Control Block
     Ptr<TcpSocketState> m_tcb;                 //!< Congestion control information
     Ptr<TcpCongestionOps> m_congestionControl; //!< Congestion control
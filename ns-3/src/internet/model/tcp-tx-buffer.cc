@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <optional>
 
 namespace ns3
 {
@@ -48,7 +49,9 @@ TcpTxBuffer::TcpTxBuffer(uint32_t n)
     : m_maxBuffer(32768),
       m_size(0),
       m_sentSize(0),
-      m_firstByteSeq(n)
+      m_firstByteSeq(n),
+      m_nextSegHint(n),
+      m_lostHint(n)
 {
     m_rWndCallback = MakeNullCallback<uint32_t>();
 }
@@ -163,6 +166,8 @@ TcpTxBuffer::SetHeadSequence(const SequenceNumber32& seq)
     NS_ASSERT(m_sentList.empty());
     m_sackSeen = false;
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_nextSegHint = seq;
+    m_lostHint = seq;
 }
 
 bool
@@ -283,7 +288,7 @@ TcpTxBuffer::GetNewSegment(uint32_t numBytes)
     NS_ASSERT(it != m_appList.end());
 
     m_appList.erase(it);
-    m_sentList.insert(m_sentList.end(), item);
+    m_sentIndex[item->m_startSeq] = m_sentList.insert(m_sentList.end(), item);
     m_sentSize += item->m_packet->GetSize();
 
     return item;
@@ -297,37 +302,33 @@ TcpTxBuffer::GetTransmittedSegment(uint32_t numBytes, const SequenceNumber32& se
     NS_ASSERT(numBytes <= m_sentSize);
     NS_ASSERT(!m_sentList.empty());
 
-    auto it = m_sentList.begin();
     bool listEdited = false;
     uint32_t s = numBytes;
 
     // Avoid to merge different packet for this retransmission if flags are
     // different.
-    for (; it != m_sentList.end(); ++it)
+    if (auto index = m_sentIndex.find(seq); index != m_sentIndex.end())
     {
-        if ((*it)->m_startSeq == seq)
+        auto it = index->second;
+        auto next = it;
+        next++;
+        if (next != m_sentList.end())
         {
-            auto next = it;
-            next++;
-            if (next != m_sentList.end())
+            // Next is not sacked and have the same value for m_lost ... there is the
+            // possibility to merge
+            if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
             {
-                // Next is not sacked and have the same value for m_lost ... there is the
-                // possibility to merge
-                if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
-                {
-                    s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
-                }
-                else
-                {
-                    // Next is sacked... better to retransmit only the first segment
-                    s = std::min(s, (*it)->m_packet->GetSize());
-                }
+                s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
             }
             else
             {
+                // Next is sacked... better to retransmit only the first segment
                 s = std::min(s, (*it)->m_packet->GetSize());
             }
-            break;
+        }
+        else
+        {
+            s = std::min(s, (*it)->m_packet->GetSize());
         }
     }
 
@@ -364,6 +365,52 @@ TcpTxBuffer::FindHighestSacked() const
     return ret;
 }
 
+TcpTxBuffer::PacketList::const_iterator
+TcpTxBuffer::FindSentItem(const SequenceNumber32& seq) const
+{
+    auto index = m_sentIndex.upper_bound(seq);
+    if (index == m_sentIndex.begin())
+    {
+        return m_sentList.end();
+    }
+    PacketList::const_iterator it = std::prev(index)->second;
+    if (seq < (*it)->m_startSeq + (*it)->m_packet->GetSize())
+    {
+        return it;
+    }
+    return m_sentList.end();
+}
+
+void
+TcpTxBuffer::SplitSentItem(const SequenceNumber32& seq)
+{
+    auto index = m_sentIndex.upper_bound(seq);
+    if (index == m_sentIndex.begin())
+    {
+        return;
+    }
+    auto it = std::prev(index)->second;
+    TcpTxItem* item = *it;
+    if (item->m_startSeq == seq || seq >= item->m_startSeq + item->m_packet->GetSize() ||
+        item->m_packet->GetSize() <= m_segmentSize)
+    {
+        // items of a single segment are never split, a block partially covering them is
+        // ignored (as done without segmentation offload)
+        return;
+    }
+
+    NS_LOG_FUNCTION(this << seq);
+    auto firstPart = new TcpTxItem();
+    SplitItems(firstPart, item, seq - item->m_startSeq);
+    firstPart->m_rateInfo = item->m_rateInfo;
+    m_sentIndex[firstPart->m_startSeq] = m_sentList.insert(it, firstPart);
+    m_sentIndex[item->m_startSeq] = it;
+    if (m_highestSack.first == it)
+    {
+        m_highestSack.second = item->m_startSeq;
+    }
+}
+
 void
 TcpTxBuffer::SplitItems(TcpTxItem* t1, TcpTxItem* t2, uint32_t size) const
 {
@@ -389,7 +436,7 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                                const SequenceNumber32& listStartFrom,
                                uint32_t numBytes,
                                const SequenceNumber32& seq,
-                               bool* listEdited) const
+                               bool* listEdited)
 {
     NS_LOG_FUNCTION(this << numBytes << seq);
 
@@ -425,6 +472,17 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
     TcpTxItem* outItem = nullptr;
     auto it = list.begin();
     SequenceNumber32 beginOfCurrentPacket = listStartFrom;
+    bool isSentList = (&list == &m_sentList);
+
+    if (isSentList)
+    {
+        // Jump directly to the item that contains seq
+        if (auto index = m_sentIndex.upper_bound(seq); index != m_sentIndex.begin())
+        {
+            it = std::prev(index)->second;
+            beginOfCurrentPacket = (*it)->m_startSeq;
+        }
+    }
 
     while (it != list.end())
     {
@@ -459,7 +517,12 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                 SplitItems(firstPart, currentItem, seq - beginOfCurrentPacket);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                auto firstIt = list.insert(it, firstPart);
+                if (isSentList)
+                {
+                    m_sentIndex[firstPart->m_startSeq] = firstIt;
+                    m_sentIndex[currentItem->m_startSeq] = it;
+                }
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -508,6 +571,10 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                     list.erase(it);
 
                     MergeItems(previous, currentItem);
+                    if (isSentList)
+                    {
+                        m_sentIndex.erase(currentItem->m_startSeq);
+                    }
                     delete currentItem;
                     if (listEdited)
                     {
@@ -525,7 +592,12 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                 SplitItems(firstPart, currentItem, numBytes);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                auto firstIt = list.insert(it, firstPart);
+                if (isSentList)
+                {
+                    m_sentIndex[firstPart->m_startSeq] = firstIt;
+                    m_sentIndex[currentItem->m_startSeq] = it;
+                }
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -555,6 +627,10 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
 
             MergeItems(currentItem, next);
             list.erase(it);
+            if (isSentList)
+            {
+                m_sentIndex.erase(next->m_startSeq);
+            }
 
             delete next;
 
@@ -587,6 +663,7 @@ TcpTxBuffer::MergeItems(TcpTxItem* t1, TcpTxItem* t2) const
     // be updated in MarkTransmittedSegment.
     if (t1->m_retrans != t2->m_retrans)
     {
+        m_nextSegHint = m_firstByteSeq;
         if (t1->m_retrans)
         {
             auto self = const_cast<TcpTxBuffer*>(this);
@@ -638,16 +715,15 @@ bool
 TcpTxBuffer::IsRetransmittedDataAcked(const SequenceNumber32& ack) const
 {
     NS_LOG_FUNCTION(this);
-    for (const auto& it : m_sentList)
+    // Only the item that ends right before ack can match
+    auto index = m_sentIndex.lower_bound(ack);
+    if (index == m_sentIndex.begin())
     {
-        TcpTxItem* item = it;
-        Ptr<Packet> p = item->m_packet;
-        if (item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans)
-        {
-            return true;
-        }
+        return false;
     }
-    return false;
+    TcpTxItem* item = *std::prev(index)->second;
+    Ptr<Packet> p = item->m_packet;
+    return item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans;
 }
 
 void
@@ -695,6 +771,7 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
 
             RemoveFromCounts(item, pktSize);
 
+            m_sentIndex.erase(item->m_startSeq);
             i = m_sentList.erase(i);
             NS_LOG_INFO("Removed " << *item << " lost: " << m_lostOut << " retrans: " << m_retrans
                                    << " sacked: " << m_sackedOut << ". Remaining data " << m_size);
@@ -713,7 +790,9 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
             NS_LOG_INFO(*item);
             // PacketTags are preserved when fragmenting
             item->m_packet = item->m_packet->CreateFragment(offset, pktSize);
+            m_sentIndex.erase(item->m_startSeq);
             item->m_startSeq += offset;
+            m_sentIndex[item->m_startSeq] = i;
             m_size -= offset;
             m_sentSize -= offset;
             m_firstByteSeq += offset;
@@ -731,6 +810,14 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
     {
         m_firstByteSeq = seq;
     }
+    if (m_nextSegHint < m_firstByteSeq)
+    {
+        m_nextSegHint = m_firstByteSeq;
+    }
+    if (m_lostHint < m_firstByteSeq)
+    {
+        m_lostHint = m_firstByteSeq;
+    }
 
     if (!m_sentList.empty())
     {
@@ -743,6 +830,7 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
             // when adding Reno dupacks in the count.
             head->m_sacked = false;
             m_sackedOut -= head->m_packet->GetSize();
+            m_nextSegHint = m_firstByteSeq;
             NS_LOG_INFO("Moving the SACK flag from the HEAD to another segment");
             AddRenoSack();
             MarkHeadAsLost();
@@ -777,15 +865,27 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
 
     for (auto option_it = list.begin(); option_it != list.end(); ++option_it)
     {
-        auto item_it = m_sentList.begin();
-        SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-
         if (m_firstByteSeq + m_sentSize < (*option_it).first)
         {
             NS_LOG_INFO("Not updating scoreboard, the option block is outside the sent list");
             return bytesSacked;
         }
 
+        // Items sent as a single block of several segments (segmentation offload)
+        // may be only partially covered: split them at the edges of the SACK block
+        SplitSentItem((*option_it).first);
+        SplitSentItem((*option_it).second);
+
+        // Only the items starting inside the block can be sacked: start from
+        // the first of them instead of walking from SND.UNA
+        auto index = m_sentIndex.lower_bound((*option_it).first);
+        if (index == m_sentIndex.end())
+        {
+            continue;
+        }
+        auto item_it = index->second;
+        SequenceNumber32 beginOfCurrentPacket = index->first;
+
         while (item_it != m_sentList.end())
         {
             uint32_t pktSize = (*item_it)->m_packet->GetSize();
@@ -879,9 +979,18 @@ TcpTxBuffer::UpdateLostCount()
                                                  << *(*m_highestSack.first));
     }
 
+    // all the unsacked items before the item at which the threshold is reached are lost
+    std::optional<SequenceNumber32> lostUpTo;
     for (auto it = m_highestSack.first; it != m_sentList.begin(); --it)
     {
         TcpTxItem* item = *it;
+        if (lostUpTo && item->m_startSeq < m_lostHint)
+        {
+            // The unsacked items before the hint are already marked as lost
+            NS_ASSERT_MSG(item->m_sacked || item->m_lost, "Unsacked item not lost: " << *item);
+            break;
+        }
+
         if (item->m_sacked)
         {
             sacked++;
@@ -889,6 +998,10 @@ TcpTxBuffer::UpdateLostCount()
 
         if (sacked >= m_dupAckThresh)
         {
+            if (!lostUpTo)
+            {
+                lostUpTo = item->m_startSeq;
+            }
             if (!item->m_sacked && !item->m_lost)
             {
                 item->m_lost = true;
@@ -906,6 +1019,10 @@ TcpTxBuffer::UpdateLostCount()
             item->m_lost = true;
             m_lostOut += item->m_packet->GetSize();
         }
+        if (lostUpTo && m_lostHint < *lostUpTo)
+        {
+            m_lostHint = *lostUpTo;
+        }
     }
     NS_LOG_INFO("Status after the update: " << *this);
     ConsistencyCheck();
@@ -921,24 +1038,19 @@ TcpTxBuffer::IsLost(const SequenceNumber32& seq) const
         return false;
     }
 
-    // In theory, using a map and hints when inserting elements can improve
-    // performance
-    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    auto it = FindSentItem(seq);
+    if (it != m_sentList.end())
     {
-        // Search for the right iterator before calling IsLost()
-        if ((*it)->m_startSeq <= seq && seq < (*it)->m_startSeq + (*it)->m_packet->GetSize())
+        if ((*it)->m_lost)
         {
-            if ((*it)->m_lost)
-            {
-                NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
-                return true;
-            }
+            NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
+            return true;
+        }
 
-            if ((*it)->m_sacked)
-            {
-                NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
-                return false;
-            }
+        if ((*it)->m_sacked)
+        {
+            NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
+            return false;
         }
     }
 
@@ -967,11 +1079,40 @@ TcpTxBuffer::NextSeg(SequenceNumber32* seq, SequenceNumber32* seqHigh, bool isRe
     SequenceNumber32 seqPerRule3;
     bool isSeqPerRule3Valid = false;
     SequenceNumber32 beginOfCurrentPkt = m_firstByteSeq;
+    auto it = m_sentList.begin();
 
-    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    // Skip the items that are all retransmitted or sacked, as found by the
+    // previous calls
+    if (m_nextSegHint > m_firstByteSeq)
+    {
+        it = FindSentItem(m_nextSegHint);
+        beginOfCurrentPkt = m_firstByteSeq + m_sentSize;
+        if (it != m_sentList.end())
+        {
+            beginOfCurrentPkt = (*it)->m_startSeq;
+        }
+    }
+    bool isPrefix = true;
+
+    for (; it != m_sentList.end(); ++it)
     {
         item = *it;
 
+        if (m_sackSeen && item->m_startSeq >= m_highestSack.second)
+        {
+            // Condition 1.b cannot hold for this item and the following ones
+            break;
+        }
+
+        if (isPrefix && (item->m_retrans || item->m_sacked))
+        {
+            m_nextSegHint = beginOfCurrentPkt + item->m_packet->GetSize();
+        }
+        else
+        {
+            isPrefix = false;
+        }
+
         // Condition 1.a , 1.b , and 1.c
         if (!item->m_retrans && !item->m_sacked &&
             ((m_sackSeen && item->m_startSeq < m_highestSack.second) || !m_sackSeen))
@@ -1205,6 +1346,9 @@ TcpTxBuffer::ResetRenoSack()
 
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
     m_sackSeen = false;
+    m_nextSegHint = m_firstByteSeq;
+    // the unsacked items are no longer all lost
+    m_lostHint = m_firstByteSeq;
 }
 
 void
@@ -1228,6 +1372,7 @@ TcpTxBuffer::ResetSentList()
         m_appList.push_front(item);
         m_sentList.pop_back();
     }
+    m_sentIndex.clear();
 
     m_sentSize = 0;
     m_lostOut = 0;
@@ -1235,6 +1380,7 @@ TcpTxBuffer::ResetSentList()
     m_sackedOut = 0;
     m_sackSeen = false;
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_nextSegHint = m_firstByteSeq;
 }
 
 void
@@ -1245,6 +1391,7 @@ TcpTxBuffer::ResetLastSegmentSent()
     {
         TcpTxItem* item = m_sentList.back();
 
+        m_sentIndex.erase(item->m_startSeq);
         m_sentList.pop_back();
         m_sentSize -= item->m_packet->GetSize();
         if (item->m_retrans)
@@ -1252,6 +1399,7 @@ TcpTxBuffer::ResetLastSegmentSent()
             m_retrans -= item->m_packet->GetSize();
         }
         m_appList.insert(m_appList.begin(), item);
+        m_nextSegHint = m_firstByteSeq;
     }
     ConsistencyCheck();
 }
@@ -1261,6 +1409,7 @@ TcpTxBuffer::SetSentListLost(bool resetSack)
 {
     NS_LOG_FUNCTION(this);
     m_retrans = 0;
+    m_nextSegHint = m_firstByteSeq;
 
     if (resetSack)
     {
@@ -1331,6 +1480,7 @@ TcpTxBuffer::DeleteRetransmittedFlagFromHead()
     {
         m_sentList.front()->m_retrans = false;
         m_retrans -= m_sentList.front()->m_packet->GetSize();
+        m_nextSegHint = m_firstByteSeq;
     }
     ConsistencyCheck();
 }
@@ -1340,6 +1490,8 @@ TcpTxBuffer::MarkHeadAsLost()
 {
     if (!m_sentList.empty())
     {
+        m_nextSegHint = m_firstByteSeq;
+
         // If the head is sacked (reneging by the receiver the previously sent
         // information) we revert the sacked flag.
         // A sacked head means that we should advance SND.UNA.. so it's an error.
@@ -1442,6 +1594,15 @@ TcpTxBuffer::ConsistencyCheck() const
     NS_ASSERT_MSG(lost == m_lostOut, " Counted lost: " << lost << " stored lost: " << m_lostOut);
     NS_ASSERT_MSG(retrans == m_retrans,
                   " Counted retrans: " << retrans << " stored retrans: " << m_retrans);
+
+    NS_ASSERT_MSG(m_sentIndex.size() == m_sentList.size(),
+                  "Indexed items: " << m_sentIndex.size() << " sent items: " << m_sentList.size());
+    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    {
+        auto index = m_sentIndex.find((*it)->m_startSeq);
+        NS_ASSERT_MSG(index != m_sentIndex.end() && index->second == it,
+                      "Item " << **it << " not indexed");
+    }
 }
 
 std::ostream&
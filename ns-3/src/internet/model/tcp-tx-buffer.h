@@ -18,6 +18,9 @@
 #include "ns3/sequence-number.h"
 #include "ns3/traced-value.h"
 
+#include <list>
+#include <map>
+
 namespace ns3
 {
 class Packet;
@@ -105,6 +108,21 @@ class Packet;
  * connection, the TcpSocketImplementation should provide hints through
  * the MarkHeadAsLost and AddRenoSack methods.
  *
+ * Scoreboard lookups
+ * ------------------
+ *
+ * The segments of the sent list are indexed by their first sequence number,
+ * so that the segment containing a given sequence (to retransmit it, to mark
+ * it as sacked, or to check if it is lost) is found in logarithmic time
+ * instead of walking the list from SND.UNA. With windows of thousands of
+ * segments, this keeps the processing of each SACK block proportional to the
+ * number of segments it covers. Similarly, NextSeg remembers the point up to
+ * which all the segments are already retransmitted or sacked, and
+ * UpdateLostCount remembers the point up to which all the unsacked segments
+ * are marked as lost, so that it does not walk back beyond it. This point is
+ * reset when the sacked segments are unsacked without being marked as lost
+ * (see ResetRenoSack).
+ *
  * @see BytesInFlight
  * @see Size
  * @see SizeFromSequence
@@ -418,8 +436,9 @@ class TcpTxBuffer : public Object
      * The {New}Reno cases, for now, are managed in TcpSocketBase through the
      * call to MarkHeadAsLost.
      * This function is, therefore, called after a SACK option has been received,
-     * and updates the lost count. It can be probably optimized by not walking
-     * the entire list, but a subset.
+     * and updates the lost count. The walk starts from the highest sacked
+     * segment and, once the threshold is reached, stops at the point up to
+     * which all the unsacked segments are known to be marked as lost.
      *
      */
     void UpdateLostCount();
@@ -554,7 +573,7 @@ class TcpTxBuffer : public Object
                                  const SequenceNumber32& startingSeq,
                                  uint32_t numBytes,
                                  const SequenceNumber32& requestedSeq,
-                                 bool* listEdited = nullptr) const;
+                                 bool* listEdited = nullptr);
 
     /**
      * @brief Merge two TcpTxItem
@@ -592,8 +611,28 @@ class TcpTxBuffer : public Object
      */
     std::pair<TcpTxBuffer::PacketList::const_iterator, SequenceNumber32> FindHighestSacked() const;
 
+    /**
+     * @brief Find the item of the sent list that contains a sequence number
+     * @param seq the sequence number
+     * @return an iterator to the item, or the end of m_sentList if no item contains seq
+     */
+    PacketList::const_iterator FindSentItem(const SequenceNumber32& seq) const;
+
+    /**
+     * @brief Split the item of the sent list that contains a sequence number,
+     * so that an item starts at that sequence number
+     *
+     * Used to map the SACK blocks on items that span several segments. Items
+     * that are not larger than a segment are not split.
+     *
+     * @param seq the sequence number
+     */
+    void SplitSentItem(const SequenceNumber32& seq);
+
     PacketList m_appList;              //!< Buffer for application data
     PacketList m_sentList;             //!< Buffer for sent (but not acked) data
+    std::map<SequenceNumber32, PacketList::iterator>
+        m_sentIndex; //!< Items of m_sentList, indexed by their first sequence number
     uint32_t m_maxBuffer;              //!< Max number of data bytes in buffer (SND.WND)
     uint32_t m_size;                   //!< Size of all data in this buffer
     uint32_t m_sentSize;               //!< Size of sent (and not discarded) segments
@@ -602,6 +641,9 @@ class TcpTxBuffer : public Object
     TracedValue<SequenceNumber32>
         m_firstByteSeq; //!< Sequence number of the first byte in data (SND.UNA)
     std::pair<PacketList::const_iterator, SequenceNumber32> m_highestSack; //!< Highest SACK byte
+    mutable SequenceNumber32
+        m_nextSegHint; //!< All the items before this sequence are retransmitted or sacked
+    SequenceNumber32 m_lostHint; //!< All the unsacked items before this sequence are lost
 
     uint32_t m_lostOut{0};   //!< Number of lost bytes
     uint32_t m_sackedOut{0}; //!< Number of sacked bytes
@@ -322,7 +322,7 @@ UdpL4Protocol::Receive(Ptr<Packet> packet, const Ipv4Header& header, Ptr<Ipv4Int
 {
     NS_LOG_FUNCTION(this << packet << header);
     UdpHeader udpHeader;
-    if (Node::ChecksumEnabled())
+    if (Node::ChecksumEnabled() && Node::ChecksumVerificationEnabled())
     {
         udpHeader.EnableChecksums();
     }
@@ -380,7 +380,7 @@ UdpL4Protocol::Receive(Ptr<Packet> packet, const Ipv6Header& header, Ptr<Ipv6Int
 {
     NS_LOG_FUNCTION(this << packet << header.GetSource() << header.GetDestination());
     UdpHeader udpHeader;
-    if (Node::ChecksumEnabled())
+    if (Node::ChecksumEnabled() && Node::ChecksumVerificationEnabled())
     {
         udpHeader.EnableChecksums();
     }
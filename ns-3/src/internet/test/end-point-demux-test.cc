@@ -0,0 +1,219 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv6-end-point-demux.h"
+#include "ns3/ipv6-end-point.h"
+#include "ns3/ipv6-interface.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief Ipv4EndPointDemux lookup test
+ */
+class Ipv4EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv4EndPointDemuxTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv4EndPointDemuxTestCase::Ipv4EndPointDemuxTestCase()
+    : TestCase("Lookup of listening and connected IPv4 end points")
+{
+}
+
+void
+Ipv4EndPointDemuxTestCase::DoRun()
+{
+    Ipv4EndPointDemux demux;
+    Ptr<Ipv4Interface> interface = CreateObject<Ipv4Interface>();
+    Ipv4Address local("10.0.0.1");
+
+    auto lookup = [&](Ipv4Address daddr, uint16_t dport, Ipv4Address saddr, uint16_t sport) {
+        auto endPoints = demux.Lookup(daddr, dport, saddr, sport, interface);
+        return endPoints.empty() ? nullptr : endPoints.front();
+    };
+
+    Ipv4EndPoint* listener = demux.Allocate(nullptr, 80);
+    NS_TEST_ASSERT_MSG_NE(listener, nullptr, "Listening end point not allocated");
+    NS_TEST_EXPECT_MSG_EQ(demux.Allocate(nullptr, 80), nullptr, "Duplicated end point allocated");
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(80), true, "Port 80 not in use");
+
+    // many connections to the listening port
+    std::vector<Ipv4EndPoint*> connections;
+    for (uint16_t i = 0; i < 1000; i++)
+    {
+        connections.push_back(
+            demux.Allocate(nullptr, local, 80, Ipv4Address(0x0b000000 + i), 1000 + i));
+        NS_TEST_ASSERT_MSG_NE(connections.back(), nullptr, "Connection not allocated");
+    }
+    NS_TEST_EXPECT_MSG_EQ(demux.Allocate(nullptr, local, 80, Ipv4Address(0x0b000000), 1000),
+                          nullptr,
+                          "Duplicated connection allocated");
+    for (uint16_t i = 0; i < 1000; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, Ipv4Address(0x0b000000 + i), 1000 + i),
+                              connections[i],
+                              "Wrong end point for connection " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, Ipv4Address(0x0b000000), 999),
+                          listener,
+                          "New connection not delivered to the listening end point");
+
+    // an end point bound to the local address takes precedence over the wildcard one
+    Ipv4Address other("10.0.0.2");
+    Ipv4EndPoint* bound = demux.Allocate(nullptr, other, 80);
+    NS_TEST_ASSERT_MSG_NE(bound, nullptr, "Bound end point not allocated");
+    NS_TEST_EXPECT_MSG_EQ(lookup(other, 80, Ipv4Address("12.0.0.1"), 1), bound, "Wrong priority");
+    NS_TEST_EXPECT_MSG_EQ(lookup(Ipv4Address("10.0.0.3"), 80, Ipv4Address("12.0.0.1"), 1),
+                          listener,
+                          "Wrong end point for another local address");
+    demux.DeAllocate(bound);
+
+    // the end points are found again after their peer changes
+    Ipv4EndPoint* client = demux.Allocate(local);
+    NS_TEST_ASSERT_MSG_NE(client, nullptr, "Client end point not allocated");
+    uint16_t port = client->GetLocalPort();
+    client->SetPeer(Ipv4Address("12.0.0.1"), 443);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, port, Ipv4Address("12.0.0.1"), 443),
+                          client,
+                          "Connected client not found");
+    client->SetPeer(Ipv4Address("12.0.0.2"), 443);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, port, Ipv4Address("12.0.0.1"), 443),
+                          nullptr,
+                          "Client found with its previous peer");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, port, Ipv4Address("12.0.0.2"), 443),
+                          client,
+                          "Client not found with its new peer");
+
+    // removed connections fall back to the listening end point
+    demux.DeAllocate(connections[0]);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, Ipv4Address(0x0b000000), 1000),
+                          listener,
+                          "Removed connection still found");
+    demux.DeAllocate(client);
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(port), false, "Port still in use");
+    NS_TEST_EXPECT_MSG_EQ(demux.GetAllEndPoints().size(), 1000, "Wrong number of end points");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief Ipv6EndPointDemux lookup test
+ */
+class Ipv6EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv6EndPointDemuxTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv6EndPointDemuxTestCase::Ipv6EndPointDemuxTestCase()
+    : TestCase("Lookup of listening and connected IPv6 end points")
+{
+}
+
+void
+Ipv6EndPointDemuxTestCase::DoRun()
+{
+    Ipv6EndPointDemux demux;
+    Ptr<Ipv6Interface> interface = CreateObject<Ipv6Interface>();
+    Ipv6Address local("2001:db8::1");
+    Ipv6Address peer("2001:db8::2");
+
+    auto lookup = [&](Ipv6Address daddr, uint16_t dport, Ipv6Address saddr, uint16_t sport) {
+        auto endPoints = demux.Lookup(daddr, dport, saddr, sport, interface);
+        return endPoints.empty() ? nullptr : endPoints.front();
+    };
+
+    Ipv6EndPoint* listener = demux.Allocate(nullptr, 80);
+    NS_TEST_ASSERT_MSG_NE(listener, nullptr, "Listening end point not allocated");
+    std::vector<Ipv6EndPoint*> connections;
+    for (uint16_t i = 0; i < 100; i++)
+    {
+        connections.push_back(demux.Allocate(nullptr, local, 80, peer, 1000 + i));
+        NS_TEST_ASSERT_MSG_NE(connections.back(), nullptr, "Connection not allocated");
+    }
+    NS_TEST_EXPECT_MSG_EQ(demux.Allocate(nullptr, local, 80, peer, 1000),
+                          nullptr,
+                          "Duplicated connection allocated");
+    for (uint16_t i = 0; i < 100; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, peer, 1000 + i),
+                              connections[i],
+                              "Wrong end point for connection " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, peer, 999),
+                          listener,
+                          "New connection not delivered to the listening end point");
+
+    Ipv6EndPoint* client = demux.Allocate(local);
+    NS_TEST_ASSERT_MSG_NE(client, nullptr, "Client end point not allocated");
+    uint16_t port = client->GetLocalPort();
+    client->SetPeer(peer, 443);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, port, peer, 443), client, "Connected client not found");
+    client->SetPeer(peer, 444);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, port, peer, 443),
+                          nullptr,
+                          "Client found with its previous peer");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, port, peer, 444),
+                          client,
+                          "Client not found with its new peer");
+
+    uint16_t newPort = port + 1;
+    NS_TEST_ASSERT_MSG_EQ(demux.LookupPortLocal(newPort), false, "Port already in use");
+    client->SetLocalPort(newPort);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, port, peer, 444),
+                          nullptr,
+                          "Client found with its previous local port");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, newPort, peer, 444),
+                          client,
+                          "Client not found with its new local port");
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(port), false, "Previous port still in use");
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(newPort), true, "New port not in use");
+
+    listener->SetLocalPort(8080);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 8080, peer, 999),
+                          listener,
+                          "Listening end point not found with its new local port");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, peer, 999),
+                          nullptr,
+                          "Listening end point found with its previous local port");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, peer, 1000),
+                          connections[0],
+                          "Connection not found after changing the port of the listener");
+
+    demux.DeAllocate(connections[0]);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, peer, 1000), nullptr, "Removed connection found");
+    demux.DeAllocate(client);
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(newPort), false, "Port still in use");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief End point demultiplexer TestSuite
+ */
+class EndPointDemuxTestSuite : public TestSuite
+{
+  public:
+    EndPointDemuxTestSuite()
+        : TestSuite("end-point-demux", Type::UNIT)
+    {
+        AddTestCase(new Ipv4EndPointDemuxTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new Ipv6EndPointDemuxTestCase, TestCase::Duration::QUICK);
+    }
+};
+
+static EndPointDemuxTestSuite g_endPointDemuxTestSuite; //!< Static variable for test initialization
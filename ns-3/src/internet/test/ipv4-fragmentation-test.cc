@@ -561,6 +561,36 @@ Ipv4FragmentationTest::DoRun()
         NS_TEST_EXPECT_MSG_EQ(end, m_receivedPacketServer->GetSize(), "trivial");
     }
 
+    // Fifth test: normal channel, no errors, each other fragment is duplicated.
+    // The packets should be received correctly since reassembly discards the duplicates.
+    channel->SetDuplicateTime(Seconds(0));
+    channel->SetDuplicateMode(true);
+    for (int i = 0; i < 5; i++)
+    {
+        uint32_t packetSize = packetSizes[i];
+
+        SetFill(fillData, 78, packetSize);
+
+        m_receivedPacketServer = Create<Packet>();
+        Simulator::ScheduleWithContext(m_socketClient->GetNode()->GetId(),
+                                       Seconds(0),
+                                       &Ipv4FragmentationTest::SendClient,
+                                       this);
+        Simulator::Run();
+
+        uint8_t recvBuffer[65000];
+
+        uint16_t recvSize = m_receivedPacketServer->GetSize();
+
+        NS_TEST_EXPECT_MSG_EQ(recvSize, packetSizes[i], "Packet size not correct");
+
+        m_receivedPacketServer->CopyData(recvBuffer, 65000);
+        NS_TEST_EXPECT_MSG_EQ(memcmp(m_data, recvBuffer, m_receivedPacketServer->GetSize()),
+                              0,
+                              "Packet content differs");
+    }
+    channel->SetDuplicateMode(false);
+
     Simulator::Destroy();
 }
 
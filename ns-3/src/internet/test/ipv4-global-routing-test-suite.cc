@@ -5,7 +5,9 @@
 #include "ns3/boolean.h"
 #include "ns3/bridge-helper.h"
 #include "ns3/config.h"
+#include "ns3/enum.h"
 #include "ns3/global-route-manager.h"
+#include "ns3/global-router-interface.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
@@ -29,9 +31,15 @@
 #include "ns3/socket-factory.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
+#include "ns3/udp-header.h"
+#include "ns3/udp-l4-protocol.h"
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
 #include <vector>
 using namespace ns3;
 
@@ -1397,6 +1405,474 @@ EcmpRouteCalculationTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief This TestCase checks that the routes updated after a topology
+ * change are the same as those computed from scratch, and that recomputing
+ * the routes restores all of them.
+ */
+class Ipv4GlobalRoutingRecomputeTestCase : public TestCase
+{
+  public:
+    Ipv4GlobalRoutingRecomputeTestCase();
+    void DoSetup() override;
+    void DoRun() override;
+
+  private:
+    /**
+     * @brief Get the global routes of all the nodes.
+     * @return the routes of each node, in order
+     */
+    std::vector<std::vector<std::string>> GetRoutes() const;
+
+    NodeContainer nodes; //!< Nodes used in the test.
+};
+
+Ipv4GlobalRoutingRecomputeTestCase::Ipv4GlobalRoutingRecomputeTestCase()
+    : TestCase("Global routes recomputed after a topology change")
+{
+}
+
+void
+Ipv4GlobalRoutingRecomputeTestCase::DoSetup()
+{
+    /*
+        //         Network Topology
+        //
+        //       n4----n0------n1
+        //             |        |
+        //             |        |
+        //             n3------n2----n5
+        //
+        //    Link n0-n1: 10.1.1.0/30
+        //    Link n1-n2: 10.1.2.0/30
+        //    Link n2-n3: 10.1.3.0/30
+        //    Link n3-n0: 10.1.4.0/30
+        //    Link n0-n4: 10.1.5.0/30
+        //    Link n2-n5: 10.1.6.0/30
+        //
+        //    n4 and n5 are stub nodes.
+    */
+    nodes.Create(6);
+
+    Ipv4GlobalRoutingHelper globalhelper;
+    InternetStackHelper stack;
+    stack.SetRoutingHelper(globalhelper);
+    stack.Install(nodes);
+    SimpleNetDeviceHelper devHelper;
+    devHelper.SetNetDevicePointToPointMode(true);
+
+    Ipv4AddressHelper address;
+    std::vector<std::pair<uint32_t, uint32_t>> links{{0, 1},
+                                                     {1, 2},
+                                                     {2, 3},
+                                                     {3, 0},
+                                                     {0, 4},
+                                                     {2, 5}};
+    for (std::size_t i = 0; i < links.size(); i++)
+    {
+        Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+        NetDeviceContainer devices = devHelper.Install(nodes.Get(links[i].first), channel);
+        devices.Add(devHelper.Install(nodes.Get(links[i].second), channel));
+        std::ostringstream network;
+        network << "10.1." << i + 1 << ".0";
+        address.SetBase(network.str().c_str(), "255.255.255.252");
+        address.Assign(devices);
+    }
+}
+
+std::vector<std::vector<std::string>>
+Ipv4GlobalRoutingRecomputeTestCase::GetRoutes() const
+{
+    std::vector<std::vector<std::string>> routes;
+    for (auto it = nodes.Begin(); it != nodes.End(); it++)
+    {
+        Ptr<Ipv4GlobalRouting> gr = (*it)->GetObject<GlobalRouter>()->GetRoutingProtocol();
+        routes.emplace_back();
+        for (uint32_t i = 0; i < gr->GetNRoutes(); i++)
+        {
+            std::ostringstream route;
+            route << *gr->GetRoute(i);
+            routes.back().push_back(route.str());
+        }
+    }
+    return routes;
+}
+
+void
+Ipv4GlobalRoutingRecomputeTestCase::DoRun()
+{
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    auto initial = GetRoutes();
+    NS_TEST_ASSERT_MSG_GT(initial[1].size(), 0, "No routes computed");
+    NS_TEST_ASSERT_MSG_EQ(initial[4].size(), 1, "A stub node has a single default route");
+
+    // bring the link n0-n1 down
+    Ptr<Ipv4> ipv4 = nodes.Get(1)->GetObject<Ipv4>();
+    uint32_t interface = ipv4->GetInterfaceForAddress(Ipv4Address("10.1.1.2"));
+    ipv4->SetDown(interface);
+    Ipv4GlobalRoutingHelper::UpdateRoutingTables();
+    auto recomputed = GetRoutes();
+    NS_TEST_EXPECT_MSG_NE((recomputed[1] == initial[1]), true, "Routes of n1 not updated");
+    NS_TEST_EXPECT_MSG_EQ((recomputed[4] == initial[4]), true, "Routes of stub n4 changed");
+
+    GlobalRouteManager::DeleteGlobalRoutes();
+    GlobalRouteManager::BuildGlobalRoutingDatabase();
+    GlobalRouteManager::InitializeRoutes();
+    auto expected = GetRoutes();
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ((recomputed[i] == expected[i]),
+                              true,
+                              "Routes of node " << i << " differ from a full computation");
+    }
+
+    // bring the link back up
+    ipv4->SetUp(interface);
+    Ipv4GlobalRoutingHelper::UpdateRoutingTables();
+    NS_TEST_EXPECT_MSG_EQ((GetRoutes() == initial), true, "Initial routes not restored");
+    Ipv4GlobalRoutingHelper::UpdateRoutingTables();
+    NS_TEST_EXPECT_MSG_EQ((GetRoutes() == initial), true, "Routes changed with no topology change");
+
+    // a route removed by hand is only restored by a full computation of the routes
+    Ptr<Ipv4GlobalRouting> gr = nodes.Get(1)->GetObject<GlobalRouter>()->GetRoutingProtocol();
+    gr->RemoveRoute(0);
+    Ipv4GlobalRoutingHelper::UpdateRoutingTables();
+    NS_TEST_EXPECT_MSG_EQ(GetRoutes()[1].size(),
+                          initial[1].size() - 1,
+                          "Routes updated with no topology change");
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    NS_TEST_EXPECT_MSG_EQ((GetRoutes() == initial), true, "Routes removed by hand not restored");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief This TestCase checks the selection of a route among equal-cost
+ * routes in the different ECMP modes.
+ */
+class Ipv4GlobalRoutingEcmpModesTestCase : public TestCase
+{
+  public:
+    Ipv4GlobalRoutingEcmpModesTestCase();
+    void DoSetup() override;
+    void DoRun() override;
+
+  private:
+    /**
+     * @brief Forward a UDP packet through the node with equal-cost routes.
+     * @param sourcePort the source port of the packet
+     * @return the gateway of the selected route
+     */
+    Ipv4Address Forward(uint16_t sourcePort);
+
+    /**
+     * @brief Callback function for RouteInput() API of GlobalRoutingProtocol.
+     * @param route the selected route
+     * @param p the packet
+     * @param header the IPv4 header
+     */
+    void Unicast(Ptr<Ipv4Route> route, Ptr<const Packet> p, const Ipv4Header& header);
+
+    NodeContainer nodes;                  //!< Nodes used in the test.
+    Ptr<Ipv4GlobalRouting> m_routing;     //!< Routing protocol of the node with ECMP routes.
+    Ptr<NetDevice> m_inputDevice;         //!< Device receiving the packets.
+    Ipv4Address m_gateway;                //!< Gateway of the last selected route.
+};
+
+Ipv4GlobalRoutingEcmpModesTestCase::Ipv4GlobalRoutingEcmpModesTestCase()
+    : TestCase("Global routing ECMP modes")
+{
+}
+
+void
+Ipv4GlobalRoutingEcmpModesTestCase::DoSetup()
+{
+    /*
+        //         Network Topology
+        //
+        //                  ----n2----
+        //                 /          \
+        //       n0------n1-----n3-----n5------n6
+        //                 \          /
+        //                  ----n4----
+        //
+        //    Link n0-n1: 10.1.1.0/30
+        //    Link n1-n2, n1-n3, n1-n4: 10.1.2.0/30, 10.1.3.0/30, 10.1.4.0/30
+        //    Link n2-n5, n3-n5, n4-n5: 10.1.5.0/30, 10.1.6.0/30, 10.1.7.0/30
+        //    Link n5-n6: 10.1.8.0/30
+        //
+        //    n1 has three equal-cost routes to n6.
+    */
+    nodes.Create(7);
+
+    Ipv4GlobalRoutingHelper globalhelper;
+    InternetStackHelper stack;
+    stack.SetRoutingHelper(globalhelper);
+    stack.Install(nodes);
+    SimpleNetDeviceHelper devHelper;
+    devHelper.SetNetDevicePointToPointMode(true);
+
+    Ipv4AddressHelper address;
+    std::vector<std::pair<uint32_t, uint32_t>> links{{0, 1},
+                                                     {1, 2},
+                                                     {1, 3},
+                                                     {1, 4},
+                                                     {2, 5},
+                                                     {3, 5},
+                                                     {4, 5},
+                                                     {5, 6}};
+    for (std::size_t i = 0; i < links.size(); i++)
+    {
+        Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+        NetDeviceContainer devices = devHelper.Install(nodes.Get(links[i].first), channel);
+        devices.Add(devHelper.Install(nodes.Get(links[i].second), channel));
+        std::ostringstream network;
+        network << "10.1." << i + 1 << ".0";
+        address.SetBase(network.str().c_str(), "255.255.255.252");
+        address.Assign(devices);
+        if (i == 0)
+        {
+            m_inputDevice = devices.Get(1);
+        }
+    }
+    m_routing = nodes.Get(1)->GetObject<GlobalRouter>()->GetRoutingProtocol();
+}
+
+void
+Ipv4GlobalRoutingEcmpModesTestCase::Unicast(Ptr<Ipv4Route> route,
+                                            Ptr<const Packet> p,
+                                            const Ipv4Header& header)
+{
+    m_gateway = route->GetGateway();
+}
+
+Ipv4Address
+Ipv4GlobalRoutingEcmpModesTestCase::Forward(uint16_t sourcePort)
+{
+    Ptr<Packet> packet = Create<Packet>(100);
+    UdpHeader udpHeader;
+    udpHeader.SetSourcePort(sourcePort);
+    udpHeader.SetDestinationPort(9);
+    packet->AddHeader(udpHeader);
+    Ipv4Header ipHeader;
+    ipHeader.SetSource(Ipv4Address("10.1.1.1"));
+    ipHeader.SetDestination(Ipv4Address("10.1.8.2"));
+    ipHeader.SetProtocol(UdpL4Protocol::PROT_NUMBER);
+
+    m_gateway = Ipv4Address();
+    m_routing->RouteInput(packet,
+                          ipHeader,
+                          m_inputDevice,
+                          MakeCallback(&Ipv4GlobalRoutingEcmpModesTestCase::Unicast, this),
+                          Ipv4RoutingProtocol::MulticastForwardCallback(),
+                          Ipv4RoutingProtocol::LocalDeliverCallback(),
+                          Ipv4RoutingProtocol::ErrorCallback());
+    return m_gateway;
+}
+
+void
+Ipv4GlobalRoutingEcmpModesTestCase::DoRun()
+{
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    const std::set<Ipv4Address> gateways{Ipv4Address("10.1.2.2"),
+                                         Ipv4Address("10.1.3.2"),
+                                         Ipv4Address("10.1.4.2")};
+
+    // no ECMP: always the first route
+    Ipv4Address first = Forward(1000);
+    NS_TEST_ASSERT_MSG_EQ(gateways.contains(first), true, "Unexpected gateway " << first);
+    for (uint16_t port = 1001; port < 1010; port++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(Forward(port), first, "Not the first route");
+    }
+
+    // per-flow hashing: the packets of a flow follow the same route, and the
+    // flows are spread over all the routes
+    m_routing->SetAttribute("EcmpMode", EnumValue(Ipv4GlobalRouting::ECMP_FLOW_HASH));
+    Ipv4Address flowGateway = Forward(1000);
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(Forward(1000), flowGateway, "Packets of a flow on several routes");
+    }
+    std::set<Ipv4Address> used;
+    for (uint16_t port = 1000; port < 1100; port++)
+    {
+        used.insert(Forward(port));
+    }
+    NS_TEST_EXPECT_MSG_EQ((used == gateways), true, "Flows not spread over all the routes");
+
+    // packet spraying: the routes are used in turn
+    m_routing->SetAttribute("EcmpMode", EnumValue(Ipv4GlobalRouting::ECMP_SPRAY));
+    std::vector<Ipv4Address> sprayed;
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        sprayed.push_back(Forward(1000));
+    }
+    std::set<Ipv4Address> firstSprayed(sprayed.begin(), sprayed.begin() + 3);
+    NS_TEST_EXPECT_MSG_EQ((firstSprayed == gateways), true, "Routes not used in turn");
+    for (uint32_t i = 3; i < 6; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(sprayed[i], sprayed[i - 3], "Routes not used in turn");
+    }
+
+    // weighted ECMP: the route through n2 is used twice as often
+    uint32_t interface =
+        nodes.Get(1)->GetObject<Ipv4>()->GetInterfaceForAddress(Ipv4Address("10.1.2.1"));
+    m_routing->SetInterfaceWeight(interface, 2);
+    std::map<Ipv4Address, uint32_t> counts;
+    for (uint32_t i = 0; i < 40; i++)
+    {
+        counts[Forward(1000)]++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(counts[Ipv4Address("10.1.2.2")], 20, "Weights not applied");
+    NS_TEST_EXPECT_MSG_EQ(counts[Ipv4Address("10.1.3.2")], 10, "Weights not applied");
+    m_routing->SetInterfaceWeight(interface, 1);
+
+    // flowlets: the route of a flow only changes after a gap longer than the timeout
+    m_routing->SetAttribute("EcmpMode", EnumValue(Ipv4GlobalRouting::ECMP_FLOWLET));
+    m_routing->SetAttribute("FlowletTimeout", TimeValue(MilliSeconds(1)));
+    std::vector<Ipv4Address> flowlets(100);
+    uint32_t changesWithinTimeout = 0;
+    uint32_t changesAfterGap = 0;
+    for (uint16_t port = 0; port < 100; port++)
+    {
+        flowlets[port] = Forward(2000 + port);
+    }
+    Simulator::Schedule(MicroSeconds(500), [&]() {
+        for (uint16_t port = 0; port < 100; port++)
+        {
+            changesWithinTimeout += (Forward(2000 + port) != flowlets[port]);
+        }
+    });
+    Simulator::Schedule(MicroSeconds(2500), [&]() {
+        for (uint16_t port = 0; port < 100; port++)
+        {
+            changesAfterGap += (Forward(2000 + port) != flowlets[port]);
+        }
+    });
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(changesWithinTimeout, 0, "Route of a flowlet changed");
+    NS_TEST_EXPECT_MSG_GT(changesAfterGap, 0, "Route never changed after a gap");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief This TestCase checks the route lookup restricted to an output
+ * interface when the only route on that interface is an external route, while
+ * the host and network routes to the destination use another interface.
+ */
+class Ipv4GlobalRoutingOifTestCase : public TestCase
+{
+  public:
+    Ipv4GlobalRoutingOifTestCase();
+    void DoRun() override;
+};
+
+Ipv4GlobalRoutingOifTestCase::Ipv4GlobalRoutingOifTestCase()
+    : TestCase("Global routing lookup restricted to an output interface")
+{
+}
+
+void
+Ipv4GlobalRoutingOifTestCase::DoRun()
+{
+    /*
+        //    n1------n0------n2
+        //
+        //    Link n0-n1: 10.1.1.0/30
+        //    Link n0-n2: 10.1.2.0/30
+        //
+        //    n0 has host and network routes to 192.168.0.1 through n1 and an
+        //    external route to 192.168.0.0/16 through n2.
+    */
+    NodeContainer nodes(3);
+
+    Ipv4GlobalRoutingHelper globalhelper;
+    InternetStackHelper stack;
+    stack.SetRoutingHelper(globalhelper);
+    stack.Install(nodes);
+    SimpleNetDeviceHelper devHelper;
+    devHelper.SetNetDevicePointToPointMode(true);
+
+    Ipv4AddressHelper address;
+    std::vector<Ptr<NetDevice>> devices;
+    for (uint32_t i = 1; i <= 2; i++)
+    {
+        Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+        NetDeviceContainer link = devHelper.Install(nodes.Get(0), channel);
+        link.Add(devHelper.Install(nodes.Get(i), channel));
+        std::ostringstream network;
+        network << "10.1." << i << ".0";
+        address.SetBase(network.str().c_str(), "255.255.255.252");
+        address.Assign(link);
+        devices.push_back(link.Get(0));
+    }
+
+    Ptr<Ipv4GlobalRouting> routing =
+        nodes.Get(0)->GetObject<GlobalRouter>()->GetRoutingProtocol();
+    Ptr<Ipv4> ipv4 = nodes.Get(0)->GetObject<Ipv4>();
+    uint32_t interface1 = ipv4->GetInterfaceForDevice(devices[0]);
+    uint32_t interface2 = ipv4->GetInterfaceForDevice(devices[1]);
+    Ipv4Address dest("192.168.0.1");
+    routing->AddHostRouteTo(dest, Ipv4Address("10.1.1.2"), interface1);
+    routing->AddNetworkRouteTo(Ipv4Address("192.168.0.0"),
+                               Ipv4Mask("255.255.255.0"),
+                               Ipv4Address("10.1.1.2"),
+                               interface1);
+    routing->AddASExternalRouteTo(Ipv4Address("192.168.0.0"),
+                                  Ipv4Mask("255.255.0.0"),
+                                  Ipv4Address("10.1.2.2"),
+                                  interface2);
+
+    Ipv4Header ipHeader;
+    ipHeader.SetSource(Ipv4Address("10.1.2.1"));
+    ipHeader.SetDestination(dest);
+    ipHeader.SetProtocol(UdpL4Protocol::PROT_NUMBER);
+
+    auto lookup = [&](Ptr<NetDevice> oif) {
+        Ptr<Packet> packet = Create<Packet>(100);
+        UdpHeader udpHeader;
+        udpHeader.SetSourcePort(1000);
+        udpHeader.SetDestinationPort(9);
+        packet->AddHeader(udpHeader);
+        Socket::SocketErrno errno_;
+        Ptr<Ipv4Route> route = routing->RouteOutput(packet, ipHeader, oif, errno_);
+        return route ? route->GetGateway() : Ipv4Address();
+    };
+
+    for (auto mode : {Ipv4GlobalRouting::ECMP_RANDOM,
+                      Ipv4GlobalRouting::ECMP_FLOW_HASH,
+                      Ipv4GlobalRouting::ECMP_SPRAY,
+                      Ipv4GlobalRouting::ECMP_FLOWLET})
+    {
+        routing->SetAttribute("EcmpMode", EnumValue(mode));
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(lookup(devices[0]),
+                                  Ipv4Address("10.1.1.2"),
+                                  "Wrong gateway on the first interface in mode " << mode);
+            NS_TEST_EXPECT_MSG_EQ(lookup(devices[1]),
+                                  Ipv4Address("10.1.2.2"),
+                                  "Wrong gateway on the second interface in mode " << mode);
+        }
+    }
+
+    routing->SetAttribute("EcmpMode", EnumValue(Ipv4GlobalRouting::ECMP_NONE));
+    routing->SetAttribute("RandomEcmpRouting", BooleanValue(true));
+    NS_TEST_EXPECT_MSG_EQ(lookup(devices[1]),
+                          Ipv4Address("10.1.2.2"),
+                          "Wrong gateway on the second interface with random ECMP routing");
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -1783,6 +2259,9 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite()
     AddTestCase(new Ipv4DynamicGlobalRoutingTestCase, TestCase::Duration::QUICK);
     AddTestCase(new Ipv4GlobalRoutingSlash32TestCase, TestCase::Duration::QUICK);
     AddTestCase(new EcmpRouteCalculationTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4GlobalRoutingRecomputeTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4GlobalRoutingEcmpModesTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4GlobalRoutingOifTestCase, TestCase::Duration::QUICK);
     AddTestCase(new GlobalRoutingProtocolTestCase, TestCase::Duration::QUICK);
 }
 
@@ -279,6 +279,131 @@ Ipv4HeaderTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 Header checksum Test
+ *
+ * Checks that the checksum of a deserialized header is updated incrementally
+ * (RFC 1624) when the TTL or the TOS are rewritten, recomputed when other
+ * fields are rewritten, and assumed valid when the header trusts it.
+ */
+class Ipv4HeaderChecksumTest : public TestCase
+{
+  public:
+    Ipv4HeaderChecksumTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Serialize a header and deserialize it, with checksums enabled.
+     * @param header The header to serialize.
+     * @param trust Whether the deserialized header trusts the checksum.
+     * @param corrupt Whether to corrupt the checksum of the serialized header.
+     * @return The deserialized header.
+     */
+    Ipv4Header RoundTrip(const Ipv4Header& header, bool trust = false, bool corrupt = false);
+
+    /**
+     * @brief Get the checksum of a serialized header.
+     * @param header The header.
+     * @return The checksum field, as written by the header.
+     */
+    uint16_t GetChecksum(const Ipv4Header& header);
+};
+
+Ipv4HeaderChecksumTest::Ipv4HeaderChecksumTest()
+    : TestCase("IPv4 Header checksum incremental update and virtual checksum valid")
+{
+}
+
+Ipv4Header
+Ipv4HeaderChecksumTest::RoundTrip(const Ipv4Header& header, bool trust, bool corrupt)
+{
+    Ptr<Packet> packet = Create<Packet>(100);
+    packet->AddHeader(header);
+    if (corrupt)
+    {
+        uint8_t bytes[20];
+        packet->CopyData(bytes, 20);
+        bytes[10] ^= 0x01;
+        Ptr<Packet> corrupted = Create<Packet>(bytes, 20);
+        packet->RemoveAtStart(20);
+        corrupted->AddAtEnd(packet);
+        packet = corrupted;
+    }
+    Ipv4Header received;
+    received.EnableChecksum();
+    if (trust)
+    {
+        received.TrustChecksum();
+    }
+    packet->RemoveHeader(received);
+    return received;
+}
+
+uint16_t
+Ipv4HeaderChecksumTest::GetChecksum(const Ipv4Header& header)
+{
+    Ptr<Packet> packet = Create<Packet>();
+    packet->AddHeader(header);
+    uint8_t bytes[20];
+    packet->CopyData(bytes, 20);
+    return (bytes[10] << 8) | bytes[11];
+}
+
+void
+Ipv4HeaderChecksumTest::DoRun()
+{
+    Ipv4Header header;
+    header.EnableChecksum();
+    header.SetSource(Ipv4Address("10.1.2.3"));
+    header.SetDestination(Ipv4Address("192.168.200.1"));
+    header.SetProtocol(17);
+    header.SetPayloadSize(100);
+    header.SetIdentification(0xbeef);
+    header.SetTtl(64);
+    header.SetDscp(Ipv4Header::DSCP_AF21);
+    header.SetEcn(Ipv4Header::ECN_ECT0);
+
+    Ipv4Header received = RoundTrip(header);
+    NS_TEST_ASSERT_MSG_EQ(received.IsChecksumOk(), true, "Bad checksum of a valid header");
+
+    // forward through many routers, marking the packet as congested half way
+    for (uint8_t ttl = 63; ttl > 0; ttl--)
+    {
+        received.SetTtl(ttl);
+        header.SetTtl(ttl);
+        if (ttl == 32)
+        {
+            received.SetEcn(Ipv4Header::ECN_CE);
+            header.SetEcn(Ipv4Header::ECN_CE);
+        }
+        NS_TEST_ASSERT_MSG_EQ(GetChecksum(received),
+                              GetChecksum(header),
+                              "Wrong incremental update for TTL " << +ttl);
+        received = RoundTrip(received);
+        NS_TEST_ASSERT_MSG_EQ(received.IsChecksumOk(), true, "Bad checksum for TTL " << +ttl);
+    }
+
+    // rewriting another field recomputes the checksum
+    received.SetDestination(Ipv4Address("172.16.0.1"));
+    header.SetDestination(Ipv4Address("172.16.0.1"));
+    NS_TEST_ASSERT_MSG_EQ(GetChecksum(received), GetChecksum(header), "Checksum not recomputed");
+
+    // a corrupted checksum is detected, unless the checksum is trusted
+    NS_TEST_ASSERT_MSG_EQ(RoundTrip(header, false, true).IsChecksumOk(),
+                          false,
+                          "Corrupted checksum not detected");
+    NS_TEST_ASSERT_MSG_EQ(RoundTrip(header, true, true).IsChecksumOk(),
+                          true,
+                          "Trusted checksum verified");
+    NS_TEST_ASSERT_MSG_EQ(GetChecksum(RoundTrip(header, true)),
+                          GetChecksum(header),
+                          "Trusted checksum not forwarded");
+}
+
 /**
  * @ingroup internet-test
  *
@@ -291,6 +416,7 @@ class Ipv4HeaderTestSuite : public TestSuite
         : TestSuite("ipv4-header", Type::UNIT)
     {
         AddTestCase(new Ipv4HeaderTest, TestCase::Duration::QUICK);
+        AddTestCase(new Ipv4HeaderChecksumTest, TestCase::Duration::QUICK);
     }
 };
 
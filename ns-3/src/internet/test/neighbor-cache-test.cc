@@ -7,6 +7,8 @@
  */
 
 #include "ns3/arp-cache.h"
+#include "ns3/arp-l3-protocol.h"
+#include "ns3/boolean.h"
 #include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/icmpv6-l4-protocol.h"
 #include "ns3/internet-stack-helper.h"
@@ -1277,6 +1279,252 @@ DynamicPartialTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief ARP cache aging sweep Test
+ */
+class ArpCacheAgingTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    ArpCacheAgingTest();
+
+  private:
+    /**
+     * @brief Check if an address has an entry in the cache.
+     * @param cache The ARP cache.
+     * @param address The IPv4 address.
+     * @param expected True if the entry is expected to be in the cache.
+     */
+    void CheckEntry(Ptr<ArpCache> cache, Ipv4Address address, bool expected);
+};
+
+ArpCacheAgingTest::ArpCacheAgingTest()
+    : TestCase("The ArpCacheAgingTest checks that the periodic sweep removes the expired entries.")
+{
+}
+
+void
+ArpCacheAgingTest::CheckEntry(Ptr<ArpCache> cache, Ipv4Address address, bool expected)
+{
+    NS_TEST_EXPECT_MSG_EQ((cache->Lookup(address) != nullptr),
+                          expected,
+                          "Unexpected entry for " << address << " at " << Simulator::Now().As());
+}
+
+void
+ArpCacheAgingTest::DoRun()
+{
+    Ptr<ArpCache> cache = CreateObject<ArpCache>();
+    cache->SetAttribute("AgingInterval", TimeValue(Seconds(1)));
+    cache->SetDeadTimeout(Seconds(5));
+    cache->SetAliveTimeout(Seconds(20));
+
+    Ipv4Address dead("10.0.0.1");
+    Ipv4Address alive("10.0.0.2");
+    Ipv4Address permanent("10.0.0.3");
+    cache->Add(dead)->MarkDead();
+    ArpCache::Entry* entry = cache->Add(alive);
+    entry->SetMacAddress(Mac48Address("00:00:00:00:00:02"));
+    entry->UpdateSeen();
+    entry = cache->Add(permanent);
+    entry->SetMacAddress(Mac48Address("00:00:00:00:00:03"));
+    entry->MarkPermanent();
+
+    // the alive entry is refreshed at 10 s, it expires after 30 s
+    Simulator::Schedule(Seconds(10), [&]() { cache->Lookup(alive)->UpdateSeen(); });
+    Simulator::Schedule(Seconds(4), &ArpCacheAgingTest::CheckEntry, this, cache, dead, true);
+    Simulator::Schedule(Seconds(7), &ArpCacheAgingTest::CheckEntry, this, cache, dead, false);
+    Simulator::Schedule(Seconds(25), &ArpCacheAgingTest::CheckEntry, this, cache, alive, true);
+    Simulator::Schedule(Seconds(32), &ArpCacheAgingTest::CheckEntry, this, cache, alive, false);
+    Simulator::Schedule(Seconds(40), &ArpCacheAgingTest::CheckEntry, this, cache, permanent, true);
+
+    Simulator::Run();
+
+    // the sweep stops once only the permanent entry is left
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), Seconds(40), "The sweep has not stopped");
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief NDISC cache NUD timers Test
+ */
+class NdiscCacheTimerTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    NdiscCacheTimerTest();
+
+  private:
+    /**
+     * @brief Check if an entry is in REACHABLE state.
+     * @param cache The NDISC cache.
+     * @param address The IPv6 address of the entry.
+     * @param expected True if the entry is expected to be reachable.
+     */
+    void CheckReachable(Ptr<NdiscCache> cache, Ipv6Address address, bool expected);
+};
+
+NdiscCacheTimerTest::NdiscCacheTimerTest()
+    : TestCase("The NdiscCacheTimerTest checks the NUD timers of the entries sharing an event.")
+{
+}
+
+void
+NdiscCacheTimerTest::CheckReachable(Ptr<NdiscCache> cache, Ipv6Address address, bool expected)
+{
+    NdiscCache::Entry* entry = cache->Lookup(address);
+    NS_TEST_ASSERT_MSG_NE(entry, nullptr, "No entry for " << address);
+    NS_TEST_EXPECT_MSG_EQ(entry->IsReachable(),
+                          expected,
+                          "Unexpected state of " << address << " at " << Simulator::Now().As());
+}
+
+void
+NdiscCacheTimerTest::DoRun()
+{
+    Ptr<Icmpv6L4Protocol> icmpv6 = CreateObject<Icmpv6L4Protocol>();
+    icmpv6->SetAttribute("ReachableTime", TimeValue(Seconds(30)));
+    Ptr<NdiscCache> cache = CreateObject<NdiscCache>();
+    cache->SetDevice(nullptr, nullptr, icmpv6);
+
+    Ipv6Address confirmed("2001::1");
+    Ipv6Address expiring("2001::2");
+    Ipv6Address stopped("2001::3");
+    Ipv6Address removed("2001::4");
+    for (const auto& address : {confirmed, expiring, stopped, removed})
+    {
+        NdiscCache::Entry* entry = cache->Add(address);
+        entry->MarkReachable(Mac48Address("00:00:00:00:00:01"));
+        entry->StartReachableTimer();
+    }
+
+    // a reachability confirmation postpones the timer of the first entry to 50 s
+    Simulator::Schedule(Seconds(20), [&]() { cache->Lookup(confirmed)->UpdateReachableTimer(); });
+    Simulator::Schedule(Seconds(10), [&]() { cache->Lookup(stopped)->StopNudTimer(); });
+    Simulator::Schedule(Seconds(10), [&]() { cache->Remove(cache->Lookup(removed)); });
+
+    auto check = [&](Time at, Ipv6Address address, bool expected) {
+        Simulator::Schedule(at,
+                            &NdiscCacheTimerTest::CheckReachable,
+                            this,
+                            cache,
+                            address,
+                            expected);
+    };
+    check(Seconds(29), expiring, true);
+    check(Seconds(31), expiring, false);
+    check(Seconds(31), stopped, true);
+    check(Seconds(49), confirmed, true);
+    check(Seconds(51), confirmed, false);
+    check(Seconds(51), stopped, true);
+
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(cache->Lookup(removed), nullptr, "Removed entry found");
+    cache->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief Static Neighbor Cache Test
+ */
+class StaticNeighborCacheTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    StaticNeighborCacheTest();
+
+  private:
+    /**
+     * @brief Receive data.
+     * @param socket The receiving socket.
+     */
+    void ReceivePkt(Ptr<Socket> socket);
+
+    /**
+     * @brief Count the packets dropped by ARP.
+     * @param packet The dropped packet.
+     */
+    void ArpDrop(Ptr<const Packet> packet);
+
+    uint32_t m_received{0}; //!< Number of received packets
+    uint32_t m_dropped{0};  //!< Number of packets dropped by ARP
+};
+
+StaticNeighborCacheTest::StaticNeighborCacheTest()
+    : TestCase("The StaticNeighborCacheTest checks that static caches do not resolve addresses.")
+{
+}
+
+void
+StaticNeighborCacheTest::ReceivePkt(Ptr<Socket> socket)
+{
+    while (socket->Recv())
+    {
+        m_received++;
+    }
+}
+
+void
+StaticNeighborCacheTest::ArpDrop(Ptr<const Packet> packet)
+{
+    m_dropped++;
+}
+
+void
+StaticNeighborCacheTest::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    SimpleNetDeviceHelper simpleHelper;
+    NetDeviceContainer net = simpleHelper.Install(nodes, channel);
+
+    InternetStackHelper internet;
+    internet.SetIpv6StackInstall(false);
+    internet.Install(nodes);
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(net);
+
+    NeighborCacheHelper neighborCache;
+    neighborCache.PopulateNeighborCache(channel);
+
+    Ptr<ArpCache> arpCache =
+        nodes.Get(0)->GetObject<Ipv4L3Protocol>()->GetInterface(1)->GetArpCache();
+    arpCache->SetAttribute("Static", BooleanValue(true));
+    nodes.Get(0)->GetObject<ArpL3Protocol>()->TraceConnectWithoutContext(
+        "Drop",
+        MakeCallback(&StaticNeighborCacheTest::ArpDrop, this));
+
+    Ptr<Socket> rxSocket = Socket::CreateSocket(nodes.Get(1), UdpSocketFactory::GetTypeId());
+    rxSocket->Bind(InetSocketAddress(Ipv4Address::GetAny(), 1234));
+    rxSocket->SetRecvCallback(MakeCallback(&StaticNeighborCacheTest::ReceivePkt, this));
+
+    Ptr<Socket> txSocket = Socket::CreateSocket(nodes.Get(0), UdpSocketFactory::GetTypeId());
+    Ipv4Address neighbor = interfaces.GetAddress(1);
+    Ipv4Address unknown("10.1.1.9");
+    Simulator::Schedule(Seconds(1), [&]() {
+        txSocket->SendTo(Create<Packet>(100), 0, InetSocketAddress(neighbor, 1234));
+        txSocket->SendTo(Create<Packet>(100), 0, InetSocketAddress(unknown, 1234));
+    });
+
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_received, 1, "The packet to the neighbor has not been received");
+    NS_TEST_EXPECT_MSG_EQ(m_dropped, 1, "The packet to the unknown address has not been dropped");
+    NS_TEST_EXPECT_MSG_EQ(arpCache->Lookup(unknown), nullptr, "The unknown address was resolved");
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -1295,6 +1543,9 @@ class NeighborCacheTestSuite : public TestSuite
         AddTestCase(new FlushTest, TestCase::Duration::QUICK);
         AddTestCase(new DuplicateTest, TestCase::Duration::QUICK);
         AddTestCase(new DynamicPartialTest, TestCase::Duration::QUICK);
+        AddTestCase(new ArpCacheAgingTest, TestCase::Duration::QUICK);
+        AddTestCase(new NdiscCacheTimerTest, TestCase::Duration::QUICK);
+        AddTestCase(new StaticNeighborCacheTest, TestCase::Duration::QUICK);
     }
 };
 
@@ -0,0 +1,199 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/prefix-trie.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief PrefixTrie basic operations test
+ */
+class PrefixTrieBasicTestCase : public TestCase
+{
+  public:
+    PrefixTrieBasicTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PrefixTrieBasicTestCase::PrefixTrieBasicTestCase()
+    : TestCase("Insert, find, erase and longest prefix match of a few prefixes")
+{
+}
+
+void
+PrefixTrieBasicTestCase::DoRun()
+{
+    PrefixTrie<4, int> trie;
+    NS_TEST_EXPECT_MSG_EQ(trie.Size(), 0, "Unexpected size of an empty trie");
+
+    trie.Insert({0, 0, 0, 0}, 0) = 1;        // 0.0.0.0/0
+    trie.Insert({10, 0, 0, 0}, 8) = 2;       // 10.0.0.0/8
+    trie.Insert({10, 1, 0, 0}, 16) = 3;      // 10.1.0.0/16
+    trie.Insert({10, 1, 2, 3}, 32) = 4;      // 10.1.2.3/32
+    trie.Insert({10, 128, 0, 0}, 9) = 5;     // 10.128.0.0/9
+    trie.Insert({10, 1, 255, 255}, 16) += 0; // already stored, the host bits are ignored
+    NS_TEST_EXPECT_MSG_EQ(trie.Size(), 5, "Unexpected number of prefixes");
+
+    NS_TEST_ASSERT_MSG_NE(trie.Find({10, 1, 0, 0}, 16), nullptr, "10.1.0.0/16 not found");
+    NS_TEST_EXPECT_MSG_EQ(*trie.Find({10, 1, 0, 0}, 16), 3, "Wrong value for 10.1.0.0/16");
+    NS_TEST_EXPECT_MSG_EQ(trie.Find({10, 1, 0, 0}, 15), nullptr, "10.0.0.0/15 found");
+    NS_TEST_EXPECT_MSG_EQ(trie.Find({10, 2, 0, 0}, 16), nullptr, "10.2.0.0/16 found");
+
+    auto longest = [&trie](PrefixTrie<4, int>::Key key) {
+        int value = 0;
+        trie.LongestMatch(key, [&value](uint8_t, int& v) {
+            value = v;
+            return true;
+        });
+        return value;
+    };
+
+    NS_TEST_EXPECT_MSG_EQ(longest({10, 1, 2, 3}), 4, "Wrong match for 10.1.2.3");
+    NS_TEST_EXPECT_MSG_EQ(longest({10, 1, 2, 4}), 3, "Wrong match for 10.1.2.4");
+    NS_TEST_EXPECT_MSG_EQ(longest({10, 2, 0, 1}), 2, "Wrong match for 10.2.0.1");
+    NS_TEST_EXPECT_MSG_EQ(longest({10, 200, 0, 1}), 5, "Wrong match for 10.200.0.1");
+    NS_TEST_EXPECT_MSG_EQ(longest({192, 168, 0, 1}), 1, "Wrong match for 192.168.0.1");
+
+    // all the matching prefixes are visited, from the longest to the shortest
+    std::vector<uint8_t> lengths;
+    trie.LongestMatch({10, 1, 2, 3}, [&lengths](uint8_t length, int&) {
+        lengths.push_back(length);
+        return false;
+    });
+    NS_TEST_ASSERT_MSG_EQ(lengths.size(), 4, "Unexpected number of matching prefixes");
+    NS_TEST_EXPECT_MSG_EQ(+lengths[0], 32, "Unexpected longest prefix");
+    NS_TEST_EXPECT_MSG_EQ(+lengths[3], 0, "Unexpected shortest prefix");
+
+    NS_TEST_EXPECT_MSG_EQ(trie.Erase({10, 1, 0, 0}, 16), true, "10.1.0.0/16 not erased");
+    NS_TEST_EXPECT_MSG_EQ(trie.Erase({10, 1, 0, 0}, 16), false, "10.1.0.0/16 erased twice");
+    NS_TEST_EXPECT_MSG_EQ(longest({10, 1, 2, 4}), 2, "Wrong match for 10.1.2.4 after erase");
+    NS_TEST_EXPECT_MSG_EQ(longest({10, 1, 2, 3}), 4, "Wrong match for 10.1.2.3 after erase");
+    NS_TEST_EXPECT_MSG_EQ(trie.Erase({0, 0, 0, 0}, 0), true, "0.0.0.0/0 not erased");
+    NS_TEST_EXPECT_MSG_EQ(longest({192, 168, 0, 1}), 0, "Unexpected match for 192.168.0.1");
+    NS_TEST_EXPECT_MSG_EQ(trie.Size(), 3, "Unexpected number of prefixes after erase");
+
+    trie.Clear();
+    NS_TEST_EXPECT_MSG_EQ(trie.Size(), 0, "Unexpected size of a cleared trie");
+    NS_TEST_EXPECT_MSG_EQ(longest({10, 1, 2, 3}), 0, "Unexpected match in a cleared trie");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief PrefixTrie randomized test against a linear longest prefix match
+ */
+class PrefixTrieRandomTestCase : public TestCase
+{
+  public:
+    PrefixTrieRandomTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PrefixTrieRandomTestCase::PrefixTrieRandomTestCase()
+    : TestCase("Random insertions and removals checked against a linear longest prefix match")
+{
+}
+
+void
+PrefixTrieRandomTestCase::DoRun()
+{
+    using Key = PrefixTrie<16, uint32_t>::Key;
+    PrefixTrie<16, uint32_t> trie;
+    std::map<std::pair<Key, uint8_t>, uint32_t> reference;
+
+    auto mask = [](Key key, uint8_t length) {
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            auto bits = std::min<int>(std::max<int>(length - 8 * i, 0), 8);
+            key[i] &= static_cast<uint8_t>(0xff00 >> bits);
+        }
+        return key;
+    };
+
+    // keys drawn from a small set of addresses, so that prefixes overlap
+    std::mt19937 rng(1);
+    std::vector<Key> addresses(8);
+    for (auto& address : addresses)
+    {
+        for (auto& byte : address)
+        {
+            byte = rng() % 4;
+        }
+    }
+    auto randomKey = [&]() {
+        auto key = addresses[rng() % addresses.size()];
+        key[rng() % 16] ^= 1 << (rng() % 8);
+        return key;
+    };
+
+    for (uint32_t step = 0; step < 5000; step++)
+    {
+        auto key = randomKey();
+        uint8_t length = rng() % 129;
+        if (rng() % 3 != 0)
+        {
+            trie.Insert(key, length) = step;
+            reference[{mask(key, length), length}] = step;
+        }
+        else
+        {
+            bool erased = reference.erase({mask(key, length), length}) > 0;
+            NS_TEST_ASSERT_MSG_EQ(trie.Erase(key, length), erased, "Unexpected erase result");
+        }
+        NS_TEST_ASSERT_MSG_EQ(trie.Size(), reference.size(), "Unexpected number of prefixes");
+
+        auto dest = randomKey();
+        int expectedLength = -1;
+        uint32_t expectedValue = 0;
+        for (const auto& [prefix, value] : reference)
+        {
+            if (prefix.second > expectedLength && mask(dest, prefix.second) == prefix.first)
+            {
+                expectedLength = prefix.second;
+                expectedValue = value;
+            }
+        }
+        int foundLength = -1;
+        uint32_t foundValue = 0;
+        trie.LongestMatch(dest, [&](uint8_t length, uint32_t& value) {
+            foundLength = length;
+            foundValue = value;
+            return true;
+        });
+        NS_TEST_ASSERT_MSG_EQ(foundLength, expectedLength, "Wrong longest prefix length");
+        NS_TEST_ASSERT_MSG_EQ(foundValue, expectedValue, "Wrong longest prefix value");
+    }
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief PrefixTrie TestSuite
+ */
+class PrefixTrieTestSuite : public TestSuite
+{
+  public:
+    PrefixTrieTestSuite()
+        : TestSuite("prefix-trie", Type::UNIT)
+    {
+        AddTestCase(new PrefixTrieBasicTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new PrefixTrieRandomTestCase, TestCase::Duration::QUICK);
+    }
+};
+
+static PrefixTrieTestSuite g_prefixTrieTestSuite; //!< Static variable for test initialization
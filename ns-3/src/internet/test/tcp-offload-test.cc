@@ -0,0 +1,229 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "tcp-error-model.h"
+#include "tcp-general-test.h"
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/tcp-header.h"
+#include "ns3/uinteger.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TcpOffloadTestSuite");
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief Check the segmentation and receive offload emulation
+ *
+ * The sender hands down blocks of up to TsoMaxSegments segments of new data,
+ * the receiver coalesces the in-order segments arriving within GroTimeout.
+ * The segments on the wire must never exceed the MSS, all the data must be
+ * acknowledged and, if a segment in the middle of a block is lost, the
+ * retransmission must only cover the lost segment.
+ */
+class TcpOffloadTest : public TcpGeneralTest
+{
+  public:
+    /**
+     * @brief Constructor.
+     * @param tsoMaxSegments Maximum number of segments in a block sent at once.
+     * @param groTimeout Maximum time a segment is held for coalescing.
+     * @param seqToKill Sequence number of a segment to drop (0 for none).
+     * @param desc Test description.
+     */
+    TcpOffloadTest(uint32_t tsoMaxSegments,
+                   Time groTimeout,
+                   uint32_t seqToKill,
+                   const std::string& desc);
+
+  protected:
+    Ptr<TcpSocketMsgBase> CreateSenderSocket(Ptr<Node> node) override;
+    Ptr<TcpSocketMsgBase> CreateReceiverSocket(Ptr<Node> node) override;
+    Ptr<ErrorModel> CreateReceiverErrorModel() override;
+    void ConfigureEnvironment() override;
+    void ConfigureProperties() override;
+    void Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who) override;
+    void Rx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who) override;
+    void UpdatedRttHistory(const SequenceNumber32& seq,
+                           uint32_t sz,
+                           bool isRetransmission,
+                           SocketWho who) override;
+    void AfterRTOExpired(const Ptr<const TcpSocketState> tcb, SocketWho who) override;
+    void FinalChecks() override;
+
+  private:
+    uint32_t m_tsoMaxSegments;       //!< Maximum number of segments in a block
+    Time m_groTimeout;               //!< Maximum time a segment is held for coalescing
+    uint32_t m_seqToKill;            //!< Sequence number to drop
+    uint32_t m_dataSegments{0};      //!< Data segments sent
+    uint32_t m_blocks{0};            //!< Blocks of several segments sent at once
+    uint32_t m_retransmissions{0};   //!< Retransmitted segments
+    uint32_t m_acks{0};              //!< ACKs sent by the receiver
+    uint32_t m_coalesced{0};         //!< Coalesced segments received
+    uint32_t m_rtoExpirations{0};    //!< RTO expirations at the sender
+    SequenceNumber32 m_highestAck{}; //!< Highest ACK received by the sender
+};
+
+TcpOffloadTest::TcpOffloadTest(uint32_t tsoMaxSegments,
+                               Time groTimeout,
+                               uint32_t seqToKill,
+                               const std::string& desc)
+    : TcpGeneralTest(desc),
+      m_tsoMaxSegments(tsoMaxSegments),
+      m_groTimeout(groTimeout),
+      m_seqToKill(seqToKill)
+{
+}
+
+void
+TcpOffloadTest::ConfigureEnvironment()
+{
+    TcpGeneralTest::ConfigureEnvironment();
+    SetAppPktCount(200);
+    SetAppPktInterval(MicroSeconds(10));
+    SetPropagationDelay(MilliSeconds(50));
+}
+
+void
+TcpOffloadTest::ConfigureProperties()
+{
+    TcpGeneralTest::ConfigureProperties();
+    SetInitialCwnd(SENDER, 10);
+}
+
+Ptr<TcpSocketMsgBase>
+TcpOffloadTest::CreateSenderSocket(Ptr<Node> node)
+{
+    Ptr<TcpSocketMsgBase> socket = TcpGeneralTest::CreateSenderSocket(node);
+    socket->SetAttribute("TsoMaxSegments", UintegerValue(m_tsoMaxSegments));
+    return socket;
+}
+
+Ptr<TcpSocketMsgBase>
+TcpOffloadTest::CreateReceiverSocket(Ptr<Node> node)
+{
+    Ptr<TcpSocketMsgBase> socket = TcpGeneralTest::CreateReceiverSocket(node);
+    socket->SetAttribute("GroTimeout", TimeValue(m_groTimeout));
+    return socket;
+}
+
+Ptr<ErrorModel>
+TcpOffloadTest::CreateReceiverErrorModel()
+{
+    Ptr<TcpSeqErrorModel> errorModel = CreateObject<TcpSeqErrorModel>();
+    if (m_seqToKill > 0)
+    {
+        errorModel->AddSeqToKill(SequenceNumber32(m_seqToKill));
+    }
+    return errorModel;
+}
+
+void
+TcpOffloadTest::Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who)
+{
+    if (who == SENDER && p->GetSize() > 0)
+    {
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(p->GetSize(),
+                                    GetSegSize(SENDER),
+                                    "Segment larger than the MSS sent");
+        m_dataSegments++;
+    }
+    else if (who == RECEIVER && p->GetSize() == 0 && h.GetFlags() == TcpHeader::ACK)
+    {
+        m_acks++;
+    }
+}
+
+void
+TcpOffloadTest::Rx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who)
+{
+    if (who == RECEIVER && p->GetSize() > GetSegSize(RECEIVER))
+    {
+        m_coalesced += p->GetSize() / GetSegSize(RECEIVER);
+    }
+    else if (who == SENDER && (h.GetFlags() & TcpHeader::ACK) && m_highestAck < h.GetAckNumber())
+    {
+        m_highestAck = h.GetAckNumber();
+    }
+}
+
+void
+TcpOffloadTest::UpdatedRttHistory(const SequenceNumber32& seq,
+                                  uint32_t sz,
+                                  bool isRetransmission,
+                                  SocketWho who)
+{
+    if (who != SENDER)
+    {
+        return;
+    }
+    if (isRetransmission)
+    {
+        NS_TEST_ASSERT_MSG_EQ(seq, SequenceNumber32(m_seqToKill), "Unexpected retransmission");
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(sz, GetSegSize(SENDER), "Retransmission of a whole block");
+        m_retransmissions++;
+    }
+    else if (sz > GetSegSize(SENDER))
+    {
+        m_blocks++;
+    }
+}
+
+void
+TcpOffloadTest::AfterRTOExpired(const Ptr<const TcpSocketState> tcb, SocketWho who)
+{
+    m_rtoExpirations++;
+}
+
+void
+TcpOffloadTest::FinalChecks()
+{
+    // the SYN and the FIN take one sequence number each
+    NS_TEST_ASSERT_MSG_EQ(m_highestAck.GetValue(),
+                          GetPktCount() * GetPktSize() + 2,
+                          "Not all the data has been acknowledged");
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(m_dataSegments,
+                                GetPktCount() * GetPktSize() / GetSegSize(SENDER),
+                                "Data sent in segments larger than the MSS");
+    NS_TEST_ASSERT_MSG_EQ((m_blocks > 0), (m_tsoMaxSegments > 1), "Unexpected blocks sent");
+    NS_TEST_ASSERT_MSG_EQ((m_coalesced > 0),
+                          m_groTimeout.IsStrictlyPositive(),
+                          "Unexpected coalesced segments");
+    if (m_groTimeout.IsStrictlyPositive())
+    {
+        // without coalescing, a delayed ACK is sent every other segment
+        NS_TEST_ASSERT_MSG_LT(m_acks, m_dataSegments / 2, "Delayed ACKs not reduced");
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_retransmissions, (m_seqToKill > 0 ? 1 : 0), "Wrong retransmissions");
+    NS_TEST_ASSERT_MSG_EQ(m_rtoExpirations, 0, "Unexpected RTO expiration");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief TCP segmentation and receive offload TestSuite
+ */
+class TcpOffloadTestSuite : public TestSuite
+{
+  public:
+    TcpOffloadTestSuite()
+        : TestSuite("tcp-offload-test", Type::UNIT)
+    {
+        AddTestCase(new TcpOffloadTest(1, Seconds(0), 0, "No offload"),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new TcpOffloadTest(8, Seconds(0), 0, "Segmentation offload"),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new TcpOffloadTest(1, MilliSeconds(1), 0, "Receive offload"),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new TcpOffloadTest(8, MilliSeconds(1), 0, "Segmentation and receive offload"),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new TcpOffloadTest(8, MilliSeconds(1), 10001, "Offload with a lost segment"),
+                    TestCase::Duration::QUICK);
+    }
+};
+
+static TcpOffloadTestSuite g_tcpOffloadTestSuite; //!< Static variable for test initialization
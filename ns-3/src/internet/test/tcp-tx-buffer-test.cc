@@ -42,6 +42,12 @@ class TcpTxBufferTestCase : public TestCase
     /** @brief Test the logic of merging items in GetTransmittedSegment()
      * which is triggered by CopyFromSequence()*/
     void TestMergeItemsWhenGetTransmittedSegment();
+    /** @brief Test the scoreboard with a large window and many SACK blocks */
+    void TestLargeWindowSack();
+    /** @brief Test the SACK blocks that partially cover the sent items */
+    void TestPartialSackBlock();
+    /** @brief Test the lost count after the reset of the SACKs emulated for Reno */
+    void TestRenoSackReneging();
     /**
      * @brief Callback to provide a value of receiver window
      * @returns the receiver window size
@@ -88,6 +94,20 @@ TcpTxBufferTestCase::DoRun()
     Simulator::Schedule(Seconds(0),
                         &TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment,
                         this);
+    Simulator::Schedule(Seconds(0), &TcpTxBufferTestCase::TestLargeWindowSack, this);
+    /*
+     * Cases for a SACK block partially covering sent items:
+     * -> the item is a single segment: the block is ignored for that item
+     * -> the item spans several segments (segmentation offload): the item is split
+     */
+    Simulator::Schedule(Seconds(0), &TcpTxBufferTestCase::TestPartialSackBlock, this);
+    /*
+     * Case for the lost count:
+     * -> the SACKs emulated for the Reno dupacks are reset (reneging), then a SACK block
+     *    arrives: all the unsacked segments below it are lost, including the segments that
+     *    were sacked before the reset
+     */
+    Simulator::Schedule(Seconds(0), &TcpTxBufferTestCase::TestRenoSackReneging, this);
 
     Simulator::Run();
     Simulator::Destroy();
@@ -152,6 +172,165 @@ TcpTxBufferTestCase::TestIsLost()
     }
 }
 
+void
+TcpTxBufferTestCase::TestLargeWindowSack()
+{
+    const uint32_t segments = 10000;
+    const uint32_t segmentSize = 1000;
+    Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer>();
+    txBuf->SetRWndCallback(MakeCallback(&TcpTxBufferTestCase::GetRWnd, this));
+    txBuf->SetHeadSequence(SequenceNumber32(1));
+    txBuf->SetSegmentSize(segmentSize);
+    txBuf->SetDupAckThresh(3);
+    txBuf->SetMaxBufferSize(segments * segmentSize);
+    txBuf->Add(Create<Packet>(segments * segmentSize));
+
+    auto seqOf = [segmentSize](uint32_t i) { return SequenceNumber32(i * segmentSize + 1); };
+    for (uint32_t i = 0; i < segments; ++i)
+    {
+        txBuf->CopyFromSequence(segmentSize, seqOf(i));
+    }
+
+    // Every even segment is lost: the receiver sacks the odd ones, one at a time
+    for (uint32_t i = 1; i < segments; i += 2)
+    {
+        Ptr<TcpOptionSack> sack = CreateObject<TcpOptionSack>();
+        sack->AddSackBlock(TcpOptionSack::SackBlock(seqOf(i), seqOf(i + 1)));
+        NS_TEST_ASSERT_MSG_EQ(txBuf->Update(sack->GetSackList()),
+                              segmentSize,
+                              "Segment " << i << " not sacked");
+    }
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(), segments / 2 * segmentSize, "Wrong sacked bytes");
+    // The even segments below the third highest sacked segment are lost
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(), (segments / 2 - 2) * segmentSize, "Wrong lost bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(seqOf(0)), true, "First segment not lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(seqOf(1)), false, "Sacked segment lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(seqOf(segments - 6) + 500), true, "Segment not lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(seqOf(segments - 4)), false, "Segment lost");
+
+    // NextSeg returns the lost segments in order, one after the other
+    SequenceNumber32 ret;
+    SequenceNumber32 retHigh;
+    for (uint32_t i = 0; i < segments - 4; i += 2)
+    {
+        NS_TEST_ASSERT_MSG_EQ(txBuf->NextSeg(&ret, &retHigh, false), true, "No lost segment");
+        NS_TEST_ASSERT_MSG_EQ(ret, seqOf(i), "Wrong lost segment returned");
+        TcpTxItem* item = txBuf->CopyFromSequence(segmentSize, ret);
+        NS_TEST_ASSERT_MSG_EQ(item->GetSeqSize(), segmentSize, "Wrong retransmission size");
+        NS_TEST_ASSERT_MSG_EQ(item->IsRetrans(), true, "Segment not marked as retransmitted");
+    }
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetRetransmitsCount(),
+                          (segments / 2 - 2) * segmentSize,
+                          "Wrong retransmitted bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsRetransmittedDataAcked(seqOf(1)),
+                          true,
+                          "First retransmission not recognized");
+
+    // A cumulative ACK releases the retransmitted and sacked segments
+    txBuf->DiscardUpTo(seqOf(segments - 4));
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(), 2 * segmentSize, "Wrong sacked bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(), 0, "Wrong lost bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetRetransmitsCount(), 0, "Wrong retransmitted bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->BytesInFlight(), 2 * segmentSize, "Wrong bytes in flight");
+}
+
+void
+TcpTxBufferTestCase::TestPartialSackBlock()
+{
+    const uint32_t segmentSize = 1000;
+    Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer>();
+    txBuf->SetRWndCallback(MakeCallback(&TcpTxBufferTestCase::GetRWnd, this));
+    txBuf->SetHeadSequence(SequenceNumber32(1));
+    txBuf->SetSegmentSize(segmentSize);
+    txBuf->SetDupAckThresh(3);
+    txBuf->Add(Create<Packet>(10 * segmentSize));
+
+    // Four segments, sent one at a time
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        txBuf->CopyFromSequence(segmentSize, SequenceNumber32(i * segmentSize + 1));
+    }
+
+    // The block starts in the middle of the second segment and ends in the middle of the
+    // fourth one: only the third segment is sacked and the segments are not split
+    Ptr<TcpOptionSack> sack = CreateObject<TcpOptionSack>();
+    sack->AddSackBlock(TcpOptionSack::SackBlock(SequenceNumber32(1501), SequenceNumber32(3501)));
+    NS_TEST_ASSERT_MSG_EQ(txBuf->Update(sack->GetSackList()),
+                          segmentSize,
+                          "Only the fully covered segment should be sacked");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(), segmentSize, "Wrong sacked bytes");
+    TcpTxItem* item = txBuf->CopyFromSequence(segmentSize, SequenceNumber32(1001));
+    NS_TEST_ASSERT_MSG_EQ(item->GetSeqSize(), segmentSize, "The second segment has been split");
+    NS_TEST_ASSERT_MSG_EQ(item->IsSacked(), false, "The second segment has been sacked");
+    item = txBuf->CopyFromSequence(segmentSize, SequenceNumber32(3001));
+    NS_TEST_ASSERT_MSG_EQ(item->GetSeqSize(), segmentSize, "The fourth segment has been split");
+    NS_TEST_ASSERT_MSG_EQ(item->IsSacked(), false, "The fourth segment has been sacked");
+
+    // Four segments, sent as a single block (segmentation offload)
+    txBuf->CopyFromSequence(4 * segmentSize, SequenceNumber32(4 * segmentSize + 1));
+
+    // The block covers the second and third segments of the block: they are sacked
+    sack = CreateObject<TcpOptionSack>();
+    sack->AddSackBlock(TcpOptionSack::SackBlock(SequenceNumber32(5001), SequenceNumber32(7001)));
+    NS_TEST_ASSERT_MSG_EQ(txBuf->Update(sack->GetSackList()),
+                          2 * segmentSize,
+                          "The covered part of the block should be sacked");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(), 3 * segmentSize, "Wrong sacked bytes");
+    item = txBuf->CopyFromSequence(segmentSize, SequenceNumber32(4001));
+    NS_TEST_ASSERT_MSG_EQ(item->GetSeqSize(), segmentSize, "The block has not been split");
+    NS_TEST_ASSERT_MSG_EQ(item->IsSacked(), false, "The first segment has been sacked");
+}
+
+void
+TcpTxBufferTestCase::TestRenoSackReneging()
+{
+    const uint32_t segmentSize = 1000;
+    Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer>();
+    txBuf->SetRWndCallback(MakeCallback(&TcpTxBufferTestCase::GetRWnd, this));
+    txBuf->SetHeadSequence(SequenceNumber32(1));
+    txBuf->SetSegmentSize(segmentSize);
+    txBuf->SetDupAckThresh(3);
+    txBuf->Add(Create<Packet>(10 * segmentSize));
+
+    auto seqOf = [segmentSize](uint32_t i) { return SequenceNumber32(i * segmentSize + 1); };
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        txBuf->CopyFromSequence(segmentSize, seqOf(i));
+    }
+
+    // Three dupacks emulated as SACKs of the segments 1 to 3 and the head marked as lost
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        txBuf->AddRenoSack();
+    }
+    txBuf->MarkHeadAsLost();
+
+    // The segments 5 to 7 are sacked, hence the segment 4 is lost
+    Ptr<TcpOptionSack> sack = CreateObject<TcpOptionSack>();
+    sack->AddSackBlock(TcpOptionSack::SackBlock(seqOf(5), seqOf(8)));
+    txBuf->Update(sack->GetSackList());
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(), 6 * segmentSize, "Wrong sacked bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(), 2 * segmentSize, "Wrong lost bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(seqOf(4)), true, "Segment 4 not lost");
+
+    // The SACKs are reset, but the segments 0 and 4 remain lost
+    txBuf->ResetRenoSack();
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(), 0, "Wrong sacked bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(), 2 * segmentSize, "Wrong lost bytes");
+
+    // The segments 7 to 9 are sacked: all the segments below them are lost, including those
+    // below the segment 4
+    sack = CreateObject<TcpOptionSack>();
+    sack->AddSackBlock(TcpOptionSack::SackBlock(seqOf(7), seqOf(10)));
+    txBuf->Update(sack->GetSackList());
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(), 3 * segmentSize, "Wrong sacked bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(), 7 * segmentSize, "Wrong lost bytes");
+    for (uint32_t i = 0; i < 7; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(seqOf(i)), true, "Segment " << i << " not lost");
+    }
+}
+
 uint32_t
 TcpTxBufferTestCase::GetRWnd() const
 {
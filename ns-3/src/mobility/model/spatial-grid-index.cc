@@ -0,0 +1,177 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+#include "spatial-grid-index.h"
+
+#include "mobility-model.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SpatialGridIndex");
+
+std::size_t
+SpatialGridIndex::CellKeyHash::operator()(const CellKey& key) const
+{
+    return std::hash<uint64_t>()((static_cast<uint64_t>(key.first) * 0x9e3779b97f4a7c15ULL) ^
+                                 static_cast<uint64_t>(key.second));
+}
+
+SpatialGridIndex::SpatialGridIndex(double cellSize)
+    : m_cellSize(cellSize)
+{
+    NS_LOG_FUNCTION(this << cellSize);
+    NS_ASSERT_MSG(cellSize > 0, "The size of the cells must be positive");
+}
+
+SpatialGridIndex::~SpatialGridIndex()
+{
+    NS_LOG_FUNCTION(this);
+    Clear();
+}
+
+void
+SpatialGridIndex::SetCellSize(double cellSize)
+{
+    NS_LOG_FUNCTION(this << cellSize);
+    NS_ASSERT_MSG(cellSize > 0, "The size of the cells must be positive");
+    NS_ASSERT_MSG(m_items.empty(), "The size of the cells can only be changed when empty");
+    m_cellSize = cellSize;
+}
+
+void
+SpatialGridIndex::Add(std::size_t index, Ptr<MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << index << mobility);
+    NS_ASSERT_MSG(!m_items.contains(index), "Item " << index << " is already in the grid");
+    m_items[index].mobility = mobility;
+    if (mobility)
+    {
+        mobility->TraceConnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&SpatialGridIndex::CourseChanged, this, index));
+    }
+    Insert(index);
+}
+
+void
+SpatialGridIndex::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& [index, item] : m_items)
+    {
+        if (item.mobility)
+        {
+            item.mobility->TraceDisconnectWithoutContext(
+                "CourseChange",
+                MakeCallback(&SpatialGridIndex::CourseChanged, this, index));
+        }
+    }
+    m_items.clear();
+    m_cells.clear();
+    m_moving.clear();
+}
+
+std::size_t
+SpatialGridIndex::GetN() const
+{
+    return m_items.size();
+}
+
+SpatialGridIndex::CellKey
+SpatialGridIndex::GetCell(const Vector& position) const
+{
+    return {static_cast<int64_t>(std::floor(position.x / m_cellSize)),
+            static_cast<int64_t>(std::floor(position.y / m_cellSize))};
+}
+
+void
+SpatialGridIndex::Insert(std::size_t index)
+{
+    auto& item = m_items.at(index);
+    if (!item.mobility || item.mobility->GetVelocity().GetLength() > 0)
+    {
+        item.inCell = false;
+        m_moving.push_back(index);
+        return;
+    }
+    item.inCell = true;
+    item.cell = GetCell(item.mobility->GetPosition());
+    m_cells[item.cell].push_back(index);
+}
+
+void
+SpatialGridIndex::Remove(std::size_t index)
+{
+    const auto& item = m_items.at(index);
+    if (!item.inCell)
+    {
+        m_moving.erase(std::find(m_moving.begin(), m_moving.end(), index));
+        return;
+    }
+    auto cellIt = m_cells.find(item.cell);
+    NS_ASSERT(cellIt != m_cells.end());
+    auto& cell = cellIt->second;
+    cell.erase(std::find(cell.begin(), cell.end(), index));
+    if (cell.empty())
+    {
+        m_cells.erase(cellIt);
+    }
+}
+
+void
+SpatialGridIndex::CourseChanged(std::size_t index, Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << index << mobility);
+    Remove(index);
+    Insert(index);
+}
+
+std::vector<std::size_t>
+SpatialGridIndex::GetCandidates(const Vector& position, double range) const
+{
+    NS_LOG_FUNCTION(this << position << range);
+    std::vector<std::size_t> candidates(m_moving);
+
+    const auto min = GetCell(Vector(position.x - range, position.y - range, 0));
+    const auto max = GetCell(Vector(position.x + range, position.y + range, 0));
+    const auto nCells = static_cast<double>(max.first - min.first + 1) *
+                        static_cast<double>(max.second - min.second + 1);
+
+    if (nCells > m_cells.size())
+    {
+        // the range covers more cells than there are occupied cells, scan the latter
+        for (const auto& [key, cell] : m_cells)
+        {
+            if (key.first >= min.first && key.first <= max.first && key.second >= min.second &&
+                key.second <= max.second)
+            {
+                candidates.insert(candidates.end(), cell.cbegin(), cell.cend());
+            }
+        }
+    }
+    else
+    {
+        for (auto x = min.first; x <= max.first; ++x)
+        {
+            for (auto y = min.second; y <= max.second; ++y)
+            {
+                if (auto it = m_cells.find({x, y}); it != m_cells.end())
+                {
+                    candidates.insert(candidates.end(), it->second.cbegin(), it->second.cend());
+                }
+            }
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+    return candidates;
+}
+
+} // namespace ns3
@@ -0,0 +1,144 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+#ifndef SPATIAL_GRID_INDEX_H
+#define SPATIAL_GRID_INDEX_H
+
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+class MobilityModel;
+
+/**
+ * @ingroup mobility
+ *
+ * @brief Uniform 2D grid of mobility models, used to find the items close to a position.
+ *
+ * The items are identified by an index chosen by the user of the grid (typically, the
+ * position of the corresponding object in a container of the user). The items whose
+ * mobility model is still (i.e., whose velocity was zero at their last course change)
+ * are stored in the cell of the grid containing their (x, y) position. The moving items
+ * and the items without mobility model are returned by every query. The grid is kept up
+ * to date by the CourseChange trace of the mobility models, hence mobility models are
+ * expected to notify a course change whenever their position or their velocity changes.
+ *
+ * The queries return a superset of the items within the given range: the user of the
+ * grid must check the actual distance of the returned items.
+ */
+class SpatialGridIndex
+{
+  public:
+    /**
+     * Create an empty grid.
+     *
+     * @param cellSize the size (in meters) of the side of the cells of the grid
+     */
+    SpatialGridIndex(double cellSize = 1000);
+    ~SpatialGridIndex();
+
+    // Delete copy constructor and assignment operator, the grid is connected to trace sources
+    SpatialGridIndex(const SpatialGridIndex&) = delete;
+    SpatialGridIndex& operator=(const SpatialGridIndex&) = delete;
+
+    /**
+     * Set the size of the side of the cells. The grid must be empty.
+     *
+     * @param cellSize the size (in meters) of the side of the cells of the grid
+     */
+    void SetCellSize(double cellSize);
+
+    /**
+     * Add an item to the grid.
+     *
+     * @param index the index identifying the item
+     * @param mobility the mobility model of the item, if any
+     */
+    void Add(std::size_t index, Ptr<MobilityModel> mobility);
+
+    /**
+     * Remove all the items and disconnect from the mobility models.
+     */
+    void Clear();
+
+    /**
+     * @return the number of items in the grid
+     */
+    std::size_t GetN() const;
+
+    /**
+     * Get the items which can be within the given range of a position, in increasing order
+     * of their index.
+     *
+     * @param position the position
+     * @param range the range (in meters)
+     * @return the indices of the candidate items
+     */
+    std::vector<std::size_t> GetCandidates(const Vector& position, double range) const;
+
+  private:
+    /// Coordinates of a cell of the grid
+    using CellKey = std::pair<int64_t, int64_t>;
+
+    /// Hash function for the coordinates of a cell
+    struct CellKeyHash
+    {
+        /**
+         * @param key the coordinates of a cell
+         * @return the hash of the coordinates
+         */
+        std::size_t operator()(const CellKey& key) const;
+    };
+
+    /// Item of the grid
+    struct Item
+    {
+        Ptr<MobilityModel> mobility; //!< the mobility model of the item, if any
+        bool inCell{false};          //!< whether the item is stored in a cell
+        CellKey cell{0, 0};          //!< the cell storing the item, if any
+    };
+
+    /**
+     * @param position a position
+     * @return the coordinates of the cell containing the position
+     */
+    CellKey GetCell(const Vector& position) const;
+
+    /**
+     * Store an item in the cell matching its position, or among the moving items.
+     *
+     * @param index the index of the item
+     */
+    void Insert(std::size_t index);
+
+    /**
+     * Remove an item from its cell or from the moving items.
+     *
+     * @param index the index of the item
+     */
+    void Remove(std::size_t index);
+
+    /**
+     * Callback for the CourseChange trace of the mobility model of an item.
+     *
+     * @param index the index of the item
+     * @param mobility the mobility model
+     */
+    void CourseChanged(std::size_t index, Ptr<const MobilityModel> mobility);
+
+    double m_cellSize;                             //!< size of the cells
+    std::unordered_map<std::size_t, Item> m_items; //!< items of the grid
+    /// cells of the grid, storing the indices of the still items
+    std::unordered_map<CellKey, std::vector<std::size_t>, CellKeyHash> m_cells;
+    std::vector<std::size_t> m_moving; //!< moving items and items without mobility model
+};
+
+} // namespace ns3
+
+#endif /* SPATIAL_GRID_INDEX_H */
@@ -0,0 +1,102 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/simulator.h"
+#include "ns3/spatial-grid-index.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * @ingroup mobility-test
+ *
+ * @brief Check the candidates returned by the spatial grid index, while the items move.
+ */
+class SpatialGridIndexTestCase : public TestCase
+{
+  public:
+    SpatialGridIndexTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+SpatialGridIndexTestCase::SpatialGridIndexTestCase()
+    : TestCase("Check the candidates of the spatial grid index")
+{
+}
+
+void
+SpatialGridIndexTestCase::DoRun()
+{
+    SpatialGridIndex grid(100);
+
+    auto near = CreateObject<ConstantPositionMobilityModel>();
+    near->SetPosition(Vector(50, 50, 0));
+    auto far = CreateObject<ConstantPositionMobilityModel>();
+    far->SetPosition(Vector(1000, -1000, 0));
+    auto moving = CreateObject<ConstantVelocityMobilityModel>();
+    moving->SetPosition(Vector(5000, 5000, 0));
+    moving->SetVelocity(Vector(1, 0, 0));
+
+    grid.Add(2, near);
+    grid.Add(0, far);
+    grid.Add(1, moving);
+    grid.Add(3, nullptr);
+    NS_TEST_EXPECT_MSG_EQ(grid.GetN(), 4, "Wrong number of items");
+
+    using Candidates = std::vector<std::size_t>;
+    NS_TEST_EXPECT_MSG_EQ((grid.GetCandidates(Vector(0, 0, 0), 100) == Candidates{1, 2, 3}),
+                          true,
+                          "The far item should not be a candidate");
+    NS_TEST_EXPECT_MSG_EQ((grid.GetCandidates(Vector(0, 0, 0), 2000) == Candidates{0, 1, 2, 3}),
+                          true,
+                          "Every item should be a candidate");
+
+    // the moving item stops, it is stored in the grid
+    moving->SetVelocity(Vector(0, 0, 0));
+    NS_TEST_EXPECT_MSG_EQ((grid.GetCandidates(Vector(0, 0, 0), 100) == Candidates{2, 3}),
+                          true,
+                          "The item which stopped should not be a candidate");
+    NS_TEST_EXPECT_MSG_EQ((grid.GetCandidates(Vector(5000, 5000, 0), 10) == Candidates{1, 3}),
+                          true,
+                          "The item which stopped should be a candidate");
+
+    // the far item moves close to the position
+    far->SetPosition(Vector(-50, -50, 0));
+    NS_TEST_EXPECT_MSG_EQ((grid.GetCandidates(Vector(0, 0, 0), 100) == Candidates{0, 2, 3}),
+                          true,
+                          "The item which moved should be a candidate");
+
+    // the grid no longer tracks the mobility models once cleared
+    grid.Clear();
+    NS_TEST_EXPECT_MSG_EQ(grid.GetN(), 0, "The grid should be empty");
+    near->SetPosition(Vector(0, 0, 0));
+    NS_TEST_EXPECT_MSG_EQ(grid.GetCandidates(Vector(0, 0, 0), 100).empty(),
+                          true,
+                          "There should be no candidate");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup mobility-test
+ *
+ * @brief Spatial grid index test suite
+ */
+class SpatialGridIndexTestSuite : public TestSuite
+{
+  public:
+    SpatialGridIndexTestSuite();
+};
+
+SpatialGridIndexTestSuite::SpatialGridIndexTestSuite()
+    : TestSuite("spatial-grid-index", Type::UNIT)
+{
+    AddTestCase(new SpatialGridIndexTestCase, TestCase::Duration::QUICK);
+}
+
+static SpatialGridIndexTestSuite g_spatialGridIndexTestSuite; //!< the test suite
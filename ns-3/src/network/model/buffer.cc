@@ -10,6 +10,10 @@
 #include "ns3/assert.h"
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
 #define LOG_INTERNAL_STATE(y)                                                                      \
     NS_LOG_LOGIC(y << "start=" << m_start << ", end=" << m_end                                     \
                    << ", zero start=" << m_zeroAreaStart << ", zero end=" << m_zeroAreaEnd         \
@@ -36,6 +40,62 @@ struct Zeroes
     const uint32_t size; //!< buffer size
 } g_zeroes;              //!< Zero-filled buffer
 
+/**
+ * @ingroup packet
+ * @brief One's complement sum of a block of memory (RFC 1071).
+ *
+ * The bytes are summed as 16 bit words in little endian byte order, the
+ * first byte being the least significant byte of a word, as in
+ * Buffer::Iterator::ReadU16. The words are summed 32 bits at a time in a
+ * 64 bit accumulator, so that the carries are folded only once at the end
+ * and the loop can be vectorized by the compiler.
+ *
+ * @param data the block of memory
+ * @param size the size of the block, in bytes
+ * @return the sum, folded to 16 bits
+ */
+uint32_t
+OnesComplementSum(const uint8_t* data, uint32_t size)
+{
+    uint64_t sum = 0;
+    uint32_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint32_t words[2];
+        memcpy(words, data + i, 8);
+        sum += words[0];
+        sum += words[1];
+    }
+    for (; i + 4 <= size; i += 4)
+    {
+        uint32_t word;
+        memcpy(&word, data + i, 4);
+        sum += word;
+    }
+    while (sum >> 16)
+    {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    if constexpr (std::endian::native == std::endian::big)
+    {
+        // the sum of big endian words is the byte swapped sum of little endian words
+        sum = ((sum >> 8) | (sum << 8)) & 0xffff;
+    }
+    for (; i + 2 <= size; i += 2)
+    {
+        sum += data[i] | (data[i + 1] << 8);
+    }
+    if (i < size)
+    {
+        sum += data[i];
+    }
+    while (sum >> 16)
+    {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    return static_cast<uint32_t>(sum);
+}
+
 } // namespace
 
 namespace ns3
@@ -1131,17 +1191,41 @@ uint16_t
 Buffer::Iterator::CalculateIpChecksum(uint16_t size, uint32_t initialChecksum)
 {
     NS_LOG_FUNCTION(this << size << initialChecksum);
-    /* see RFC 1071 to understand this code. */
-    uint32_t sum = initialChecksum;
-
-    for (int j = 0; j < size / 2; j++)
-    {
-        sum += ReadU16();
-    }
-
-    if (size & 1)
+    NS_ASSERT_MSG(m_current >= m_dataStart && m_current + size <= m_dataEnd,
+                  GetReadErrorMessage());
+    /* see RFC 1071 to understand this code. The data before and after the
+       zero area are summed in place; the zero area adds nothing to the sum. */
+    uint64_t sum = initialChecksum;
+    uint32_t offset = 0;
+    while (offset < size)
     {
-        sum += ReadU8();
+        uint32_t length = size - offset;
+        const uint8_t* data = nullptr;
+        if (m_current < m_zeroStart)
+        {
+            length = std::min(length, m_zeroStart - m_current);
+            data = &m_data[m_current];
+        }
+        else if (m_current < m_zeroEnd)
+        {
+            length = std::min(length, m_zeroEnd - m_current);
+        }
+        else
+        {
+            data = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+        }
+        if (data != nullptr)
+        {
+            uint32_t partial = OnesComplementSum(data, length);
+            if (offset & 1)
+            {
+                // the block starts in the middle of a word: swap the bytes of its sum
+                partial = ((partial >> 8) | (partial << 8)) & 0xffff;
+            }
+            sum += partial;
+        }
+        m_current += length;
+        offset += length;
     }
 
     while (sum >> 16)
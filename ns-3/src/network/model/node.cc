@@ -40,6 +40,22 @@ static GlobalValue g_checksumEnabled =
                 BooleanValue(false),
                 MakeBooleanChecker());
 
+/**
+ * @relates Node
+ * @anchor GlobalValueChecksumVerificationEnabled
+ * @brief A global switch to verify the checksums of the received packets.
+ *
+ * When checksums are enabled and this switch is off, the checksums of the
+ * received packets are assumed to be valid without being computed ("virtual
+ * checksum valid"), while the packets sent still carry correct checksums.
+ */
+static GlobalValue g_checksumVerificationEnabled =
+    GlobalValue("ChecksumVerificationEnabled",
+                "If false, the checksums of the received packets are assumed to be valid "
+                "instead of being verified (only relevant if ChecksumEnabled is true)",
+                BooleanValue(true),
+                MakeBooleanChecker());
+
 TypeId
 Node::GetTypeId()
 {
@@ -271,6 +287,14 @@ Node::ChecksumEnabled()
     return val.Get();
 }
 
+bool
+Node::ChecksumVerificationEnabled()
+{
+    BooleanValue val;
+    g_checksumVerificationEnabled.GetValue(val);
+    return val.Get();
+}
+
 bool
 Node::PromiscReceiveFromDevice(Ptr<NetDevice> device,
                                Ptr<const Packet> packet,
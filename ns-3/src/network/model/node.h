@@ -202,6 +202,12 @@ class Node : public Object
      */
     static bool ChecksumEnabled();
 
+    /**
+     * @returns true if the checksums of the received packets must be verified,
+     *          false if they are assumed to be valid.
+     */
+    static bool ChecksumVerificationEnabled();
+
   protected:
     /**
      * The dispose method. Subclasses must override this method
@@ -384,6 +384,84 @@ BufferTest::DoRun()
     NS_TEST_ASSERT_MSG_EQ(val1, val2, "Bad ReadNtohU16()");
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Buffer::Iterator::CalculateIpChecksum unit tests, against a byte by byte
+ * implementation of RFC 1071, with blocks spanning the zero area and
+ * starting at odd offsets.
+ */
+class BufferChecksumTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    BufferChecksumTest();
+};
+
+BufferChecksumTest::BufferChecksumTest()
+    : TestCase("Buffer checksum")
+{
+}
+
+void
+BufferChecksumTest::DoRun()
+{
+    Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+
+    for (uint32_t run = 0; run < 200; run++)
+    {
+        uint32_t zeroes = rng->GetInteger(0, 100);
+        uint32_t head = rng->GetInteger(0, 1500);
+        uint32_t tail = rng->GetInteger(0, 100);
+        Buffer buffer(zeroes);
+        buffer.AddAtStart(head);
+        buffer.AddAtEnd(tail);
+        Buffer::Iterator i = buffer.Begin();
+        for (uint32_t j = 0; j < head; j++)
+        {
+            i.WriteU8(rng->GetInteger(0, 255));
+        }
+        i = buffer.End();
+        i.Prev(tail);
+        for (uint32_t j = 0; j < tail; j++)
+        {
+            i.WriteU8(rng->GetInteger(0, 255));
+        }
+
+        uint32_t size = buffer.GetSize();
+        uint32_t start = rng->GetInteger(0, size);
+        uint32_t length = rng->GetInteger(0, size - start);
+        uint32_t initial = rng->GetInteger(0, 0xffff);
+
+        i = buffer.Begin();
+        i.Next(start);
+        uint32_t sum = initial;
+        for (uint32_t j = 0; j < length; j++)
+        {
+            uint32_t byte = i.ReadU8();
+            sum += (j & 1) ? (byte << 8) : byte;
+        }
+        while (sum >> 16)
+        {
+            sum = (sum & 0xffff) + (sum >> 16);
+        }
+        uint16_t expected = ~sum;
+
+        i = buffer.Begin();
+        i.Next(start);
+        NS_TEST_ASSERT_MSG_EQ(i.CalculateIpChecksum(length, initial),
+                              expected,
+                              "Wrong checksum of " << length << " bytes from " << start
+                                                   << " (head " << head << ", zeroes " << zeroes
+                                                   << ", tail " << tail << ")");
+        NS_TEST_ASSERT_MSG_EQ(i.GetDistanceFrom(buffer.Begin()),
+                              start + length,
+                              "Iterator not advanced past the checksummed bytes");
+    }
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -400,6 +478,7 @@ BufferTestSuite::BufferTestSuite()
     : TestSuite("buffer", Type::UNIT)
 {
     AddTestCase(new BufferTest, TestCase::Duration::QUICK);
+    AddTestCase(new BufferChecksumTest, TestCase::Duration::QUICK);
 }
 
 static BufferTestSuite g_bufferTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,179 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/drop-tail-queue.h"
+#include "ns3/ring-buffer.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <deque>
+
+using namespace ns3;
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief RingBuffer Test: compare the content of a RingBuffer with that of a
+ * std::deque after a sequence of insertions and removals at both ends and in
+ * the middle, which also causes the buffer to wrap around and grow.
+ */
+class RingBufferTest : public TestCase
+{
+  public:
+    RingBufferTest();
+    void DoRun() override;
+
+  private:
+    /**
+     * Check that the given buffer and deque contain the same elements.
+     *
+     * @param buffer the ring buffer
+     * @param ref the reference deque
+     */
+    void CheckEqual(const RingBuffer<int>& buffer, const std::deque<int>& ref);
+};
+
+RingBufferTest::RingBufferTest()
+    : TestCase("Check insertions and removals in the RingBuffer container")
+{
+}
+
+void
+RingBufferTest::CheckEqual(const RingBuffer<int>& buffer, const std::deque<int>& ref)
+{
+    NS_TEST_ASSERT_MSG_EQ(buffer.size(), ref.size(), "Unexpected number of elements");
+    NS_TEST_ASSERT_MSG_EQ((buffer.end() - buffer.begin()),
+                          static_cast<std::ptrdiff_t>(ref.size()),
+                          "Unexpected iterator distance");
+    auto refIt = ref.cbegin();
+    for (auto it = buffer.cbegin(); it != buffer.cend(); ++it, ++refIt)
+    {
+        NS_TEST_ASSERT_MSG_EQ(*it, *refIt, "Unexpected element");
+    }
+}
+
+void
+RingBufferTest::DoRun()
+{
+    RingBuffer<int> buffer;
+    std::deque<int> ref;
+
+    NS_TEST_EXPECT_MSG_EQ(buffer.empty(), true, "The buffer should be empty");
+    NS_TEST_EXPECT_MSG_EQ(buffer.capacity(), 0, "No storage should be allocated yet");
+
+    // fill the buffer so that it needs to grow a few times
+    for (int i = 0; i < 40; ++i)
+    {
+        buffer.push_back(i);
+        ref.push_back(i);
+    }
+    CheckEqual(buffer, ref);
+    NS_TEST_EXPECT_MSG_EQ(buffer.capacity(), 64, "Unexpected capacity after growing");
+
+    // make the head move forward, then wrap the tail around the end of the storage
+    for (int i = 0; i < 30; ++i)
+    {
+        buffer.erase(buffer.cbegin());
+        ref.pop_front();
+    }
+    for (int i = 100; i < 150; ++i)
+    {
+        buffer.insert(buffer.cend(), i);
+        ref.push_back(i);
+    }
+    CheckEqual(buffer, ref);
+    NS_TEST_EXPECT_MSG_EQ(buffer.capacity(), 64, "The buffer should not have grown");
+
+    // insert at the front
+    buffer.insert(buffer.cbegin(), -1);
+    ref.push_front(-1);
+    CheckEqual(buffer, ref);
+
+    // insert and remove close to the front and close to the back
+    auto it = buffer.insert(buffer.cbegin() + 3, 1000);
+    NS_TEST_EXPECT_MSG_EQ(*it, 1000, "Unexpected value pointed to by the returned iterator");
+    ref.insert(ref.begin() + 3, 1000);
+    buffer.insert(buffer.cend() - 2, 2000);
+    ref.insert(ref.end() - 2, 2000);
+    CheckEqual(buffer, ref);
+
+    it = buffer.erase(buffer.cbegin() + 5);
+    auto refIt = ref.erase(ref.begin() + 5);
+    NS_TEST_EXPECT_MSG_EQ(*it, *refIt, "Unexpected value pointed to by the returned iterator");
+    buffer.erase(buffer.cend() - 4);
+    ref.erase(ref.end() - 4);
+    CheckEqual(buffer, ref);
+
+    // growing while the content wraps around must preserve the order of the elements
+    for (int i = 0; i < 100; ++i)
+    {
+        buffer.push_front(-i);
+        ref.push_front(-i);
+    }
+    CheckEqual(buffer, ref);
+
+    auto capacity = buffer.capacity();
+    buffer.clear();
+    NS_TEST_EXPECT_MSG_EQ(buffer.empty(), true, "The buffer should be empty");
+    NS_TEST_EXPECT_MSG_EQ(buffer.capacity(), capacity, "Clearing should retain the storage");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Check that removing a packet from a queue backed by a RingBuffer
+ * releases the reference held by the queue.
+ */
+class RingBufferQueueTest : public TestCase
+{
+  public:
+    RingBufferQueueTest();
+    void DoRun() override;
+};
+
+RingBufferQueueTest::RingBufferQueueTest()
+    : TestCase("Check that a RingBuffer backed queue releases dequeued packets")
+{
+}
+
+void
+RingBufferQueueTest::DoRun()
+{
+    auto queue = CreateObject<DropTailQueue<Packet>>();
+    queue->SetAttribute("MaxSize", StringValue("1000p"));
+
+    auto p = Create<Packet>(100);
+    NS_TEST_EXPECT_MSG_EQ(p->GetReferenceCount(), 1, "Unexpected reference count");
+
+    for (int i = 0; i < 500; ++i)
+    {
+        queue->Enqueue(Create<Packet>(100));
+        queue->Dequeue();
+    }
+    queue->Enqueue(p);
+    NS_TEST_EXPECT_MSG_EQ(p->GetReferenceCount(), 2, "The queue should hold a reference");
+    queue->Dequeue();
+    NS_TEST_EXPECT_MSG_EQ(p->GetReferenceCount(), 1, "The queue should have released the packet");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief RingBuffer TestSuite
+ */
+class RingBufferTestSuite : public TestSuite
+{
+  public:
+    RingBufferTestSuite()
+        : TestSuite("ring-buffer", Type::UNIT)
+    {
+        AddTestCase(new RingBufferTest(), TestCase::Duration::QUICK);
+        AddTestCase(new RingBufferQueueTest(), TestCase::Duration::QUICK);
+    }
+};
+
+static RingBufferTestSuite g_ringBufferTestSuite; //!< Static variable for test initialization
@@ -235,7 +235,13 @@ class QueueBase : public Object
  * container used internally to store queue items. The container type must provide
  * the methods insert(), erase() and clear() and define the iterator and const_iterator
  * types, following the usual syntax of C++ containers. The default container type
- * is std::list (as defined in queue-fwd.h). In case the container is such that
+ * is RingBuffer (as defined in queue-fwd.h), a contiguous circular buffer that
+ * grows geometrically and hence does not allocate memory on every enqueue once it
+ * has reached its steady-state capacity. Note that, unlike std::list, RingBuffer
+ * iterators are invalidated by insertions and removals; a queue that needs to keep
+ * iterators to its items across such operations (or frequently inserts items in the
+ * middle of the queue) can select std::list or any other container through the
+ * Container template parameter. In case the container is such that
  * an object stored within the queue is obtained from a container element through
  * an operation other than dereferencing an iterator pointing to the container
  * element, the container has to provide a public method named GetItem that
@@ -0,0 +1,579 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include "ns3/assert.h"
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup queue
+ * ns3::RingBuffer declaration and implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup queue
+ * @brief Contiguous circular buffer used to store the items of a Queue
+ *
+ * The elements are stored in a single array whose capacity is a power of two
+ * and which is doubled whenever the buffer is full, hence inserting or removing
+ * an element at either end takes amortized constant time and does not require
+ * any memory allocation once the buffer has reached its steady-state capacity.
+ * Inserting or removing an element in the middle of the buffer shifts the
+ * elements on the shorter side of the given position.
+ *
+ * The class provides the subset of the std::deque interface required by the
+ * Queue class (insert(), erase(), clear() and the iterator types). Unlike
+ * std::list, iterators are invalidated by insertions and removals.
+ *
+ * @tparam T \explicit Type of the stored elements, which must be default
+ *           constructible and move assignable
+ */
+template <typename T>
+class RingBuffer
+{
+  private:
+    /**
+     * Random access iterator over the elements of a RingBuffer. An iterator
+     * stores the logical position of the element, i.e., its distance from the
+     * head of the buffer.
+     *
+     * @tparam IsConst whether this is a const iterator
+     */
+    template <bool IsConst>
+    class Iter
+    {
+      public:
+        /// The iterator category
+        using iterator_category = std::random_access_iterator_tag;
+        /// The type of the pointed-to elements
+        using value_type = T;
+        /// The type of the difference between two iterators
+        using difference_type = std::ptrdiff_t;
+        /// The pointer type
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        /// The reference type
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+        /// The type of the buffer the iterator refers to
+        using BufferType = std::conditional_t<IsConst, const RingBuffer, RingBuffer>;
+
+        Iter() = default;
+
+        /**
+         * Constructor
+         *
+         * @param buffer the buffer
+         * @param pos the logical position of the element
+         */
+        Iter(BufferType* buffer, std::size_t pos)
+            : m_buffer(buffer),
+              m_pos(pos)
+        {
+        }
+
+        /**
+         * Conversion from a non-const iterator to a const iterator.
+         *
+         * @tparam C whether the other iterator is const
+         * @param other the other iterator
+         */
+        template <bool C, typename = std::enable_if_t<IsConst && !C>>
+        Iter(const Iter<C>& other)
+            : m_buffer(other.m_buffer),
+              m_pos(other.m_pos)
+        {
+        }
+
+        /// @return a reference to the pointed-to element
+        reference operator*() const
+        {
+            return m_buffer->At(m_pos);
+        }
+
+        /// @return a pointer to the pointed-to element
+        pointer operator->() const
+        {
+            return &m_buffer->At(m_pos);
+        }
+
+        /**
+         * @param n the offset
+         * @return a reference to the element at the given offset from this iterator
+         */
+        reference operator[](difference_type n) const
+        {
+            return m_buffer->At(m_pos + n);
+        }
+
+        /// @return a reference to this iterator after increment
+        Iter& operator++()
+        {
+            ++m_pos;
+            return *this;
+        }
+
+        /// @return a copy of this iterator before increment
+        Iter operator++(int)
+        {
+            Iter tmp = *this;
+            ++m_pos;
+            return tmp;
+        }
+
+        /// @return a reference to this iterator after decrement
+        Iter& operator--()
+        {
+            --m_pos;
+            return *this;
+        }
+
+        /// @return a copy of this iterator before decrement
+        Iter operator--(int)
+        {
+            Iter tmp = *this;
+            --m_pos;
+            return tmp;
+        }
+
+        /**
+         * @param n the offset
+         * @return a reference to this iterator after moving it by the given offset
+         */
+        Iter& operator+=(difference_type n)
+        {
+            m_pos += n;
+            return *this;
+        }
+
+        /**
+         * @param n the offset
+         * @return a reference to this iterator after moving it back by the given offset
+         */
+        Iter& operator-=(difference_type n)
+        {
+            m_pos -= n;
+            return *this;
+        }
+
+        /**
+         * @param it the iterator
+         * @param n the offset
+         * @return an iterator pointing to the element at the given offset from the given iterator
+         */
+        friend Iter operator+(Iter it, difference_type n)
+        {
+            return it += n;
+        }
+
+        /**
+         * @param n the offset
+         * @param it the iterator
+         * @return an iterator pointing to the element at the given offset from the given iterator
+         */
+        friend Iter operator+(difference_type n, Iter it)
+        {
+            return it += n;
+        }
+
+        /**
+         * @param it the iterator
+         * @param n the offset
+         * @return an iterator pointing to the element at the given offset before the given
+         *         iterator
+         */
+        friend Iter operator-(Iter it, difference_type n)
+        {
+            return it -= n;
+        }
+
+        /**
+         * @param a the first iterator
+         * @param b the second iterator
+         * @return the distance between the two iterators
+         */
+        friend difference_type operator-(const Iter& a, const Iter& b)
+        {
+            return static_cast<difference_type>(a.m_pos) - static_cast<difference_type>(b.m_pos);
+        }
+
+        /**
+         * @param a the first iterator
+         * @param b the second iterator
+         * @return true if the two iterators point to the same element
+         */
+        friend bool operator==(const Iter& a, const Iter& b)
+        {
+            return a.m_pos == b.m_pos;
+        }
+
+        /**
+         * @param a the first iterator
+         * @param b the second iterator
+         * @return the ordering of the positions of the two iterators
+         */
+        friend auto operator<=>(const Iter& a, const Iter& b)
+        {
+            return a.m_pos <=> b.m_pos;
+        }
+
+      private:
+        friend class RingBuffer;
+        friend class Iter<!IsConst>;
+
+        BufferType* m_buffer{nullptr}; //!< the buffer
+        std::size_t m_pos{0};          //!< the logical position of the element
+    };
+
+  public:
+    /// The type of the stored elements
+    using value_type = T;
+    /// The size type
+    using size_type = std::size_t;
+    /// The reference type
+    using reference = T&;
+    /// The const reference type
+    using const_reference = const T&;
+    /// Iterator
+    using iterator = Iter<false>;
+    /// Const iterator
+    using const_iterator = Iter<true>;
+
+    RingBuffer() = default;
+
+    /// @return the number of stored elements
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /// @return true if the buffer contains no element
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /// @return the number of elements that can be stored without reallocating
+    size_type capacity() const
+    {
+        return m_storage.size();
+    }
+
+    /**
+     * Make room for at least the given number of elements.
+     *
+     * @param n the number of elements
+     */
+    void reserve(size_type n)
+    {
+        if (n > capacity())
+        {
+            Grow(n);
+        }
+    }
+
+    /// @return an iterator pointing to the first element
+    iterator begin()
+    {
+        return iterator(this, 0);
+    }
+
+    /// @return an iterator pointing past the last element
+    iterator end()
+    {
+        return iterator(this, m_size);
+    }
+
+    /// @return a const iterator pointing to the first element
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0);
+    }
+
+    /// @return a const iterator pointing past the last element
+    const_iterator end() const
+    {
+        return const_iterator(this, m_size);
+    }
+
+    /// @return a const iterator pointing to the first element
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    /// @return a const iterator pointing past the last element
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    /// @return a reference to the first element
+    reference front()
+    {
+        NS_ASSERT(m_size > 0);
+        return At(0);
+    }
+
+    /// @return a const reference to the first element
+    const_reference front() const
+    {
+        NS_ASSERT(m_size > 0);
+        return At(0);
+    }
+
+    /// @return a reference to the last element
+    reference back()
+    {
+        NS_ASSERT(m_size > 0);
+        return At(m_size - 1);
+    }
+
+    /// @return a const reference to the last element
+    const_reference back() const
+    {
+        NS_ASSERT(m_size > 0);
+        return At(m_size - 1);
+    }
+
+    /**
+     * @param pos the logical position of an element
+     * @return a reference to the element
+     */
+    reference operator[](size_type pos)
+    {
+        return At(pos);
+    }
+
+    /**
+     * @param pos the logical position of an element
+     * @return a const reference to the element
+     */
+    const_reference operator[](size_type pos) const
+    {
+        return At(pos);
+    }
+
+    /**
+     * Append an element to the buffer.
+     *
+     * @param value the element
+     */
+    void push_back(T value)
+    {
+        if (m_size == capacity())
+        {
+            Grow(m_size + 1);
+        }
+        At(m_size) = std::move(value);
+        ++m_size;
+    }
+
+    /**
+     * Prepend an element to the buffer.
+     *
+     * @param value the element
+     */
+    void push_front(T value)
+    {
+        if (m_size == capacity())
+        {
+            Grow(m_size + 1);
+        }
+        m_head = (m_head - 1) & m_mask;
+        At(0) = std::move(value);
+        ++m_size;
+    }
+
+    /**
+     * Remove the first element. The slot previously occupied by the element is
+     * reset, so that resources held by the element are released immediately.
+     */
+    void pop_front()
+    {
+        NS_ASSERT(m_size > 0);
+        At(0) = T();
+        m_head = (m_head + 1) & m_mask;
+        --m_size;
+    }
+
+    /**
+     * Remove the last element. The slot previously occupied by the element is
+     * reset, so that resources held by the element are released immediately.
+     */
+    void pop_back()
+    {
+        NS_ASSERT(m_size > 0);
+        At(m_size - 1) = T();
+        --m_size;
+    }
+
+    /**
+     * Insert an element before the given position.
+     *
+     * @param pos the position before which the element is inserted
+     * @param value the element
+     * @return an iterator pointing to the inserted element
+     */
+    iterator insert(const_iterator pos, T value)
+    {
+        size_type idx = pos.m_pos;
+        NS_ASSERT(idx <= m_size);
+
+        if (idx == m_size)
+        {
+            push_back(std::move(value));
+        }
+        else if (idx == 0)
+        {
+            push_front(std::move(value));
+        }
+        else
+        {
+            if (m_size == capacity())
+            {
+                Grow(m_size + 1);
+            }
+            if (idx < m_size / 2)
+            {
+                // shift the elements preceding the given position one slot towards the front
+                m_head = (m_head - 1) & m_mask;
+                for (size_type i = 0; i < idx; ++i)
+                {
+                    At(i) = std::move(At(i + 1));
+                }
+            }
+            else
+            {
+                // shift the elements following the given position one slot towards the back
+                for (size_type i = m_size; i > idx; --i)
+                {
+                    At(i) = std::move(At(i - 1));
+                }
+            }
+            At(idx) = std::move(value);
+            ++m_size;
+        }
+        return iterator(this, idx);
+    }
+
+    /**
+     * Remove the element at the given position.
+     *
+     * @param pos the position of the element to remove
+     * @return an iterator pointing to the element following the removed one
+     */
+    iterator erase(const_iterator pos)
+    {
+        size_type idx = pos.m_pos;
+        NS_ASSERT(idx < m_size);
+
+        if (idx == 0)
+        {
+            pop_front();
+        }
+        else if (idx == m_size - 1)
+        {
+            pop_back();
+        }
+        else if (idx < m_size / 2)
+        {
+            // shift the elements preceding the given position one slot towards the back
+            for (size_type i = idx; i > 0; --i)
+            {
+                At(i) = std::move(At(i - 1));
+            }
+            pop_front();
+        }
+        else
+        {
+            // shift the elements following the given position one slot towards the front
+            for (size_type i = idx; i + 1 < m_size; ++i)
+            {
+                At(i) = std::move(At(i + 1));
+            }
+            pop_back();
+        }
+        return iterator(this, idx);
+    }
+
+    /**
+     * Remove all the elements. The storage is retained, so that the buffer can
+     * be refilled without further memory allocations.
+     */
+    void clear()
+    {
+        for (size_type i = 0; i < m_size; ++i)
+        {
+            At(i) = T();
+        }
+        m_head = 0;
+        m_size = 0;
+    }
+
+  private:
+    /**
+     * @param pos the logical position of an element
+     * @return a reference to the element
+     */
+    T& At(size_type pos)
+    {
+        return m_storage[(m_head + pos) & m_mask];
+    }
+
+    /**
+     * @param pos the logical position of an element
+     * @return a const reference to the element
+     */
+    const T& At(size_type pos) const
+    {
+        return m_storage[(m_head + pos) & m_mask];
+    }
+
+    /**
+     * Reallocate the storage so that it can hold at least the given number of
+     * elements. The new capacity is the smallest power of two that is not less
+     * than the given number of elements and not less than twice the current
+     * capacity. The elements are moved to the beginning of the new storage.
+     *
+     * @param minCapacity the minimum required capacity
+     */
+    void Grow(size_type minCapacity)
+    {
+        size_type newCapacity = (capacity() == 0 ? MIN_CAPACITY : 2 * capacity());
+        while (newCapacity < minCapacity)
+        {
+            newCapacity *= 2;
+        }
+
+        std::vector<T> storage(newCapacity);
+        for (size_type i = 0; i < m_size; ++i)
+        {
+            storage[i] = std::move(At(i));
+        }
+        m_storage.swap(storage);
+        m_head = 0;
+        m_mask = newCapacity - 1;
+    }
+
+    /// Capacity allocated the first time an element is inserted
+    static constexpr size_type MIN_CAPACITY = 16;
+
+    std::vector<T> m_storage; //!< the storage, whose size is zero or a power of two
+    size_type m_head{0};      //!< index in the storage of the first element
+    size_type m_size{0};      //!< number of stored elements
+    size_type m_mask{0};      //!< capacity of the storage minus one
+};
+
+} // namespace ns3
+
+#endif /* RING_BUFFER_H */
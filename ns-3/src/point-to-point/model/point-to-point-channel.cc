@@ -96,6 +96,39 @@ PointToPointChannel::TransmitStart(Ptr<const Packet> p, Ptr<PointToPointNetDevic
     return true;
 }
 
+bool
+PointToPointChannel::TransmitBurst(const std::vector<BurstItem>& burst,
+                                   Ptr<PointToPointNetDevice> src)
+{
+    NS_LOG_FUNCTION(this << burst.size() << src);
+    NS_ASSERT(!burst.empty());
+
+    NS_ASSERT(m_link[0].m_state != INITIALIZING);
+    NS_ASSERT(m_link[1].m_state != INITIALIZING);
+
+    uint32_t wire = src == m_link[0].m_src ? 0 : 1;
+
+    std::vector<std::pair<Time, Ptr<Packet>>> rxBurst;
+    rxBurst.reserve(burst.size());
+
+    for (const auto& item : burst)
+    {
+        NS_LOG_LOGIC("UID is " << item.packet->GetUid() << ")");
+        Time lastBitTime = item.txStart + item.txTime + m_delay;
+        rxBurst.emplace_back(Simulator::Now() + lastBitTime, item.packet->Copy());
+
+        // Call the tx anim callback on the net device
+        m_txrxPointToPoint(item.packet, src, m_link[wire].m_dst, item.txTime, lastBitTime);
+    }
+
+    Simulator::ScheduleWithContext(m_link[wire].m_dst->GetNode()->GetId(),
+                                   rxBurst.front().first - Simulator::Now(),
+                                   &PointToPointNetDevice::ReceiveBurst,
+                                   m_link[wire].m_dst,
+                                   std::move(rxBurst));
+    return true;
+}
+
 std::size_t
 PointToPointChannel::GetNDevices() const
 {
@@ -10,10 +10,12 @@
 #include "ns3/channel.h"
 #include "ns3/data-rate.h"
 #include "ns3/nstime.h"
+#include "ns3/packet.h"
 #include "ns3/ptr.h"
 #include "ns3/traced-callback.h"
 
 #include <list>
+#include <vector>
 
 namespace ns3
 {
@@ -70,6 +72,31 @@ class PointToPointChannel : public Channel
      */
     virtual bool TransmitStart(Ptr<const Packet> p, Ptr<PointToPointNetDevice> src, Time txTime);
 
+    /**
+     * @brief A packet belonging to a burst of packets transmitted back to back
+     */
+    struct BurstItem
+    {
+        Ptr<const Packet> packet; //!< the packet
+        Time txStart; //!< transmission start time, relative to the start of the burst
+        Time txTime;  //!< transmit time of the packet
+    };
+
+    /**
+     * @brief Transmit a burst of packets sent back to back over this channel
+     *
+     * Unlike TransmitStart, which schedules a receive event for every packet,
+     * a single event is scheduled at the time the last bit of the first packet
+     * of the burst reaches the destination device, which then delivers each
+     * packet of the burst at its own reception time.
+     *
+     * @param burst the packets of the burst, in transmission order
+     * @param src Source PointToPointNetDevice
+     * @returns true if successful (currently always true)
+     */
+    virtual bool TransmitBurst(const std::vector<BurstItem>& burst,
+                               Ptr<PointToPointNetDevice> src);
+
     /**
      * @brief Get number of devices on this channel
      * @returns number of devices on this channel
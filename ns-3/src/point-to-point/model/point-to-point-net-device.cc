@@ -60,6 +60,17 @@ PointToPointNetDevice::GetTypeId()
                           TimeValue(Seconds(0)),
                           MakeTimeAccessor(&PointToPointNetDevice::m_tInterframeGap),
                           MakeTimeChecker())
+            .AddAttribute("MaxBurstSize",
+                          "The maximum number of packets dequeued and transmitted back to back "
+                          "within a single transmit event when the transmit queue is backlogged. "
+                          "A value of one disables the batched transmission mode. Note that the "
+                          "PhyTxBegin trace source is fired for all the packets of a burst when "
+                          "the burst starts and the PhyTxEnd trace source is fired for all the "
+                          "packets of a burst when the burst ends, rather than at the start and "
+                          "at the end of the transmission of each packet.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&PointToPointNetDevice::m_maxBurstSize),
+                          MakeUintegerChecker<uint32_t>(1))
 
             //
             // Transmit queueing discipline for the device which includes its own set
@@ -118,7 +129,9 @@ PointToPointNetDevice::GetTypeId()
                             "ns3::Packet::TracedCallback")
             .AddTraceSource("PhyTxEnd",
                             "Trace source indicating a packet has been "
-                            "completely transmitted over the channel",
+                            "completely transmitted over the channel (or, in the batched "
+                            "transmission mode, that the burst including the packet has been "
+                            "completely transmitted)",
                             MakeTraceSourceAccessor(&PointToPointNetDevice::m_phyTxEndTrace),
                             "ns3::Packet::TracedCallback")
             .AddTraceSource("PhyTxDrop",
@@ -167,7 +180,8 @@ PointToPointNetDevice::PointToPointNetDevice()
     : m_txMachineState(READY),
       m_channel(nullptr),
       m_linkUp(false),
-      m_currentPkt(nullptr)
+      m_currentPkt(nullptr),
+      m_maxBurstSize(1)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -204,6 +218,9 @@ PointToPointNetDevice::DoDispose()
     m_channel = nullptr;
     m_receiveErrorModel = nullptr;
     m_currentPkt = nullptr;
+    m_txBurst.clear();
+    m_rxBurstEvent.Cancel();
+    m_rxBurst.clear();
     m_queue = nullptr;
     NetDevice::DoDispose();
 }
@@ -252,6 +269,57 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
     return result;
 }
 
+bool
+PointToPointNetDevice::TransmitBurst(Ptr<Packet> p)
+{
+    NS_LOG_FUNCTION(this << p);
+
+    NS_ASSERT_MSG(m_txMachineState == READY, "Must be READY to transmit");
+    NS_ASSERT_MSG(m_txBurst.empty(), "A burst is still being transmitted");
+    m_txMachineState = BUSY;
+    m_currentPkt = p;
+
+    //
+    // The packets of the burst are transmitted back to back, hence the
+    // transmission of a packet starts when the transmission of the previous
+    // packet is complete and the interframe gap has elapsed.
+    //
+    std::vector<PointToPointChannel::BurstItem> burst;
+    Time txStart;
+
+    while (true)
+    {
+        NS_LOG_LOGIC("UID is " << p->GetUid() << ")");
+        m_phyTxBeginTrace(p);
+
+        Time txTime = m_bps.CalculateBytesTxTime(p->GetSize());
+        burst.push_back({p, txStart, txTime});
+        txStart += txTime + m_tInterframeGap;
+
+        if (burst.size() == m_maxBurstSize || !(p = m_queue->Dequeue()))
+        {
+            break;
+        }
+        m_snifferTrace(p);
+        m_promiscSnifferTrace(p);
+        m_txBurst.push_back(p);
+    }
+
+    NS_LOG_LOGIC("Schedule TransmitCompleteEvent for a burst of "
+                 << burst.size() << " packets in " << txStart.As(Time::S));
+    Simulator::Schedule(txStart, &PointToPointNetDevice::TransmitComplete, this);
+
+    bool result = m_channel->TransmitBurst(burst, this);
+    if (!result)
+    {
+        for (const auto& item : burst)
+        {
+            m_phyTxDropTrace(item.packet);
+        }
+    }
+    return result;
+}
+
 void
 PointToPointNetDevice::TransmitComplete()
 {
@@ -271,6 +339,12 @@ PointToPointNetDevice::TransmitComplete()
     m_phyTxEndTrace(m_currentPkt);
     m_currentPkt = nullptr;
 
+    for (const auto& pkt : m_txBurst)
+    {
+        m_phyTxEndTrace(pkt);
+    }
+    m_txBurst.clear();
+
     Ptr<Packet> p = m_queue->Dequeue();
     if (!p)
     {
@@ -283,6 +357,12 @@ PointToPointNetDevice::TransmitComplete()
     //
     m_snifferTrace(p);
     m_promiscSnifferTrace(p);
+
+    if (m_maxBurstSize > 1 && !m_queue->IsEmpty())
+    {
+        TransmitBurst(p);
+        return;
+    }
     TransmitStart(p);
 }
 
@@ -373,6 +453,46 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
     }
 }
 
+void
+PointToPointNetDevice::ReceiveBurst(std::vector<std::pair<Time, Ptr<Packet>>> burst)
+{
+    NS_LOG_FUNCTION(this << burst.size());
+
+    //
+    // Bursts are transmitted back to back on the wire, hence the packets of
+    // this burst are received after all the packets of the previous bursts.
+    //
+    NS_ASSERT(m_rxBurst.empty() || m_rxBurst.back().first <= burst.front().first);
+    m_rxBurst.insert(m_rxBurst.end(),
+                     std::make_move_iterator(burst.begin()),
+                     std::make_move_iterator(burst.end()));
+
+    if (!m_rxBurstEvent.IsPending())
+    {
+        DeliverBurst();
+    }
+}
+
+void
+PointToPointNetDevice::DeliverBurst()
+{
+    NS_LOG_FUNCTION(this);
+
+    while (!m_rxBurst.empty() && m_rxBurst.front().first <= Simulator::Now())
+    {
+        Ptr<Packet> packet = std::move(m_rxBurst.front().second);
+        m_rxBurst.pop_front();
+        Receive(packet);
+    }
+
+    if (!m_rxBurst.empty())
+    {
+        m_rxBurstEvent = Simulator::Schedule(m_rxBurst.front().first - Simulator::Now(),
+                                             &PointToPointNetDevice::DeliverBurst,
+                                             this);
+    }
+}
+
 Ptr<Queue<Packet>>
 PointToPointNetDevice::GetQueue() const
 {
@@ -10,6 +10,7 @@
 #include "ns3/address.h"
 #include "ns3/callback.h"
 #include "ns3/data-rate.h"
+#include "ns3/event-id.h"
 #include "ns3/mac48-address.h"
 #include "ns3/net-device.h"
 #include "ns3/node.h"
@@ -20,6 +21,9 @@
 #include "ns3/traced-callback.h"
 
 #include <cstring>
+#include <deque>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -48,6 +52,18 @@ class ErrorModel;
  * Key parameters or objects that can be specified for this device
  * include a queue, data rate, and interframe transmission gap (the
  * propagation delay is set in the PointToPointChannel).
+ *
+ * If the MaxBurstSize attribute is greater than one, the device operates in
+ * batched transmission mode: when a transmission completes and the queue is
+ * backlogged, up to MaxBurstSize packets are dequeued at once and their
+ * back-to-back transmission times are computed analytically. A single
+ * transmit complete event is scheduled for the whole burst and the channel
+ * schedules a single receive event per burst, which the receiving device
+ * expands by delivering each packet at its own reception time. Hence, packet
+ * reception times are the same as in the non-batched mode, but packets are
+ * removed from the transmit queue (and the PhyTxBegin and Sniffer trace
+ * sources are fired) when the burst starts rather than when the transmission
+ * of each packet starts.
  */
 class PointToPointNetDevice : public NetDevice
 {
@@ -143,6 +159,18 @@ class PointToPointNetDevice : public NetDevice
      */
     void Receive(Ptr<Packet> p);
 
+    /**
+     * Receive a burst of packets from a connected PointToPointChannel.
+     *
+     * This method is called by the channel when the last bit of the first
+     * packet of a burst has arrived at the device. Every packet of the burst
+     * is passed to Receive() at its own reception time.
+     *
+     * @param burst the packets of the burst, each paired with the (absolute)
+     *        time at which its last bit arrives at the device
+     */
+    void ReceiveBurst(std::vector<std::pair<Time, Ptr<Packet>>> burst);
+
     // The remaining methods are documented in ns3::NetDevice*
 
     void SetIfIndex(const uint32_t index) override;
@@ -242,14 +270,35 @@ class PointToPointNetDevice : public NetDevice
      */
     bool TransmitStart(Ptr<Packet> p);
 
+    /**
+     * Start Sending a Burst of Packets Down the Wire.
+     *
+     * Dequeue up to MaxBurstSize - 1 more packets and transmit them back to
+     * back after the given packet. A single event is scheduled for the time at
+     * which the bits of the last packet of the burst have been completely
+     * transmitted.
+     *
+     * @see PointToPointChannel::TransmitBurst ()
+     * @see TransmitComplete()
+     * @param p the first packet of the burst
+     * @returns true if success, false on failure
+     */
+    bool TransmitBurst(Ptr<Packet> p);
+
     /**
      * Stop Sending a Packet Down the Wire and Begin the Interframe Gap.
      *
      * The TransmitComplete method is used internally to finish the process
-     * of sending a packet out on the channel.
+     * of sending a packet (or a burst of packets) out on the channel.
      */
     void TransmitComplete();
 
+    /**
+     * Pass the packets of the received bursts whose reception time has been
+     * reached to Receive() and schedule the next reception, if any.
+     */
+    void DeliverBurst();
+
     /**
      * @brief Make the link up and running
      *
@@ -433,6 +482,15 @@ class PointToPointNetDevice : public NetDevice
 
     Ptr<Packet> m_currentPkt; //!< Current packet processed
 
+    /**
+     * The maximum number of packets transmitted back to back within a single
+     * transmit event (a value of one disables the batched transmission mode)
+     */
+    uint32_t m_maxBurstSize;
+    std::vector<Ptr<Packet>> m_txBurst; //!< packets of the current burst after m_currentPkt
+    std::deque<std::pair<Time, Ptr<Packet>>> m_rxBurst; //!< received packets yet to deliver
+    EventId m_rxBurstEvent; //!< event to deliver the next packet of a received burst
+
     /**
      * @brief PPP to Ethernet protocol number mapping
      * @param protocol A PPP protocol number
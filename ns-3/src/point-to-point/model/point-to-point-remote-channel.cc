@@ -62,4 +62,28 @@ PointToPointRemoteChannel::TransmitStart(Ptr<const Packet> p,
     return true;
 }
 
+bool
+PointToPointRemoteChannel::TransmitBurst(const std::vector<BurstItem>& burst,
+                                         Ptr<PointToPointNetDevice> src)
+{
+    NS_LOG_FUNCTION(this << burst.size() << src);
+
+    IsInitialized();
+
+    uint32_t wire = src == GetSource(0) ? 0 : 1;
+    Ptr<PointToPointNetDevice> dst = GetDestination(wire);
+
+    for (const auto& item : burst)
+    {
+        NS_LOG_LOGIC("UID is " << item.packet->GetUid() << ")");
+        // Calculate the rxTime (absolute)
+        Time rxTime = Simulator::Now() + item.txStart + item.txTime + GetDelay();
+        MpiInterface::SendPacket(item.packet->Copy(),
+                                 rxTime,
+                                 dst->GetNode()->GetId(),
+                                 dst->GetIfIndex());
+    }
+    return true;
+}
+
 } // namespace ns3
@@ -56,6 +56,19 @@ class PointToPointRemoteChannel : public PointToPointChannel
      * @returns true if successful (currently always true)
      */
     bool TransmitStart(Ptr<const Packet> p, Ptr<PointToPointNetDevice> src, Time txTime) override;
+
+    /**
+     * @brief Transmit a burst of packets
+     *
+     * Each packet of the burst is sent to the remote process along with its
+     * own reception time.
+     *
+     * @param burst the packets of the burst, in transmission order
+     * @param src Source PointToPointNetDevice
+     * @returns true if successful (currently always true)
+     */
+    bool TransmitBurst(const std::vector<BurstItem>& burst,
+                       Ptr<PointToPointNetDevice> src) override;
 };
 
 } // namespace ns3
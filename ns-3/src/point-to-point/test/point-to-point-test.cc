@@ -12,8 +12,10 @@
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -128,6 +130,152 @@ PointToPointTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @brief Test class for the batched transmission mode of the PointToPoint model
+ *
+ * It enqueues a backlog of packets in a PointToPointNetDevice and checks that
+ * every packet is received at the time it would be received if packets were
+ * transmitted one at a time, and that the batched transmission mode reduces
+ * the number of events.
+ */
+class PointToPointBurstTest : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test
+     */
+    PointToPointBurstTest();
+
+    /**
+     * @brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    /**
+     * @brief Send a number of packets from the given device at the same time
+     *
+     * @param device the transmitting device
+     * @param nPackets the number of packets to send
+     */
+    void SendPackets(Ptr<PointToPointNetDevice> device, uint32_t nPackets);
+
+    /**
+     * @brief Callback function which records the packet reception time
+     *
+     * @param dev The receiving device.
+     * @param pkt The received packet.
+     * @param mode The protocol mode used.
+     * @param sender The sender address.
+     *
+     * @return A boolean indicating packet handled properly.
+     */
+    bool RxPacket(Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address& sender);
+
+    /**
+     * @brief Run a simulation with the given maximum burst size
+     *
+     * @param maxBurstSize the value of the MaxBurstSize attribute of the devices
+     * @return the number of events executed by the simulator
+     */
+    uint64_t RunSimulation(uint32_t maxBurstSize);
+
+    std::vector<Time> m_rxTimes; //!< packet reception times
+};
+
+PointToPointBurstTest::PointToPointBurstTest()
+    : TestCase("PointToPoint batched transmission")
+{
+}
+
+void
+PointToPointBurstTest::SendPackets(Ptr<PointToPointNetDevice> device, uint32_t nPackets)
+{
+    for (uint32_t i = 0; i < nPackets; ++i)
+    {
+        // use different packet sizes so that transmit times differ
+        device->Send(Create<Packet>(500 + 100 * (i % 5)), device->GetBroadcast(), 0x800);
+    }
+}
+
+bool
+PointToPointBurstTest::RxPacket(Ptr<NetDevice> dev,
+                                Ptr<const Packet> pkt,
+                                uint16_t mode,
+                                const Address& sender)
+{
+    m_rxTimes.push_back(Simulator::Now());
+    return true;
+}
+
+uint64_t
+PointToPointBurstTest::RunSimulation(uint32_t maxBurstSize)
+{
+    m_rxTimes.clear();
+
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel>();
+    channel->SetAttribute("Delay", TimeValue(MilliSeconds(2)));
+
+    for (auto dev : {devA, devB})
+    {
+        dev->SetAttribute("DataRate", DataRateValue(DataRate("10Mbps")));
+        dev->SetAttribute("InterframeGap", TimeValue(MicroSeconds(5)));
+        dev->SetAttribute("MaxBurstSize", UintegerValue(maxBurstSize));
+        dev->Attach(channel);
+        dev->SetAddress(Mac48Address::Allocate());
+        dev->SetQueue(CreateObject<DropTailQueue<Packet>>());
+    }
+
+    a->AddDevice(devA);
+    b->AddDevice(devB);
+
+    devB->SetReceiveCallback(MakeCallback(&PointToPointBurstTest::RxPacket, this));
+
+    // two backlogs, the second one being generated while the first one is in flight
+    Simulator::Schedule(Seconds(1), &PointToPointBurstTest::SendPackets, this, devA, 30);
+    Simulator::Schedule(Seconds(1) + MilliSeconds(3),
+                        &PointToPointBurstTest::SendPackets,
+                        this,
+                        devA,
+                        10);
+
+    Simulator::Run();
+    uint64_t nEvents = Simulator::GetEventCount();
+    Simulator::Destroy();
+    return nEvents;
+}
+
+void
+PointToPointBurstTest::DoRun()
+{
+    uint64_t nEvents = RunSimulation(1);
+    std::vector<Time> expected = m_rxTimes;
+    NS_TEST_ASSERT_MSG_EQ(expected.size(), 40, "Unexpected number of received packets");
+
+    for (uint32_t maxBurstSize : {2, 8, 64})
+    {
+        uint64_t nBurstEvents = RunSimulation(maxBurstSize);
+        NS_TEST_ASSERT_MSG_EQ(m_rxTimes.size(),
+                              expected.size(),
+                              "Unexpected number of received packets with bursts of "
+                                  << maxBurstSize << " packets");
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            NS_TEST_EXPECT_MSG_EQ(m_rxTimes[i],
+                                  expected[i],
+                                  "Unexpected reception time for packet "
+                                      << i << " with bursts of " << maxBurstSize << " packets");
+        }
+        NS_TEST_EXPECT_MSG_LT(nBurstEvents,
+                              nEvents,
+                              "Batched transmission did not reduce the number of events");
+    }
+}
+
 /**
  * @brief TestSuite for PointToPoint module
  */
@@ -144,6 +292,7 @@ PointToPointTestSuite::PointToPointTestSuite()
     : TestSuite("devices-point-to-point", Type::UNIT)
 {
     AddTestCase(new PointToPointTest, TestCase::Duration::QUICK);
+    AddTestCase(new PointToPointBurstTest, TestCase::Duration::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
@@ -82,6 +82,7 @@ MultiModelSpectrumChannel::DoDispose()
     NS_LOG_FUNCTION(this);
     m_txSpectrumModelInfoMap.clear();
     m_rxSpectrumModelInfoMap.clear();
+    m_rxPhyGrids.clear();
     SpectrumChannel::DoDispose();
 }
 
@@ -116,6 +117,7 @@ MultiModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
         if (phyIt != rxInfoIterator->second.m_rxPhys.end())
         {
             rxInfoIterator->second.m_rxPhys.erase(phyIt);
+            m_rxPhyGrids.erase(rxInfoIterator->first);
             --m_numDevices;
             break; // there should be at most one entry
         }
@@ -241,7 +243,9 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     NS_LOG_LOGIC("converter map first element: "
                  << txInfoIterator->second.m_spectrumConverterMap.begin()->first);
 
-    std::map<SpectrumModelUid_t, Ptr<SpectrumValue>> convertedPsds{};
+    // the PSDs converted to the RX SpectrumModels are computed once per transmission and then
+    // shared by all the receivers, instead of being copied for every receiver
+    auto convertedPsds = std::make_shared<ConvertedPsdMap_t>();
     for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
          rxInfoIterator != m_rxSpectrumModelInfoMap.end();
          ++rxInfoIterator)
@@ -268,7 +272,7 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
             }
             convertedTxPowerSpectrum = rxConverterIterator->second.Convert(txParams->psd);
         }
-        convertedPsds.emplace(rxSpectrumModelUid, convertedTxPowerSpectrum);
+        convertedPsds->emplace(rxSpectrumModelUid, convertedTxPowerSpectrum);
     }
 
     for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
@@ -284,10 +288,10 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
             continue;
         }
 
-        for (auto rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin();
-             rxPhyIterator != rxInfoIterator->second.m_rxPhys.end();
-             ++rxPhyIterator)
+        const auto& rxPhys = rxInfoIterator->second.m_rxPhys;
+        for (auto i : GetRxPhyIndices(rxPhys, m_rxPhyGrids[rxSpectrumModelUid], refTxMobility))
         {
+            auto rxPhyIterator = rxPhys.cbegin() + i;
             NS_ASSERT_MSG((*rxPhyIterator)->GetRxSpectrumModel()->GetUid() == rxSpectrumModelUid,
                           "SpectrumModel change was not notified to MultiModelSpectrumChannel "
                           "(i.e., AddRx should be called again after model is changed)");
@@ -317,7 +321,7 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
 
                 NS_LOG_LOGIC("copying signal parameters " << txParams);
                 auto rxParams = txParams->Copy();
-                rxParams->psd = Copy<SpectrumValue>(convertedPsds.at(rxSpectrumModelUid));
+                rxParams->psd = Copy<SpectrumValue>(convertedPsds->at(rxSpectrumModelUid));
                 Time delay{0};
 
                 auto receiverMobility = (*rxPhyIterator)->GetMobility();
@@ -330,6 +334,11 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                         txMobility =
                             wraparound->GetVirtualMobilityModel(refTxMobility, receiverMobility);
                     }
+                    if (!IsInRange(txMobility, receiverMobility))
+                    {
+                        NS_LOG_LOGIC("receiver beyond MaxRange");
+                        continue;
+                    }
                     rxParams->txMobility = txMobility;
 
                     if (rxParams->txAntenna)
@@ -377,12 +386,11 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
 }
 
 void
-MultiModelSpectrumChannel::StartRx(
-    Ptr<SpectrumValue> txPsd,
-    double txAntennaGain,
-    Ptr<SpectrumSignalParameters> params,
-    Ptr<SpectrumPhy> receiver,
-    const std::map<SpectrumModelUid_t, Ptr<SpectrumValue>>& availableConvertedPsds)
+MultiModelSpectrumChannel::StartRx(Ptr<SpectrumValue> txPsd,
+                                   double txAntennaGain,
+                                   Ptr<SpectrumSignalParameters> params,
+                                   Ptr<SpectrumPhy> receiver,
+                                   std::shared_ptr<const ConvertedPsdMap_t> availableConvertedPsds)
 {
     NS_LOG_FUNCTION(this);
 
@@ -395,11 +403,12 @@ MultiModelSpectrumChannel::StartRx(
     {
         NS_LOG_LOGIC("SpectrumModelUid changed since TX started");
 
-        const auto itConvertedPsd = availableConvertedPsds.find(phySpectrumModelUid);
-        if (itConvertedPsd != availableConvertedPsds.cend())
+        const auto itConvertedPsd = availableConvertedPsds->find(phySpectrumModelUid);
+        if (itConvertedPsd != availableConvertedPsds->cend())
         {
             NS_LOG_LOGIC("converted PSD already exists for " << phySpectrumModelUid);
-            params->psd = itConvertedPsd->second;
+            // copy it, since the PSD is modified below and the converted PSDs are shared
+            params->psd = Copy<SpectrumValue>(itConvertedPsd->second);
         }
         else
         {
@@ -442,7 +451,7 @@ MultiModelSpectrumChannel::StartRx(
 
         if (m_propagationLoss && (txMobility->GetPosition() != rxMobility->GetPosition()))
         {
-            propagationGainDb = m_propagationLoss->CalcRxPower(0, txMobility, rxMobility);
+            propagationGainDb = GetPropagationGainDb(txMobility, rxMobility);
             NS_LOG_LOGIC("propagationGainDb = " << propagationGainDb << " dB");
             pathLossDb -= propagationGainDb;
         }
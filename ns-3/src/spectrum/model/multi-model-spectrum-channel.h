@@ -17,6 +17,7 @@
 #include "ns3/propagation-delay-model.h"
 
 #include <map>
+#include <memory>
 #include <set>
 
 namespace ns3
@@ -76,6 +77,12 @@ class RxSpectrumModelInfo
  */
 typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap_t;
 
+/**
+ * @ingroup spectrum
+ * Container: SpectrumModelUid_t, PSD converted to that SpectrumModel
+ */
+typedef std::map<SpectrumModelUid_t, Ptr<SpectrumValue>> ConvertedPsdMap_t;
+
 /**
  * @ingroup spectrum
  *
@@ -133,14 +140,14 @@ class MultiModelSpectrumChannel : public SpectrumChannel
      * @param txAntennaGain The antenna gain at the transmitter.
      * @param params The signal parameters.
      * @param receiver A pointer to the receiver SpectrumPhy.
-     * @param availableConvertedPsds available converted PSDs from the TX PSD.
+     * @param availableConvertedPsds available converted PSDs from the TX PSD, shared by all the
+     *        receivers of the transmission
      */
-    virtual void StartRx(
-        Ptr<SpectrumValue> txPsd,
-        double txAntennaGain,
-        Ptr<SpectrumSignalParameters> params,
-        Ptr<SpectrumPhy> receiver,
-        const std::map<SpectrumModelUid_t, Ptr<SpectrumValue>>& availableConvertedPsds);
+    virtual void StartRx(Ptr<SpectrumValue> txPsd,
+                         double txAntennaGain,
+                         Ptr<SpectrumSignalParameters> params,
+                         Ptr<SpectrumPhy> receiver,
+                         std::shared_ptr<const ConvertedPsdMap_t> availableConvertedPsds);
 
     /**
      * Data structure holding, for each TX SpectrumModel,  all the
@@ -156,6 +163,12 @@ class MultiModelSpectrumChannel : public SpectrumChannel
      */
     RxSpectrumModelInfoMap_t m_rxSpectrumModelInfoMap;
 
+    /**
+     * Spatial grids of the indices of the SpectrumPhy instances of each RX spectrum model,
+     * in the m_rxPhys container of the matching entry of m_rxSpectrumModelInfoMap.
+     */
+    std::map<SpectrumModelUid_t, SpatialGridIndex> m_rxPhyGrids;
+
     /**
      * Number of devices connected to the channel.
      */
@@ -46,6 +46,7 @@ SingleModelSpectrumChannel::DoDispose()
 {
     NS_LOG_FUNCTION(this);
     m_phyList.clear();
+    m_rxPhyGrid.Clear();
     m_spectrumModel = nullptr;
     SpectrumChannel::DoDispose();
 }
@@ -69,6 +70,7 @@ SingleModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
     if (it != std::end(m_phyList))
     {
         m_phyList.erase(it);
+        m_rxPhyGrid.Clear();
     }
 }
 
@@ -116,8 +118,9 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     Ptr<MobilityModel> refSenderMobility = txParams->txPhy->GetMobility();
     Ptr<MobilityModel> senderMobility = refSenderMobility;
 
-    for (auto rxPhyIterator = m_phyList.begin(); rxPhyIterator != m_phyList.end(); ++rxPhyIterator)
+    for (auto i : GetRxPhyIndices(m_phyList, m_rxPhyGrid, refSenderMobility))
     {
+        auto rxPhyIterator = m_phyList.cbegin() + i;
         Ptr<NetDevice> rxNetDevice = (*rxPhyIterator)->GetDevice();
         Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
 
@@ -153,6 +156,11 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                     senderMobility =
                         wraparound->GetVirtualMobilityModel(refSenderMobility, receiverMobility);
                 }
+                if (!IsInRange(senderMobility, receiverMobility))
+                {
+                    NS_LOG_LOGIC("receiver beyond MaxRange");
+                    continue;
+                }
                 rxParams->txMobility = senderMobility;
 
                 double txAntennaGain = 0;
@@ -177,8 +185,7 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                 }
                 if (m_propagationLoss)
                 {
-                    propagationGainDb =
-                        m_propagationLoss->CalcRxPower(0, senderMobility, receiverMobility);
+                    propagationGainDb = GetPropagationGainDb(senderMobility, receiverMobility);
                     NS_LOG_LOGIC("propagationGainDb = " << propagationGainDb << " dB");
                     pathLossDb -= propagationGainDb;
                 }
@@ -63,6 +63,11 @@ class SingleModelSpectrumChannel : public SpectrumChannel
      */
     PhyList m_phyList;
 
+    /**
+     * Spatial grid of the indices of the SpectrumPhy instances in m_phyList.
+     */
+    SpatialGridIndex m_rxPhyGrid;
+
     /**
      * SpectrumModel that this channel instance is supporting.
      */
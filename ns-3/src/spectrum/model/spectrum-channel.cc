@@ -8,11 +8,16 @@
 
 #include "spectrum-channel.h"
 
+#include "wraparound-model.h"
+
 #include "ns3/abort.h"
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
 
+#include <numeric>
+
 namespace ns3
 {
 
@@ -34,6 +39,8 @@ SpectrumChannel::DoDispose()
 {
     NS_LOG_FUNCTION(this);
 
+    ClearPropagationGains();
+
     // Any propagation model that holds a pointer
     // back to the spectrum channel should not call Dispose()
     // of its channel pointer, or else a loop may occur.
@@ -69,12 +76,37 @@ SpectrumChannel::GetTypeId()
                           MakeDoubleAccessor(&SpectrumChannel::m_maxLossDb),
                           MakeDoubleChecker<double>())
 
+            .AddAttribute("MaxRange",
+                          "The maximum distance in meters between a transmitter and the "
+                          "receivers to which its transmissions are passed. Unlike MaxLossDb, "
+                          "which is checked after computing the loss for every receiver, the "
+                          "receivers farther than this distance are not considered at all: "
+                          "they are looked up in a spatial grid, which relies on the "
+                          "CourseChange trace of their mobility models. The default value "
+                          "of zero disables the cutoff. Tune this value with care.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&SpectrumChannel::m_maxRange),
+                          MakeDoubleChecker<double>(0))
+
             .AddAttribute("PropagationLossModel",
                           "A pointer to the propagation loss model attached to this channel.",
                           PointerValue(nullptr),
-                          MakePointerAccessor(&SpectrumChannel::m_propagationLoss),
+                          MakePointerAccessor(&SpectrumChannel::SetPropagationLossModel,
+                                              &SpectrumChannel::GetPropagationLossModel),
                           MakePointerChecker<PropagationLossModel>())
 
+            .AddAttribute("CachePropagationLoss",
+                          "If true, the gain computed by the single-frequency "
+                          "PropagationLossModel between a transmitter and a receiver that are "
+                          "both still is reused by the following transmissions, until either "
+                          "of them notifies a course change. Only enable it if the "
+                          "PropagationLossModel is deterministic, i.e., if it always returns "
+                          "the same gain for the same positions, and if the mobility models "
+                          "notify a course change whenever their position or velocity changes.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&SpectrumChannel::m_cachePropagationLoss),
+                          MakeBooleanChecker())
+
             .AddTraceSource("Gain",
                             "This trace is fired whenever a new path loss value "
                             "is calculated. The parameters to this trace are : "
@@ -120,6 +152,15 @@ SpectrumChannel::AddPropagationLossModel(Ptr<PropagationLossModel> loss)
         loss->SetNext(m_propagationLoss);
     }
     m_propagationLoss = loss;
+    ClearPropagationGains();
+}
+
+void
+SpectrumChannel::SetPropagationLossModel(Ptr<PropagationLossModel> loss)
+{
+    NS_LOG_FUNCTION(this << loss);
+    m_propagationLoss = loss;
+    ClearPropagationGains();
 }
 
 void
@@ -194,6 +235,97 @@ SpectrumChannel::GetPropagationDelayModel() const
     return m_propagationDelay;
 }
 
+std::vector<std::size_t>
+SpectrumChannel::GetRxPhyIndices(const std::vector<Ptr<SpectrumPhy>>& rxPhys,
+                                 SpatialGridIndex& grid,
+                                 Ptr<const MobilityModel> txMobility) const
+{
+    NS_LOG_FUNCTION(this << txMobility);
+    if (m_maxRange == 0 || !txMobility || GetObject<WraparoundModel>())
+    {
+        std::vector<std::size_t> indices(rxPhys.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        return indices;
+    }
+    if (grid.GetN() != rxPhys.size())
+    {
+        grid.Clear();
+        grid.SetCellSize(m_maxRange);
+        for (std::size_t i = 0; i < rxPhys.size(); ++i)
+        {
+            grid.Add(i, rxPhys[i]->GetMobility());
+        }
+    }
+    return grid.GetCandidates(txMobility->GetPosition(), m_maxRange);
+}
+
+bool
+SpectrumChannel::IsInRange(Ptr<const MobilityModel> txMobility,
+                           Ptr<const MobilityModel> rxMobility) const
+{
+    return m_maxRange == 0 || txMobility->GetDistanceFrom(rxMobility) <= m_maxRange;
+}
+
+double
+SpectrumChannel::GetPropagationGainDb(Ptr<MobilityModel> txMobility, Ptr<MobilityModel> rxMobility)
+{
+    NS_LOG_FUNCTION(this << txMobility << rxMobility);
+    NS_ASSERT(m_propagationLoss);
+
+    // the gain between moving nodes changes without any course change being notified, and the
+    // virtual mobility models created by the wraparound model are never used again
+    if (!m_cachePropagationLoss || txMobility->GetVelocity().GetLength() > 0 ||
+        rxMobility->GetVelocity().GetLength() > 0 || GetObject<WraparoundModel>())
+    {
+        return m_propagationLoss->CalcRxPower(0, txMobility, rxMobility);
+    }
+
+    auto& gains = m_propagationGains[txMobility];
+    if (auto it = gains.find(rxMobility); it != gains.cend())
+    {
+        NS_LOG_LOGIC("Using the cached propagation gain");
+        return it->second;
+    }
+
+    for (const auto& mobility : {txMobility, rxMobility})
+    {
+        if (m_propagationGainMobilities.insert(mobility).second)
+        {
+            mobility->TraceConnectWithoutContext(
+                "CourseChange",
+                MakeCallback(&SpectrumChannel::CourseChanged, this));
+        }
+    }
+    const auto gainDb = m_propagationLoss->CalcRxPower(0, txMobility, rxMobility);
+    gains.emplace(rxMobility, gainDb);
+    return gainDb;
+}
+
+void
+SpectrumChannel::CourseChanged(Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    m_propagationGains.erase(mobility);
+    for (auto& [txMobility, gains] : m_propagationGains)
+    {
+        gains.erase(mobility);
+    }
+}
+
+void
+SpectrumChannel::ClearPropagationGains()
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& mobility : m_propagationGainMobilities)
+    {
+        mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&SpectrumChannel::CourseChanged, this));
+    }
+    m_propagationGainMobilities.clear();
+    m_propagationGains.clear();
+}
+
 int64_t
 SpectrumChannel::AssignStreams(int64_t stream)
 {
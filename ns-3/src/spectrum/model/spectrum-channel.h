@@ -21,8 +21,12 @@
 #include "ns3/object.h"
 #include "ns3/propagation-delay-model.h"
 #include "ns3/propagation-loss-model.h"
+#include "ns3/spatial-grid-index.h"
 #include "ns3/traced-callback.h"
 
+#include <map>
+#include <set>
+
 namespace ns3
 {
 
@@ -227,6 +231,40 @@ class SpectrumChannel : public Channel
      */
     virtual int64_t DoAssignStreams(int64_t stream);
 
+    /**
+     * Get the receivers which may be within MaxRange of a transmitter. If MaxRange is
+     * not set or if a WraparoundModel is aggregated to the channel, all the receivers
+     * are returned.
+     *
+     * @param rxPhys the receivers
+     * @param grid the spatial grid of the receivers, (re)built when it does not hold all of them
+     * @param txMobility the mobility model of the transmitter, if any
+     * @return the indices of the candidate receivers in rxPhys, in increasing order
+     */
+    std::vector<std::size_t> GetRxPhyIndices(const std::vector<Ptr<SpectrumPhy>>& rxPhys,
+                                             SpatialGridIndex& grid,
+                                             Ptr<const MobilityModel> txMobility) const;
+
+    /**
+     * @param txMobility the mobility model of the transmitter
+     * @param rxMobility the mobility model of the receiver
+     * @return whether the receiver is within MaxRange of the transmitter (always true
+     *         if MaxRange is not set)
+     */
+    bool IsInRange(Ptr<const MobilityModel> txMobility, Ptr<const MobilityModel> rxMobility) const;
+
+    /**
+     * Get the gain of the single-frequency propagation loss model between a transmitter and a
+     * receiver. If CachePropagationLoss is enabled, the gain between a still transmitter and a
+     * still receiver is computed once and then reused until either of them notifies a course
+     * change.
+     *
+     * @param txMobility the mobility model of the transmitter
+     * @param rxMobility the mobility model of the receiver
+     * @return the propagation gain in dB
+     */
+    double GetPropagationGainDb(Ptr<MobilityModel> txMobility, Ptr<MobilityModel> rxMobility);
+
     /**
      * The `PathLoss` trace source. Exporting the pointers to the Tx and Rx
      * SpectrumPhy and a pathloss value, in dB.
@@ -258,6 +296,13 @@ class SpectrumChannel : public Channel
      */
     double m_maxLossDb;
 
+    /**
+     * Maximum distance [m] between a transmitter and its receivers, 0 if none.
+     *
+     * Any device farther than this distance is considered out of range.
+     */
+    double m_maxRange;
+
     /**
      * Single-frequency propagation loss model to be used with this channel.
      */
@@ -282,6 +327,37 @@ class SpectrumChannel : public Channel
      * Transmit filter to be used with this channel
      */
     Ptr<SpectrumTransmitFilter> m_filter{nullptr};
+
+  private:
+    /**
+     * Callback for the CourseChange trace of the mobility models involved in the cached
+     * propagation gains: remove the gains involving the given mobility model.
+     *
+     * @param mobility the mobility model
+     */
+    void CourseChanged(Ptr<const MobilityModel> mobility);
+
+    /**
+     * Remove all the cached propagation gains and disconnect from the mobility models.
+     */
+    void ClearPropagationGains();
+
+    /**
+     * Set the single-frequency propagation loss model through the PropagationLossModel
+     * attribute: unlike AddPropagationLossModel, the given model replaces the current one.
+     * The cached propagation gains are removed.
+     *
+     * @param loss a pointer to the propagation loss model to be used
+     */
+    void SetPropagationLossModel(Ptr<PropagationLossModel> loss);
+
+    bool m_cachePropagationLoss; //!< whether the propagation gains between still nodes are cached
+
+    /// cached propagation gains (dB), indexed by the mobility models of transmitter and receiver
+    std::map<Ptr<const MobilityModel>, std::map<Ptr<const MobilityModel>, double>>
+        m_propagationGains;
+    /// the mobility models whose CourseChange trace is connected to by the cache
+    std::set<Ptr<MobilityModel>> m_propagationGainMobilities;
 };
 
 } // namespace ns3
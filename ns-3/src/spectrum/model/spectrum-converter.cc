@@ -69,16 +69,18 @@ SpectrumConverter::Convert(Ptr<const SpectrumValue> fvvf) const
 
     Ptr<SpectrumValue> tvvf = Create<SpectrumValue>(m_toSpectrumModel);
 
+    // the indices stored in the conversion matrix are valid by construction, hence the values
+    // are accessed without bounds checking
+    const auto fromValues = fvvf->ConstValuesBegin();
     auto tvit = tvvf->ValuesBegin();
     size_t i = 0; // Index of conversion coefficient
 
-    for (auto convIt = m_conversionRowPtr.begin(); convIt != m_conversionRowPtr.end(); ++convIt)
+    for (const auto rowEnd : m_conversionRowPtr)
     {
         double sum = 0;
-        while (i < *convIt)
+        for (; i < rowEnd; ++i)
         {
-            sum += (*fvvf)[m_conversionColInd.at(i)] * m_conversionMatrix.at(i);
-            i++;
+            sum += fromValues[m_conversionColInd[i]] * m_conversionMatrix[i];
         }
         *tvit = sum;
         ++tvit;
@@ -21,11 +21,14 @@
 #include "ns3/shuffle.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <map>
 #include <random>
+#include <thread>
 
 namespace ns3
 {
@@ -1157,6 +1160,15 @@ ThreeGppChannelModel::GetTypeId()
                           DoubleValue(0.0),
                           MakeDoubleAccessor(&ThreeGppChannelModel::m_vScatt),
                           MakeDoubleChecker<double>(0.0))
+            .AddAttribute("NumThreads",
+                          "The number of threads computing the coefficients of a new channel "
+                          "matrix, each of which handles a subset of the receive antenna "
+                          "elements. Zero means as many threads as the hardware supports. The "
+                          "channel matrix does not depend on the number of threads, since the "
+                          "random parameters are generated beforehand.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::m_numThreads),
+                          MakeUintegerChecker<uint32_t>())
 
         ;
     return tid;
@@ -3407,45 +3419,91 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
         }
     }
 
-    // The following for loops computes the channel coefficients
-    // Keeps track of how many sub-clusters have been added up to now
-    uint8_t numSubClustersAdded = 0;
-    for (uint8_t nIndex = 0; nIndex < channelParams->m_reducedClusterNumber; nIndex++)
+    // The phase terms of the rays only depend on either the receive or the transmit element,
+    // hence they are computed once per element and ray rather than once per pair of elements
+    // and ray. The element locations and polarizations are also retrieved once per element
+    const auto numClusters = channelParams->m_reducedClusterNumber;
+    const auto numRays = table3gpp->m_raysPerCluster;
+    std::vector<uint8_t> uPols(uSize);
+    std::vector<uint8_t> sPols(sSize);
+    Complex3DVector rxPhases(numRays, uSize, numClusters); // rx phase term (m, u, n)
+    Complex3DVector txPhases(numRays, sSize, numClusters); // tx phase term (m, s, n)
+    for (size_t uIndex = 0; uIndex < uSize; uIndex++)
+    {
+        uPols[uIndex] = uAntenna->GetElemPol(uIndex);
+        Vector uLoc = uAntenna->GetElementLocation(uIndex);
+        for (uint8_t nIndex = 0; nIndex < numClusters; nIndex++)
+        {
+            for (uint8_t mIndex = 0; mIndex < numRays; mIndex++)
+            {
+                // lambda_0 is accounted in the antenna spacing uLoc and sLoc.
+                double rxPhaseDiff =
+                    2 * M_PI *
+                    (sinCosA[nIndex][mIndex] * uLoc.x + sinSinA[nIndex][mIndex] * uLoc.y +
+                     cosZoA[nIndex][mIndex] * uLoc.z);
+                rxPhases(mIndex, uIndex, nIndex) =
+                    std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff));
+            }
+        }
+    }
+    for (size_t sIndex = 0; sIndex < sSize; sIndex++)
     {
-        for (size_t uIndex = 0; uIndex < uSize; uIndex++)
+        sPols[sIndex] = sAntenna->GetElemPol(sIndex);
+        Vector sLoc = sAntenna->GetElementLocation(sIndex);
+        for (uint8_t nIndex = 0; nIndex < numClusters; nIndex++)
         {
-            Vector uLoc = uAntenna->GetElementLocation(uIndex);
+            for (uint8_t mIndex = 0; mIndex < numRays; mIndex++)
+            {
+                double txPhaseDiff =
+                    2 * M_PI *
+                    (sinCosD[nIndex][mIndex] * sLoc.x + sinSinD[nIndex][mIndex] * sLoc.y +
+                     cosZoD[nIndex][mIndex] * sLoc.z);
+                txPhases(mIndex, sIndex, nIndex) =
+                    std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+            }
+        }
+    }
+
+    // The sub-clusters of the 2 strongest clusters are stored after the other clusters:
+    // keep track of the index of the first sub-cluster (after the first one) of each of them
+    std::vector<uint16_t> subClusterIndex(numClusters, 0);
+    uint16_t numSubClustersAdded = 0;
+    for (uint8_t nIndex = 0; nIndex < numClusters; nIndex++)
+    {
+        if (nIndex == channelParams->m_cluster1st || nIndex == channelParams->m_cluster2nd)
+        {
+            subClusterIndex[nIndex] = numClusters + numSubClustersAdded;
+            numSubClustersAdded += 2;
+        }
+    }
+
+    // Compute the channel coefficients for the given receive element. The coefficients of
+    // different receive elements are independent of each other, hence they can be computed by
+    // different threads. This function must not access anything but the local variables
+    // computed above and the channel parameters.
+    auto computeCoefficients = [&](size_t uIndex) {
+        for (uint8_t nIndex = 0; nIndex < numClusters; nIndex++)
+        {
+            const double clusterAmplitude =
+                sqrt(channelParams->m_clusterPower[nIndex] / numRays);
 
             for (size_t sIndex = 0; sIndex < sSize; sIndex++)
             {
-                Vector sLoc = sAntenna->GetElementLocation(sIndex);
+                const auto& rayTerms = raysPreComp.at(std::make_pair(sPols[sIndex], uPols[uIndex]));
+
                 // Compute the N-2 weakest cluster, assuming 0 slant angle and a
                 // polarization slant angle configured in the array (7.5-22)
                 if (nIndex != channelParams->m_cluster1st && nIndex != channelParams->m_cluster2nd)
                 {
                     std::complex<double> rays(0, 0);
-                    for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
+                    for (uint8_t mIndex = 0; mIndex < numRays; mIndex++)
                     {
-                        // lambda_0 is accounted in the antenna spacing uLoc and sLoc.
-                        double rxPhaseDiff =
-                            2 * M_PI *
-                            (sinCosA[nIndex][mIndex] * uLoc.x + sinSinA[nIndex][mIndex] * uLoc.y +
-                             cosZoA[nIndex][mIndex] * uLoc.z);
-
-                        double txPhaseDiff =
-                            2 * M_PI *
-                            (sinCosD[nIndex][mIndex] * sLoc.x + sinSinD[nIndex][mIndex] * sLoc.y +
-                             cosZoD[nIndex][mIndex] * sLoc.z);
                         // NOTE Doppler is computed in the CalcBeamformingGain function and is
                         // simplified to only account for the center angle of each cluster.
-                        rays += raysPreComp[std::make_pair(sAntenna->GetElemPol(sIndex),
-                                                           uAntenna->GetElemPol(uIndex))](nIndex,
-                                                                                          mIndex) *
-                                std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
-                                std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+                        rays += rayTerms(nIndex, mIndex) * rxPhases(mIndex, uIndex, nIndex) *
+                                txPhases(mIndex, sIndex, nIndex);
                     }
-                    rays *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
+                    rays *= clusterAmplitude;
                     hUsn(uIndex, sIndex, nIndex) = rays;
                 }
                 else //(7.5-28)
@@ -3454,26 +3512,13 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
                     std::complex<double> raysSub2(0, 0);
                     std::complex<double> raysSub3(0, 0);
 
-                    for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
+                    for (uint8_t mIndex = 0; mIndex < numRays; mIndex++)
                     {
                         // ZML:Just remind me that the angle offsets for the 3 subclusters were not
                         // generated correctly.
-                        double rxPhaseDiff =
-                            2 * M_PI *
-                            (sinCosA[nIndex][mIndex] * uLoc.x + sinSinA[nIndex][mIndex] * uLoc.y +
-                             cosZoA[nIndex][mIndex] * uLoc.z);
-
-                        double txPhaseDiff =
-                            2 * M_PI *
-                            (sinCosD[nIndex][mIndex] * sLoc.x + sinSinD[nIndex][mIndex] * sLoc.y +
-                             cosZoD[nIndex][mIndex] * sLoc.z);
-
-                        std::complex<double> raySub =
-                            raysPreComp[std::make_pair(sAntenna->GetElemPol(sIndex),
-                                                       uAntenna->GetElemPol(uIndex))](nIndex,
-                                                                                      mIndex) *
-                            std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
-                            std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+                        std::complex<double> raySub = rayTerms(nIndex, mIndex) *
+                                                      rxPhases(mIndex, uIndex, nIndex) *
+                                                      txPhases(mIndex, sIndex, nIndex);
 
                         switch (mIndex)
                         {
@@ -3496,26 +3541,51 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
                             break;
                         }
                     }
-                    raysSub1 *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                    raysSub2 *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                    raysSub3 *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
+                    raysSub1 *= clusterAmplitude;
+                    raysSub2 *= clusterAmplitude;
+                    raysSub3 *= clusterAmplitude;
                     hUsn(uIndex, sIndex, nIndex) = raysSub1;
-                    hUsn(uIndex,
-                         sIndex,
-                         channelParams->m_reducedClusterNumber + numSubClustersAdded) = raysSub2;
-                    hUsn(uIndex,
-                         sIndex,
-                         channelParams->m_reducedClusterNumber + numSubClustersAdded + 1) =
-                        raysSub3;
+                    hUsn(uIndex, sIndex, subClusterIndex[nIndex]) = raysSub2;
+                    hUsn(uIndex, sIndex, subClusterIndex[nIndex] + 1) = raysSub3;
                 }
             }
         }
-        if (nIndex == channelParams->m_cluster1st || nIndex == channelParams->m_cluster2nd)
+    };
+
+    // The following loops compute the channel coefficients, possibly on multiple threads
+    std::size_t nThreads = m_numThreads;
+    if (nThreads == 0)
+    {
+        nThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    nThreads = std::min(nThreads, uSize);
+
+    if (nThreads <= 1)
+    {
+        for (size_t uIndex = 0; uIndex < uSize; uIndex++)
         {
-            numSubClustersAdded += 2;
+            computeCoefficients(uIndex);
+        }
+    }
+    else
+    {
+        NS_LOG_LOGIC("Computing the channel coefficients on " << nThreads << " threads");
+        std::atomic<std::size_t> next{0};
+        auto work = [&computeCoefficients, &next, uSize]() {
+            for (auto uIndex = next++; uIndex < uSize; uIndex = next++)
+            {
+                computeCoefficients(uIndex);
+            }
+        };
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < nThreads; i++)
+        {
+            threads.emplace_back(work);
+        }
+        work();
+        for (auto& thread : threads)
+        {
+            thread.join();
         }
     }
 
@@ -0,0 +1,347 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/net-device.h"
+#include "ns3/object-factory.h"
+#include "ns3/pointer.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/simulator.h"
+#include "ns3/single-model-spectrum-channel.h"
+#include "ns3/spectrum-phy.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief SpectrumPhy counting the signals it receives
+ */
+class MaxRangeTestPhy : public SpectrumPhy
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param model the spectrum model of the PHY
+     * @param position the position of the PHY
+     */
+    MaxRangeTestPhy(Ptr<const SpectrumModel> model, const Vector& position)
+        : m_model(model),
+          m_mobility(CreateObject<ConstantPositionMobilityModel>())
+    {
+        m_mobility->SetPosition(position);
+    }
+
+    void SetDevice(Ptr<NetDevice> d) override
+    {
+    }
+
+    Ptr<NetDevice> GetDevice() const override
+    {
+        return nullptr;
+    }
+
+    void SetMobility(Ptr<MobilityModel> m) override
+    {
+        m_mobility = m;
+    }
+
+    Ptr<MobilityModel> GetMobility() const override
+    {
+        return m_mobility;
+    }
+
+    void SetChannel(Ptr<SpectrumChannel> c) override
+    {
+    }
+
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override
+    {
+        return m_model;
+    }
+
+    Ptr<Object> GetAntenna() const override
+    {
+        return nullptr;
+    }
+
+    void StartRx(Ptr<SpectrumSignalParameters> params) override
+    {
+        ++m_nRx;
+    }
+
+    uint32_t m_nRx{0}; //!< number of received signals
+
+  private:
+    Ptr<const SpectrumModel> m_model; //!< the spectrum model
+    Ptr<MobilityModel> m_mobility;    //!< the mobility model
+};
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Check that the receivers beyond the MaxRange attribute of a spectrum channel are culled
+ */
+class SpectrumChannelMaxRangeTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param channelType the TypeId name of the spectrum channel
+     */
+    SpectrumChannelMaxRangeTestCase(std::string channelType)
+        : TestCase("MaxRange of " + channelType),
+          m_channelType(channelType)
+    {
+    }
+
+  protected:
+    /**
+     * Constructor
+     *
+     * @param name the name of the test case
+     * @param channelType the TypeId name of the spectrum channel
+     */
+    SpectrumChannelMaxRangeTestCase(std::string name, std::string channelType)
+        : TestCase(name),
+          m_channelType(channelType)
+    {
+    }
+
+    /**
+     * Transmit a signal from a PHY and return the number of signals received by every PHY.
+     *
+     * @param channel the spectrum channel
+     * @param phys the PHYs, the first one transmits
+     * @return the number of signals received by every PHY
+     */
+    std::vector<uint32_t> Transmit(Ptr<SpectrumChannel> channel,
+                                   const std::vector<Ptr<MaxRangeTestPhy>>& phys);
+
+    std::string m_channelType; //!< the TypeId name of the spectrum channel
+
+  private:
+    void DoRun() override;
+};
+
+std::vector<uint32_t>
+SpectrumChannelMaxRangeTestCase::Transmit(Ptr<SpectrumChannel> channel,
+                                          const std::vector<Ptr<MaxRangeTestPhy>>& phys)
+{
+    auto params = Create<SpectrumSignalParameters>();
+    params->duration = MicroSeconds(10);
+    params->txPhy = phys.front();
+    params->psd = Create<SpectrumValue>(phys.front()->GetRxSpectrumModel());
+    *params->psd = 1e-9;
+
+    for (const auto& phy : phys)
+    {
+        phy->m_nRx = 0;
+    }
+    channel->StartTx(params);
+    Simulator::Run();
+
+    std::vector<uint32_t> nRx;
+    for (const auto& phy : phys)
+    {
+        nRx.push_back(phy->m_nRx);
+    }
+    return nRx;
+}
+
+void
+SpectrumChannelMaxRangeTestCase::DoRun()
+{
+    ObjectFactory factory(m_channelType);
+    auto channel = factory.Create<SpectrumChannel>();
+    auto model = Create<SpectrumModel>(std::vector<double>{2.4e9, 2.41e9});
+
+    std::vector<Ptr<MaxRangeTestPhy>> phys;
+    for (double x : {0, 100, 1000, 5000, 300})
+    {
+        phys.push_back(CreateObject<MaxRangeTestPhy>(model, Vector(x, 0, 0)));
+        channel->AddRx(phys.back());
+    }
+
+    using Received = std::vector<uint32_t>;
+    NS_TEST_EXPECT_MSG_EQ((Transmit(channel, phys) == Received{0, 1, 1, 1, 1}),
+                          true,
+                          "All the receivers should receive the signal without MaxRange");
+
+    channel->SetAttribute("MaxRange", DoubleValue(500));
+    NS_TEST_EXPECT_MSG_EQ((Transmit(channel, phys) == Received{0, 1, 0, 0, 1}),
+                          true,
+                          "Only the receivers within MaxRange should receive the signal");
+
+    // the grid follows the receivers which move
+    phys[2]->GetMobility()->SetPosition(Vector(-400, 0, 0));
+    phys[1]->GetMobility()->SetPosition(Vector(0, 600, 0));
+    NS_TEST_EXPECT_MSG_EQ((Transmit(channel, phys) == Received{0, 0, 1, 0, 1}),
+                          true,
+                          "The receivers which moved are not culled properly");
+
+    // the grid follows the receivers which are removed
+    channel->RemoveRx(phys[2]);
+    NS_TEST_EXPECT_MSG_EQ((Transmit(channel, phys) == Received{0, 0, 0, 0, 1}),
+                          true,
+                          "The removed receiver should not receive the signal");
+
+    channel->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Propagation loss model counting the number of times the gain is computed
+ */
+class CountingPropagationLossModel : public PropagationLossModel
+{
+  public:
+    uint32_t m_nCalls{0}; //!< number of times the gain was computed
+
+  private:
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override
+    {
+        ++const_cast<CountingPropagationLossModel*>(this)->m_nCalls;
+        return txPowerDbm - 0.1 * a->GetDistanceFrom(b);
+    }
+
+    int64_t DoAssignStreams(int64_t stream) override
+    {
+        return 0;
+    }
+};
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Check that the propagation gains between still nodes are cached by a spectrum channel
+ * until the nodes change course
+ */
+class SpectrumChannelLossCacheTestCase : public SpectrumChannelMaxRangeTestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param channelType the TypeId name of the spectrum channel
+     */
+    SpectrumChannelLossCacheTestCase(std::string channelType)
+        : SpectrumChannelMaxRangeTestCase("Propagation loss cache of " + channelType, channelType)
+    {
+    }
+
+  private:
+    void DoRun() override;
+};
+
+void
+SpectrumChannelLossCacheTestCase::DoRun()
+{
+    ObjectFactory factory(m_channelType);
+    factory.Set("CachePropagationLoss", BooleanValue(true));
+    auto channel = factory.Create<SpectrumChannel>();
+    auto lossModel = CreateObject<CountingPropagationLossModel>();
+    channel->AddPropagationLossModel(lossModel);
+    auto model = Create<SpectrumModel>(std::vector<double>{2.4e9, 2.41e9});
+
+    std::vector<Ptr<MaxRangeTestPhy>> phys;
+    for (double x : {0, 100, 200})
+    {
+        phys.push_back(CreateObject<MaxRangeTestPhy>(model, Vector(x, 0, 0)));
+        channel->AddRx(phys.back());
+    }
+
+    Transmit(channel, phys);
+    NS_TEST_EXPECT_MSG_EQ(lossModel->m_nCalls, 2, "The gain to every receiver must be computed");
+
+    Transmit(channel, phys);
+    NS_TEST_EXPECT_MSG_EQ(lossModel->m_nCalls, 2, "The gains between still nodes are cached");
+
+    // a course change invalidates the gains involving the node
+    phys[1]->GetMobility()->SetPosition(Vector(0, 150, 0));
+    Transmit(channel, phys);
+    NS_TEST_EXPECT_MSG_EQ(lossModel->m_nCalls, 3, "Only the gain to the moved node is computed");
+
+    // the gains to a moving node are never cached
+    auto mobility = CreateObject<ConstantVelocityMobilityModel>();
+    mobility->SetPosition(Vector(200, 0, 0));
+    mobility->SetVelocity(Vector(1, 0, 0));
+    phys[2]->SetMobility(mobility);
+    Transmit(channel, phys);
+    Transmit(channel, phys);
+    NS_TEST_EXPECT_MSG_EQ(lossModel->m_nCalls, 5, "The gain to a moving node is not cached");
+
+    // replacing the propagation loss model through the attribute invalidates all the gains
+    auto newLossModel = CreateObject<CountingPropagationLossModel>();
+    channel->SetAttribute("PropagationLossModel", PointerValue(newLossModel));
+    Transmit(channel, phys);
+    NS_TEST_EXPECT_MSG_EQ(lossModel->m_nCalls, 5, "The replaced model must no longer be used");
+    NS_TEST_EXPECT_MSG_EQ(newLossModel->m_nCalls,
+                          2,
+                          "The gains cached before replacing the model must not be used");
+
+    channel->SetAttribute("CachePropagationLoss", BooleanValue(false));
+    Transmit(channel, phys);
+    NS_TEST_EXPECT_MSG_EQ(newLossModel->m_nCalls, 4, "No gain is cached when caching is disabled");
+
+    channel->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Spectrum channel MaxRange test suite
+ */
+class SpectrumChannelMaxRangeTestSuite : public TestSuite
+{
+  public:
+    SpectrumChannelMaxRangeTestSuite();
+};
+
+SpectrumChannelMaxRangeTestSuite::SpectrumChannelMaxRangeTestSuite()
+    : TestSuite("spectrum-channel-max-range", Type::UNIT)
+{
+    AddTestCase(new SpectrumChannelMaxRangeTestCase("ns3::SingleModelSpectrumChannel"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumChannelMaxRangeTestCase("ns3::MultiModelSpectrumChannel"),
+                TestCase::Duration::QUICK);
+}
+
+static SpectrumChannelMaxRangeTestSuite g_spectrumChannelMaxRangeTestSuite; //!< the test suite
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Spectrum channel propagation loss cache test suite
+ */
+class SpectrumChannelLossCacheTestSuite : public TestSuite
+{
+  public:
+    SpectrumChannelLossCacheTestSuite();
+};
+
+SpectrumChannelLossCacheTestSuite::SpectrumChannelLossCacheTestSuite()
+    : TestSuite("spectrum-channel-loss-cache", Type::UNIT)
+{
+    AddTestCase(new SpectrumChannelLossCacheTestCase("ns3::SingleModelSpectrumChannel"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumChannelLossCacheTestCase("ns3::MultiModelSpectrumChannel"),
+                TestCase::Duration::QUICK);
+}
+
+static SpectrumChannelLossCacheTestSuite
+    g_spectrumChannelLossCacheTestSuite; //!< the test suite
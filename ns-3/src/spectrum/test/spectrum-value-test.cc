@@ -214,6 +214,20 @@ SpectrumValueTestSuite::SpectrumValueTestSuite()
     AddTestCase(new SpectrumValueTestCase(tv5, v5, "tv5 *= v2"), TestCase::Duration::QUICK);
     AddTestCase(new SpectrumValueTestCase(tv6, v6, "tv6 div= v2"), TestCase::Duration::QUICK);
 
+    // the operators applied to temporaries reuse the values of the temporaries
+    tv3 = SpectrumValue(v1) + v2;
+    tv4 = -(v2 - v1);
+    tv5 = SpectrumValue(v1) * v2;
+    tv6 = SpectrumValue(v1) / v2;
+
+    AddTestCase(new SpectrumValueTestCase(tv3, v3, "tv3 = temp(v1) + v2"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(tv4, v4, "tv4 = -(v2 - v1)"), TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(tv5, v5, "tv5 = temp(v1) * v2"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(tv6, v6, "tv6 = temp(v1) div v2"),
+                TestCase::Duration::QUICK);
+
     SpectrumValue tv7a(f);
     SpectrumValue tv8a(f);
     SpectrumValue tv9a(f);
@@ -248,6 +262,19 @@ SpectrumValueTestSuite::SpectrumValueTestSuite()
     AddTestCase(new SpectrumValueTestCase(tv10b, v10, "tv10b = doubleValue div v1"),
                 TestCase::Duration::QUICK);
 
+    tv7b = doubleValue + SpectrumValue(v1);
+    tv8b = SpectrumValue(v1) - doubleValue;
+    tv9b = doubleValue * SpectrumValue(v1);
+    tv10b = SpectrumValue(v1) / doubleValue;
+    AddTestCase(new SpectrumValueTestCase(tv7b, v7, "tv7b =  doubleValue + temp(v1)"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(tv8b, v8, "tv8b =  temp(v1) - doubleValue"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(tv9b, v9, "tv9b =  doubleValue * temp(v1)"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(tv10b, v10, "tv10b = temp(v1) div doubleValue"),
+                TestCase::Duration::QUICK);
+
     SpectrumValue v1ls3(f);
     SpectrumValue v1rs3(f);
     SpectrumValue tv1ls3(f);
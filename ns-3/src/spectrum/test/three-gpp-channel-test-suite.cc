@@ -6,6 +6,7 @@
 
 #include "ns3/abort.h"
 #include "ns3/angles.h"
+#include "ns3/boolean.h"
 #include "ns3/channel-condition-model.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
@@ -1450,6 +1451,112 @@ ThreeGppMimoPolarizationTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup spectrum-tests
+ *
+ * Test case checking that the channel matrix generated by the ThreeGppChannelModel does not
+ * depend on the number of threads used to compute its coefficients.
+ */
+class ThreeGppChannelMatrixThreadsTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param numThreads the number of threads of the channel model under test
+     */
+    ThreeGppChannelMatrixThreadsTest(uint32_t numThreads);
+
+  private:
+    /**
+     * Build the test scenario
+     */
+    void DoRun() override;
+
+    /**
+     * Generate a channel matrix between two nodes with a new channel model
+     * @param numThreads the number of threads computing the coefficients
+     * @return the channel matrix
+     */
+    Ptr<const ThreeGppChannelModel::ChannelMatrix> GetChannel(uint32_t numThreads);
+
+    uint32_t m_numThreads; //!< the number of threads of the channel model under test
+};
+
+ThreeGppChannelMatrixThreadsTest::ThreeGppChannelMatrixThreadsTest(uint32_t numThreads)
+    : TestCase("Check that the channel matrix does not depend on the number of threads, "
+               "NumThreads=" +
+               std::to_string(numThreads)),
+      m_numThreads(numThreads)
+{
+}
+
+Ptr<const ThreeGppChannelModel::ChannelMatrix>
+ThreeGppChannelMatrixThreadsTest::GetChannel(uint32_t numThreads)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    Ptr<ThreeGppChannelModel> channelModel = CreateObject<ThreeGppChannelModel>();
+    channelModel->SetAttribute("Frequency", DoubleValue(28.0e9));
+    channelModel->SetAttribute("Scenario", StringValue("UMi-StreetCanyon"));
+    channelModel->SetAttribute("ChannelConditionModel",
+                               PointerValue(CreateObject<NeverLosChannelConditionModel>()));
+    channelModel->SetAttribute("NumThreads", UintegerValue(numThreads));
+    channelModel->AssignStreams(1);
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    Ptr<MobilityModel> txMob = CreateObject<ConstantPositionMobilityModel>();
+    txMob->SetPosition(Vector(0.0, 0.0, 10.0));
+    Ptr<MobilityModel> rxMob = CreateObject<ConstantPositionMobilityModel>();
+    rxMob->SetPosition(Vector(80.0, 20.0, 1.5));
+    nodes.Get(0)->AggregateObject(txMob);
+    nodes.Get(1)->AggregateObject(rxMob);
+
+    // use dual-polarized arrays, so that all the precomputed ray terms are used
+    Ptr<PhasedArrayModel> txAntenna = CreateObjectWithAttributes<UniformPlanarArray>(
+        "NumColumns",
+        UintegerValue(4),
+        "NumRows",
+        UintegerValue(2),
+        "AntennaElement",
+        PointerValue(CreateObject<ThreeGppAntennaModel>()),
+        "IsDualPolarized",
+        BooleanValue(true));
+    Ptr<PhasedArrayModel> rxAntenna = CreateObjectWithAttributes<UniformPlanarArray>(
+        "NumColumns",
+        UintegerValue(3),
+        "NumRows",
+        UintegerValue(3),
+        "AntennaElement",
+        PointerValue(CreateObject<IsotropicAntennaModel>()));
+
+    return channelModel->GetChannel(txMob, rxMob, txAntenna, rxAntenna);
+}
+
+void
+ThreeGppChannelMatrixThreadsTest::DoRun()
+{
+    auto reference = GetChannel(1);
+    auto channel = GetChannel(m_numThreads);
+
+    NS_TEST_ASSERT_MSG_EQ(channel->m_channel.GetNumRows(),
+                          reference->m_channel.GetNumRows(),
+                          "Unexpected number of rows of the channel matrix");
+    NS_TEST_ASSERT_MSG_EQ(channel->m_channel.GetNumCols(),
+                          reference->m_channel.GetNumCols(),
+                          "Unexpected number of columns of the channel matrix");
+    NS_TEST_ASSERT_MSG_EQ(channel->m_channel.GetNumPages(),
+                          reference->m_channel.GetNumPages(),
+                          "Unexpected number of clusters of the channel matrix");
+    NS_TEST_ASSERT_MSG_EQ((channel->m_channel == reference->m_channel),
+                          true,
+                          "The channel matrix depends on the number of threads");
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup spectrum-tests
  *
@@ -1477,6 +1584,8 @@ ThreeGppChannelTestSuite::ThreeGppChannelTestSuite()
     AddTestCase(new ThreeGppChannelMatrixUpdateTest(2, 4, 2, 2), TestCase::Duration::QUICK);
     AddTestCase(new ThreeGppChannelMatrixUpdateTest(2, 2, 2, 2), TestCase::Duration::QUICK);
     AddTestCase(new ThreeGppAntennaSetupChangedTest(), TestCase::Duration::QUICK);
+    AddTestCase(new ThreeGppChannelMatrixThreadsTest(4), TestCase::Duration::QUICK);
+    AddTestCase(new ThreeGppChannelMatrixThreadsTest(0), TestCase::Duration::QUICK);
     AddTestCase(new ThreeGppSpectrumPropagationLossModelTest(4, 4, 1, 1),
                 TestCase::Duration::QUICK);
     AddTestCase(new ThreeGppSpectrumPropagationLossModelTest(4, 4, 2, 2),
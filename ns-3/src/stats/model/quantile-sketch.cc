@@ -0,0 +1,195 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "quantile-sketch.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+/// Samples smaller than this value are counted as zero
+static constexpr double QUANTILE_SKETCH_MIN_VALUE = 1e-12;
+
+QuantileSketch::QuantileSketch(double relativeAccuracy)
+    : m_alpha(relativeAccuracy),
+      m_offset(0),
+      m_zeroCount(0),
+      m_count(0),
+      m_sum(0),
+      m_min(std::numeric_limits<double>::infinity()),
+      m_max(0)
+{
+    NS_ABORT_MSG_IF(relativeAccuracy <= 0 || relativeAccuracy >= 1,
+                    "The relative accuracy must be in (0, 1)");
+    m_gamma = (1 + m_alpha) / (1 - m_alpha);
+    m_logGamma = std::log(m_gamma);
+}
+
+int32_t
+QuantileSketch::Index(double value) const
+{
+    return static_cast<int32_t>(std::ceil(std::log(value) / m_logGamma));
+}
+
+double
+QuantileSketch::Value(int32_t index) const
+{
+    // bucket i covers (gamma^(i-1), gamma^i]; this value is at a relative
+    // distance of at most alpha from any value of the bucket
+    return 2 * std::pow(m_gamma, index) / (m_gamma + 1);
+}
+
+void
+QuantileSketch::Extend(int32_t index)
+{
+    if (m_buckets.empty())
+    {
+        m_buckets.assign(1, 0);
+        m_offset = index;
+        return;
+    }
+    if (index < m_offset)
+    {
+        m_buckets.insert(m_buckets.begin(), m_offset - index, 0);
+        m_offset = index;
+    }
+    else if (index >= m_offset + static_cast<int32_t>(m_buckets.size()))
+    {
+        m_buckets.resize(index - m_offset + 1, 0);
+    }
+}
+
+void
+QuantileSketch::Add(double value)
+{
+    NS_ASSERT_MSG(value >= 0, "Samples must be non-negative");
+    if (value < QUANTILE_SKETCH_MIN_VALUE)
+    {
+        m_zeroCount++;
+    }
+    else
+    {
+        auto index = Index(value);
+        Extend(index);
+        m_buckets[index - m_offset]++;
+    }
+    m_count++;
+    m_sum += value;
+    m_min = std::min(m_min, value);
+    m_max = std::max(m_max, value);
+}
+
+void
+QuantileSketch::Merge(const QuantileSketch& other)
+{
+    NS_ABORT_MSG_IF(m_alpha != other.m_alpha,
+                    "Cannot merge sketches with different relative accuracy");
+    if (other.m_count == 0)
+    {
+        return;
+    }
+    if (!other.m_buckets.empty())
+    {
+        Extend(other.m_offset);
+        Extend(other.m_offset + static_cast<int32_t>(other.m_buckets.size()) - 1);
+        for (std::size_t i = 0; i < other.m_buckets.size(); i++)
+        {
+            m_buckets[other.m_offset + i - m_offset] += other.m_buckets[i];
+        }
+    }
+    m_zeroCount += other.m_zeroCount;
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+}
+
+void
+QuantileSketch::Clear()
+{
+    m_buckets.clear();
+    m_offset = 0;
+    m_zeroCount = 0;
+    m_count = 0;
+    m_sum = 0;
+    m_min = std::numeric_limits<double>::infinity();
+    m_max = 0;
+}
+
+double
+QuantileSketch::GetQuantile(double q) const
+{
+    NS_ABORT_MSG_IF(q < 0 || q > 1, "The quantile must be in [0, 1]");
+    if (m_count == 0)
+    {
+        return 0;
+    }
+
+    // zero-based rank of the requested sample
+    auto rank = static_cast<uint64_t>(q * (m_count - 1));
+    if (rank < m_zeroCount)
+    {
+        return 0;
+    }
+    uint64_t cumulative = m_zeroCount;
+    for (std::size_t i = 0; i < m_buckets.size(); i++)
+    {
+        cumulative += m_buckets[i];
+        if (cumulative > rank)
+        {
+            return std::clamp(Value(m_offset + static_cast<int32_t>(i)), m_min, m_max);
+        }
+    }
+    return m_max;
+}
+
+uint64_t
+QuantileSketch::GetCount() const
+{
+    return m_count;
+}
+
+double
+QuantileSketch::GetSum() const
+{
+    return m_sum;
+}
+
+double
+QuantileSketch::GetMean() const
+{
+    return m_count > 0 ? m_sum / m_count : 0;
+}
+
+double
+QuantileSketch::GetMin() const
+{
+    return m_count > 0 ? m_min : 0;
+}
+
+double
+QuantileSketch::GetMax() const
+{
+    return m_max;
+}
+
+double
+QuantileSketch::GetRelativeAccuracy() const
+{
+    return m_alpha;
+}
+
+std::size_t
+QuantileSketch::GetNBuckets() const
+{
+    return m_buckets.size();
+}
+
+} // namespace ns3
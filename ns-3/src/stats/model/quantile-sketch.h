@@ -0,0 +1,114 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef QUANTILE_SKETCH_H
+#define QUANTILE_SKETCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup stats
+ * @brief Streaming estimator of the quantiles of a set of non-negative samples
+ *
+ * The samples are counted in buckets whose boundaries grow geometrically by a
+ * factor gamma = (1 + alpha) / (1 - alpha), where alpha is the relative
+ * accuracy (Masson, Rim and Lee, "DDSketch: a fast and fully-mergeable quantile
+ * sketch with relative-error guarantees", VLDB 2019). Any quantile is
+ * then estimated with a relative error of at most alpha, regardless of the
+ * number of samples and of their distribution, while the memory used only
+ * grows with the logarithm of the ratio between the largest and the smallest
+ * sample. Sketches with the same relative accuracy can be merged.
+ *
+ * Samples smaller than the minimum indexable value (1e-12) are counted as zero.
+ */
+class QuantileSketch
+{
+  public:
+    /**
+     * Constructor
+     * @param relativeAccuracy the relative accuracy of the quantile estimates, in (0, 1)
+     */
+    QuantileSketch(double relativeAccuracy = 0.01);
+
+    /**
+     * Add a sample.
+     * @param value the sample (must be non-negative)
+     */
+    void Add(double value);
+
+    /**
+     * Add the samples counted by another sketch.
+     * @param other the other sketch (must have the same relative accuracy)
+     */
+    void Merge(const QuantileSketch& other);
+
+    /// Remove all the samples
+    void Clear();
+
+    /**
+     * @param q the quantile, in [0, 1] (e.g., 0.99 for the 99th percentile)
+     * @return the estimate of the given quantile, or zero if there is no sample
+     */
+    double GetQuantile(double q) const;
+
+    /// @return the number of samples
+    uint64_t GetCount() const;
+
+    /// @return the sum of the samples
+    double GetSum() const;
+
+    /// @return the mean of the samples, or zero if there is no sample
+    double GetMean() const;
+
+    /// @return the smallest sample, or zero if there is no sample
+    double GetMin() const;
+
+    /// @return the largest sample, or zero if there is no sample
+    double GetMax() const;
+
+    /// @return the relative accuracy of the quantile estimates
+    double GetRelativeAccuracy() const;
+
+    /// @return the number of buckets currently allocated
+    std::size_t GetNBuckets() const;
+
+  private:
+    /**
+     * @param value a positive value
+     * @return the index of the bucket the value belongs to
+     */
+    int32_t Index(double value) const;
+
+    /**
+     * @param index the index of a bucket
+     * @return the value representative of the bucket
+     */
+    double Value(int32_t index) const;
+
+    /**
+     * Make sure that the bucket with the given index is allocated.
+     * @param index the index of the bucket
+     */
+    void Extend(int32_t index);
+
+    double m_alpha;                  //!< relative accuracy
+    double m_gamma;                  //!< ratio between the boundaries of consecutive buckets
+    double m_logGamma;               //!< natural logarithm of gamma
+    std::vector<uint64_t> m_buckets; //!< bucket counters
+    int32_t m_offset;                //!< index of the first allocated bucket
+    uint64_t m_zeroCount;            //!< number of samples counted as zero
+    uint64_t m_count;                //!< number of samples
+    double m_sum;                    //!< sum of the samples
+    double m_min;                    //!< smallest sample
+    double m_max;                    //!< largest sample
+};
+
+} // namespace ns3
+
+#endif /* QUANTILE_SKETCH_H */
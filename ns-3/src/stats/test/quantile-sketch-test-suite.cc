@@ -0,0 +1,108 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/quantile-sketch.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief QuantileSketch Test: compare the quantiles estimated by a sketch with
+ * the exact quantiles of a heavy-tailed set of samples.
+ */
+class QuantileSketchTestCase : public TestCase
+{
+  public:
+    QuantileSketchTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+QuantileSketchTestCase::QuantileSketchTestCase()
+    : TestCase("QuantileSketch")
+{
+}
+
+void
+QuantileSketchTestCase::DoRun()
+{
+    const double alpha = 0.01;
+    QuantileSketch sketch(alpha);
+    QuantileSketch first(alpha);
+    QuantileSketch second(alpha);
+    std::vector<double> samples;
+
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetQuantile(0.5), 0, "An empty sketch should return zero");
+
+    // values spanning eight orders of magnitude
+    uint64_t state = 1;
+    for (uint32_t i = 0; i < 50000; ++i)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        double u = static_cast<double>(state >> 11) / static_cast<double>(1ULL << 53);
+        double value = 1e-6 * std::pow(10, 8 * u * u);
+        samples.push_back(value);
+        sketch.Add(value);
+        (i % 2 == 0 ? first : second).Add(value);
+    }
+    sketch.Add(0);
+    first.Add(0);
+    samples.push_back(0);
+    std::sort(samples.begin(), samples.end());
+
+    first.Merge(second);
+    NS_TEST_EXPECT_MSG_EQ(first.GetCount(), samples.size(), "Unexpected number of samples");
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetCount(), samples.size(), "Unexpected number of samples");
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetMin(), 0, "Unexpected minimum");
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetMax(), samples.back(), "Unexpected maximum");
+
+    for (double q : {0.0, 0.01, 0.1, 0.5, 0.9, 0.95, 0.99, 0.999, 1.0})
+    {
+        double exact = samples[static_cast<std::size_t>(q * (samples.size() - 1))];
+        double estimate = sketch.GetQuantile(q);
+        NS_TEST_EXPECT_MSG_EQ_TOL(estimate,
+                                  exact,
+                                  alpha * exact + 1e-15,
+                                  "Quantile " << q << " exceeds the relative accuracy");
+        NS_TEST_EXPECT_MSG_EQ(first.GetQuantile(q),
+                              estimate,
+                              "Merged sketch differs for quantile " << q);
+    }
+
+    // the number of buckets grows with the logarithm of the range of the samples
+    NS_TEST_EXPECT_MSG_LT(sketch.GetNBuckets(),
+                          static_cast<std::size_t>(std::log(1e8) / std::log(1.02) + 2),
+                          "Too many buckets");
+
+    sketch.Clear();
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetCount(), 0, "The sketch should be empty");
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetNBuckets(), 0, "The sketch should be empty");
+}
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief QuantileSketch TestSuite
+ */
+class QuantileSketchTestSuite : public TestSuite
+{
+  public:
+    QuantileSketchTestSuite();
+};
+
+QuantileSketchTestSuite::QuantileSketchTestSuite()
+    : TestSuite("quantile-sketch", Type::UNIT)
+{
+    AddTestCase(new QuantileSketchTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static QuantileSketchTestSuite g_quantileSketchTestSuite;
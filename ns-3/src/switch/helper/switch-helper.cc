@@ -0,0 +1,266 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "switch-helper.h"
+
+#include "ns3/channel.h"
+#include "ns3/ipv4-static-routing-helper.h"
+#include "ns3/ipv4.h"
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/switch-net-device.h"
+
+#include <map>
+#include <queue>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup switch
+ * ns3::SwitchHelper implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SwitchHelper");
+
+namespace
+{
+
+/**
+ * @ingroup switch
+ * @param device a NetDevice
+ * @return the NetDevices attached to the same channel as the given device
+ */
+std::vector<Ptr<NetDevice>>
+GetPeers(Ptr<NetDevice> device)
+{
+    std::vector<Ptr<NetDevice>> peers;
+    auto channel = device->GetChannel();
+    if (!channel)
+    {
+        return peers;
+    }
+    for (std::size_t i = 0; i < channel->GetNDevices(); ++i)
+    {
+        if (auto peer = channel->GetDevice(i); peer != device)
+        {
+            peers.push_back(peer);
+        }
+    }
+    return peers;
+}
+
+} // namespace
+
+SwitchHelper::SwitchHelper()
+{
+    NS_LOG_FUNCTION(this);
+    m_deviceFactory.SetTypeId("ns3::SwitchNetDevice");
+}
+
+void
+SwitchHelper::SetDeviceAttribute(std::string n1, const AttributeValue& v1)
+{
+    NS_LOG_FUNCTION(this << n1);
+    m_deviceFactory.Set(n1, v1);
+}
+
+NetDeviceContainer
+SwitchHelper::Install(Ptr<Node> node, NetDeviceContainer c)
+{
+    NS_LOG_FUNCTION(this << node);
+
+    NetDeviceContainer devs;
+    auto dev = m_deviceFactory.Create<SwitchNetDevice>();
+    devs.Add(dev);
+    node->AddDevice(dev);
+
+    for (auto i = c.Begin(); i != c.End(); ++i)
+    {
+        NS_LOG_LOGIC("Add switch port " << *i);
+        dev->AddSwitchPort(*i);
+    }
+    return devs;
+}
+
+NetDeviceContainer
+SwitchHelper::Install(NodeContainer c)
+{
+    NS_LOG_FUNCTION(this);
+
+    NetDeviceContainer devs;
+    for (auto it = c.Begin(); it != c.End(); ++it)
+    {
+        NetDeviceContainer ports;
+        for (uint32_t i = 0; i < (*it)->GetNDevices(); ++i)
+        {
+            ports.Add((*it)->GetDevice(i));
+        }
+        devs.Add(Install(*it, ports));
+    }
+    return devs;
+}
+
+void
+SwitchHelper::PopulateForwardingTables()
+{
+    NS_LOG_FUNCTION_NOARGS();
+
+    // collect the switches and map each switch port to its switch and port index
+    std::vector<Ptr<SwitchNetDevice>> switches;
+    std::map<Ptr<NetDevice>, std::pair<uint32_t, uint32_t>> portOwner;
+
+    for (auto it = NodeList::Begin(); it != NodeList::End(); ++it)
+    {
+        for (uint32_t i = 0; i < (*it)->GetNDevices(); ++i)
+        {
+            if (auto sw = DynamicCast<SwitchNetDevice>((*it)->GetDevice(i)))
+            {
+                for (uint32_t p = 0; p < sw->GetNSwitchPorts(); ++p)
+                {
+                    portOwner[sw->GetSwitchPort(p)] = {switches.size(), p};
+                }
+                switches.push_back(sw);
+            }
+        }
+    }
+
+    /// A link between two switches, seen from one of them
+    struct Link
+    {
+        uint32_t port;     //!< the port of the local switch
+        uint32_t peer;     //!< the index of the remote switch
+        uint32_t peerPort; //!< the port of the remote switch
+    };
+
+    std::vector<std::vector<Link>> links(switches.size());
+    // the switches and ports an IPv4 address is directly attached to
+    std::map<Ipv4Address, std::vector<std::pair<uint32_t, uint32_t>>> attachments;
+
+    for (uint32_t s = 0; s < switches.size(); ++s)
+    {
+        for (uint32_t p = 0; p < switches[s]->GetNSwitchPorts(); ++p)
+        {
+            for (const auto& peer : GetPeers(switches[s]->GetSwitchPort(p)))
+            {
+                if (auto owner = portOwner.find(peer); owner != portOwner.end())
+                {
+                    links[s].push_back({p, owner->second.first, owner->second.second});
+                    continue;
+                }
+                auto ipv4 = peer->GetNode()->GetObject<Ipv4>();
+                if (!ipv4)
+                {
+                    continue;
+                }
+                auto interface = ipv4->GetInterfaceForDevice(peer);
+                if (interface < 0)
+                {
+                    continue;
+                }
+                for (uint32_t a = 0; a < ipv4->GetNAddresses(interface); ++a)
+                {
+                    attachments[ipv4->GetAddress(interface, a).GetLocal()].emplace_back(s, p);
+                }
+            }
+        }
+    }
+
+    // breadth-first search from the switches each address is attached to
+    for (const auto& [address, attached] : attachments)
+    {
+        std::vector<uint32_t> distance(switches.size(), UINT32_MAX);
+        std::vector<std::vector<uint32_t>> ports(switches.size());
+        std::queue<uint32_t> toVisit;
+
+        for (const auto& [s, p] : attached)
+        {
+            if (distance[s] == UINT32_MAX)
+            {
+                distance[s] = 0;
+                toVisit.push(s);
+            }
+            ports[s].push_back(p);
+        }
+
+        while (!toVisit.empty())
+        {
+            auto s = toVisit.front();
+            toVisit.pop();
+            for (const auto& link : links[s])
+            {
+                if (distance[link.peer] == UINT32_MAX)
+                {
+                    distance[link.peer] = distance[s] + 1;
+                    toVisit.push(link.peer);
+                }
+                if (distance[link.peer] == distance[s] + 1)
+                {
+                    ports[link.peer].push_back(link.peerPort);
+                }
+            }
+        }
+
+        for (uint32_t s = 0; s < switches.size(); ++s)
+        {
+            if (!ports[s].empty())
+            {
+                NS_LOG_LOGIC("Switch " << s << ": " << address << " through " << ports[s].size()
+                                       << " port(s)");
+                switches[s]->GetForwardingTable().AddIpv4Entry(address, ports[s]);
+            }
+        }
+    }
+}
+
+void
+SwitchHelper::SetHostDefaultRoutes(NodeContainer hosts)
+{
+    NS_LOG_FUNCTION_NOARGS();
+
+    Ipv4StaticRoutingHelper helper;
+
+    for (auto it = hosts.Begin(); it != hosts.End(); ++it)
+    {
+        auto ipv4 = (*it)->GetObject<Ipv4>();
+        NS_ASSERT_MSG(ipv4, "No Ipv4 object aggregated to node " << (*it)->GetId());
+        auto routing = helper.GetStaticRouting(ipv4);
+        NS_ASSERT_MSG(routing, "No Ipv4StaticRouting on node " << (*it)->GetId());
+
+        for (uint32_t i = 0; i < (*it)->GetNDevices(); ++i)
+        {
+            auto device = (*it)->GetDevice(i);
+            auto interface = ipv4->GetInterfaceForDevice(device);
+            if (interface < 0)
+            {
+                continue;
+            }
+            for (const auto& peer : GetPeers(device))
+            {
+                auto node = peer->GetNode();
+                bool isSwitchPort = false;
+                for (uint32_t d = 0; d < node->GetNDevices() && !isSwitchPort; ++d)
+                {
+                    auto sw = DynamicCast<SwitchNetDevice>(node->GetDevice(d));
+                    for (uint32_t p = 0; sw && p < sw->GetNSwitchPorts(); ++p)
+                    {
+                        isSwitchPort |= (sw->GetSwitchPort(p) == peer);
+                    }
+                }
+                if (isSwitchPort)
+                {
+                    NS_LOG_LOGIC("Node " << (*it)->GetId() << ": default route through interface "
+                                         << interface);
+                    routing->SetDefaultRoute(Ipv4Address::GetAny(), interface);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,94 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef SWITCH_HELPER_H
+#define SWITCH_HELPER_H
+
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/object-factory.h"
+
+#include <string>
+
+/**
+ * @file
+ * @ingroup switch
+ * ns3::SwitchHelper declaration.
+ */
+
+namespace ns3
+{
+
+class Node;
+class AttributeValue;
+
+/**
+ * @ingroup switch
+ * @brief Install SwitchNetDevices and populate their forwarding tables
+ */
+class SwitchHelper
+{
+  public:
+    SwitchHelper();
+
+    /**
+     * Set an attribute on each ns3::SwitchNetDevice created by
+     * SwitchHelper::Install
+     *
+     * @param n1 the name of the attribute to set
+     * @param v1 the value of the attribute to set
+     */
+    void SetDeviceAttribute(std::string n1, const AttributeValue& v1);
+
+    /**
+     * This method creates an ns3::SwitchNetDevice with the attributes
+     * configured by SwitchHelper::SetDeviceAttribute, adds the device
+     * to the node, and attaches the given NetDevices as ports of the
+     * switch.
+     *
+     * @param node The node to install the device in
+     * @param c Container of NetDevices to add as switch ports
+     * @returns A container holding the added net device.
+     */
+    NetDeviceContainer Install(Ptr<Node> node, NetDeviceContainer c);
+
+    /**
+     * For each of the given nodes, create an ns3::SwitchNetDevice and attach
+     * all the NetDevices already installed on the node as ports of the switch.
+     *
+     * @param c The nodes to install the device in
+     * @returns A container holding the added net devices.
+     */
+    NetDeviceContainer Install(NodeContainer c);
+
+    /**
+     * Populate the IPv4 forwarding tables of all the switches in the simulation.
+     *
+     * The switches and the links among them are explored to compute, for each
+     * IPv4 address assigned to an interface of a node attached to a switch, the
+     * set of shortest paths (in number of hops) from every switch. Every switch
+     * is then given an entry including all the ports on a shortest path towards
+     * such address, among which packets are spread by means of ECMP.
+     *
+     * This method must be called after the IPv4 addresses have been assigned.
+     */
+    static void PopulateForwardingTables();
+
+    /**
+     * Add to each of the given nodes a default route through each interface
+     * attached to a switch port. The nodes must have been given an
+     * Ipv4StaticRouting protocol (which is the case when the default
+     * InternetStackHelper configuration is used).
+     *
+     * @param hosts the nodes to configure
+     */
+    static void SetHostDefaultRoutes(NodeContainer hosts);
+
+  private:
+    ObjectFactory m_deviceFactory; //!< Object factory
+};
+
+} // namespace ns3
+
+#endif /* SWITCH_HELPER_H */
@@ -0,0 +1,163 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "switch-forwarding-table.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+
+/**
+ * @file
+ * @ingroup switch
+ * ns3::SwitchForwardingTable implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SwitchForwardingTable");
+
+SwitchForwardingTable::SwitchForwardingTable()
+    : m_defaultGroup(NO_GROUP)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+SwitchForwardingTable::AddIpv4Entry(Ipv4Address dest, const std::vector<uint32_t>& ports)
+{
+    NS_LOG_FUNCTION(this << dest << ports.size());
+    m_ipv4Entries[dest] = GetGroup(ports);
+}
+
+void
+SwitchForwardingTable::AddMacEntry(Mac48Address dest, const std::vector<uint32_t>& ports)
+{
+    NS_LOG_FUNCTION(this << dest << ports.size());
+    m_macEntries[MacToKey(dest)] = GetGroup(ports);
+}
+
+void
+SwitchForwardingTable::SetDefaultPorts(const std::vector<uint32_t>& ports)
+{
+    NS_LOG_FUNCTION(this << ports.size());
+    m_defaultGroup = (ports.empty() ? NO_GROUP : GetGroup(ports));
+}
+
+void
+SwitchForwardingTable::RemoveIpv4Entry(Ipv4Address dest)
+{
+    NS_LOG_FUNCTION(this << dest);
+    m_ipv4Entries.erase(dest);
+}
+
+void
+SwitchForwardingTable::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    m_ipv4Entries.clear();
+    m_macEntries.clear();
+    m_defaultGroup = NO_GROUP;
+    m_groups.clear();
+    m_groupPorts.clear();
+    m_groupIndex.clear();
+}
+
+uint32_t
+SwitchForwardingTable::LookupIpv4(Ipv4Address dest, uint32_t hash) const
+{
+    auto it = m_ipv4Entries.find(dest);
+    return SelectPort(it != m_ipv4Entries.end() ? it->second : m_defaultGroup, hash);
+}
+
+uint32_t
+SwitchForwardingTable::LookupMac(Mac48Address dest, uint32_t hash) const
+{
+    auto it = m_macEntries.find(MacToKey(dest));
+    return SelectPort(it != m_macEntries.end() ? it->second : m_defaultGroup, hash);
+}
+
+std::vector<uint32_t>
+SwitchForwardingTable::GetIpv4Ports(Ipv4Address dest) const
+{
+    auto it = m_ipv4Entries.find(dest);
+    if (it == m_ipv4Entries.end())
+    {
+        return {};
+    }
+    const auto& group = m_groups[it->second];
+    return {m_groupPorts.begin() + group.offset,
+            m_groupPorts.begin() + group.offset + group.size};
+}
+
+std::size_t
+SwitchForwardingTable::GetNIpv4Entries() const
+{
+    return m_ipv4Entries.size();
+}
+
+std::size_t
+SwitchForwardingTable::GetNMacEntries() const
+{
+    return m_macEntries.size();
+}
+
+std::size_t
+SwitchForwardingTable::GetNGroups() const
+{
+    return m_groups.size();
+}
+
+uint32_t
+SwitchForwardingTable::GetGroup(std::vector<uint32_t> ports)
+{
+    NS_ASSERT_MSG(!ports.empty(), "A next-hop group must include at least one port");
+
+    // the order of the ports does not matter, hence use a canonical representation
+    std::sort(ports.begin(), ports.end());
+    ports.erase(std::unique(ports.begin(), ports.end()), ports.end());
+
+    auto [it, inserted] = m_groupIndex.emplace(ports, m_groups.size());
+    if (inserted)
+    {
+        m_groups.push_back({static_cast<uint32_t>(m_groupPorts.size()),
+                            static_cast<uint32_t>(ports.size())});
+        m_groupPorts.insert(m_groupPorts.end(), ports.begin(), ports.end());
+    }
+    return it->second;
+}
+
+uint32_t
+SwitchForwardingTable::SelectPort(uint32_t group, uint32_t hash) const
+{
+    if (group == NO_GROUP)
+    {
+        return NO_PORT;
+    }
+    const auto& g = m_groups[group];
+    if (g.size == 1)
+    {
+        return m_groupPorts[g.offset];
+    }
+    // map the hash onto [0, size) with a multiplication rather than a modulo
+    auto index = static_cast<uint32_t>((static_cast<uint64_t>(hash) * g.size) >> 32);
+    return m_groupPorts[g.offset + index];
+}
+
+uint64_t
+SwitchForwardingTable::MacToKey(Mac48Address address)
+{
+    uint8_t buffer[6];
+    address.CopyTo(buffer);
+    uint64_t key = 0;
+    for (auto byte : buffer)
+    {
+        key = (key << 8) | byte;
+    }
+    return key;
+}
+
+} // namespace ns3
@@ -0,0 +1,152 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef SWITCH_FORWARDING_TABLE_H
+#define SWITCH_FORWARDING_TABLE_H
+
+#include "ns3/ipv4-address.h"
+#include "ns3/mac48-address.h"
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup switch
+ * ns3::SwitchForwardingTable declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup switch
+ * @brief Flat forwarding table of a SwitchNetDevice
+ *
+ * The forwarding table maps IPv4 destination addresses and MAC destination
+ * addresses (exact match) to next-hop groups, i.e., sets of output ports
+ * among which the output port of a packet is selected based on the hash
+ * of the packet flow identifier (ECMP). Next-hop groups are stored
+ * contiguously and shared among all the entries having the same set of
+ * output ports. A default next-hop group can be used for destinations that
+ * do not match any entry.
+ */
+class SwitchForwardingTable
+{
+  public:
+    /// Value returned by the lookup methods when no output port is found
+    static constexpr uint32_t NO_PORT = UINT32_MAX;
+
+    SwitchForwardingTable();
+
+    /**
+     * Add (or replace) an entry for the given IPv4 destination address.
+     *
+     * @param dest the IPv4 destination address
+     * @param ports the indices of the output ports among which packets are spread
+     */
+    void AddIpv4Entry(Ipv4Address dest, const std::vector<uint32_t>& ports);
+
+    /**
+     * Add (or replace) an entry for the given MAC destination address.
+     *
+     * @param dest the MAC destination address
+     * @param ports the indices of the output ports among which packets are spread
+     */
+    void AddMacEntry(Mac48Address dest, const std::vector<uint32_t>& ports);
+
+    /**
+     * Set the output ports used for destinations not matching any entry.
+     *
+     * @param ports the indices of the output ports among which packets are spread
+     */
+    void SetDefaultPorts(const std::vector<uint32_t>& ports);
+
+    /**
+     * Remove the entry for the given IPv4 destination address, if any.
+     *
+     * @param dest the IPv4 destination address
+     */
+    void RemoveIpv4Entry(Ipv4Address dest);
+
+    /**
+     * Remove all the entries and the default next-hop group.
+     */
+    void Clear();
+
+    /**
+     * @param dest the IPv4 destination address
+     * @param hash the hash of the flow identifier of the packet
+     * @return the index of the output port, or NO_PORT if no entry matches
+     */
+    uint32_t LookupIpv4(Ipv4Address dest, uint32_t hash) const;
+
+    /**
+     * @param dest the MAC destination address
+     * @param hash the hash of the flow identifier of the packet
+     * @return the index of the output port, or NO_PORT if no entry matches
+     */
+    uint32_t LookupMac(Mac48Address dest, uint32_t hash) const;
+
+    /**
+     * @param dest the IPv4 destination address
+     * @return the indices of the output ports for the given destination (possibly none)
+     */
+    std::vector<uint32_t> GetIpv4Ports(Ipv4Address dest) const;
+
+    /// @return the number of IPv4 entries
+    std::size_t GetNIpv4Entries() const;
+
+    /// @return the number of MAC entries
+    std::size_t GetNMacEntries() const;
+
+    /// @return the number of distinct next-hop groups
+    std::size_t GetNGroups() const;
+
+  private:
+    /// A set of output ports stored contiguously in m_groupPorts
+    struct Group
+    {
+        uint32_t offset; //!< index in m_groupPorts of the first port of the group
+        uint32_t size;   //!< number of ports in the group
+    };
+
+    /// Value of the group index meaning that there is no group
+    static constexpr uint32_t NO_GROUP = UINT32_MAX;
+
+    /**
+     * Get the index of the group including the given ports, creating the
+     * group if it does not exist yet.
+     *
+     * @param ports the indices of the output ports
+     * @return the index of the group
+     */
+    uint32_t GetGroup(std::vector<uint32_t> ports);
+
+    /**
+     * @param group the index of a group
+     * @param hash the hash of the flow identifier of the packet
+     * @return the index of the selected output port
+     */
+    uint32_t SelectPort(uint32_t group, uint32_t hash) const;
+
+    /**
+     * @param address a MAC address
+     * @return the address as an integer
+     */
+    static uint64_t MacToKey(Mac48Address address);
+
+    std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash> m_ipv4Entries; //!< IPv4 entries
+    std::unordered_map<uint64_t, uint32_t> m_macEntries; //!< MAC entries
+    uint32_t m_defaultGroup;                             //!< default group
+    std::vector<Group> m_groups;                         //!< next-hop groups
+    std::vector<uint32_t> m_groupPorts;                  //!< ports of all the groups
+    std::map<std::vector<uint32_t>, uint32_t> m_groupIndex; //!< group index by set of ports
+};
+
+} // namespace ns3
+
+#endif /* SWITCH_FORWARDING_TABLE_H */
@@ -0,0 +1,604 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "switch-net-device.h"
+
+#include "ns3/channel.h"
+#include "ns3/double.h"
+#include "ns3/hash.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/queue.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @file
+ * @ingroup switch
+ * ns3::SwitchNetDevice implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SwitchNetDevice");
+
+NS_OBJECT_ENSURE_REGISTERED(SwitchNetDevice);
+
+TypeId
+SwitchNetDevice::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::SwitchNetDevice")
+            .SetParent<NetDevice>()
+            .SetGroupName("Switch")
+            .AddConstructor<SwitchNetDevice>()
+            .AddAttribute("Mtu",
+                          "The MAC-level Maximum Transmission Unit",
+                          UintegerValue(1500),
+                          MakeUintegerAccessor(&SwitchNetDevice::SetMtu, &SwitchNetDevice::GetMtu),
+                          MakeUintegerChecker<uint16_t>())
+            .AddAttribute("BufferSize",
+                          "The size in bytes of the buffer shared among all the ports",
+                          UintegerValue(12000000),
+                          MakeUintegerAccessor(&SwitchNetDevice::m_bufferSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("DtAlpha",
+                          "The alpha parameter of the dynamic threshold policy: a packet is "
+                          "admitted into a queue if the queue occupancy is less than alpha "
+                          "times the free buffer space",
+                          DoubleValue(1.0),
+                          MakeDoubleAccessor(&SwitchNetDevice::m_alpha),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("EcnThreshold",
+                          "The queue occupancy in bytes above which ECN capable packets are "
+                          "marked with CE (a null value disables ECN marking)",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&SwitchNetDevice::m_ecnThreshold),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("NumPriorities",
+                          "The number of priority queues per port. Changing this value after "
+                          "ports have been added has no effect on such ports.",
+                          UintegerValue(8),
+                          MakeUintegerAccessor(&SwitchNetDevice::m_nPriorities),
+                          MakeUintegerChecker<uint8_t>(1, 8))
+            .AddAttribute("HashSeed",
+                          "The seed of the hash of the flow identifier used to select the "
+                          "output port among multiple equal-cost ports",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&SwitchNetDevice::m_hashSeed),
+                          MakeUintegerChecker<uint32_t>())
+            .AddTraceSource("Drop",
+                            "A packet has been dropped by the switch",
+                            MakeTraceSourceAccessor(&SwitchNetDevice::m_dropTrace),
+                            "ns3::Packet::TracedCallback")
+            .AddTraceSource("EcnMark",
+                            "An IPv4 packet has been marked with CE by the switch",
+                            MakeTraceSourceAccessor(&SwitchNetDevice::m_ecnMarkTrace),
+                            "ns3::Packet::TracedCallback");
+    return tid;
+}
+
+SwitchNetDevice::SwitchNetDevice()
+    : m_node(nullptr),
+      m_ifIndex(0),
+      m_mtu(1500),
+      m_bufferSize(12000000),
+      m_bufferUsed(0),
+      m_alpha(1.0),
+      m_ecnThreshold(0),
+      m_nPriorities(8),
+      m_hashSeed(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+SwitchNetDevice::~SwitchNetDevice()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+SwitchNetDevice::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& port : m_ports)
+    {
+        port.txEvent.Cancel();
+        port.device = nullptr;
+        port.txQueue = nullptr;
+        port.queues.clear();
+    }
+    m_ports.clear();
+    m_portIndex.clear();
+    m_table.Clear();
+    m_node = nullptr;
+    NetDevice::DoDispose();
+}
+
+uint32_t
+SwitchNetDevice::AddSwitchPort(Ptr<NetDevice> device)
+{
+    NS_LOG_FUNCTION(this << device);
+    NS_ASSERT(device != this);
+    NS_ASSERT_MSG(m_node, "The switch device must be added to a node before adding ports");
+    NS_ASSERT_MSG(device->GetNode() == m_node, "The port must belong to the node of the switch");
+
+    uint32_t index = m_ports.size();
+    Port port;
+    port.device = device;
+    port.queues.resize(m_nPriorities);
+    port.queueBytes.assign(m_nPriorities, 0);
+
+    PointerValue ptr;
+    if (device->GetAttributeFailSafe("TxQueue", ptr))
+    {
+        port.txQueue = ptr.Get<Queue<Packet>>();
+    }
+    if (port.txQueue)
+    {
+        port.txQueue->TraceConnectWithoutContext(
+            "Dequeue",
+            MakeCallback(&SwitchNetDevice::NotifyTxQueueDequeue, this).Bind(index));
+    }
+    m_ports.push_back(std::move(port));
+
+    if (device->GetIfIndex() >= m_portIndex.size())
+    {
+        m_portIndex.resize(device->GetIfIndex() + 1, SwitchForwardingTable::NO_PORT);
+    }
+    m_portIndex[device->GetIfIndex()] = index;
+
+    m_node->RegisterProtocolHandler(MakeCallback(&SwitchNetDevice::ReceiveFromDevice, this),
+                                    0,
+                                    device,
+                                    true);
+    return index;
+}
+
+uint32_t
+SwitchNetDevice::GetNSwitchPorts() const
+{
+    return m_ports.size();
+}
+
+Ptr<NetDevice>
+SwitchNetDevice::GetSwitchPort(uint32_t n) const
+{
+    NS_ASSERT(n < m_ports.size());
+    return m_ports[n].device;
+}
+
+SwitchForwardingTable&
+SwitchNetDevice::GetForwardingTable()
+{
+    return m_table;
+}
+
+uint32_t
+SwitchNetDevice::GetBufferOccupancy() const
+{
+    return m_bufferUsed;
+}
+
+uint32_t
+SwitchNetDevice::GetQueueOccupancy(uint32_t port, uint8_t priority) const
+{
+    NS_ASSERT(port < m_ports.size() && priority < m_ports[port].queueBytes.size());
+    return m_ports[port].queueBytes[priority];
+}
+
+void
+SwitchNetDevice::ReceiveFromDevice(Ptr<NetDevice> device,
+                                   Ptr<const Packet> packet,
+                                   uint16_t protocol,
+                                   const Address& source,
+                                   const Address& destination,
+                                   PacketType packetType)
+{
+    NS_LOG_FUNCTION(this << device << packet << protocol << packetType);
+
+    if (!m_promiscRxCallback.IsNull())
+    {
+        m_promiscRxCallback(this, packet, protocol, source, destination, packetType);
+    }
+
+    NS_ASSERT(device->GetIfIndex() < m_portIndex.size());
+    uint32_t inPort = m_portIndex[device->GetIfIndex()];
+    NS_ASSERT(inPort < m_ports.size() && m_ports[inPort].device == device);
+
+    if (protocol == Ipv4L3Protocol::PROT_NUMBER)
+    {
+        ForwardIpv4(inPort, packet->Copy());
+    }
+    else
+    {
+        ForwardL2(inPort,
+                  packet->Copy(),
+                  protocol,
+                  Mac48Address::ConvertFrom(source),
+                  Mac48Address::ConvertFrom(destination));
+    }
+}
+
+void
+SwitchNetDevice::ForwardIpv4(uint32_t inPort, Ptr<Packet> packet)
+{
+    NS_LOG_FUNCTION(this << inPort << packet);
+
+    Ipv4Header ipHeader;
+    if (Node::ChecksumEnabled())
+    {
+        // keep the received checksum, which is updated incrementally when the
+        // TTL and the ECN field are changed
+        ipHeader.EnableChecksum();
+        ipHeader.TrustChecksum();
+    }
+    packet->RemoveHeader(ipHeader);
+
+    if (ipHeader.GetTtl() <= 1)
+    {
+        NS_LOG_LOGIC("TTL expired, dropping packet " << packet->GetUid());
+        packet->AddHeader(ipHeader);
+        Drop(packet);
+        return;
+    }
+    ipHeader.SetTtl(ipHeader.GetTtl() - 1);
+
+    uint32_t ports = 0;
+    uint8_t protocol = ipHeader.GetProtocol();
+    if ((protocol == 6 || protocol == 17) && ipHeader.GetFragmentOffset() == 0 &&
+        packet->GetSize() >= 4)
+    {
+        // the source and destination ports are the first four bytes of the TCP/UDP header
+        uint8_t buffer[4];
+        packet->CopyData(buffer, 4);
+        std::memcpy(&ports, buffer, 4);
+    }
+
+    uint32_t hash =
+        FlowHash(ipHeader.GetSource(), ipHeader.GetDestination(), protocol, ports);
+    uint32_t outPort = m_table.LookupIpv4(ipHeader.GetDestination(), hash);
+
+    if (outPort == SwitchForwardingTable::NO_PORT || outPort == inPort ||
+        outPort >= m_ports.size())
+    {
+        NS_LOG_LOGIC("No output port for " << ipHeader.GetDestination() << ", dropping packet "
+                                           << packet->GetUid());
+        packet->AddHeader(ipHeader);
+        Drop(packet);
+        return;
+    }
+
+    uint8_t priority = std::min<uint8_t>(ipHeader.GetTos() >> 5, m_nPriorities - 1);
+    uint32_t size = packet->GetSize() + ipHeader.GetSerializedSize();
+
+    if (!CanEnqueue(outPort, priority, size))
+    {
+        NS_LOG_LOGIC("Shared buffer threshold exceeded, dropping packet " << packet->GetUid());
+        packet->AddHeader(ipHeader);
+        Drop(packet);
+        return;
+    }
+
+    bool mark = false;
+    if (m_ecnThreshold > 0 && m_ports[outPort].queueBytes[priority] >= m_ecnThreshold &&
+        (ipHeader.GetEcn() == Ipv4Header::ECN_ECT0 || ipHeader.GetEcn() == Ipv4Header::ECN_ECT1))
+    {
+        NS_LOG_LOGIC("Marking packet " << packet->GetUid() << " with CE");
+        ipHeader.SetEcn(Ipv4Header::ECN_CE);
+        mark = true;
+    }
+
+    packet->AddHeader(ipHeader);
+    if (mark)
+    {
+        m_ecnMarkTrace(packet);
+    }
+
+    Enqueue(outPort, priority, {packet, Ipv4L3Protocol::PROT_NUMBER, {}, {}, false});
+}
+
+void
+SwitchNetDevice::ForwardL2(uint32_t inPort,
+                           Ptr<Packet> packet,
+                           uint16_t protocol,
+                           Mac48Address src,
+                           Mac48Address dst)
+{
+    NS_LOG_FUNCTION(this << inPort << packet << protocol << src << dst);
+
+    uint8_t buffer[12];
+    src.CopyTo(buffer);
+    dst.CopyTo(buffer + 6);
+    uint32_t hash = Hash32(reinterpret_cast<const char*>(buffer), sizeof(buffer)) ^ m_hashSeed;
+
+    uint32_t outPort = m_table.LookupMac(dst, hash);
+
+    if (outPort == SwitchForwardingTable::NO_PORT || outPort == inPort ||
+        outPort >= m_ports.size())
+    {
+        NS_LOG_LOGIC("No output port for " << dst << ", dropping packet " << packet->GetUid());
+        Drop(packet);
+        return;
+    }
+
+    if (!CanEnqueue(outPort, 0, packet->GetSize()))
+    {
+        NS_LOG_LOGIC("Shared buffer threshold exceeded, dropping packet " << packet->GetUid());
+        Drop(packet);
+        return;
+    }
+
+    Enqueue(outPort, 0, {packet, protocol, src, dst, true});
+}
+
+uint32_t
+SwitchNetDevice::FlowHash(Ipv4Address src, Ipv4Address dst, uint8_t protocol, uint32_t ports) const
+{
+    uint8_t buffer[17];
+    src.Serialize(buffer);
+    dst.Serialize(buffer + 4);
+    buffer[8] = protocol;
+    std::memcpy(buffer + 9, &ports, 4);
+    uint32_t salt = m_hashSeed ^ (m_node ? m_node->GetId() : 0);
+    std::memcpy(buffer + 13, &salt, 4);
+    return Hash32(reinterpret_cast<const char*>(buffer), sizeof(buffer));
+}
+
+bool
+SwitchNetDevice::CanEnqueue(uint32_t port, uint8_t priority, uint32_t size) const
+{
+    if (m_bufferUsed + size > m_bufferSize)
+    {
+        return false;
+    }
+    // dynamic threshold: the queue occupancy must be less than alpha times the free space
+    return m_ports[port].queueBytes[priority] < m_alpha * (m_bufferSize - m_bufferUsed);
+}
+
+void
+SwitchNetDevice::Drop(Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << packet);
+    m_dropTrace(packet);
+}
+
+void
+SwitchNetDevice::Enqueue(uint32_t port, uint8_t priority, Item item)
+{
+    NS_LOG_FUNCTION(this << port << +priority << item.packet);
+
+    uint32_t size = item.packet->GetSize();
+    m_ports[port].queues[priority].push_back(std::move(item));
+    m_ports[port].queueBytes[priority] += size;
+    m_bufferUsed += size;
+
+    if (!m_ports[port].txEvent.IsPending())
+    {
+        Transmit(port);
+    }
+}
+
+void
+SwitchNetDevice::Transmit(uint32_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+
+    auto& port = m_ports[index];
+
+    while (!port.txQueue || port.txQueue->IsEmpty())
+    {
+        // strict priority: serve the highest priority non-empty queue
+        auto prio = static_cast<int>(port.queues.size()) - 1;
+        while (prio >= 0 && port.queues[prio].empty())
+        {
+            --prio;
+        }
+        if (prio < 0)
+        {
+            return;
+        }
+
+        Item item = std::move(port.queues[prio].front());
+        port.queues[prio].pop_front();
+        uint32_t size = item.packet->GetSize();
+        NS_ASSERT(port.queueBytes[prio] >= size && m_bufferUsed >= size);
+        port.queueBytes[prio] -= size;
+        m_bufferUsed -= size;
+
+        bool sent = item.l2 ? (port.device->SupportsSendFrom()
+                                   ? port.device->SendFrom(item.packet,
+                                                           item.src,
+                                                           item.dst,
+                                                           item.protocol)
+                                   : port.device->Send(item.packet, item.dst, item.protocol))
+                            : port.device->Send(item.packet,
+                                                port.device->GetBroadcast(),
+                                                item.protocol);
+        if (!sent)
+        {
+            NS_LOG_LOGIC("Port device refused packet " << item.packet->GetUid());
+            Drop(item.packet);
+        }
+    }
+}
+
+void
+SwitchNetDevice::NotifyTxQueueDequeue(uint32_t port, Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(this << port << packet);
+
+    // The device is dequeuing a packet to start its transmission; hand it the
+    // next packet once it is done (packets cannot be passed to the device from
+    // within the dequeue operation)
+    if (m_bufferUsed > 0 && !m_ports[port].txEvent.IsPending())
+    {
+        m_ports[port].txEvent = Simulator::ScheduleNow(&SwitchNetDevice::Transmit, this, port);
+    }
+}
+
+void
+SwitchNetDevice::SetIfIndex(const uint32_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+    m_ifIndex = index;
+}
+
+uint32_t
+SwitchNetDevice::GetIfIndex() const
+{
+    return m_ifIndex;
+}
+
+Ptr<Channel>
+SwitchNetDevice::GetChannel() const
+{
+    return nullptr;
+}
+
+void
+SwitchNetDevice::SetAddress(Address address)
+{
+    NS_LOG_FUNCTION(this << address);
+    m_address = Mac48Address::ConvertFrom(address);
+}
+
+Address
+SwitchNetDevice::GetAddress() const
+{
+    return m_address;
+}
+
+bool
+SwitchNetDevice::SetMtu(const uint16_t mtu)
+{
+    NS_LOG_FUNCTION(this << mtu);
+    m_mtu = mtu;
+    return true;
+}
+
+uint16_t
+SwitchNetDevice::GetMtu() const
+{
+    return m_mtu;
+}
+
+bool
+SwitchNetDevice::IsLinkUp() const
+{
+    return true;
+}
+
+void
+SwitchNetDevice::AddLinkChangeCallback(Callback<void> callback)
+{
+}
+
+bool
+SwitchNetDevice::IsBroadcast() const
+{
+    return true;
+}
+
+Address
+SwitchNetDevice::GetBroadcast() const
+{
+    return Mac48Address::GetBroadcast();
+}
+
+bool
+SwitchNetDevice::IsMulticast() const
+{
+    return true;
+}
+
+Address
+SwitchNetDevice::GetMulticast(Ipv4Address multicastGroup) const
+{
+    return Mac48Address::GetMulticast(multicastGroup);
+}
+
+Address
+SwitchNetDevice::GetMulticast(Ipv6Address addr) const
+{
+    return Mac48Address::GetMulticast(addr);
+}
+
+bool
+SwitchNetDevice::IsPointToPoint() const
+{
+    return false;
+}
+
+bool
+SwitchNetDevice::IsBridge() const
+{
+    return true;
+}
+
+bool
+SwitchNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(this << packet << dest << protocolNumber);
+    NS_LOG_WARN("A SwitchNetDevice does not originate packets");
+    return false;
+}
+
+bool
+SwitchNetDevice::SendFrom(Ptr<Packet> packet,
+                          const Address& src,
+                          const Address& dest,
+                          uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(this << packet << src << dest << protocolNumber);
+    NS_LOG_WARN("A SwitchNetDevice does not originate packets");
+    return false;
+}
+
+Ptr<Node>
+SwitchNetDevice::GetNode() const
+{
+    return m_node;
+}
+
+void
+SwitchNetDevice::SetNode(Ptr<Node> node)
+{
+    NS_LOG_FUNCTION(this << node);
+    m_node = node;
+}
+
+bool
+SwitchNetDevice::NeedsArp() const
+{
+    return false;
+}
+
+void
+SwitchNetDevice::SetReceiveCallback(NetDevice::ReceiveCallback cb)
+{
+    // packets are never delivered to the upper layers
+}
+
+void
+SwitchNetDevice::SetPromiscReceiveCallback(NetDevice::PromiscReceiveCallback cb)
+{
+    m_promiscRxCallback = cb;
+}
+
+bool
+SwitchNetDevice::SupportsSendFrom() const
+{
+    return false;
+}
+
+} // namespace ns3
@@ -0,0 +1,305 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef SWITCH_NET_DEVICE_H
+#define SWITCH_NET_DEVICE_H
+
+#include "switch-forwarding-table.h"
+
+#include "ns3/event-id.h"
+#include "ns3/mac48-address.h"
+#include "ns3/net-device.h"
+#include "ns3/queue-fwd.h"
+#include "ns3/ring-buffer.h"
+#include "ns3/traced-callback.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup switch
+ * ns3::SwitchNetDevice declaration.
+ */
+
+namespace ns3
+{
+
+class Node;
+class Packet;
+
+/**
+ * @defgroup switch Data Center Switch
+ *
+ * This module provides a lightweight model of a data center switch, which
+ * forwards packets among its ports based on a flat forwarding table, without
+ * traversing any protocol stack.
+ */
+
+/**
+ * @ingroup switch
+ * @brief A virtual net device that forwards packets among multiple ports
+ *
+ * The SwitchNetDevice aggregates multiple "real" netdevices (the ports) and
+ * forwards the packets received from a port to another port, based on the
+ * entries of a SwitchForwardingTable:
+ *
+ * - IPv4 packets are forwarded based on their destination address; their TTL
+ *   is decremented and they are transmitted to the broadcast address of the
+ *   output port, hence L3 forwarding is meant to be used with point-to-point
+ *   ports;
+ * - other frames are forwarded based on their destination MAC address and
+ *   their source and destination MAC addresses are preserved.
+ *
+ * If multiple output ports are available for a destination, the output port
+ * is selected based on the hash of the flow identifier of the packet (the
+ * five-tuple for TCP and UDP packets), hence all the packets of a flow follow
+ * the same path. The hash is salted with the node ID and the HashSeed
+ * attribute to avoid the polarization of the traffic across switch tiers.
+ *
+ * Packets are stored in a buffer shared among all the ports. Each port has
+ * NumPriorities FIFO queues served with strict priority; the priority of
+ * IPv4 packets is the IP precedence (the three most significant bits of the
+ * TOS field), capped to the number of priorities minus one. A packet is
+ * admitted into a queue if the buffer has enough free space and the queue
+ * occupancy is less than a dynamic threshold equal to DtAlpha times the
+ * amount of free buffer space (Choudhury and Hahne). If the EcnThreshold
+ * attribute is non-null, ECN capable IPv4 packets are marked with CE when
+ * the occupancy of the queue they are enqueued into exceeds the threshold.
+ *
+ * Packets are handed to a port device only when the transmit queue of the
+ * device is empty, so that the switch buffer (and not the device queue) is
+ * where packets wait for transmission. Port devices are assumed to provide
+ * their transmit queue through the "TxQueue" attribute (as the
+ * PointToPointNetDevice and CsmaNetDevice do); otherwise, packets are handed
+ * to the port device as soon as they are enqueued.
+ *
+ * Packets are forwarded once they have been completely received by the
+ * ingress port (store-and-forward).
+ *
+ * @attention The switch does not run any protocol (it does not answer ARP
+ * requests nor does it flood frames with unknown destination), hence its
+ * forwarding table must be populated in advance, e.g., by means of the
+ * SwitchHelper. The switch device neither originates packets nor delivers
+ * packets to the upper layers of its node (the receive callback is never
+ * invoked); only the promiscuous receive callback is notified of the packets
+ * received by the ports.
+ */
+class SwitchNetDevice : public NetDevice
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+    SwitchNetDevice();
+    ~SwitchNetDevice() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    SwitchNetDevice(const SwitchNetDevice&) = delete;
+    SwitchNetDevice& operator=(const SwitchNetDevice&) = delete;
+
+    /**
+     * @brief Add a port to the switch device
+     *
+     * The switch device and the given port must have been added to the same node.
+     *
+     * @param port the NetDevice to add
+     * @return the index of the port
+     */
+    uint32_t AddSwitchPort(Ptr<NetDevice> port);
+
+    /**
+     * @return the number of ports of the switch
+     */
+    uint32_t GetNSwitchPorts() const;
+
+    /**
+     * @param n the port index
+     * @return the n-th port of the switch
+     */
+    Ptr<NetDevice> GetSwitchPort(uint32_t n) const;
+
+    /**
+     * @return a reference to the forwarding table of the switch
+     */
+    SwitchForwardingTable& GetForwardingTable();
+
+    /**
+     * @return the number of bytes currently stored in the switch buffer
+     */
+    uint32_t GetBufferOccupancy() const;
+
+    /**
+     * @param port the port index
+     * @param priority the priority
+     * @return the number of bytes currently stored in the given queue of the given port
+     */
+    uint32_t GetQueueOccupancy(uint32_t port, uint8_t priority) const;
+
+    // inherited from NetDevice base class.
+    void SetIfIndex(const uint32_t index) override;
+    uint32_t GetIfIndex() const override;
+    Ptr<Channel> GetChannel() const override;
+    void SetAddress(Address address) override;
+    Address GetAddress() const override;
+    bool SetMtu(const uint16_t mtu) override;
+    uint16_t GetMtu() const override;
+    bool IsLinkUp() const override;
+    void AddLinkChangeCallback(Callback<void> callback) override;
+    bool IsBroadcast() const override;
+    Address GetBroadcast() const override;
+    bool IsMulticast() const override;
+    Address GetMulticast(Ipv4Address multicastGroup) const override;
+    bool IsPointToPoint() const override;
+    bool IsBridge() const override;
+    bool Send(Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber) override;
+    bool SendFrom(Ptr<Packet> packet,
+                  const Address& source,
+                  const Address& dest,
+                  uint16_t protocolNumber) override;
+    Ptr<Node> GetNode() const override;
+    void SetNode(Ptr<Node> node) override;
+    bool NeedsArp() const override;
+    void SetReceiveCallback(NetDevice::ReceiveCallback cb) override;
+    void SetPromiscReceiveCallback(NetDevice::PromiscReceiveCallback cb) override;
+    bool SupportsSendFrom() const override;
+    Address GetMulticast(Ipv6Address addr) const override;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * Receives a packet from one port and forwards it.
+     * @param device the originating port
+     * @param packet the received packet
+     * @param protocol the packet protocol (e.g., Ethertype)
+     * @param source the packet source
+     * @param destination the packet destination
+     * @param packetType the packet type (e.g., host, broadcast, etc.)
+     */
+    void ReceiveFromDevice(Ptr<NetDevice> device,
+                           Ptr<const Packet> packet,
+                           uint16_t protocol,
+                           const Address& source,
+                           const Address& destination,
+                           PacketType packetType);
+
+    /**
+     * Forward an IPv4 packet.
+     * @param inPort the index of the ingress port
+     * @param packet the packet (including the IPv4 header)
+     */
+    void ForwardIpv4(uint32_t inPort, Ptr<Packet> packet);
+
+    /**
+     * Forward a frame based on its destination MAC address.
+     * @param inPort the index of the ingress port
+     * @param packet the packet
+     * @param protocol the packet protocol
+     * @param src the source MAC address
+     * @param dst the destination MAC address
+     */
+    void ForwardL2(uint32_t inPort,
+                   Ptr<Packet> packet,
+                   uint16_t protocol,
+                   Mac48Address src,
+                   Mac48Address dst);
+
+    /**
+     * Check whether a packet can be stored in the given queue according to the
+     * dynamic threshold policy of the shared buffer.
+     * @param port the index of the output port
+     * @param priority the priority
+     * @param size the size of the packet
+     * @return true if the packet can be admitted
+     */
+    bool CanEnqueue(uint32_t port, uint8_t priority, uint32_t size) const;
+
+    /**
+     * Drop a packet.
+     * @param packet the dropped packet
+     */
+    void Drop(Ptr<const Packet> packet);
+
+    /// A packet stored in the switch buffer
+    struct Item
+    {
+        Ptr<Packet> packet; //!< the packet
+        uint16_t protocol;  //!< the packet protocol
+        Mac48Address src;   //!< the source MAC address (L2 forwarding only)
+        Mac48Address dst;   //!< the destination MAC address (L2 forwarding only)
+        bool l2;            //!< whether the packet is forwarded based on MAC addresses
+    };
+
+    /**
+     * Store a packet in the given queue and start transmission if the output
+     * port is idle.
+     * @param port the index of the output port
+     * @param priority the priority
+     * @param item the packet to store
+     */
+    void Enqueue(uint32_t port, uint8_t priority, Item item);
+
+    /**
+     * Hand packets to the device of the given port for as long as its transmit
+     * queue is empty.
+     * @param port the index of the port
+     */
+    void Transmit(uint32_t port);
+
+    /**
+     * Called when a packet is dequeued from the transmit queue of the device
+     * of the given port.
+     * @param port the index of the port
+     * @param packet the dequeued packet
+     */
+    void NotifyTxQueueDequeue(uint32_t port, Ptr<const Packet> packet);
+
+    /**
+     * Compute the hash of the flow identifier of an IPv4 packet.
+     * @param src the source address
+     * @param dst the destination address
+     * @param protocol the transport protocol
+     * @param ports the source and destination ports (network byte order)
+     * @return the hash of the flow identifier
+     */
+    uint32_t FlowHash(Ipv4Address src, Ipv4Address dst, uint8_t protocol, uint32_t ports) const;
+
+    /// A port of the switch
+    struct Port
+    {
+        Ptr<NetDevice> device;           //!< the port device
+        Ptr<Queue<Packet>> txQueue;      //!< the transmit queue of the device, if any
+        std::vector<RingBuffer<Item>> queues; //!< the queues, one per priority
+        std::vector<uint32_t> queueBytes;     //!< the occupancy of the queues, in bytes
+        EventId txEvent;                      //!< event to resume transmission
+    };
+
+    NetDevice::PromiscReceiveCallback m_promiscRxCallback; //!< promiscuous receive callback
+
+    Mac48Address m_address;     //!< MAC address of the switch device
+    Ptr<Node> m_node;           //!< node owning this NetDevice
+    std::vector<Port> m_ports;  //!< switch ports
+    std::vector<uint32_t> m_portIndex; //!< index of the port of the device, by device ifIndex
+    uint32_t m_ifIndex;         //!< interface index
+    uint16_t m_mtu;             //!< MTU of the switch device
+    SwitchForwardingTable m_table; //!< forwarding table
+
+    uint32_t m_bufferSize;  //!< size of the shared buffer, in bytes
+    uint32_t m_bufferUsed;  //!< number of bytes stored in the shared buffer
+    double m_alpha;         //!< the alpha parameter of the dynamic threshold policy
+    uint32_t m_ecnThreshold; //!< ECN marking threshold, in bytes (0 to disable)
+    uint8_t m_nPriorities;  //!< number of priorities per port
+    uint32_t m_hashSeed;    //!< seed of the flow hash
+
+    TracedCallback<Ptr<const Packet>> m_dropTrace;    //!< packets dropped by the switch
+    TracedCallback<Ptr<const Packet>> m_ecnMarkTrace; //!< packets marked with CE
+};
+
+} // namespace ns3
+
+#endif /* SWITCH_NET_DEVICE_H */
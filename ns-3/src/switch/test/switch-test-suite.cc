@@ -0,0 +1,473 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/global-value.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+#include "ns3/switch-helper.h"
+#include "ns3/switch-net-device.h"
+#include "ns3/test.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup switch
+ * @defgroup switch-test switch module tests
+ */
+
+/**
+ * @ingroup switch-test
+ * @ingroup tests
+ *
+ * @brief Check the forwarding table: next-hop groups are shared among entries
+ * having the same set of ports and the port selected for a given hash is one
+ * of the ports of the entry.
+ */
+class SwitchForwardingTableTest : public TestCase
+{
+  public:
+    SwitchForwardingTableTest();
+
+  private:
+    void DoRun() override;
+};
+
+SwitchForwardingTableTest::SwitchForwardingTableTest()
+    : TestCase("Check the switch forwarding table")
+{
+}
+
+void
+SwitchForwardingTableTest::DoRun()
+{
+    SwitchForwardingTable table;
+
+    table.AddIpv4Entry(Ipv4Address("10.0.0.1"), {0});
+    table.AddIpv4Entry(Ipv4Address("10.0.0.2"), {2, 3});
+    table.AddIpv4Entry(Ipv4Address("10.0.0.3"), {3, 2, 3});
+    table.AddMacEntry(Mac48Address("00:00:00:00:00:01"), {0});
+
+    NS_TEST_EXPECT_MSG_EQ(table.GetNIpv4Entries(), 3, "Unexpected number of IPv4 entries");
+    NS_TEST_EXPECT_MSG_EQ(table.GetNMacEntries(), 1, "Unexpected number of MAC entries");
+    NS_TEST_EXPECT_MSG_EQ(table.GetNGroups(), 2, "Next-hop groups should be shared");
+
+    NS_TEST_EXPECT_MSG_EQ(table.LookupIpv4(Ipv4Address("10.0.0.1"), 12345),
+                          0,
+                          "Unexpected output port");
+    NS_TEST_EXPECT_MSG_EQ(table.LookupIpv4(Ipv4Address("10.0.0.4"), 12345),
+                          SwitchForwardingTable::NO_PORT,
+                          "No output port expected for an unknown destination");
+    NS_TEST_EXPECT_MSG_EQ(table.LookupMac(Mac48Address("00:00:00:00:00:01"), 0),
+                          0,
+                          "Unexpected output port");
+
+    std::vector<uint32_t> count(4);
+    for (uint32_t hash = 0; hash < 1000; ++hash)
+    {
+        auto port = table.LookupIpv4(Ipv4Address("10.0.0.2"), hash * 4294968);
+        NS_TEST_ASSERT_MSG_EQ((port == 2 || port == 3), true, "Unexpected output port");
+        count[port]++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(count[2], 500, "Hashes should be spread evenly over the ports");
+
+    table.SetDefaultPorts({1});
+    NS_TEST_EXPECT_MSG_EQ(table.LookupIpv4(Ipv4Address("10.0.0.4"), 12345),
+                          1,
+                          "The default port should be used for an unknown destination");
+
+    table.RemoveIpv4Entry(Ipv4Address("10.0.0.1"));
+    NS_TEST_EXPECT_MSG_EQ(table.LookupIpv4(Ipv4Address("10.0.0.1"), 12345),
+                          1,
+                          "The default port should be used after removing the entry");
+}
+
+/**
+ * @ingroup switch-test
+ * @ingroup tests
+ *
+ * @brief Base class for the tests sending UDP packets through a network of
+ * switches.
+ */
+class SwitchNetworkTestBase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param name the test case name
+     */
+    SwitchNetworkTestBase(std::string name);
+
+  protected:
+    /**
+     * Send packets from the given node to the given address, each from a
+     * different UDP socket (hence each belonging to a different flow).
+     * @param node the sending node
+     * @param dest the destination address
+     * @param nPackets the number of packets
+     * @param size the packet size
+     * @param tos the TOS of the packets
+     */
+    void SendPackets(Ptr<Node> node,
+                     Ipv4Address dest,
+                     uint32_t nPackets,
+                     uint32_t size,
+                     uint8_t tos = 0);
+
+    /**
+     * Create a socket receiving the packets sent to the given node.
+     * @param node the receiving node
+     */
+    void Receive(Ptr<Node> node);
+
+    static constexpr uint16_t PORT = 9; //!< the destination UDP port
+    uint32_t m_received{0};             //!< number of received packets
+
+  private:
+    std::vector<Ptr<Socket>> m_sockets; //!< sockets
+};
+
+SwitchNetworkTestBase::SwitchNetworkTestBase(std::string name)
+    : TestCase(name)
+{
+}
+
+void
+SwitchNetworkTestBase::SendPackets(Ptr<Node> node,
+                                   Ipv4Address dest,
+                                   uint32_t nPackets,
+                                   uint32_t size,
+                                   uint8_t tos)
+{
+    for (uint32_t i = 0; i < nPackets; ++i)
+    {
+        auto socket = Socket::CreateSocket(node, UdpSocketFactory::GetTypeId());
+        socket->Bind();
+        socket->SetIpTos(tos);
+        socket->SendTo(Create<Packet>(size), 0, InetSocketAddress(dest, PORT));
+        m_sockets.push_back(socket);
+    }
+}
+
+void
+SwitchNetworkTestBase::Receive(Ptr<Node> node)
+{
+    auto socket = Socket::CreateSocket(node, UdpSocketFactory::GetTypeId());
+    socket->Bind(InetSocketAddress(Ipv4Address::GetAny(), PORT));
+    socket->SetRecvCallback([this](Ptr<Socket> s) {
+        while (s->Recv())
+        {
+            m_received++;
+        }
+    });
+    m_sockets.push_back(socket);
+}
+
+/**
+ * @ingroup switch-test
+ * @ingroup tests
+ *
+ * @brief Check that packets are delivered across a leaf-spine network and that
+ * flows are spread over both spines.
+ */
+class SwitchLeafSpineTest : public SwitchNetworkTestBase
+{
+  public:
+    SwitchLeafSpineTest();
+
+  private:
+    void DoRun() override;
+};
+
+SwitchLeafSpineTest::SwitchLeafSpineTest()
+    : SwitchNetworkTestBase("Check ECMP forwarding in a leaf-spine network")
+{
+}
+
+void
+SwitchLeafSpineTest::DoRun()
+{
+    NodeContainer hosts(4);
+    NodeContainer leaves(2);
+    NodeContainer spines(2);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("10Gbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("1us"));
+
+    InternetStackHelper internet;
+    internet.Install(hosts);
+
+    Ipv4AddressHelper address("10.0.0.0", "255.255.255.0");
+    std::vector<NetDeviceContainer> spineLinks(2);
+
+    for (uint32_t h = 0; h < hosts.GetN(); ++h)
+    {
+        auto devices = p2p.Install(hosts.Get(h), leaves.Get(h / 2));
+        address.Assign(NetDeviceContainer(devices.Get(0)));
+        address.NewNetwork();
+    }
+    for (uint32_t l = 0; l < leaves.GetN(); ++l)
+    {
+        for (uint32_t s = 0; s < spines.GetN(); ++s)
+        {
+            spineLinks[s].Add(p2p.Install(leaves.Get(l), spines.Get(s)).Get(1));
+        }
+    }
+
+    SwitchHelper switchHelper;
+    auto switches = switchHelper.Install(NodeContainer(leaves, spines));
+    SwitchHelper::PopulateForwardingTables();
+    SwitchHelper::SetHostDefaultRoutes(hosts);
+
+    auto leaf0 = DynamicCast<SwitchNetDevice>(switches.Get(0));
+    NS_TEST_EXPECT_MSG_EQ(leaf0->GetNSwitchPorts(), 4, "Unexpected number of ports");
+    NS_TEST_EXPECT_MSG_EQ(leaf0->GetForwardingTable().GetIpv4Ports(Ipv4Address("10.0.2.1")).size(),
+                          2,
+                          "Remote hosts should be reachable through both spines");
+    NS_TEST_EXPECT_MSG_EQ(leaf0->GetForwardingTable().GetIpv4Ports(Ipv4Address("10.0.1.1")).size(),
+                          1,
+                          "Local hosts should be reachable through a single port");
+
+    std::vector<uint32_t> spineRx(2);
+    for (uint32_t s = 0; s < spines.GetN(); ++s)
+    {
+        for (auto it = spineLinks[s].Begin(); it != spineLinks[s].End(); ++it)
+        {
+            (*it)->TraceConnectWithoutContext("MacRx",
+                                              Callback<void, Ptr<const Packet>>(
+                                                  [&spineRx, s](Ptr<const Packet>) {
+                                                      spineRx[s]++;
+                                                  }));
+        }
+    }
+
+    Receive(hosts.Get(2));
+    Receive(hosts.Get(1));
+    Simulator::Schedule(Seconds(1), [=, this]() {
+        SendPackets(hosts.Get(0), Ipv4Address("10.0.2.1"), 50, 500);
+        SendPackets(hosts.Get(3), Ipv4Address("10.0.1.1"), 50, 500);
+    });
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(m_received, 100, "Not all the packets have been received");
+    NS_TEST_EXPECT_MSG_EQ(spineRx[0] + spineRx[1], 100, "All packets should cross a spine");
+    NS_TEST_EXPECT_MSG_GT(spineRx[0], 0, "Flows should be spread over both spines");
+    NS_TEST_EXPECT_MSG_GT(spineRx[1], 0, "Flows should be spread over both spines");
+}
+
+/**
+ * @ingroup switch-test
+ * @ingroup tests
+ *
+ * @brief Check the shared buffer admission policy and ECN marking: two senders
+ * send a burst of packets to a receiver attached to a slow port.
+ */
+class SwitchBufferTest : public SwitchNetworkTestBase
+{
+  public:
+    /**
+     * Constructor
+     * @param bufferSize the size of the shared buffer
+     * @param ecnThreshold the ECN marking threshold
+     */
+    SwitchBufferTest(uint32_t bufferSize, uint32_t ecnThreshold);
+
+  private:
+    void DoRun() override;
+
+    uint32_t m_bufferSize;   //!< size of the shared buffer
+    uint32_t m_ecnThreshold; //!< ECN marking threshold
+};
+
+SwitchBufferTest::SwitchBufferTest(uint32_t bufferSize, uint32_t ecnThreshold)
+    : SwitchNetworkTestBase("Check the shared buffer with BufferSize=" +
+                            std::to_string(bufferSize) +
+                            " EcnThreshold=" + std::to_string(ecnThreshold)),
+      m_bufferSize(bufferSize),
+      m_ecnThreshold(ecnThreshold)
+{
+}
+
+void
+SwitchBufferTest::DoRun()
+{
+    NodeContainer hosts(3);
+    NodeContainer sw(1);
+
+    InternetStackHelper internet;
+    internet.Install(hosts);
+
+    PointToPointHelper p2p;
+    p2p.SetChannelAttribute("Delay", StringValue("1us"));
+    Ipv4AddressHelper address("10.0.0.0", "255.255.255.0");
+    NetDeviceContainer ports;
+
+    for (uint32_t h = 0; h < hosts.GetN(); ++h)
+    {
+        // the last host is attached to a slow port
+        p2p.SetDeviceAttribute("DataRate", StringValue(h < 2 ? "1Gbps" : "10Mbps"));
+        auto devices = p2p.Install(hosts.Get(h), sw.Get(0));
+        address.Assign(NetDeviceContainer(devices.Get(0)));
+        address.NewNetwork();
+        ports.Add(devices.Get(1));
+    }
+
+    SwitchHelper switchHelper;
+    switchHelper.SetDeviceAttribute("BufferSize", UintegerValue(m_bufferSize));
+    switchHelper.SetDeviceAttribute("EcnThreshold", UintegerValue(m_ecnThreshold));
+    auto dev = DynamicCast<SwitchNetDevice>(switchHelper.Install(sw.Get(0), ports).Get(0));
+    SwitchHelper::PopulateForwardingTables();
+    SwitchHelper::SetHostDefaultRoutes(hosts);
+
+    uint32_t drops = 0;
+    uint32_t marks = 0;
+    uint32_t maxOccupancy = 0;
+    dev->TraceConnectWithoutContext("Drop",
+                                    Callback<void, Ptr<const Packet>>(
+                                        [&drops](Ptr<const Packet>) { drops++; }));
+    dev->TraceConnectWithoutContext("EcnMark",
+                                    Callback<void, Ptr<const Packet>>(
+                                        [&marks](Ptr<const Packet>) { marks++; }));
+    ports.Get(0)->TraceConnectWithoutContext(
+        "MacRx",
+        Callback<void, Ptr<const Packet>>([&maxOccupancy, dev](Ptr<const Packet>) {
+            maxOccupancy = std::max(maxOccupancy, dev->GetBufferOccupancy());
+        }));
+
+    const uint32_t nPackets = 100;
+    const uint32_t size = 1000;
+    Receive(hosts.Get(2));
+    Simulator::Schedule(Seconds(1), [=, this]() {
+        // ECN capable packets (ECT(0))
+        SendPackets(hosts.Get(0), Ipv4Address("10.0.2.1"), nPackets, size, 0x02);
+        SendPackets(hosts.Get(1), Ipv4Address("10.0.2.1"), nPackets, size, 0x02);
+    });
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(m_received + drops, 2 * nPackets, "Packets should be received or dropped");
+    if (m_bufferSize >= 2 * nPackets * (size + 28))
+    {
+        NS_TEST_EXPECT_MSG_EQ(drops, 0, "No packet should be dropped");
+    }
+    else
+    {
+        NS_TEST_EXPECT_MSG_GT(drops, 0, "Packets should be dropped");
+        // with alpha equal to one, a single queue cannot use more than half of the buffer
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(maxOccupancy,
+                                    m_bufferSize / 2 + size + 28,
+                                    "The dynamic threshold has not been enforced");
+    }
+    if (m_ecnThreshold == 0)
+    {
+        NS_TEST_EXPECT_MSG_EQ(marks, 0, "No packet should be marked");
+    }
+    else
+    {
+        NS_TEST_EXPECT_MSG_GT(marks, 0, "Packets should be marked");
+        NS_TEST_EXPECT_MSG_LT(marks, m_received, "Not all the packets should be marked");
+    }
+}
+
+/**
+ * @ingroup switch-test
+ * @ingroup tests
+ *
+ * @brief Check that packets forwarded by a chain of switches are received
+ * when IPv4 checksums are enabled, i.e., that the switches keep the checksum
+ * valid when decrementing the TTL.
+ */
+class SwitchChecksumTest : public SwitchNetworkTestBase
+{
+  public:
+    SwitchChecksumTest();
+
+  private:
+    void DoRun() override;
+};
+
+SwitchChecksumTest::SwitchChecksumTest()
+    : SwitchNetworkTestBase("Check forwarding with IPv4 checksums enabled")
+{
+}
+
+void
+SwitchChecksumTest::DoRun()
+{
+    GlobalValue::Bind("ChecksumEnabled", BooleanValue(true));
+
+    NodeContainer hosts(2);
+    NodeContainer switchNodes(2);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("10Gbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("1us"));
+
+    InternetStackHelper internet;
+    internet.Install(hosts);
+
+    Ipv4AddressHelper address("10.0.0.0", "255.255.255.0");
+    for (uint32_t h = 0; h < hosts.GetN(); ++h)
+    {
+        auto devices = p2p.Install(hosts.Get(h), switchNodes.Get(h));
+        address.Assign(NetDeviceContainer(devices.Get(0)));
+        address.NewNetwork();
+    }
+    p2p.Install(switchNodes.Get(0), switchNodes.Get(1));
+
+    SwitchHelper switchHelper;
+    switchHelper.Install(switchNodes);
+    SwitchHelper::PopulateForwardingTables();
+    SwitchHelper::SetHostDefaultRoutes(hosts);
+
+    Receive(hosts.Get(1));
+    Simulator::Schedule(Seconds(1), [=, this]() {
+        SendPackets(hosts.Get(0), Ipv4Address("10.0.1.1"), 20, 500);
+    });
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    GlobalValue::Bind("ChecksumEnabled", BooleanValue(false));
+
+    NS_TEST_EXPECT_MSG_EQ(m_received, 20, "Not all the packets have been received");
+}
+
+/**
+ * @ingroup switch-test
+ * @ingroup tests
+ *
+ * @brief Switch TestSuite
+ */
+class SwitchTestSuite : public TestSuite
+{
+  public:
+    SwitchTestSuite()
+        : TestSuite("switch", Type::UNIT)
+    {
+        AddTestCase(new SwitchForwardingTableTest(), TestCase::Duration::QUICK);
+        AddTestCase(new SwitchLeafSpineTest(), TestCase::Duration::QUICK);
+        AddTestCase(new SwitchChecksumTest(), TestCase::Duration::QUICK);
+        AddTestCase(new SwitchBufferTest(1000000, 0), TestCase::Duration::QUICK);
+        AddTestCase(new SwitchBufferTest(20000, 0), TestCase::Duration::QUICK);
+        AddTestCase(new SwitchBufferTest(1000000, 10000), TestCase::Duration::QUICK);
+    }
+};
+
+static SwitchTestSuite g_switchTestSuite; //!< Static variable for test initialization
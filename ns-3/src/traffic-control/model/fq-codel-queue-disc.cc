@@ -199,12 +199,10 @@ FqCoDelQueueDisc::SetAssociativeHash(uint32_t flowHash)
 
     for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
     {
-        auto it = m_flowsIndices.find(i);
+        uint32_t index = m_flowsIndices[i];
 
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqCoDelFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
-                FqCoDelFlow::INACTIVE)
+        if (index == NO_FLOW || m_tags[i] == flowHash ||
+            StaticCast<FqCoDelFlow>(GetQueueDiscClass(index))->GetStatus() == FqCoDelFlow::INACTIVE)
         {
             // this queue has not been created yet or is associated with this flow
             // or is inactive, hence we can use it
@@ -256,7 +254,7 @@ FqCoDelQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     }
 
     Ptr<FqCoDelFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    if (m_flowsIndices[h] == NO_FLOW)
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
         flow = m_flowFactory.Create<FqCoDelFlow>();
@@ -322,7 +320,8 @@ FqCoDelQueueDisc::DoDequeue()
                 NS_LOG_DEBUG("Increase deficit for new flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
                 flow->SetStatus(FqCoDelFlow::OLD_FLOW);
-                m_oldFlows.splice(m_oldFlows.end(), m_newFlows, m_newFlows.begin());
+                m_newFlows.pop_front();
+                m_oldFlows.push_back(flow);
             }
             else
             {
@@ -339,7 +338,8 @@ FqCoDelQueueDisc::DoDequeue()
             {
                 NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.splice(m_oldFlows.end(), m_oldFlows, m_oldFlows.begin());
+                m_oldFlows.pop_front();
+                m_oldFlows.push_back(flow);
             }
             else
             {
@@ -442,6 +442,9 @@ FqCoDelQueueDisc::InitializeParams()
 {
     NS_LOG_FUNCTION(this);
 
+    m_flowsIndices.assign(m_flows, NO_FLOW);
+    m_tags.assign(m_flows, std::nullopt);
+
     m_flowFactory.SetTypeId("ns3::FqCoDelFlow");
 
     m_queueDiscFactory.SetTypeId("ns3::CoDelQueueDisc");
@@ -459,15 +462,20 @@ FqCoDelQueueDisc::FqCoDelDrop()
     uint32_t index = 0;
     Ptr<QueueDisc> qd;
 
-    /* Queue is full! Find the fat flow and drop packet(s) from it */
-    for (uint32_t i = 0; i < GetNQueueDiscClasses(); i++)
+    /* Queue is full! Find the fat flow and drop packet(s) from it. The flows
+     * holding packets are all in the lists of new and old flows, the ties are
+     * broken in favor of the class with the lowest index */
+    for (const auto* flows : {&m_newFlows, &m_oldFlows})
     {
-        qd = GetQueueDiscClass(i)->GetQueueDisc();
-        uint32_t bytes = qd->GetNBytes();
-        if (bytes > maxBacklog)
+        for (const auto& flow : *flows)
         {
-            maxBacklog = bytes;
-            index = i;
+            uint32_t i = m_flowsIndices[flow->GetIndex()];
+            uint32_t bytes = flow->GetQueueDisc()->GetNBytes();
+            if (bytes > maxBacklog || (bytes > 0 && bytes == maxBacklog && i < index))
+            {
+                maxBacklog = bytes;
+                index = i;
+            }
         }
     }
 
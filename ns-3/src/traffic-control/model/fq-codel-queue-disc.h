@@ -13,9 +13,11 @@
 #include "queue-disc.h"
 
 #include "ns3/object-factory.h"
+#include "ns3/ring-buffer.h"
 
-#include <list>
-#include <map>
+#include <limits>
+#include <optional>
+#include <vector>
 
 namespace ns3
 {
@@ -169,11 +171,14 @@ class FqCoDelQueueDisc : public QueueDisc
     bool m_enableSetAssociativeHash; //!< whether to enable set associative hash
     bool m_useL4s; //!< True if L4S is used (ECT1 packets are marked at CE threshold)
 
-    std::list<Ptr<FqCoDelFlow>> m_newFlows; //!< The list of new flows
-    std::list<Ptr<FqCoDelFlow>> m_oldFlows; //!< The list of old flows
+    RingBuffer<Ptr<FqCoDelFlow>> m_newFlows; //!< The list of new flows
+    RingBuffer<Ptr<FqCoDelFlow>> m_oldFlows; //!< The list of old flows
 
-    std::map<uint32_t, uint32_t> m_flowsIndices; //!< Map with the index of class for each flow
-    std::map<uint32_t, uint32_t> m_tags;         //!< Tags used by set associative hash
+    /// Value of m_flowsIndices for the flow queues that have not been created yet
+    static constexpr uint32_t NO_FLOW = std::numeric_limits<uint32_t>::max();
+
+    std::vector<uint32_t> m_flowsIndices;       //!< Index of class for each flow queue
+    std::vector<std::optional<uint32_t>> m_tags; //!< Tags used by set associative hash
 
     ObjectFactory m_flowFactory;      //!< Factory to create a new flow
     ObjectFactory m_queueDiscFactory; //!< Factory to create a new queue
@@ -254,12 +254,10 @@ FqPieQueueDisc::SetAssociativeHash(uint32_t flowHash)
 
     for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
     {
-        auto it = m_flowsIndices.find(i);
+        uint32_t index = m_flowsIndices[i];
 
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqPieFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
-                FqPieFlow::INACTIVE)
+        if (index == NO_FLOW || m_tags[i] == flowHash ||
+            StaticCast<FqPieFlow>(GetQueueDiscClass(index))->GetStatus() == FqPieFlow::INACTIVE)
         {
             // this queue has not been created yet or is associated with this flow
             // or is inactive, hence we can use it
@@ -311,7 +309,7 @@ FqPieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     }
 
     Ptr<FqPieFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    if (m_flowsIndices[h] == NO_FLOW)
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
         flow = m_flowFactory.Create<FqPieFlow>();
@@ -395,8 +393,8 @@ FqPieQueueDisc::DoDequeue()
             {
                 NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.push_back(flow);
                 m_oldFlows.pop_front();
+                m_oldFlows.push_back(flow);
             }
             else
             {
@@ -499,6 +497,9 @@ FqPieQueueDisc::InitializeParams()
 {
     NS_LOG_FUNCTION(this);
 
+    m_flowsIndices.assign(m_flows, NO_FLOW);
+    m_tags.assign(m_flows, std::nullopt);
+
     m_flowFactory.SetTypeId("ns3::FqPieFlow");
 
     m_queueDiscFactory.SetTypeId("ns3::PieQueueDisc");
@@ -525,15 +526,20 @@ FqPieQueueDisc::FqPieDrop()
     uint32_t index = 0;
     Ptr<QueueDisc> qd;
 
-    /* Queue is full! Find the fat flow and drop packet(s) from it */
-    for (uint32_t i = 0; i < GetNQueueDiscClasses(); i++)
+    /* Queue is full! Find the fat flow and drop packet(s) from it. The flows
+     * holding packets are all in the lists of new and old flows, the ties are
+     * broken in favor of the class with the lowest index */
+    for (const auto* flows : {&m_newFlows, &m_oldFlows})
     {
-        qd = GetQueueDiscClass(i)->GetQueueDisc();
-        uint32_t bytes = qd->GetNBytes();
-        if (bytes > maxBacklog)
+        for (const auto& flow : *flows)
         {
-            maxBacklog = bytes;
-            index = i;
+            uint32_t i = m_flowsIndices[flow->GetIndex()];
+            uint32_t bytes = flow->GetQueueDisc()->GetNBytes();
+            if (bytes > maxBacklog || (bytes > 0 && bytes == maxBacklog && i < index))
+            {
+                maxBacklog = bytes;
+                index = i;
+            }
         }
     }
 
@@ -0,0 +1,320 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/fq-cobalt-queue-disc.h"
+#include "ns3/fq-codel-queue-disc.h"
+#include "ns3/fq-pie-queue-disc.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+using namespace ns3;
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Flow queue disc test item, whose hash is the identifier of its flow
+ */
+class FqQueueDiscTestItem : public QueueDiscItem
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param p the packet
+     * @param flow the identifier of the flow
+     */
+    FqQueueDiscTestItem(Ptr<Packet> p, uint32_t flow);
+
+    // Delete default constructor, copy constructor and assignment operator to avoid misuse
+    FqQueueDiscTestItem() = delete;
+    FqQueueDiscTestItem(const FqQueueDiscTestItem&) = delete;
+    FqQueueDiscTestItem& operator=(const FqQueueDiscTestItem&) = delete;
+
+    void AddHeader() override;
+    bool Mark() override;
+    uint32_t Hash(uint32_t perturbation) const override;
+
+  private:
+    uint32_t m_flow; //!< the identifier of the flow
+};
+
+FqQueueDiscTestItem::FqQueueDiscTestItem(Ptr<Packet> p, uint32_t flow)
+    : QueueDiscItem(p, Address(), 0),
+      m_flow(flow)
+{
+}
+
+void
+FqQueueDiscTestItem::AddHeader()
+{
+}
+
+bool
+FqQueueDiscTestItem::Mark()
+{
+    return false;
+}
+
+uint32_t
+FqQueueDiscTestItem::Hash(uint32_t perturbation) const
+{
+    return m_flow;
+}
+
+/**
+ * Create a flow queue disc.
+ *
+ * @tparam QueueDiscType the flow queue disc type (FqCoDelQueueDisc, FqPieQueueDisc or
+ *         FqCobaltQueueDisc)
+ * @param quantum the quantum of the queue disc
+ * @return the queue disc
+ */
+template <typename QueueDiscType>
+Ptr<QueueDisc>
+CreateFqQueueDisc(uint32_t quantum)
+{
+    Ptr<QueueDiscType> queue = CreateObject<QueueDiscType>();
+    queue->SetQuantum(quantum);
+    return queue;
+}
+
+/// Function creating a flow queue disc with the given quantum
+typedef Ptr<QueueDisc> (*FqQueueDiscCreator)(uint32_t quantum);
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Base class of the flow queue disc tests
+ */
+class FqQueueDiscTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param name the name of the test
+     * @param create the function creating the queue disc
+     */
+    FqQueueDiscTestCase(std::string name, FqQueueDiscCreator create)
+        : TestCase(create(1)->GetInstanceTypeId().GetName() + ": " + name),
+          m_create(create)
+    {
+    }
+
+  protected:
+    /**
+     * Create and initialize a queue disc.
+     *
+     * @param maxPackets the maximum number of packets of the queue disc
+     * @param flows the number of flow queues
+     * @param setAssociativeHash whether to enable set associative hash
+     * @return the queue disc
+     */
+    Ptr<QueueDisc> CreateQueueDisc(uint32_t maxPackets, uint32_t flows, bool setAssociativeHash)
+    {
+        Ptr<QueueDisc> queue = m_create(m_pktSize);
+        queue->SetAttribute("MaxSize",
+                            QueueSizeValue(QueueSize(QueueSizeUnit::PACKETS, maxPackets)));
+        queue->SetAttribute("Flows", UintegerValue(flows));
+        queue->SetAttribute("DropBatchSize", UintegerValue(1));
+        queue->SetAttribute("EnableSetAssociativeHash", BooleanValue(setAssociativeHash));
+        queue->SetAttribute("SetWays", UintegerValue(4));
+        queue->Initialize();
+        return queue;
+    }
+
+    /**
+     * Enqueue a packet.
+     *
+     * @param queue the queue disc
+     * @param flow the identifier of the flow of the packet
+     */
+    void Enqueue(Ptr<QueueDisc> queue, uint32_t flow)
+    {
+        queue->Enqueue(Create<FqQueueDiscTestItem>(Create<Packet>(m_pktSize), flow));
+    }
+
+    /**
+     * Get the number of packets of a flow queue.
+     *
+     * @param queue the queue disc
+     * @param index the index of the class of the flow queue
+     * @return the number of packets of the flow queue
+     */
+    uint32_t GetNPackets(Ptr<QueueDisc> queue, std::size_t index)
+    {
+        return queue->GetQueueDiscClass(index)->GetQueueDisc()->GetNPackets();
+    }
+
+    const uint32_t m_pktSize{100}; //!< the size of the packets
+
+  private:
+    FqQueueDiscCreator m_create; //!< the function creating the queue disc
+};
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Check the packets dropped from the fat flow when the queue disc overflows
+ */
+class FqQueueDiscOverflowTest : public FqQueueDiscTestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param create the function creating the queue disc
+     */
+    FqQueueDiscOverflowTest(FqQueueDiscCreator create)
+        : FqQueueDiscTestCase("drop from the fat flow on overflow", create)
+    {
+    }
+
+  private:
+    void DoRun() override;
+};
+
+void
+FqQueueDiscOverflowTest::DoRun()
+{
+    Ptr<QueueDisc> queue = CreateQueueDisc(4, 4, false);
+
+    for (uint32_t flow : {0, 0, 0, 1, 1})
+    {
+        Enqueue(queue, flow);
+    }
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNPackets(), 4, "A packet should have been dropped");
+    NS_TEST_EXPECT_MSG_EQ(GetNPackets(queue, 0), 2, "The fat flow lost no packet");
+    NS_TEST_EXPECT_MSG_EQ(GetNPackets(queue, 1), 2, "The other flow lost a packet");
+
+    // the two fattest flows have the same size, the first one loses a packet
+    Enqueue(queue, 2);
+    NS_TEST_EXPECT_MSG_EQ(GetNPackets(queue, 0), 1, "The first fat flow lost no packet");
+    NS_TEST_EXPECT_MSG_EQ(GetNPackets(queue, 1), 2, "The second fat flow lost a packet");
+    NS_TEST_EXPECT_MSG_EQ(GetNPackets(queue, 2), 1, "The new flow lost a packet");
+    NS_TEST_EXPECT_MSG_EQ(queue->GetStats().nTotalDroppedPackets, 2, "Wrong number of drops");
+
+    queue->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Check that the flows are served in round robin
+ */
+class FqQueueDiscRoundRobinTest : public FqQueueDiscTestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param create the function creating the queue disc
+     */
+    FqQueueDiscRoundRobinTest(FqQueueDiscCreator create)
+        : FqQueueDiscTestCase("deficit round robin", create)
+    {
+    }
+
+  private:
+    void DoRun() override;
+};
+
+void
+FqQueueDiscRoundRobinTest::DoRun()
+{
+    Ptr<QueueDisc> queue = CreateQueueDisc(100, 4, false);
+
+    for (uint32_t flow : {1, 1, 1, 2, 2, 2})
+    {
+        Enqueue(queue, flow);
+    }
+    for (uint32_t flow : {1, 2, 1, 2, 1, 2})
+    {
+        Ptr<QueueDiscItem> item = queue->Dequeue();
+        NS_TEST_ASSERT_MSG_NE(item, nullptr, "A packet should have been dequeued");
+        NS_TEST_EXPECT_MSG_EQ(item->Hash(0), flow, "The packet belongs to the wrong flow");
+    }
+    NS_TEST_EXPECT_MSG_EQ(queue->Dequeue(), nullptr, "The queue disc should be empty");
+
+    // the flows are inactive again, they are reused
+    Enqueue(queue, 2);
+    Enqueue(queue, 1);
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNQueueDiscClasses(), 2, "No flow queue should be created");
+    NS_TEST_EXPECT_MSG_EQ(queue->Dequeue()->Hash(0), 2, "The packet belongs to the wrong flow");
+    NS_TEST_EXPECT_MSG_EQ(queue->Dequeue()->Hash(0), 1, "The packet belongs to the wrong flow");
+
+    queue->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Check that the set associative hash separates the colliding flows
+ */
+class FqQueueDiscSetAssociativeHashTest : public FqQueueDiscTestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param create the function creating the queue disc
+     */
+    FqQueueDiscSetAssociativeHashTest(FqQueueDiscCreator create)
+        : FqQueueDiscTestCase("set associative hash", create)
+    {
+    }
+
+  private:
+    void DoRun() override;
+};
+
+void
+FqQueueDiscSetAssociativeHashTest::DoRun()
+{
+    // flows 1 and 9 collide in queue 1
+    Ptr<QueueDisc> queue = CreateQueueDisc(100, 8, false);
+    Enqueue(queue, 1);
+    Enqueue(queue, 9);
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNQueueDiscClasses(), 1, "The flows should collide");
+    queue->Dispose();
+
+    // with set associative hash, they use the first free queues of the set
+    queue = CreateQueueDisc(100, 8, true);
+    Enqueue(queue, 1);
+    Enqueue(queue, 9);
+    Enqueue(queue, 1);
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNQueueDiscClasses(), 2, "The flows should not collide");
+    NS_TEST_EXPECT_MSG_EQ(GetNPackets(queue, 0), 2, "Wrong size of the first flow");
+    NS_TEST_EXPECT_MSG_EQ(GetNPackets(queue, 1), 1, "Wrong size of the second flow");
+    queue->Dispose();
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Flow queue discs (FqCoDel, FqPie, FqCobalt) Test Suite
+ */
+static class FqQueueDiscTestSuite : public TestSuite
+{
+  public:
+    FqQueueDiscTestSuite()
+        : TestSuite("fq-queue-disc", Type::UNIT)
+    {
+        for (FqQueueDiscCreator create : {&CreateFqQueueDisc<FqCoDelQueueDisc>,
+                                          &CreateFqQueueDisc<FqPieQueueDisc>,
+                                          &CreateFqQueueDisc<FqCobaltQueueDisc>})
+        {
+            AddTestCase(new FqQueueDiscOverflowTest(create), TestCase::Duration::QUICK);
+            AddTestCase(new FqQueueDiscRoundRobinTest(create), TestCase::Duration::QUICK);
+            AddTestCase(new FqQueueDiscSetAssociativeHashTest(create), TestCase::Duration::QUICK);
+        }
+    }
+} g_fqQueueDiscTestSuite; ///< the test suite
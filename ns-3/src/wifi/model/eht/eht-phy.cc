@@ -212,6 +212,13 @@ EhtPhy::DoEndReceiveField(WifiPpduField field, Ptr<Event> event)
     }
 }
 
+bool
+EhtPhy::IsFieldEndObservable(WifiPpduField field) const
+{
+    // U-SIG is processed like SIG-A and EHT-SIG is processed like SIG-B
+    return field == WIFI_PPDU_FIELD_U_SIG || field == WIFI_PPDU_FIELD_EHT_SIG;
+}
+
 PhyEntity::PhyFieldRxStatus
 EhtPhy::ProcessSig(Ptr<Event> event, PhyFieldRxStatus status, WifiPpduField field)
 {
@@ -247,6 +247,7 @@ class EhtPhy : public HePhy
     void BuildModeList() override;
     WifiMode GetSigMode(WifiPpduField field, const WifiTxVector& txVector) const override;
     PhyFieldRxStatus DoEndReceiveField(WifiPpduField field, Ptr<Event> event) override;
+    bool IsFieldEndObservable(WifiPpduField field) const override;
     PhyFieldRxStatus ProcessSig(Ptr<Event> event,
                                 PhyFieldRxStatus status,
                                 WifiPpduField field) override;
@@ -0,0 +1,85 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "error-rate-lookup-table.h"
+
+#include "wifi-utils.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ErrorRateLookupTable");
+
+ErrorRateLookupTable::ErrorRateLookupTable(const ErrorProbabilityFunction& function,
+                                           dB_u minSnr,
+                                           dB_u maxSnr,
+                                           dB_u step)
+    : m_minSnr(minSnr),
+      m_step(step)
+{
+    NS_LOG_FUNCTION(this << minSnr << maxSnr << step);
+    NS_ASSERT(step > 0 && maxSnr > minSnr);
+    const auto nBins = static_cast<std::size_t>(std::lround((maxSnr - minSnr) / step));
+    m_logErrors.reserve(nBins + 1);
+    for (std::size_t i = 0; i <= nBins; ++i)
+    {
+        m_logErrors.push_back(std::log(function(DbToRatio(minSnr + i * step))));
+    }
+
+    m_bins.reserve(nBins);
+    std::size_t nExact = 0;
+    for (std::size_t i = 0; i < nBins; ++i)
+    {
+        const auto exact = function(DbToRatio(minSnr + (i + 0.5) * step));
+        const auto lower = m_logErrors[i];
+        const auto upper = m_logErrors[i + 1];
+        auto bin = Bin::EXACT;
+        if (std::isinf(lower) && std::isinf(upper))
+        {
+            // the error probability is zero at both bounds of the bin
+            bin = (exact == 0.0) ? Bin::ZERO : Bin::EXACT;
+        }
+        else if (std::isfinite(lower) && std::isfinite(upper))
+        {
+            const auto interpolated = std::exp((lower + upper) / 2);
+            const auto tolerance = std::max(RELATIVE_TOLERANCE * exact, ABSOLUTE_TOLERANCE);
+            bin = (std::abs(interpolated - exact) <= tolerance) ? Bin::INTERPOLATED : Bin::EXACT;
+        }
+        nExact += (bin == Bin::EXACT) ? 1 : 0;
+        m_bins.push_back(bin);
+    }
+    NS_LOG_DEBUG(nExact << " out of " << nBins << " bins require the exact computation");
+}
+
+std::optional<double>
+ErrorRateLookupTable::GetErrorProbability(double snr) const
+{
+    if (snr <= 0)
+    {
+        return std::nullopt;
+    }
+    const auto position = (RatioToDb(snr) - m_minSnr) / m_step;
+    if (!(position >= 0) || position >= m_bins.size())
+    {
+        return std::nullopt;
+    }
+    const auto i = static_cast<std::size_t>(position);
+    switch (m_bins[i])
+    {
+    case Bin::INTERPOLATED:
+        return std::exp(m_logErrors[i] + (position - i) * (m_logErrors[i + 1] - m_logErrors[i]));
+    case Bin::ZERO:
+        return 0.0;
+    case Bin::EXACT:
+    default:
+        return std::nullopt;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,80 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef ERROR_RATE_LOOKUP_TABLE_H
+#define ERROR_RATE_LOOKUP_TABLE_H
+
+#include "wifi-units.h"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup wifi
+ * @brief Lookup table of an error probability as a function of the SNR.
+ *
+ * The table samples the error probability (typically, the probability of a decoding error
+ * event per bit, from which the success rate of a chunk of any size can be derived) on a
+ * uniform grid of SNR values in dB, and interpolates linearly the logarithm of the error
+ * probability between two consecutive samples. When the table is built, the interpolated
+ * value at the middle of every bin is compared against the exact value: the bins for which
+ * the interpolation error exceeds the tolerance (and the SNR values outside the range of
+ * the table) are not served by the table, and the caller shall then compute the exact value.
+ */
+class ErrorRateLookupTable
+{
+  public:
+    /// Function returning the error probability for a given SNR (linear scale)
+    using ErrorProbabilityFunction = std::function<double(double)>;
+
+    /**
+     * Build the table by sampling the given function. The function is not used after
+     * the table is built.
+     *
+     * @param function the function returning the error probability for a given SNR
+     * @param minSnr the smallest SNR of the table
+     * @param maxSnr the largest SNR of the table
+     * @param step the distance between two consecutive samples
+     */
+    ErrorRateLookupTable(const ErrorProbabilityFunction& function,
+                         dB_u minSnr,
+                         dB_u maxSnr,
+                         dB_u step);
+
+    /**
+     * @param snr the SNR (linear scale)
+     * @return the error probability for the given SNR, unless the SNR is outside the range
+     *         of the table or in a bin for which the interpolation is not accurate enough
+     */
+    std::optional<double> GetErrorProbability(double snr) const;
+
+    /// Maximum relative error of the interpolated error probabilities
+    static constexpr double RELATIVE_TOLERANCE = 1e-4;
+    /// Maximum absolute error of the interpolated error probabilities, when smaller than the
+    /// relative one
+    static constexpr double ABSOLUTE_TOLERANCE = 1e-15;
+
+  private:
+    /// How the error probability is obtained within a bin
+    enum class Bin : uint8_t
+    {
+        INTERPOLATED = 0, //!< interpolated between the samples at the bounds of the bin
+        ZERO,             //!< the error probability is zero over the bin
+        EXACT             //!< the exact value has to be computed
+    };
+
+    dB_u m_minSnr;                   //!< the smallest SNR of the table
+    dB_u m_step;                     //!< the distance between two consecutive samples
+    std::vector<double> m_logErrors; //!< natural logarithm of the sampled error probabilities
+    std::vector<Bin> m_bins;         //!< how the error probability is obtained in every bin
+};
+
+} // namespace ns3
+
+#endif /* ERROR_RATE_LOOKUP_TABLE_H */
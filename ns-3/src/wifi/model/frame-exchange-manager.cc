@@ -652,10 +652,25 @@ void
 FrameExchangeManager::DequeueMpdu(Ptr<const WifiMpdu> mpdu)
 {
     NS_LOG_DEBUG(this << *mpdu);
+    DequeueMpdus({mpdu});
+}
 
-    if (mpdu->IsQueued())
+void
+FrameExchangeManager::DequeueMpdus(const std::list<Ptr<const WifiMpdu>>& mpdus)
+{
+    NS_LOG_FUNCTION(this << mpdus.size());
+
+    std::map<AcIndex, std::list<Ptr<const WifiMpdu>>> queuedMpdus;
+    for (const auto& mpdu : mpdus)
+    {
+        if (mpdu->IsQueued())
+        {
+            queuedMpdus[mpdu->GetQueueAc()].push_back(mpdu);
+        }
+    }
+    for (const auto& [ac, acMpdus] : queuedMpdus)
     {
-        m_mac->GetTxopQueue(mpdu->GetQueueAc())->DequeueIfQueued({mpdu});
+        m_mac->GetTxopQueue(ac)->DequeueIfQueued(acMpdus);
     }
 }
 
@@ -565,11 +565,23 @@ class FrameExchangeManager : public Object
     virtual void ForwardMpduDown(Ptr<WifiMpdu> mpdu, WifiTxVector& txVector);
 
     /**
-     * Dequeue the given MPDU from the queue in which it is stored.
+     * Dequeue the given MPDU from the queue in which it is stored. This is equivalent to
+     * calling DequeueMpdus with a list containing the given MPDU only.
      *
      * @param mpdu the given MPDU
      */
-    virtual void DequeueMpdu(Ptr<const WifiMpdu> mpdu);
+    void DequeueMpdu(Ptr<const WifiMpdu> mpdu);
+
+    /**
+     * Dequeue the given MPDUs from the queues in which they are stored. The MPDUs that
+     * are not queued are ignored. The MPDUs stored in the same queue are dequeued at once,
+     * so that the queue and the scheduler are updated only once per Access Category.
+     * Subclasses that need to act upon the dequeue of MPDUs shall override this method,
+     * which is called whenever MPDUs are dequeued by a frame exchange manager.
+     *
+     * @param mpdus the given MPDUs
+     */
+    virtual void DequeueMpdus(const std::list<Ptr<const WifiMpdu>>& mpdus);
 
     /**
      * Compute how to set the Duration/ID field of a frame being transmitted with
@@ -426,6 +426,7 @@ HePhy::DoAbortCurrentReception(WifiPhyRxfailureReason reason)
             endMpduEvent.Cancel();
         }
         m_endOfMpduEvents.clear();
+        m_pendingMpdus.clear();
     }
     else
     {
@@ -741,6 +742,14 @@ HePhy::ProcessSigB(Ptr<Event> event, PhyFieldRxStatus status)
     return status;
 }
 
+bool
+HePhy::IsFieldEndObservable(WifiPpduField field) const
+{
+    // the end of SIG-A is notified (e.g., to the OBSS PD algorithm) and the PPDU may be
+    // filtered based on the content of SIG-A
+    return field == WIFI_PPDU_FIELD_SIG_A;
+}
+
 bool
 HePhy::IsConfigSupported(Ptr<const WifiPpdu> ppdu) const
 {
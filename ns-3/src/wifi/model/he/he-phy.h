@@ -458,6 +458,7 @@ class HePhy : public VhtPhy
                                 WifiPpduField field) override;
     Ptr<Event> DoGetEvent(Ptr<const WifiPpdu> ppdu, RxPowerWattPerChannelBand& rxPowersW) override;
     bool IsConfigSupported(Ptr<const WifiPpdu> ppdu) const override;
+    bool IsFieldEndObservable(WifiPpduField field) const override;
     Time DoStartReceivePayload(Ptr<Event> event) override;
     std::pair<MHz_u, WifiSpectrumBandInfo> GetChannelWidthAndBand(const WifiTxVector& txVector,
                                                                   uint16_t staId) const override;
@@ -26,6 +26,8 @@
 #include "ns3/wifi-utils.h"
 
 #include <array>
+#include <list>
+#include <map>
 #include <optional>
 
 #undef NS_LOG_APPEND_CONTEXT
@@ -1355,10 +1357,7 @@ void
 HtFrameExchangeManager::DequeuePsdu(Ptr<const WifiPsdu> psdu)
 {
     NS_LOG_FUNCTION(this << *psdu);
-    for (const auto& mpdu : *PeekPointer(psdu))
-    {
-        DequeueMpdu(mpdu);
-    }
+    DequeueMpdus({psdu->begin(), psdu->end()});
 }
 
 void
@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <numeric>
+#include <optional>
 
 namespace ns3
 {
@@ -183,10 +184,6 @@ void
 InterferenceHelper::DoDispose()
 {
     NS_LOG_FUNCTION(this);
-    for (auto it : m_niChanges)
-    {
-        it.second.clear();
-    }
     m_niChanges.clear();
     m_firstPowers.clear();
     m_errorRateModel = nullptr;
@@ -368,10 +365,14 @@ InterferenceHelper::AppendEvent(Ptr<Event> event,
             // HE TB PPDU transmission and the start of HE TB payload.
             m_firstPowers.find(band)->second = previousPowerStart;
         }
-        auto first =
+        // the NI change at the end of the event is inserted after the one at the start, hence
+        // the index of the latter is still valid after the insertion (unlike iterators)
+        const auto start =
             AddNiChangeEvent(event->GetStartTime(), NiChange(previousPowerStart, event), niIt);
-        auto last = AddNiChangeEvent(event->GetEndTime(), NiChange(previousPowerEnd, event), niIt);
-        for (auto i = first; i != last; ++i)
+        const auto first = std::distance(niIt->second.begin(), start);
+        const auto last =
+            AddNiChangeEvent(event->GetEndTime(), NiChange(previousPowerEnd, event), niIt);
+        for (auto i = niIt->second.begin() + first; i != last; ++i)
         {
             i->second.AddPower(power);
         }
@@ -431,7 +432,7 @@ InterferenceHelper::CalculateSnr(Watt_u signal,
 
 Watt_u
 InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
-                                                NiChangesPerBand& nis,
+                                                NiChangesView& nis,
                                                 const WifiSpectrumBandInfo& band) const
 {
     NS_LOG_FUNCTION(this << band);
@@ -440,12 +441,19 @@ InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
     auto noiseInterference = firstPower_it->second;
     auto niIt = m_niChanges.find(band);
     NS_ABORT_IF(niIt == m_niChanges.end());
+    const auto& niChanges = niIt->second;
     const auto now = Simulator::Now();
-    auto it = niIt->second.find(event->GetStartTime());
+    const auto start = std::lower_bound(
+        niChanges.cbegin(),
+        niChanges.cend(),
+        event->GetStartTime(),
+        [](const auto& niChange, Time time) { return niChange.first < time; });
+    NS_ABORT_IF(start == niChanges.cend() || start->first != event->GetStartTime());
     const auto muMimoPower = (event->GetPpdu()->GetType() == WIFI_PPDU_TYPE_UL_MU)
                                  ? CalculateMuMimoPowerW(event, band)
                                  : Watt_u{0.0};
-    for (; it != niIt->second.end() && it->first < now; ++it)
+    const auto rxPower = event->GetRxPower(band);
+    for (auto it = start; it != niChanges.cend() && it->first < now; ++it)
     {
         if (IsSameMuMimoTransmission(event, it->second.GetEvent()) &&
             (event != it->second.GetEvent()))
@@ -454,26 +462,27 @@ InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
             // unless this is the same event
             continue;
         }
-        noiseInterference = it->second.GetPower() - event->GetRxPower(band) - muMimoPower;
+        noiseInterference = it->second.GetPower() - rxPower - muMimoPower;
         if (std::abs(noiseInterference) < std::numeric_limits<double>::epsilon())
         {
             // fix some possible rounding issues with double values
             noiseInterference = Watt_u{0.0};
         }
     }
-    it = niIt->second.find(event->GetStartTime());
-    NS_ABORT_IF(it == niIt->second.end());
-    for (; it != niIt->second.end() && it->second.GetEvent() != event; ++it)
+    // the NI changes of the event span from its start NI change to its end NI change
+    auto first = start;
+    while (first != niChanges.cend() && first->second.GetEvent() != event)
     {
-        ;
+        ++first;
     }
-    auto& ni = nis[band];
-    ni.emplace(event->GetStartTime(), NiChange(Watt_u{0}, event));
-    while (++it != niIt->second.end() && it->second.GetEvent() != event)
+    NS_ABORT_IF(first == niChanges.cend());
+    auto last = std::next(first);
+    while (last != niChanges.cend() && last->second.GetEvent() != event)
     {
-        ni.insert(*it);
+        ++last;
     }
-    ni.emplace(event->GetEndTime(), NiChange(Watt_u{0}, event));
+    NS_ABORT_IF(last == niChanges.cend());
+    nis = NiChangesView(first, std::next(last));
     NS_ASSERT_MSG(noiseInterference >= Watt_u{0.0},
                   "CalculateNoiseInterferenceW returns negative value " << noiseInterference);
     return noiseInterference;
@@ -492,7 +501,7 @@ InterferenceHelper::CalculateMuMimoPowerW(Ptr<const Event> event,
     {
         if (IsSameMuMimoTransmission(event, it->second.GetEvent()))
         {
-            auto hePpdu = DynamicCast<HePpdu>(it->second.GetEvent()->GetPpdu()->Copy());
+            auto hePpdu = DynamicCast<const HePpdu>(it->second.GetEvent()->GetPpdu());
             NS_ASSERT(hePpdu);
             HePpdu::TxPsdFlag psdFlag = hePpdu->GetTxPsdFlag();
             if (psdFlag == HePpdu::PSD_HE_PORTION)
@@ -562,25 +571,25 @@ InterferenceHelper::CalculatePayloadChunkSuccessRate(double snir,
 double
 InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
                                         MHz_u channelWidth,
-                                        NiChangesPerBand* nis,
+                                        NiChangesView nis,
                                         const WifiSpectrumBandInfo& band,
                                         uint16_t staId,
                                         std::pair<Time, Time> window) const
 {
     NS_LOG_FUNCTION(this << channelWidth << band << staId << window.first << window.second);
     double psr = 1.0; /* Packet Success Rate */
-    const auto& niIt = nis->find(band)->second;
-    auto j = niIt.cbegin();
+    auto j = nis.begin();
     auto previous = j->first;
     Watt_u muMimoPower{0.0};
-    const auto payloadMode = event->GetPpdu()->GetTxVector().GetMode(staId);
+    const auto& txVector = event->GetPpdu()->GetTxVector();
+    const auto payloadMode = txVector.GetMode(staId);
+    const auto nss = txVector.GetNss(staId);
     auto phyPayloadStart = j->first;
     if (event->GetPpdu()->GetType() != WIFI_PPDU_TYPE_UL_MU &&
         event->GetPpdu()->GetType() !=
             WIFI_PPDU_TYPE_DL_MU) // j->first corresponds to the start of the MU payload
     {
-        phyPayloadStart = j->first + WifiPhy::CalculatePhyPreambleAndHeaderDuration(
-                                         event->GetPpdu()->GetTxVector());
+        phyPayloadStart = j->first + WifiPhy::CalculatePhyPreambleAndHeaderDuration(txVector);
     }
     else
     {
@@ -591,35 +600,27 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
     NS_ABORT_IF(!m_firstPowers.contains(band));
     auto noiseInterference = m_firstPowers.at(band);
     auto power = event->GetRxPower(band);
-    while (++j != niIt.cend())
+    while (++j != nis.end())
     {
         Time current = j->first;
         NS_LOG_DEBUG("previous= " << previous << ", current=" << current);
         NS_ASSERT(current >= previous);
-        const auto snr = CalculateSnr(power,
-                                      noiseInterference,
-                                      channelWidth,
-                                      event->GetPpdu()->GetTxVector().GetNss(staId));
         // Case 1: Both previous and current point to the windowed payload
-        if (previous >= windowStart)
-        {
-            psr *= CalculatePayloadChunkSuccessRate(snr,
-                                                    Min(windowEnd, current) - previous,
-                                                    event->GetPpdu()->GetTxVector(),
-                                                    staId);
-            NS_LOG_DEBUG("Both previous and current point to the windowed payload: mode="
-                         << payloadMode << ", psr=" << psr);
-        }
         // Case 2: previous is before windowed payload and current is in the windowed payload
-        else if (current >= windowStart)
+        // The SNR of the chunks before the windowed payload is not needed
+        if (current >= windowStart)
         {
+            const auto snr = CalculateSnr(power, noiseInterference, channelWidth, nss);
+            const auto chunkStart = Max(previous, windowStart);
             psr *= CalculatePayloadChunkSuccessRate(snr,
-                                                    Min(windowEnd, current) - windowStart,
-                                                    event->GetPpdu()->GetTxVector(),
+                                                    Min(windowEnd, current) - chunkStart,
+                                                    txVector,
                                                     staId);
-            NS_LOG_DEBUG(
-                "previous is before windowed payload and current is in the windowed payload: mode="
-                << payloadMode << ", psr=" << psr);
+            NS_LOG_DEBUG((previous >= windowStart
+                              ? "Both previous and current point to the windowed payload"
+                              : "previous is before windowed payload and current is in the "
+                                "windowed payload")
+                         << ": mode=" << payloadMode << ", psr=" << psr);
         }
         noiseInterference = j->second.GetPower() - power;
         if (IsSameMuMimoTransmission(event, j->second.GetEvent()))
@@ -642,15 +643,14 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
 
 double
 InterferenceHelper::CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
-                                                 NiChangesPerBand* nis,
+                                                 NiChangesView nis,
                                                  MHz_u channelWidth,
                                                  const WifiSpectrumBandInfo& band,
-                                                 PhyHeaderSections phyHeaderSections) const
+                                                 const PhyHeaderSections& phyHeaderSections) const
 {
     NS_LOG_FUNCTION(this << band);
     double psr = 1.0; /* Packet Success Rate */
-    auto niIt = nis->find(band)->second;
-    auto j = niIt.begin();
+    auto j = nis.begin();
 
     NS_ASSERT(!phyHeaderSections.empty());
     Time stopLastSection;
@@ -663,12 +663,13 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
     NS_ABORT_IF(!m_firstPowers.contains(band));
     auto noiseInterference = m_firstPowers.at(band);
     const auto power = event->GetRxPower(band);
-    while (++j != niIt.end())
+    const auto& txVector = event->GetPpdu()->GetTxVector();
+    while (++j != nis.end())
     {
         auto current = j->first;
         NS_LOG_DEBUG("previous= " << previous << ", current=" << current);
         NS_ASSERT(current >= previous);
-        const auto snr = CalculateSnr(power, noiseInterference, channelWidth, 1);
+        std::optional<double> snr;
         for (const auto& section : phyHeaderSections)
         {
             const auto start = section.second.first.first;
@@ -679,10 +680,14 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
                 const auto duration = Min(stop, current) - Max(start, previous);
                 if (duration.IsStrictlyPositive())
                 {
-                    psr *= CalculateChunkSuccessRate(snr,
+                    if (!snr)
+                    {
+                        snr = CalculateSnr(power, noiseInterference, channelWidth, 1);
+                    }
+                    psr *= CalculateChunkSuccessRate(*snr,
                                                      duration,
                                                      section.second.second,
-                                                     event->GetPpdu()->GetTxVector(),
+                                                     txVector,
                                                      section.first);
                     NS_LOG_DEBUG("Current NI change in "
                                  << section.first << " [" << start << ", " << stop << "] for "
@@ -705,19 +710,18 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
 
 double
 InterferenceHelper::CalculatePhyHeaderPer(Ptr<const Event> event,
-                                          NiChangesPerBand* nis,
+                                          NiChangesView nis,
                                           MHz_u channelWidth,
                                           const WifiSpectrumBandInfo& band,
                                           WifiPpduField header) const
 {
     NS_LOG_FUNCTION(this << band << header);
-    auto niIt = nis->find(band)->second;
     auto phyEntity =
         WifiPhy::GetStaticPhyEntity(event->GetPpdu()->GetTxVector().GetModulationClass());
 
     PhyHeaderSections sections;
     for (const auto& section :
-         phyEntity->GetPhyHeaderSections(event->GetPpdu()->GetTxVector(), niIt.begin()->first))
+         phyEntity->GetPhyHeaderSections(event->GetPpdu()->GetTxVector(), nis.front().first))
     {
         if (section.first == header)
         {
@@ -742,7 +746,7 @@ InterferenceHelper::CalculatePayloadSnrPer(Ptr<Event> event,
 {
     NS_LOG_FUNCTION(this << channelWidth << band << staId << relativeMpduStartStop.first
                          << relativeMpduStartStop.second);
-    NiChangesPerBand ni;
+    NiChangesView ni;
     const auto noiseInterference = CalculateNoiseInterferenceW(event, ni, band);
     const auto snr = CalculateSnr(event->GetRxPower(band),
                                   noiseInterference,
@@ -753,7 +757,7 @@ InterferenceHelper::CalculatePayloadSnrPer(Ptr<Event> event,
      * all SNIR changes in the SNIR vector.
      */
     const auto per =
-        CalculatePayloadPer(event, channelWidth, &ni, band, staId, relativeMpduStartStop);
+        CalculatePayloadPer(event, channelWidth, ni, band, staId, relativeMpduStartStop);
 
     return SnrPer(snr, per);
 }
@@ -764,7 +768,7 @@ InterferenceHelper::CalculateSnr(Ptr<Event> event,
                                  uint8_t nss,
                                  const WifiSpectrumBandInfo& band) const
 {
-    NiChangesPerBand ni;
+    NiChangesView ni;
     const auto noiseInterference = CalculateNoiseInterferenceW(event, ni, band);
     return CalculateSnr(event->GetRxPower(band), noiseInterference, channelWidth, nss);
 }
@@ -776,14 +780,14 @@ InterferenceHelper::CalculatePhyHeaderSnrPer(Ptr<Event> event,
                                              WifiPpduField header) const
 {
     NS_LOG_FUNCTION(this << band << header);
-    NiChangesPerBand ni;
+    NiChangesView ni;
     const auto noiseInterference = CalculateNoiseInterferenceW(event, ni, band);
     const auto snr = CalculateSnr(event->GetRxPower(band), noiseInterference, channelWidth, 1);
 
     /* calculate the SNIR at the start of the PHY header and accumulate
      * all SNIR changes in the SNIR vector.
      */
-    const auto per = CalculatePhyHeaderPer(event, &ni, channelWidth, band, header);
+    const auto per = CalculatePhyHeaderPer(event, ni, channelWidth, band, header);
 
     return SnrPer(snr, per);
 }
@@ -791,7 +795,10 @@ InterferenceHelper::CalculatePhyHeaderSnrPer(Ptr<Event> event,
 InterferenceHelper::NiChanges::iterator
 InterferenceHelper::GetNextPosition(Time moment, NiChangesPerBand::iterator niIt) const
 {
-    return niIt->second.upper_bound(moment);
+    return std::upper_bound(niIt->second.begin(),
+                            niIt->second.end(),
+                            moment,
+                            [](Time time, const auto& niChange) { return time < niChange.first; });
 }
 
 InterferenceHelper::NiChanges::iterator
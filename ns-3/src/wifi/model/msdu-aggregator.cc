@@ -23,6 +23,9 @@
 #include "ns3/packet.h"
 
 #include <algorithm>
+#include <iterator>
+#include <list>
+#include <vector>
 
 namespace ns3
 {
@@ -142,7 +145,7 @@ MsduAggregator::GetNextAmsdu(Ptr<WifiMpdu> peekedItem,
 
     // perform A-MSDU aggregation
     auto amsdu = queue->GetOriginal(peekedItem);
-    std::size_t nMsdu = 1;
+    std::vector<Ptr<const WifiMpdu>> msdus;
     peekedItem = queue->PeekByTidAndAddress(tid, recipient, peekedItem->GetOriginal());
 
     // stop aggregation if we find an A-MSDU in the queue. This likely happens when an A-MSDU is
@@ -155,23 +158,27 @@ MsduAggregator::GetNextAmsdu(Ptr<WifiMpdu> peekedItem,
         NS_ASSERT_MSG(!peekedItem->HasSeqNoAssigned(),
                       "Found item with sequence number assignment after one without: perhaps "
                       "sequence numbers were not released correctly?");
-        // find the next MPDU before dequeuing the current one
-        auto msdu = peekedItem->GetOriginal();
-        peekedItem = queue->PeekByTidAndAddress(tid, recipient, msdu);
-        queue->DequeueIfQueued({amsdu});
-        // perform A-MSDU aggregation
-        amsdu->Aggregate(msdu);
-        queue->Replace(msdu, amsdu);
-
-        nMsdu++;
+        msdus.push_back(peekedItem->GetOriginal());
+        peekedItem = queue->PeekByTidAndAddress(tid, recipient, msdus.back());
     }
 
-    if (nMsdu == 1)
+    if (msdus.empty())
     {
         NS_LOG_DEBUG("Aggregation failed (could not aggregate at least two MSDUs)");
         return nullptr;
     }
 
+    // the first MSDU (which becomes the A-MSDU) and all the aggregated MSDUs but the last one
+    // are dequeued at once, while the A-MSDU takes the place of the last aggregated MSDU
+    std::list<Ptr<const WifiMpdu>> dequeued{amsdu};
+    dequeued.insert(dequeued.end(), msdus.cbegin(), std::prev(msdus.cend()));
+    queue->DequeueIfQueued(dequeued);
+    for (const auto& msdu : msdus)
+    {
+        amsdu->Aggregate(msdu);
+    }
+    queue->Replace(msdus.back(), amsdu);
+
     // Aggregation succeeded
     return m_htFem->CreateAliasIfNeeded(amsdu);
 }
@@ -11,10 +11,12 @@
 
 #include "wifi-tx-vector.h"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 
 #include <bitset>
 #include <cmath>
+#include <map>
 
 namespace ns3
 {
@@ -26,10 +28,19 @@ NS_OBJECT_ENSURE_REGISTERED(NistErrorRateModel);
 TypeId
 NistErrorRateModel::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::NistErrorRateModel")
-                            .SetParent<ErrorRateModel>()
-                            .SetGroupName("Wifi")
-                            .AddConstructor<NistErrorRateModel>();
+    static TypeId tid =
+        TypeId("ns3::NistErrorRateModel")
+            .SetParent<ErrorRateModel>()
+            .SetGroupName("Wifi")
+            .AddConstructor<NistErrorRateModel>()
+            .AddAttribute("UseLookupTables",
+                          "Whether to read the coded error probabilities from precomputed lookup "
+                          "tables shared by all the instances of this model, instead of computing "
+                          "them for every chunk. The interpolation error of the lookup tables is "
+                          "bounded by ErrorRateLookupTable::RELATIVE_TOLERANCE.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&NistErrorRateModel::m_useLookupTables),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -169,6 +180,32 @@ NistErrorRateModel::GetFecQamBer(uint16_t constellationSize,
     return pms;
 }
 
+const ErrorRateLookupTable&
+NistErrorRateModel::GetLookupTable(uint16_t constellationSize, uint8_t bValue) const
+{
+    // the tables are shared by all the instances of this model
+    static std::map<std::pair<uint16_t, uint8_t>, ErrorRateLookupTable> tables;
+
+    const auto key = std::make_pair(constellationSize, bValue);
+    auto it = tables.find(key);
+    if (it == tables.end())
+    {
+        NS_LOG_DEBUG("Build lookup table for " << constellationSize << "-QAM and b=" << +bValue);
+        auto pe = [this, constellationSize, bValue](double snr) {
+            const auto ber = (constellationSize == 2)   ? GetBpskBer(snr)
+                             : (constellationSize == 4) ? GetQpskBer(snr)
+                                                        : GetQamBer(constellationSize, snr);
+            return (ber == 0.0) ? 0.0 : std::min(CalculatePe(ber, bValue), 1.0);
+        };
+        it = tables
+                 .emplace(std::piecewise_construct,
+                          std::forward_as_tuple(key),
+                          std::forward_as_tuple(pe, dB_u{-10}, dB_u{50}, dB_u{0.01}))
+                 .first;
+    }
+    return it->second;
+}
+
 uint8_t
 NistErrorRateModel::GetBValue(WifiCodeRate codeRate) const
 {
@@ -202,6 +239,15 @@ NistErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
     NS_LOG_FUNCTION(this << mode << snr << nbits << +numRxAntennas << field << staId);
     if (mode.GetModulationClass() >= WIFI_MOD_CLASS_ERP_OFDM)
     {
+        if (m_useLookupTables)
+        {
+            const auto& table =
+                GetLookupTable(mode.GetConstellationSize(), GetBValue(mode.GetCodeRate()));
+            if (const auto pe = table.GetErrorProbability(snr))
+            {
+                return std::pow(1 - *pe, nbits);
+            }
+        }
         if (mode.GetConstellationSize() == 2)
         {
             return GetFecBpskBer(snr, nbits, GetBValue(mode.GetCodeRate()));
@@ -9,6 +9,7 @@
 #ifndef NIST_ERROR_RATE_MODEL_H
 #define NIST_ERROR_RATE_MODEL_H
 
+#include "error-rate-lookup-table.h"
 #include "error-rate-model.h"
 #include "wifi-mode.h"
 
@@ -22,6 +23,10 @@ namespace ns3
  * the model description and validation can be found in
  * http://www.nsnam.org/~pei/80211ofdm.pdf.  For DSSS modulations (802.11b),
  * the model uses the DsssErrorRateModel.
+ *
+ * If the UseLookupTables attribute is set, the coded error probabilities are read from
+ * lookup tables (see ErrorRateLookupTable) shared by all the instances of this model,
+ * instead of being computed for every chunk.
  */
 class NistErrorRateModel : public ErrorRateModel
 {
@@ -117,6 +122,18 @@ class NistErrorRateModel : public ErrorRateModel
                         double snr,
                         uint64_t nbits,
                         uint8_t bValue) const;
+    /**
+     * Return the lookup table of the coded error probability for the given constellation
+     * size and coding rate. The table is built upon first use.
+     *
+     * @param constellationSize the constellation size (M)
+     * @param bValue the bValue such that coding rate = bValue / (bValue + 1)
+     *
+     * @return the lookup table of the coded error probability
+     */
+    const ErrorRateLookupTable& GetLookupTable(uint16_t constellationSize, uint8_t bValue) const;
+
+    bool m_useLookupTables; //!< whether to read the coded error probabilities from lookup tables
 };
 
 } // namespace ns3
@@ -29,6 +29,7 @@
 #include "ns3/simulator.h"
 
 #include <algorithm>
+#include <cmath>
 
 #undef NS_LOG_APPEND_CONTEXT
 #define NS_LOG_APPEND_CONTEXT WIFI_PHY_NS_LOG_APPEND_CONTEXT(m_wifiPhy)
@@ -312,42 +313,121 @@ PhyEntity::EndReceiveField(WifiPpduField field, Ptr<Event> event)
     }
     else
     {
-        Ptr<const WifiPpdu> ppdu = event->GetPpdu();
-        switch (status.actionIfFailure)
+        HandleFieldRxFailure(event,
+                             status,
+                             GetRemainingDurationAfterField(event->GetPpdu(), field));
+    }
+}
+
+void
+PhyEntity::ScheduleEndReceivePhyHeaders(Ptr<Event> event, WifiPpduField field)
+{
+    NS_LOG_FUNCTION(this << *event << field);
+    NS_ASSERT(m_wifiPhy); // no sense if no owner WifiPhy instance
+    const auto& txVector = event->GetPpdu()->GetTxVector();
+    const auto preamble = txVector.GetPreambleType();
+    auto lastField = field;
+    while (!IsFieldEndObservable(lastField) &&
+           GetNextField(lastField, preamble) != WIFI_PPDU_FIELD_DATA)
+    {
+        lastField = GetNextField(lastField, preamble);
+    }
+    const auto delay = event->GetStartTime() +
+                       GetDurationUpToField(GetNextField(lastField, preamble), txVector) -
+                       Simulator::Now();
+    m_wifiPhy->NotifyCcaBusy(event->GetPpdu(), delay); // will be prolonged by next fields
+    m_wifiPhy->m_endPhyRxEvent = Simulator::Schedule(delay,
+                                                     &PhyEntity::EndReceivePhyHeaders,
+                                                     this,
+                                                     event,
+                                                     field,
+                                                     lastField);
+}
+
+void
+PhyEntity::EndReceivePhyHeaders(Ptr<Event> event,
+                                WifiPpduField firstField,
+                                WifiPpduField lastField)
+{
+    NS_LOG_FUNCTION(this << *event << firstField << lastField);
+    NS_ASSERT(m_wifiPhy); // no sense if no owner WifiPhy instance
+    NS_ASSERT(m_wifiPhy->m_endPhyRxEvent.IsExpired());
+    const auto preamble = event->GetPpdu()->GetTxVector().GetPreambleType();
+    for (auto field = firstField;; field = GetNextField(field, preamble))
+    {
+        NS_ABORT_MSG_IF(field != WIFI_PPDU_FIELD_PREAMBLE && !DoStartReceiveField(field, event),
+                        "Unknown field " << field << " for this PHY entity");
+        if (const auto status = DoEndReceiveField(field, event); !status.isSuccess)
+        {
+            HandleFieldRxFailure(event, status, event->GetEndTime() - Simulator::Now());
+            return;
+        }
+        if (field == lastField)
         {
-        case ABORT:
-            // Abort reception, but consider medium as busy
-            AbortCurrentReception(status.reason);
-            if (event->GetEndTime() > (Simulator::Now() + m_state->GetDelayUntilIdle()))
-            {
-                m_wifiPhy->SwitchMaybeToCcaBusy(ppdu);
-            }
-            break;
-        case DROP:
-            // Notify drop, keep in CCA busy, and perform same processing as IGNORE case
-            if (status.reason == FILTERED)
-            {
-                // PHY-RXSTART is immediately followed by PHY-RXEND (Filtered)
-                m_wifiPhy->m_phyRxPayloadBeginTrace(
-                    txVector,
-                    NanoSeconds(0)); // this callback (equivalent to PHY-RXSTART primitive) is also
-                                     // triggered for filtered PPDUs
-            }
-            m_wifiPhy->NotifyRxPpduDrop(ppdu, status.reason);
-            m_wifiPhy->NotifyCcaBusy(ppdu, GetRemainingDurationAfterField(ppdu, field));
-        // no break
-        case IGNORE:
-            // Keep in Rx state and reset at end
-            m_endRxPayloadEvents.push_back(
-                Simulator::Schedule(GetRemainingDurationAfterField(ppdu, field),
-                                    &PhyEntity::ResetReceive,
-                                    this,
-                                    event));
             break;
-        default:
-            NS_FATAL_ERROR("Unknown action in case of failure");
         }
     }
+    if (const auto nextField = GetNextField(lastField, preamble);
+        nextField != WIFI_PPDU_FIELD_DATA)
+    {
+        ScheduleEndReceivePhyHeaders(event, nextField);
+        return;
+    }
+    StartReceivePayload(event);
+}
+
+void
+PhyEntity::HandleFieldRxFailure(Ptr<Event> event,
+                                const PhyFieldRxStatus& status,
+                                Time remainingDuration)
+{
+    NS_LOG_FUNCTION(this << *event << status << remainingDuration);
+    Ptr<const WifiPpdu> ppdu = event->GetPpdu();
+    const auto& txVector = ppdu->GetTxVector();
+    switch (status.actionIfFailure)
+    {
+    case ABORT:
+        // Abort reception, but consider medium as busy
+        AbortCurrentReception(status.reason);
+        if (event->GetEndTime() > (Simulator::Now() + m_state->GetDelayUntilIdle()))
+        {
+            m_wifiPhy->SwitchMaybeToCcaBusy(ppdu);
+        }
+        break;
+    case DROP:
+        // Notify drop, keep in CCA busy, and perform same processing as IGNORE case
+        if (status.reason == FILTERED)
+        {
+            // PHY-RXSTART is immediately followed by PHY-RXEND (Filtered)
+            m_wifiPhy->m_phyRxPayloadBeginTrace(
+                txVector,
+                NanoSeconds(0)); // this callback (equivalent to PHY-RXSTART primitive) is also
+                                 // triggered for filtered PPDUs
+        }
+        m_wifiPhy->NotifyRxPpduDrop(ppdu, status.reason);
+        m_wifiPhy->NotifyCcaBusy(ppdu, remainingDuration);
+    // no break
+    case IGNORE:
+        // Keep in Rx state and reset at end
+        m_endRxPayloadEvents.push_back(
+            Simulator::Schedule(remainingDuration, &PhyEntity::ResetReceive, this, event));
+        break;
+    default:
+        NS_FATAL_ERROR("Unknown action in case of failure");
+    }
+}
+
+bool
+PhyEntity::IsFieldEndObservable(WifiPpduField field) const
+{
+    return false;
+}
+
+bool
+PhyEntity::IsRxAbstracted(Ptr<const WifiPpdu> ppdu) const
+{
+    // the reception of MU PPDUs involves per-user events and is never abstracted
+    return m_wifiPhy->m_rxAbstraction && !ppdu->GetTxVector().IsMu();
 }
 
 Time
@@ -657,14 +737,22 @@ PhyEntity::ScheduleEndOfMpdus(Ptr<Event> event)
                     << i << " in " << endOfMpduDuration.As(Time::NS) << " (relativeStart="
                     << relativeStart.As(Time::NS) << ", mpduDuration=" << mpduDuration.As(Time::NS)
                     << ", remainingAmdpuDuration=" << remainingAmpduDuration.As(Time::NS) << ")");
-        m_endOfMpduEvents.push_back(Simulator::Schedule(endOfMpduDuration,
-                                                        &PhyEntity::EndOfMpdu,
-                                                        this,
-                                                        event,
-                                                        *mpdu,
-                                                        i,
-                                                        relativeStart,
-                                                        mpduDuration));
+        if (IsRxAbstracted(ppdu))
+        {
+            // the reception of the MPDU is resolved at the end of the PSDU
+            m_pendingMpdus.push_back({*mpdu, i, relativeStart, mpduDuration});
+        }
+        else
+        {
+            m_endOfMpduEvents.push_back(Simulator::Schedule(endOfMpduDuration,
+                                                            &PhyEntity::EndOfMpdu,
+                                                            this,
+                                                            event,
+                                                            *mpdu,
+                                                            i,
+                                                            relativeStart,
+                                                            mpduDuration));
+        }
 
         // Prepare next iteration
         ++i;
@@ -720,6 +808,27 @@ PhyEntity::EndReceivePayload(Ptr<Event> event)
     NS_ASSERT(event->GetEndTime() == Simulator::Now());
     const auto staId = GetStaId(ppdu);
     const auto channelWidthAndBand = GetChannelWidthAndBand(txVector, staId);
+    if (!m_pendingMpdus.empty())
+    {
+        // the reception is abstracted: the SINR chunks of the whole PSDU are mapped onto an
+        // effective SINR (i.e., the constant SINR yielding the same PSDU success rate), from
+        // which the reception status of every MPDU is derived
+        const auto psduDuration =
+            ppdu->GetTxDuration() - CalculatePhyPreambleAndHeaderDuration(txVector);
+        m_psduSnrPer = {m_wifiPhy->m_interference->CalculatePayloadSnrPer(
+                            event,
+                            channelWidthAndBand.first,
+                            channelWidthAndBand.second,
+                            staId,
+                            {Time{0}, psduDuration}),
+                        psduDuration};
+        for (const auto& [mpdu, index, relativeStart, duration] : m_pendingMpdus)
+        {
+            EndOfMpdu(event, mpdu, index, relativeStart, duration);
+        }
+        m_pendingMpdus.clear();
+        m_psduSnrPer.reset();
+    }
     const auto snr = m_wifiPhy->m_interference->CalculateSnr(event,
                                                              channelWidthAndBand.first,
                                                              txVector.GetNss(staId),
@@ -812,12 +921,25 @@ PhyEntity::GetReceptionStatus(Ptr<WifiMpdu> mpdu,
 {
     NS_LOG_FUNCTION(this << *mpdu << *event << staId << relativeMpduStart << mpduDuration);
     const auto channelWidthAndBand = GetChannelWidthAndBand(event->GetPpdu()->GetTxVector(), staId);
-    SnrPer snrPer = m_wifiPhy->m_interference->CalculatePayloadSnrPer(
-        event,
-        channelWidthAndBand.first,
-        channelWidthAndBand.second,
-        staId,
-        {relativeMpduStart, relativeMpduStart + mpduDuration});
+    SnrPer snrPer;
+    if (m_psduSnrPer)
+    {
+        // the success rate of the MPDU is the share of the PSDU success rate matching the
+        // share of the PSDU duration occupied by the MPDU
+        const auto& [psduSnrPer, psduDuration] = *m_psduSnrPer;
+        snrPer.snr = psduSnrPer.snr;
+        snrPer.per = 1 - std::pow(1 - psduSnrPer.per,
+                                  mpduDuration.GetSeconds() / psduDuration.GetSeconds());
+    }
+    else
+    {
+        snrPer = m_wifiPhy->m_interference->CalculatePayloadSnrPer(
+            event,
+            channelWidthAndBand.first,
+            channelWidthAndBand.second,
+            staId,
+            {relativeMpduStart, relativeMpduStart + mpduDuration});
+    }
 
     WifiMode mode = event->GetPpdu()->GetTxVector().GetMode(staId);
     NS_LOG_DEBUG("rate=" << (mode.GetDataRate(event->GetPpdu()->GetTxVector(), staId))
@@ -987,6 +1109,7 @@ PhyEntity::NotifyInterferenceRxEndAndClear(bool reset)
         NS_ASSERT(endOfMpduEvent.IsExpired());
     }
     m_endOfMpduEvents.clear();
+    m_pendingMpdus.clear();
     for (const auto& [staId, endOfMacHdrEvents] : m_endOfMacHdrEvents)
     {
         for (const auto& endOfMacHdrEvent : endOfMacHdrEvents)
@@ -1135,6 +1258,14 @@ PhyEntity::EndPreambleDetectionPeriod(Ptr<Event> event)
                                  m_wifiPhy->m_currentEvent->GetRxPowerPerBand());
         m_wifiPhy->m_timeLastPreambleDetected = Simulator::Now();
 
+        if (IsRxAbstracted(event->GetPpdu()))
+        {
+            // Receive the fields preceding the Data field at once, except those whose end is
+            // observable outside of the PHY
+            ScheduleEndReceivePhyHeaders(event, WIFI_PPDU_FIELD_PREAMBLE);
+            return;
+        }
+
         // Continue receiving preamble
         const auto durationTillEnd =
             GetDuration(WIFI_PPDU_FIELD_PREAMBLE, event->GetPpdu()->GetTxVector()) -
@@ -1195,6 +1326,7 @@ PhyEntity::CancelAllEvents()
         endMpduEvent.Cancel();
     }
     m_endOfMpduEvents.clear();
+    m_pendingMpdus.clear();
     for (auto& [staId, endOfMacHdrEvents] : m_endOfMacHdrEvents)
     {
         for (auto& endMacHdrEvent : endOfMacHdrEvents)
@@ -1235,6 +1367,7 @@ PhyEntity::DoAbortCurrentReception(WifiPhyRxfailureReason reason)
             endMpduEvent.Cancel();
         }
         m_endOfMpduEvents.clear();
+        m_pendingMpdus.clear();
         for (auto& [staId, endOfMacHdrEvents] : m_endOfMacHdrEvents)
         {
             for (auto& endMacHdrEvent : endOfMacHdrEvents)
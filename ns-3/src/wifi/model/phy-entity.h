@@ -346,6 +346,46 @@ class WIFI_EXPORT PhyEntity
      * @param event the event holding incoming PPDU's information
      */
     void EndReceiveField(WifiPpduField field, Ptr<Event> event);
+    /**
+     * Schedule the end of the reception of a group of fields preceding the Data field, starting
+     * with the given field. A group ends with the first field whose end is observable outside
+     * of the PHY (\see IsFieldEndObservable) or with the field preceding the Data field. This
+     * is used instead of the per-field reception (\see StartReceiveField and \see
+     * EndReceiveField) when the reception of the PPDU is abstracted (\see IsRxAbstracted).
+     *
+     * @param event the event holding incoming PPDU's information
+     * @param field the first field of the group
+     */
+    void ScheduleEndReceivePhyHeaders(Ptr<Event> event, WifiPpduField field);
+    /**
+     * End receiving a group of fields preceding the Data field at once (\see
+     * ScheduleEndReceivePhyHeaders).
+     *
+     * The fields are processed in order by calling DoEndReceiveField. If all the fields are
+     * successfully received, the reception of the next group of fields or of the payload is
+     * started.
+     *
+     * @param event the event holding incoming PPDU's information
+     * @param firstField the first field of the group
+     * @param lastField the last field of the group
+     */
+    void EndReceivePhyHeaders(Ptr<Event> event, WifiPpduField firstField, WifiPpduField lastField);
+    /**
+     * Perform the actions indicated by the status of a field whose reception failed.
+     *
+     * @param event the event holding incoming PPDU's information
+     * @param status the status of the reception of the field
+     * @param remainingDuration the remaining duration of the PPDU
+     */
+    void HandleFieldRxFailure(Ptr<Event> event,
+                              const PhyFieldRxStatus& status,
+                              Time remainingDuration);
+    /**
+     * @param ppdu the incoming PPDU
+     * @return whether the reception of the given PPDU is abstracted, i.e., whether the PHY
+     *         header fields and the MPDUs are each resolved by a single event
+     */
+    bool IsRxAbstracted(Ptr<const WifiPpdu> ppdu) const;
 
     /**
      * The last symbol of the PPDU has arrived.
@@ -608,6 +648,17 @@ class WIFI_EXPORT PhyEntity
      */
     virtual bool IsConfigSupported(Ptr<const WifiPpdu> ppdu) const;
 
+    /**
+     * Whether the end of the given PHY header field has effects that are observable outside
+     * of the PHY (e.g., on the CCA indications or on the PPDU drop notifications). If so, the
+     * end of the field is processed at the time it is received also when the reception of the
+     * PPDU is abstracted (\see IsRxAbstracted).
+     *
+     * @param field the PHY header field
+     * @return \c true if the end of the field is observable outside of the PHY
+     */
+    virtual bool IsFieldEndObservable(WifiPpduField field) const;
+
     /**
      * Drop the PPDU and the corresponding preamble detection event, but keep CCA busy
      * state after the completion of the currently processed event.
@@ -911,6 +962,22 @@ class WIFI_EXPORT PhyEntity
 
     std::vector<EventId> m_endPreambleDetectionEvents; //!< the end of preamble detection events
     std::vector<EventId> m_endOfMpduEvents; //!< the end of MPDU events (only used for A-MPDUs)
+
+    /// Information about an MPDU whose reception is resolved at the end of the PSDU
+    struct PendingMpdu
+    {
+        Ptr<WifiMpdu> mpdu; //!< the MPDU
+        std::size_t index;  //!< the index of the MPDU within the A-MPDU
+        Time relativeStart; //!< the relative start time of the MPDU within the A-MPDU
+        Time duration;      //!< the duration of the MPDU
+    };
+
+    /// the MPDUs whose reception is resolved at the end of the PSDU (only used when the
+    /// reception is abstracted)
+    std::vector<PendingMpdu> m_pendingMpdus;
+    /// the SNR and PER of the whole PSDU along with the PSDU duration, from which the
+    /// reception status of the pending MPDUs is derived
+    std::optional<std::pair<SnrPer, Time>> m_psduSnrPer;
     std::map<uint16_t, std::vector<EventId>>
         m_endOfMacHdrEvents; //!< STA_ID-indexed map of the RX end of MAC header events
 
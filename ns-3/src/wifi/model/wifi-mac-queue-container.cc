@@ -14,8 +14,6 @@
 #include "ns3/mac48-address.h"
 #include "ns3/simulator.h"
 
-#include <vector>
-
 namespace ns3
 {
 
@@ -24,7 +22,6 @@ WifiMacQueueContainer::clear()
 {
     m_queues.clear();
     m_expiredQueue.clear();
-    m_nBytesPerQueue.clear();
 }
 
 WifiMacQueueContainer::iterator
@@ -32,14 +29,20 @@ WifiMacQueueContainer::insert(const_iterator pos, Ptr<WifiMpdu> item)
 {
     WifiContainerQueueId queueId = GetQueueId(item);
 
-    NS_ABORT_MSG_UNLESS(pos == m_queues[queueId].cend() || GetQueueId(pos->mpdu) == queueId,
+    auto& queueInfo = m_queues[queueId];
+
+    NS_ABORT_MSG_UNLESS(pos == queueInfo.queue.cend() || GetQueueId(pos->mpdu) == queueId,
                         "pos iterator does not point to the correct container queue");
     NS_ABORT_MSG_IF(!item->IsOriginal(), "Only the original copy of an MPDU can be inserted");
 
-    auto [it, ret] = m_nBytesPerQueue.insert({queueId, 0});
-    it->second += item->GetSize();
+    queueInfo.nBytes += item->GetSize();
+    if (pos != queueInfo.queue.cend() || queueInfo.checkedAll)
+    {
+        // the new MPDU may be reached by the next check for MPDUs with expired lifetime
+        queueInfo.nextExpiryCheck = Time{0};
+    }
 
-    return m_queues[queueId].emplace(pos, item);
+    return queueInfo.queue.emplace(pos, item);
 }
 
 WifiMacQueueContainer::iterator
@@ -50,13 +53,19 @@ WifiMacQueueContainer::erase(const_iterator pos)
         return m_expiredQueue.erase(pos);
     }
 
-    WifiContainerQueueId queueId = GetQueueId(pos->mpdu);
-    auto it = m_nBytesPerQueue.find(queueId);
-    NS_ASSERT(it != m_nBytesPerQueue.end());
-    NS_ASSERT(it->second >= pos->mpdu->GetSize());
-    it->second -= pos->mpdu->GetSize();
+    auto it = m_queues.find(GetQueueId(pos->mpdu));
+    NS_ASSERT(it != m_queues.end());
+    auto& queueInfo = it->second;
+    NS_ASSERT(queueInfo.nBytes >= pos->mpdu->GetSize());
+    queueInfo.nBytes -= pos->mpdu->GetSize();
+    if (pos->inflights.empty())
+    {
+        // the removed MPDU may be the one at which the last check for MPDUs with
+        // expired lifetime stopped
+        queueInfo.nextExpiryCheck = Time{0};
+    }
 
-    return m_queues[queueId].erase(pos);
+    return queueInfo.queue.erase(pos);
 }
 
 Ptr<WifiMpdu>
@@ -106,17 +115,17 @@ WifiMacQueueContainer::GetQueueId(Ptr<const WifiMpdu> mpdu)
 const WifiMacQueueContainer::ContainerQueue&
 WifiMacQueueContainer::GetQueue(const WifiContainerQueueId& queueId) const
 {
-    return m_queues[queueId];
+    return m_queues[queueId].queue;
 }
 
 uint32_t
 WifiMacQueueContainer::GetNBytes(const WifiContainerQueueId& queueId) const
 {
-    if (auto it = m_queues.find(queueId); it == m_queues.end() || it->second.empty())
+    if (auto it = m_queues.find(queueId); it != m_queues.end() && !it->second.queue.empty())
     {
-        return 0;
+        return it->second.nBytes;
     }
-    return m_nBytesPerQueue.at(queueId);
+    return 0;
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
@@ -126,12 +135,21 @@ WifiMacQueueContainer::ExtractExpiredMpdus(const WifiContainerQueueId& queueId)
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
-WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
+WifiMacQueueContainer::DoExtractExpiredMpdus(QueueInfo& queueInfo) const
 {
+    Time now = Simulator::Now();
+
+    if (queueInfo.nextExpiryCheck > now)
+    {
+        // no MPDU can have been expired since the last check
+        return {m_expiredQueue.end(), m_expiredQueue.end()};
+    }
+
+    auto& queue = queueInfo.queue;
     std::optional<std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>> ret;
     auto firstExpiredIt = queue.begin();
     auto lastExpiredIt = firstExpiredIt;
-    Time now = Simulator::Now();
+    auto nextExpiryCheck = Time::Max();
 
     do
     {
@@ -140,6 +158,7 @@ WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
              firstExpiredIt != queue.end() && !firstExpiredIt->inflights.empty();
              ++firstExpiredIt, ++lastExpiredIt)
         {
+            nextExpiryCheck = Min(nextExpiryCheck, firstExpiredIt->expiryTime);
         }
 
         if (!ret)
@@ -157,17 +176,22 @@ WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
             lastExpiredIt->ac = AC_UNDEF;
             lastExpiredIt->deleter(lastExpiredIt->mpdu);
 
-            WifiContainerQueueId queueId = GetQueueId(lastExpiredIt->mpdu);
-            auto it = m_nBytesPerQueue.find(queueId);
-            NS_ASSERT(it != m_nBytesPerQueue.end());
-            NS_ASSERT(it->second >= lastExpiredIt->mpdu->GetSize());
-            it->second -= lastExpiredIt->mpdu->GetSize();
+            NS_ASSERT(queueInfo.nBytes >= lastExpiredIt->mpdu->GetSize());
+            queueInfo.nBytes -= lastExpiredIt->mpdu->GetSize();
 
             ++lastExpiredIt;
         }
 
         if (lastExpiredIt == firstExpiredIt)
         {
+            // the check stopped at the end of the queue or at a non-inflight MPDU that has not
+            // expired, which does not expire later than the MPDUs following it in the queue
+            queueInfo.checkedAll = (firstExpiredIt == queue.end());
+            if (!queueInfo.checkedAll)
+            {
+                nextExpiryCheck = Min(nextExpiryCheck, firstExpiredIt->expiryTime);
+            }
+            queueInfo.nextExpiryCheck = nextExpiryCheck;
             break;
         }
 
@@ -185,9 +209,9 @@ WifiMacQueueContainer::ExtractAllExpiredMpdus() const
 {
     std::optional<WifiMacQueueContainer::iterator> firstExpiredIt;
 
-    for (auto& queue : m_queues)
+    for (auto& [queueId, queueInfo] : m_queues)
     {
-        auto [firstIt, lastIt] = DoExtractExpiredMpdus(queue.second);
+        auto [firstIt, lastIt] = DoExtractExpiredMpdus(queueInfo);
 
         if (firstIt != lastIt && !firstExpiredIt)
         {
@@ -205,6 +229,15 @@ WifiMacQueueContainer::GetAllExpiredMpdus() const
     return {m_expiredQueue.begin(), m_expiredQueue.end()};
 }
 
+void
+WifiMacQueueContainer::NotifyExpiryTimesChanged() const
+{
+    for (auto& [queueId, queueInfo] : m_queues)
+    {
+        queueInfo.nextExpiryCheck = Time{0};
+    }
+}
+
 } // namespace ns3
 
 /****************************************************
@@ -215,16 +248,22 @@ std::size_t
 std::hash<ns3::WifiContainerQueueId>::operator()(ns3::WifiContainerQueueId queueId) const
 {
     auto [type, addrType, address, tid] = queueId;
-    const std::size_t size = tid.has_value() ? 8 : 7;
 
-    std::vector<uint8_t> buffer(size);
-    buffer[0] = type;
-    address.CopyTo(&buffer[1]);
+    // the 48-bit address, the queue type, the receiver address type and the TID (if any)
+    // fit in a 64-bit integer, which is hashed without allocating memory
+    uint8_t buffer[6];
+    address.CopyTo(buffer);
+    uint64_t key = 0;
+    for (const auto byte : buffer)
+    {
+        key = (key << 8) | byte;
+    }
+    key |= static_cast<uint64_t>(type & 0x03) << 48;
+    key |= static_cast<uint64_t>(static_cast<uint8_t>(addrType) & 0x03) << 50;
     if (tid.has_value())
     {
-        buffer[7] = *tid;
+        key |= (uint64_t{1} << 52) | (static_cast<uint64_t>(*tid) << 53);
     }
 
-    std::string s(buffer.begin(), buffer.end());
-    return std::hash<std::string>{}(s);
+    return std::hash<uint64_t>{}(key);
 }
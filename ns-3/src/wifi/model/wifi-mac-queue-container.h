@@ -210,22 +210,43 @@ class WifiMacQueueContainer
      */
     std::pair<iterator, iterator> GetAllExpiredMpdus() const;
 
+    /**
+     * Notify the container that the expiry time of the queued MPDUs may have been modified
+     * (e.g., because the maximum delay of the MAC queue has changed), so that all the container
+     * queues are checked for MPDUs with expired lifetime at the next extraction.
+     */
+    void NotifyExpiryTimesChanged() const;
+
   private:
+    /**
+     * Information associated with a container queue. When the container queue is checked for
+     * MPDUs with expired lifetime, the check stops at the first non-inflight MPDU that has not
+     * expired; no MPDU can be extracted until the earliest expiry time of such MPDU and of the
+     * inflight MPDUs preceding it (which may no longer be inflight by then). Hence, the
+     * following checks return immediately until such time, unless an MPDU is inserted before
+     * the MPDU at which the check stopped or a non-inflight MPDU is removed.
+     */
+    struct QueueInfo
+    {
+        ContainerQueue queue;    //!< the container queue
+        uint32_t nBytes{0};      //!< size in bytes of the MPDUs in the container queue
+        Time nextExpiryCheck{0}; //!< time before which no MPDU can be extracted because expired
+        bool checkedAll{false};  //!< whether the last check reached the end of the queue
+    };
+
     /**
      * Transfer non-inflight MPDUs with expired lifetime in the given container queue to the
      * container queue storing MPDUs with expired lifetime.
      *
-     * @param queue the given container queue
+     * @param queueInfo the information associated with the given container queue
      * @return the range [first, last) of iterators pointing to the MPDUs transferred
      *         to the container queue storing MPDUs with expired lifetime
      */
-    std::pair<iterator, iterator> DoExtractExpiredMpdus(ContainerQueue& queue) const;
+    std::pair<iterator, iterator> DoExtractExpiredMpdus(QueueInfo& queueInfo) const;
 
-    mutable std::unordered_map<WifiContainerQueueId, ContainerQueue>
+    mutable std::unordered_map<WifiContainerQueueId, QueueInfo>
         m_queues;                          //!< the container queues
     mutable ContainerQueue m_expiredQueue; //!< queue storing MPDUs with expired lifetime
-    mutable std::unordered_map<WifiContainerQueueId, uint32_t>
-        m_nBytesPerQueue; //!< size in bytes of the container queues
 };
 
 } // namespace ns3
@@ -210,6 +210,8 @@ WifiMacQueue::SetMaxDelay(Time delay)
 {
     NS_LOG_FUNCTION(this << delay);
     m_maxDelay = delay;
+    // MPDUs enqueued from now on may expire before the MPDUs already queued
+    GetContainer().NotifyExpiryTimesChanged();
 }
 
 Time
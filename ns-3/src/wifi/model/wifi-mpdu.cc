@@ -270,9 +270,13 @@ WifiMpdu::DoAggregate(Ptr<const WifiMpdu> msdu)
 
     original.m_msduList.emplace_back(msdu->GetPacket(), hdr);
 
-    // build the A-MSDU
+    // build the A-MSDU. The packet is extended in place if nobody else holds a reference to it
+    // (as it happens when several MSDUs are aggregated in a row), thus avoiding to copy the
+    // A-MSDU built so far every time a new MSDU is added
     NS_ASSERT(original.m_packet);
-    Ptr<Packet> amsdu = original.m_packet->Copy();
+    Ptr<Packet> amsdu = (original.m_packet->GetReferenceCount() == 1)
+                            ? ConstCast<Packet>(original.m_packet)
+                            : original.m_packet->Copy();
 
     // pad the previous A-MSDU subframe if the A-MSDU is not empty
     if (original.m_packet->GetSize() > 0)
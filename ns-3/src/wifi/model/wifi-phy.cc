@@ -292,6 +292,21 @@ WifiPhy::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(&WifiPhy::m_notifyRxMacHeaderEnd),
                           MakeBooleanChecker())
+            .AddAttribute("RxAbstraction",
+                          "Whether to abstract the reception of the PPDUs (except MU PPDUs). "
+                          "When enabled, the fields preceding the Data field are received by "
+                          "a single event (except that the end of HE-SIG-A, U-SIG and EHT-SIG "
+                          "is still processed at its time, e.g., for the BSS color filtering "
+                          "and the OBSS PD spatial reuse) and the reception status of all the "
+                          "MPDUs of the PSDU is determined at the end of the PSDU from an "
+                          "effective SINR, instead of having one event per PHY header field "
+                          "and per MPDU. Note that this changes the MAC timing: the MPDUs of an "
+                          "A-MPDU are all forwarded to the MAC layer at the end of the PSDU "
+                          "rather than at the end of each MPDU (the start and the end of the "
+                          "reception and the CCA indications are not affected).",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&WifiPhy::m_rxAbstraction),
+                          MakeBooleanChecker())
             .AddTraceSource(
                 "PhyTxBegin",
                 "Trace source indicating a packet has begun transmitting over the medium; "
@@ -1694,6 +1694,7 @@ class WIFI_EXPORT WifiPhy : public Object
     Ptr<ErrorModel> m_postReceptionErrorModel;            //!< Error model for receive packet events
     Time m_timeLastPreambleDetected; //!< Record the time the last preamble was detected
     bool m_notifyRxMacHeaderEnd;     //!< whether the PHY is capable of notifying MAC header RX end
+    bool m_rxAbstraction;            //!< whether the reception of the PPDUs is abstracted
 
     Callback<void> m_capabilitiesChangedCallback; //!< Callback when PHY capabilities changed
 };
@@ -47,9 +47,9 @@ WifiPsdu::WifiPsdu(Ptr<const WifiMpdu> mpdu, bool isSingle)
 
 WifiPsdu::WifiPsdu(std::vector<Ptr<WifiMpdu>> mpduList)
     : m_isSingle(mpduList.size() == 1),
-      m_mpduList(mpduList)
+      m_mpduList(std::move(mpduList))
 {
-    NS_ABORT_MSG_IF(mpduList.empty(), "Cannot initialize a WifiPsdu with an empty MPDU list");
+    NS_ABORT_MSG_IF(m_mpduList.empty(), "Cannot initialize a WifiPsdu with an empty MPDU list");
 
     m_size = 0;
     for (auto& mpdu : m_mpduList)
@@ -12,9 +12,12 @@
 #include "wifi-tx-vector.h"
 #include "wifi-utils.h"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 
 #include <cmath>
+#include <map>
+#include <tuple>
 
 namespace ns3
 {
@@ -26,10 +29,20 @@ NS_OBJECT_ENSURE_REGISTERED(YansErrorRateModel);
 TypeId
 YansErrorRateModel::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::YansErrorRateModel")
-                            .SetParent<ErrorRateModel>()
-                            .SetGroupName("Wifi")
-                            .AddConstructor<YansErrorRateModel>();
+    static TypeId tid =
+        TypeId("ns3::YansErrorRateModel")
+            .SetParent<ErrorRateModel>()
+            .SetGroupName("Wifi")
+            .AddConstructor<YansErrorRateModel>()
+            .AddAttribute("UseLookupTables",
+                          "Whether to read the error probabilities of the OFDM modulations from "
+                          "precomputed lookup tables shared by all the instances of this model, "
+                          "instead of computing them for every chunk. The interpolation error of "
+                          "the lookup tables is bounded by "
+                          "ErrorRateLookupTable::RELATIVE_TOLERANCE.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&YansErrorRateModel::m_useLookupTables),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -142,6 +155,14 @@ YansErrorRateModel::GetFecBpskBer(double snr,
                                   uint32_t adFree) const
 {
     NS_LOG_FUNCTION(this << snr << nbits << signalSpread << phyRate << dFree << adFree);
+    if (m_useLookupTables)
+    {
+        const auto ebNo = snr * signalSpread * 1e6 / phyRate;
+        if (const auto pmu = GetLookupTable(2, dFree, adFree, 0).GetErrorProbability(ebNo))
+        {
+            return std::pow(1 - *pmu, nbits);
+        }
+    }
     double ber = GetBpskBer(snr, signalSpread, phyRate);
     if (ber == 0.0)
     {
@@ -166,6 +187,15 @@ YansErrorRateModel::GetFecQamBer(double snr,
 {
     NS_LOG_FUNCTION(this << snr << nbits << signalSpread << phyRate << m << dFree << adFree
                          << adFreePlusOne);
+    if (m_useLookupTables)
+    {
+        const auto ebNo = snr * signalSpread * 1e6 / phyRate;
+        const auto& table = GetLookupTable(m, dFree, adFree, adFreePlusOne);
+        if (const auto pmu = table.GetErrorProbability(ebNo))
+        {
+            return std::pow(1 - *pmu, nbits);
+        }
+    }
     double ber = GetQamBer(snr, m, signalSpread, phyRate);
     if (ber == 0.0)
     {
@@ -182,6 +212,46 @@ YansErrorRateModel::GetFecQamBer(double snr,
     return pms;
 }
 
+const ErrorRateLookupTable&
+YansErrorRateModel::GetLookupTable(uint32_t m,
+                                   uint32_t dFree,
+                                   uint32_t adFree,
+                                   uint32_t adFreePlusOne) const
+{
+    // the tables are shared by all the instances of this model
+    static std::map<std::tuple<uint32_t, uint32_t, uint32_t, uint32_t>, ErrorRateLookupTable>
+        tables;
+
+    const auto key = std::make_tuple(m, dFree, adFree, adFreePlusOne);
+    auto it = tables.find(key);
+    if (it == tables.end())
+    {
+        NS_LOG_DEBUG("Build lookup table for m=" << m << ", dFree=" << dFree << ", adFree="
+                                                 << adFree << ", adFreePlusOne=" << adFreePlusOne);
+        auto pmu = [this, m, dFree, adFree, adFreePlusOne](double ebNo) {
+            // the SNR equals Eb/No for a signal spread of 1 MHz and a PHY rate of 1 Mbps
+            const auto ber = (m == 2) ? GetBpskBer(ebNo, MHz_u{1}, 1000000)
+                                      : GetQamBer(ebNo, m, MHz_u{1}, 1000000);
+            if (ber == 0.0)
+            {
+                return 0.0;
+            }
+            auto pe = adFree * CalculatePd(ber, dFree);
+            if (adFreePlusOne > 0)
+            {
+                pe += adFreePlusOne * CalculatePd(ber, dFree + 1);
+            }
+            return std::min(pe, 1.0);
+        };
+        it = tables
+                 .emplace(std::piecewise_construct,
+                          std::forward_as_tuple(key),
+                          std::forward_as_tuple(pmu, dB_u{-10}, dB_u{50}, dB_u{0.01}))
+                 .first;
+    }
+    return it->second;
+}
+
 double
 YansErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
                                           const WifiTxVector& txVector,
@@ -9,6 +9,7 @@
 #ifndef YANS_ERROR_RATE_MODEL_H
 #define YANS_ERROR_RATE_MODEL_H
 
+#include "error-rate-lookup-table.h"
 #include "error-rate-model.h"
 
 namespace ns3
@@ -38,6 +39,10 @@ namespace ns3
  *      57(2):440-449, February 2009.
  *    - More detailed description and validation can be found in
  *      http://www.nsnam.org/~pei/80211b.pdf
+ *
+ * If the UseLookupTables attribute is set, the error probabilities of the OFDM modulations
+ * are read from lookup tables (see ErrorRateLookupTable) indexed by Eb/No and shared by all
+ * the instances of this model, instead of being computed for every chunk.
  */
 class YansErrorRateModel : public ErrorRateModel
 {
@@ -154,6 +159,23 @@ class YansErrorRateModel : public ErrorRateModel
                         uint32_t dfree,
                         uint32_t adFree,
                         uint32_t adFreePlusOne) const;
+    /**
+     * Return the lookup table of the error probability, as a function of Eb/No, for the
+     * given modulation and convolutional code. The table is built upon first use.
+     *
+     * @param m the constellation size (2 stands for BPSK)
+     * @param dFree the free distance of the code
+     * @param adFree the number of paths at the free distance
+     * @param adFreePlusOne the number of paths at the free distance plus one
+     *
+     * @return the lookup table of the error probability
+     */
+    const ErrorRateLookupTable& GetLookupTable(uint32_t m,
+                                               uint32_t dFree,
+                                               uint32_t adFree,
+                                               uint32_t adFreePlusOne) const;
+
+    bool m_useLookupTables; //!< whether to read the error probabilities from lookup tables
 };
 
 } // namespace ns3
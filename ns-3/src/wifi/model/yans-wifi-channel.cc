@@ -14,6 +14,7 @@
 #include "wifi-utils.h"
 #include "yans-wifi-phy.h"
 
+#include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
@@ -46,7 +47,16 @@ YansWifiChannel::GetTypeId()
                           "A pointer to the propagation delay model attached to this channel.",
                           PointerValue(),
                           MakePointerAccessor(&YansWifiChannel::m_delay),
-                          MakePointerChecker<PropagationDelayModel>());
+                          MakePointerChecker<PropagationDelayModel>())
+            .AddAttribute("MaxRange",
+                          "The maximum distance (in meters) between the sender and the receivers "
+                          "of a transmission. Receivers farther than this distance are not "
+                          "notified of the transmission at all. The receivers are looked up in "
+                          "a spatial grid of the PHYs, which relies on the CourseChange trace of "
+                          "their mobility models. A value of zero disables the cutoff.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&YansWifiChannel::m_maxRange),
+                          MakeDoubleChecker<double>(0));
     return tid;
 }
 
@@ -81,42 +91,69 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u t
     NS_LOG_FUNCTION(this << sender << ppdu << txPower);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
-    for (auto i = m_phyList.begin(); i != m_phyList.end(); i++)
+
+    auto sendTo = [&](Ptr<YansWifiPhy> receiver) {
+        // For now don't account for inter channel interference nor channel bonding
+        if (receiver == sender || receiver->GetChannelNumber() != sender->GetChannelNumber())
+        {
+            return;
+        }
+
+        auto receiverMobility = receiver->GetMobility()->GetObject<MobilityModel>();
+        if (m_maxRange > 0 && senderMobility->GetDistanceFrom(receiverMobility) > m_maxRange)
+        {
+            NS_LOG_DEBUG("receiver " << receiver << " out of range");
+            return;
+        }
+        const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
+        const dBm_u rxPower{m_loss->CalcRxPower(txPower, senderMobility, receiverMobility)};
+        NS_LOG_DEBUG("propagation: txPower="
+                     << txPower << "dBm, rxPower=" << rxPower << "dBm, "
+                     << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
+                     << "m, delay=" << delay);
+        auto dstNetDevice = receiver->GetDevice();
+        uint32_t dstNode;
+        if (!dstNetDevice)
+        {
+            dstNode = 0xffffffff;
+        }
+        else
+        {
+            dstNode = dstNetDevice->GetNode()->GetId();
+        }
+
+        Simulator::ScheduleWithContext(dstNode,
+                                       delay,
+                                       &YansWifiChannel::Receive,
+                                       receiver,
+                                       ppdu,
+                                       rxPower);
+    };
+
+    if (m_maxRange == 0)
+    {
+        for (const auto& phy : m_phyList)
+        {
+            sendTo(phy);
+        }
+        return;
+    }
+
+    // the grid is (re)built when PHYs have been added since the last transmission
+    if (m_receivers.GetN() != m_phyList.size())
     {
-        if (sender != (*i))
+        m_receivers.Clear();
+        m_receivers.SetCellSize(m_maxRange);
+        for (std::size_t i = 0; i < m_phyList.size(); ++i)
         {
-            // For now don't account for inter channel interference nor channel bonding
-            if ((*i)->GetChannelNumber() != sender->GetChannelNumber())
-            {
-                continue;
-            }
-
-            auto receiverMobility = (*i)->GetMobility()->GetObject<MobilityModel>();
-            const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
-            const dBm_u rxPower{m_loss->CalcRxPower(txPower, senderMobility, receiverMobility)};
-            NS_LOG_DEBUG("propagation: txPower="
-                         << txPower << "dBm, rxPower=" << rxPower << "dBm, "
-                         << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
-                         << "m, delay=" << delay);
-            auto dstNetDevice = (*i)->GetDevice();
-            uint32_t dstNode;
-            if (!dstNetDevice)
-            {
-                dstNode = 0xffffffff;
-            }
-            else
-            {
-                dstNode = dstNetDevice->GetNode()->GetId();
-            }
-
-            Simulator::ScheduleWithContext(dstNode,
-                                           delay,
-                                           &YansWifiChannel::Receive,
-                                           (*i),
-                                           ppdu,
-                                           rxPower);
+            m_receivers.Add(i, m_phyList[i]->GetMobility());
         }
     }
+    // the candidates are sorted, hence the receptions are scheduled in the order of the PHY list
+    for (auto i : m_receivers.GetCandidates(senderMobility->GetPosition(), m_maxRange))
+    {
+        sendTo(m_phyList[i]);
+    }
 }
 
 void
@@ -12,6 +12,7 @@
 #include "wifi-units.h"
 
 #include "ns3/channel.h"
+#include "ns3/spatial-grid-index.h"
 
 namespace ns3
 {
@@ -72,7 +73,8 @@ class YansWifiChannel : public Channel
      * This method should not be invoked by normal users. It is
      * currently invoked only from YansWifiPhy::StartTx.  The channel
      * attempts to deliver the PPDU to all other YansWifiPhy objects
-     * on the channel (except for the sender).
+     * on the channel (except for the sender) and, if the MaxRange attribute
+     * is set, within that range of the sender.
      */
     void Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u txPower) const;
 
@@ -107,6 +109,9 @@ class YansWifiChannel : public Channel
     PhyList m_phyList;                  //!< List of YansWifiPhys connected to this YansWifiChannel
     Ptr<PropagationLossModel> m_loss;   //!< Propagation loss model
     Ptr<PropagationDelayModel> m_delay; //!< Propagation delay model
+    double m_maxRange;                  //!< Maximum distance (m) to the receivers, 0 if none
+    /// Spatial grid of the indices of the PHY list, (re)built at the first transmission
+    mutable SpatialGridIndex m_receivers;
 };
 
 } // namespace ns3
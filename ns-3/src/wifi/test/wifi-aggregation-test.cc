@@ -565,6 +565,20 @@ TwoLevelAggregationTest::DoRun()
     bool result{item};
     NS_TEST_EXPECT_MSG_EQ(result, true, "aggregation failed");
     NS_TEST_EXPECT_MSG_EQ(item->GetPacketSize(), 3030, "wrong packet size");
+    NS_TEST_EXPECT_MSG_EQ(std::distance(item->begin(), item->end()),
+                          2,
+                          "Unexpected number of MSDUs in the A-MSDU");
+    NS_TEST_EXPECT_MSG_EQ(GetBeQueue()->GetWifiMacQueue()->GetNPackets(),
+                          2,
+                          "The A-MSDU should have replaced the aggregated MSDUs in the queue");
+
+    // the A-MSDU packet must be deaggregated into the original MSDUs
+    auto msdus = MsduAggregator::Deaggregate(item->GetPacket()->Copy());
+    NS_TEST_ASSERT_MSG_EQ(msdus.size(), 2, "Unexpected number of deaggregated MSDUs");
+    for (const auto& [msdu, subframeHdr] : msdus)
+    {
+        NS_TEST_EXPECT_MSG_EQ(msdu->GetSize(), 1500, "Unexpected size of deaggregated MSDU");
+    }
 
     // dequeue the MSDUs
     DequeueMpdus({item});
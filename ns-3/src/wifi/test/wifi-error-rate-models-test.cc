@@ -14,11 +14,13 @@
 #include <gsl/gsl_sf_bessel.h>
 #endif
 
+#include "ns3/boolean.h"
 #include "ns3/dsss-error-rate-model.h"
 #include "ns3/he-phy.h" //includes HT and VHT
 #include "ns3/interference-helper.h"
 #include "ns3/log.h"
 #include "ns3/nist-error-rate-model.h"
+#include "ns3/object-factory.h"
 #include "ns3/table-based-error-rate-model.h"
 #include "ns3/test.h"
 #include "ns3/wifi-phy.h"
@@ -1102,6 +1104,80 @@ TableBasedErrorRateTestCase::DoRun()
     }
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Check that the lookup tables of the NIST and YANS error rate models match the exact
+ * computation of the chunk success rate.
+ */
+class WifiErrorRateModelsTestCaseLookupTables : public TestCase
+{
+  public:
+    WifiErrorRateModelsTestCaseLookupTables();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Compare the chunk success rates returned by an error rate model with and without
+     * lookup tables, for all the HE MCSs and a range of SNR values.
+     *
+     * @param typeId the TypeId of the error rate model
+     */
+    void CompareModels(const std::string& typeId);
+};
+
+WifiErrorRateModelsTestCaseLookupTables::WifiErrorRateModelsTestCaseLookupTables()
+    : TestCase("WifiErrorRateModel test case lookup tables")
+{
+}
+
+void
+WifiErrorRateModelsTestCaseLookupTables::CompareModels(const std::string& typeId)
+{
+    ObjectFactory factory(typeId);
+    auto exact = factory.Create<ErrorRateModel>();
+    factory.Set("UseLookupTables", BooleanValue(true));
+    auto table = factory.Create<ErrorRateModel>();
+
+    for (uint8_t mcs = 0; mcs <= 11; ++mcs)
+    {
+        WifiTxVector txVector(HePhy::GetHeMcs(mcs),
+                              0,
+                              WIFI_PREAMBLE_HE_SU,
+                              NanoSeconds(800),
+                              1,
+                              1,
+                              0,
+                              MHz_u{20},
+                              false);
+        for (dB_u snr = -5; snr <= dB_u{45}; snr += dB_u{0.13})
+        {
+            for (uint64_t nbits : {8 * 32, 8 * 1500, 8 * 65535})
+            {
+                const auto expected =
+                    exact->GetChunkSuccessRate(txVector.GetMode(), txVector, DbToRatio(snr), nbits);
+                const auto actual =
+                    table->GetChunkSuccessRate(txVector.GetMode(), txVector, DbToRatio(snr), nbits);
+                NS_TEST_ASSERT_MSG_EQ_TOL(actual,
+                                          expected,
+                                          1e-4,
+                                          typeId << ": wrong chunk success rate for HE MCS "
+                                                 << +mcs << ", SNR=" << snr << " dB and "
+                                                 << nbits << " bits");
+            }
+        }
+    }
+}
+
+void
+WifiErrorRateModelsTestCaseLookupTables::DoRun()
+{
+    CompareModels("ns3::NistErrorRateModel");
+    CompareModels("ns3::YansErrorRateModel");
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -1120,6 +1196,7 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite()
     AddTestCase(new WifiErrorRateModelsTestCaseDsss, TestCase::Duration::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseNist, TestCase::Duration::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseMimo, TestCase::Duration::QUICK);
+    AddTestCase(new WifiErrorRateModelsTestCaseLookupTables, TestCase::Duration::QUICK);
     AddTestCase(new TableBasedErrorRateTestCase("DefaultTableBasedHtMcs0-1458bytes",
                                                 HtPhy::GetHtMcs0(),
                                                 1458),
@@ -12,6 +12,8 @@
 #include "ns3/wifi-mac-queue.h"
 
 #include <algorithm>
+#include <iterator>
+#include <vector>
 
 using namespace ns3;
 
@@ -417,6 +419,130 @@ WifiExtractExpiredMpdusTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Test the checks for MPDUs with expired lifetime in a MAC queue container
+ *
+ * The MAC queue container does not check a container queue again for MPDUs with expired lifetime
+ * until an MPDU may have expired. This test verifies that expired MPDUs are extracted as soon as
+ * they can be, i.e., when an inflight MPDU with expired lifetime is no longer inflight, when an
+ * MPDU is inserted at the head of the container queue and when the non-inflight MPDU at which
+ * the previous check stopped expires.
+ */
+class WifiExpiryCheckTest : public TestCase
+{
+  public:
+    WifiExpiryCheckTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Insert a new MPDU into the container.
+     *
+     * @param inflight whether the MPDU is inflight
+     * @param expiryTime the expiry time for the MPDU
+     * @param front whether the MPDU is inserted at the head of the container queue
+     * @return an iterator pointing to the inserted MPDU
+     */
+    WifiMacQueueContainer::iterator Insert(bool inflight, Time expiryTime, bool front = false);
+
+    /**
+     * Extract the MPDUs with expired lifetime from the container queue and check that the
+     * extracted MPDUs are the expected ones.
+     *
+     * @param expectedSeqNo the sequence numbers of the MPDUs expected to be extracted
+     */
+    void CheckExtracted(const std::vector<uint16_t>& expectedSeqNo);
+
+    WifiMacQueueContainer m_container; //!< MAC queue container
+    uint16_t m_currentSeqNo{0};        //!< sequence number of current MPDU
+    Mac48Address m_rxAddr;             //!< Receiver Address of MPDUs
+};
+
+WifiExpiryCheckTest::WifiExpiryCheckTest()
+    : TestCase("Test checks for expired MPDUs in MAC queue container")
+{
+}
+
+WifiMacQueueContainer::iterator
+WifiExpiryCheckTest::Insert(bool inflight, Time expiryTime, bool front)
+{
+    WifiMacHeader header(WIFI_MAC_QOSDATA);
+    header.SetAddr1(m_rxAddr);
+    header.SetQosTid(0);
+    header.SetSequenceNumber(m_currentSeqNo++);
+    auto mpdu = Create<WifiMpdu>(Create<Packet>(), header);
+
+    const auto& queue = m_container.GetQueue(WifiMacQueueContainer::GetQueueId(mpdu));
+    auto elemIt = m_container.insert(front ? queue.cbegin() : queue.cend(), mpdu);
+    elemIt->expiryTime = expiryTime;
+    if (inflight)
+    {
+        elemIt->inflights.emplace(0, mpdu);
+    }
+    elemIt->deleter = [](auto mpdu) {};
+    return elemIt;
+}
+
+void
+WifiExpiryCheckTest::CheckExtracted(const std::vector<uint16_t>& expectedSeqNo)
+{
+    WifiContainerQueueId queueId{WIFI_QOSDATA_QUEUE, WifiRcvAddr::UNICAST, m_rxAddr, 0};
+    auto [first, last] = m_container.ExtractExpiredMpdus(queueId);
+
+    std::vector<uint16_t> actualSeqNo;
+    std::transform(first, last, std::back_inserter(actualSeqNo), [](auto& elem) {
+        return elem.mpdu->GetHeader().GetSequenceNumber();
+    });
+
+    NS_TEST_EXPECT_MSG_EQ((actualSeqNo == expectedSeqNo),
+                          true,
+                          "Unexpected MPDUs extracted at time " << Simulator::Now().As(Time::MS));
+}
+
+void
+WifiExpiryCheckTest::DoRun()
+{
+    m_rxAddr = Mac48Address::Allocate();
+
+    auto inflightIt = Insert(true, MilliSeconds(10)); // MPDU 0
+    Insert(false, MilliSeconds(20));                  // MPDU 1
+
+    Simulator::Schedule(MilliSeconds(15), [&]() {
+        // MPDU 0 not extracted because inflight, MPDU 1 not expired
+        CheckExtracted({});
+        // MPDU 0 is no longer inflight and is extracted
+        inflightIt->inflights.clear();
+        CheckExtracted({0});
+        // MPDU 2 is enqueued behind MPDU 1, which has not expired
+        Insert(false, MilliSeconds(30));
+        CheckExtracted({});
+    });
+
+    Simulator::Schedule(MilliSeconds(25), [&]() {
+        // MPDU 1 expired, MPDU 2 not expired
+        CheckExtracted({1});
+        CheckExtracted({});
+        // MPDU 3 is inserted at the head of the queue and it has already expired
+        Insert(false, MilliSeconds(22), true);
+        CheckExtracted({3});
+    });
+
+    Simulator::Schedule(MilliSeconds(35), [&]() {
+        // MPDU 2 expired
+        CheckExtracted({2});
+        // MPDU 4 is enqueued in the empty queue and it has already expired
+        Insert(false, MilliSeconds(32));
+        CheckExtracted({4});
+    });
+
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -525,6 +651,7 @@ WifiMacQueueTestSuite::WifiMacQueueTestSuite()
 {
     AddTestCase(new WifiMacQueueDropOldestTest, TestCase::Duration::QUICK);
     AddTestCase(new WifiExtractExpiredMpdusTest, TestCase::Duration::QUICK);
+    AddTestCase(new WifiExpiryCheckTest, TestCase::Duration::QUICK);
     AddTestCase(new WifiMacQueueFlushTest, TestCase::Duration::QUICK);
 }
 
@@ -11,6 +11,7 @@
 #include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/double.h"
+#include "ns3/he-configuration.h"
 #include "ns3/he-phy.h"
 #include "ns3/he-ppdu.h"
 #include "ns3/interference-helper.h"
@@ -29,6 +30,7 @@
 #include "ns3/single-model-spectrum-channel.h"
 #include "ns3/spectrum-wifi-helper.h"
 #include "ns3/spectrum-wifi-phy.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
 #include "ns3/threshold-preamble-detection-model.h"
 #include "ns3/wifi-bandwidth-filter.h"
@@ -42,6 +44,7 @@
 #include "ns3/wifi-utils.h"
 
 #include <optional>
+#include <tuple>
 
 using namespace ns3;
 
@@ -3961,6 +3964,458 @@ TestAmpduReception::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Abstracted A-MPDU reception test
+ *
+ * An A-MPDU containing 3 MPDUs is received with the detailed and with the abstracted
+ * reception of the PPDUs (see the RxAbstraction attribute of WifiPhy), firstly without
+ * interference and then with an interfering signal overlapping the whole payload. The test
+ * checks that the reception status of the MPDUs and the time at which the reception of the
+ * A-MPDU ends are the same in both modes, and that the abstracted reception schedules fewer
+ * events.
+ */
+class TestAbstractedAmpduReception : public WifiPhyReceptionTest
+{
+  public:
+    TestAbstractedAmpduReception();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+
+    /// Outcome of the reception of an A-MPDU
+    struct RxOutcome
+    {
+        std::vector<bool> statusPerMpdu; //!< reception status per MPDU
+        Time rxEnd;                      //!< time at which the reception ended
+        uint64_t nEvents{0};             //!< number of events executed by the simulator
+    };
+
+    /**
+     * RX success function
+     * @param psdu the PSDU
+     * @param rxSignalInfo the info on the received signal (\see RxSignalInfo)
+     * @param txVector the transmit vector
+     * @param statusPerMpdu reception status per MPDU
+     */
+    void RxSuccess(Ptr<const WifiPsdu> psdu,
+                   RxSignalInfo rxSignalInfo,
+                   const WifiTxVector& txVector,
+                   const std::vector<bool>& statusPerMpdu);
+    /**
+     * RX failure function
+     * @param psdu the PSDU
+     */
+    void RxFailure(Ptr<const WifiPsdu> psdu);
+
+    /**
+     * Send an A-MPDU with 3 MPDUs of 1000 bytes.
+     * @param rxPower the transmit power
+     */
+    void SendAmpdu(dBm_u rxPower);
+
+    /**
+     * Receive an A-MPDU, possibly along with an interfering A-MPDU starting during the
+     * payload of the former.
+     * @param rxAbstraction whether the reception of the PPDUs is abstracted
+     * @param interference whether an interfering A-MPDU is received
+     * @return the outcome of the reception
+     */
+    RxOutcome Receive(bool rxAbstraction, bool interference);
+
+    RxOutcome m_outcome; //!< the outcome of the ongoing reception
+};
+
+TestAbstractedAmpduReception::TestAbstractedAmpduReception()
+    : WifiPhyReceptionTest("Abstracted A-MPDU reception test")
+{
+}
+
+void
+TestAbstractedAmpduReception::RxSuccess(Ptr<const WifiPsdu> psdu,
+                                        RxSignalInfo rxSignalInfo,
+                                        const WifiTxVector& txVector,
+                                        const std::vector<bool>& statusPerMpdu)
+{
+    NS_LOG_FUNCTION(this << *psdu << rxSignalInfo << txVector);
+    if (statusPerMpdu.empty()) // wait for the whole A-MPDU
+    {
+        return;
+    }
+    m_outcome.statusPerMpdu = statusPerMpdu;
+    m_outcome.rxEnd = Simulator::Now();
+}
+
+void
+TestAbstractedAmpduReception::RxFailure(Ptr<const WifiPsdu> psdu)
+{
+    NS_LOG_FUNCTION(this << *psdu);
+    m_outcome.statusPerMpdu.assign(psdu->GetNMpdus(), false);
+    m_outcome.rxEnd = Simulator::Now();
+}
+
+void
+TestAbstractedAmpduReception::SendAmpdu(dBm_u rxPower)
+{
+    WifiTxVector txVector = WifiTxVector(HePhy::GetHeMcs0(),
+                                         0,
+                                         WIFI_PREAMBLE_HE_SU,
+                                         NanoSeconds(800),
+                                         1,
+                                         1,
+                                         0,
+                                         MHz_u{20},
+                                         true);
+
+    WifiMacHeader hdr;
+    hdr.SetType(WIFI_MAC_QOSDATA);
+    hdr.SetQosTid(0);
+
+    std::vector<Ptr<WifiMpdu>> mpduList;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        mpduList.push_back(Create<WifiMpdu>(Create<Packet>(1000), hdr));
+    }
+    Ptr<WifiPsdu> psdu = Create<WifiPsdu>(mpduList);
+
+    Time txDuration =
+        SpectrumWifiPhy::CalculateTxDuration(psdu->GetSize(), txVector, m_phy->GetPhyBand());
+
+    Ptr<WifiPpdu> ppdu =
+        Create<HePpdu>(psdu, txVector, m_phy->GetOperatingChannel(), txDuration, m_uid++);
+
+    Ptr<WifiSpectrumSignalParameters> txParams = Create<WifiSpectrumSignalParameters>();
+    txParams->psd = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(FREQUENCY,
+                                                                                CHANNEL_WIDTH,
+                                                                                DbmToW(rxPower),
+                                                                                GUARD_WIDTH);
+    txParams->txPhy = nullptr;
+    txParams->duration = txDuration;
+    txParams->ppdu = ppdu;
+
+    m_phy->StartRx(txParams, nullptr);
+}
+
+void
+TestAbstractedAmpduReception::DoSetup()
+{
+    WifiPhyReceptionTest::DoSetup();
+
+    m_phy->SetReceiveOkCallback(MakeCallback(&TestAbstractedAmpduReception::RxSuccess, this));
+    m_phy->SetReceiveErrorCallback(MakeCallback(&TestAbstractedAmpduReception::RxFailure, this));
+
+    Ptr<ThresholdPreambleDetectionModel> preambleDetectionModel =
+        CreateObject<ThresholdPreambleDetectionModel>();
+    m_phy->SetPreambleDetectionModel(preambleDetectionModel);
+}
+
+TestAbstractedAmpduReception::RxOutcome
+TestAbstractedAmpduReception::Receive(bool rxAbstraction, bool interference)
+{
+    m_phy->SetAttribute("RxAbstraction", BooleanValue(rxAbstraction));
+    m_outcome = RxOutcome{};
+
+    dBm_u rxPower{-50};
+    const auto delay = MilliSeconds(100);
+    const auto start = Simulator::Now() + delay;
+    Simulator::Schedule(delay, &TestAbstractedAmpduReception::SendAmpdu, this, rxPower);
+    if (interference)
+    {
+        // the interfering signal starts during the first MPDU and ends after the A-MPDU
+        Simulator::Schedule(delay + MicroSeconds(60),
+                            &TestAbstractedAmpduReception::SendAmpdu,
+                            this,
+                            rxPower + dB_u{3});
+    }
+    const auto nEvents = Simulator::GetEventCount();
+    Simulator::Run();
+    m_outcome.nEvents = Simulator::GetEventCount() - nEvents;
+    m_outcome.rxEnd -= start;
+    return m_outcome;
+}
+
+void
+TestAbstractedAmpduReception::DoRun()
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    int64_t streamNumber = 0;
+    m_phy->AssignStreams(streamNumber);
+
+    for (auto interference : {false, true})
+    {
+        const auto detailed = Receive(false, interference);
+        const auto abstracted = Receive(true, interference);
+
+        NS_TEST_EXPECT_MSG_EQ(detailed.statusPerMpdu.size(),
+                              3,
+                              "Expected a reception status for every MPDU");
+        NS_TEST_EXPECT_MSG_EQ((abstracted.statusPerMpdu == detailed.statusPerMpdu),
+                              true,
+                              "The abstracted reception status of the MPDUs is not as expected");
+        NS_TEST_EXPECT_MSG_EQ(abstracted.rxEnd,
+                              detailed.rxEnd,
+                              "The abstracted reception did not end at the expected time");
+        const auto expectedOk = !interference;
+        NS_TEST_EXPECT_MSG_EQ(std::count(detailed.statusPerMpdu.cbegin(),
+                                         detailed.statusPerMpdu.cend(),
+                                         expectedOk),
+                              3,
+                              "Unexpected reception status of the MPDUs");
+        NS_TEST_EXPECT_MSG_LT(abstracted.nEvents,
+                              detailed.nEvents,
+                              "The abstracted reception should execute fewer events");
+    }
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Check the MAC layer outcome of the abstracted reception
+ *
+ * In every BSS, an AP sends A-MPDUs to an associated STA, firstly with the detailed and then
+ * with the abstracted reception of the PPDUs (see the RxAbstraction attribute of WifiPhy). The
+ * test checks that the PSDUs are transmitted at the same times and with the same sizes by all
+ * the devices (i.e., that the frame exchanges and the channel access are not affected) and that
+ * the STAs receive the same packets in both cases. The times at which the MPDUs of an A-MPDU
+ * are forwarded to the MAC layer are not checked, because they differ by design.
+ *
+ * If OBSS PD is enabled, two BSSs with different BSS colors are deployed and the devices use
+ * the constant OBSS PD algorithm. The test then also checks that the receptions of the inter-BSS
+ * PPDUs are aborted by the OBSS PD algorithm at the same times (i.e., at the end of HE-SIG-A).
+ */
+class TestRxAbstractionMacOutcome : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param obssPd whether to deploy two BSSs using the OBSS PD spatial reuse
+     */
+    TestRxAbstractionMacOutcome(bool obssPd);
+
+  private:
+    void DoRun() override;
+
+    /// Outcome of a simulation
+    struct MacOutcome
+    {
+        std::vector<std::tuple<Time, std::size_t, uint32_t>>
+            txFrames; //!< the (time, device index, size) of the transmitted PSDUs
+        std::vector<std::tuple<Time, std::size_t>>
+            ccaResets;            //!< the (time, device index) of the OBSS PD CCA resets
+        std::size_t maxNMpdus{0}; //!< the maximum number of MPDUs in a transmitted PSDU
+        uint32_t nRxPackets{0};   //!< the number of packets received by the STA applications
+    };
+
+    /**
+     * Run a simulation.
+     * @param rxAbstraction whether the reception of the PPDUs is abstracted
+     * @return the outcome of the simulation
+     */
+    MacOutcome Run(bool rxAbstraction);
+
+    static constexpr uint32_t N_PACKETS = 200; //!< the number of packets sent by every AP
+
+    bool m_obssPd; //!< whether to deploy two BSSs using the OBSS PD spatial reuse
+};
+
+TestRxAbstractionMacOutcome::TestRxAbstractionMacOutcome(bool obssPd)
+    : TestCase(std::string("Check the MAC layer outcome of the abstracted reception") +
+               (obssPd ? " with OBSS PD" : "")),
+      m_obssPd(obssPd)
+{
+}
+
+TestRxAbstractionMacOutcome::MacOutcome
+TestRxAbstractionMacOutcome::Run(bool rxAbstraction)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    int64_t streamNumber = 100;
+
+    const std::size_t nBss = m_obssPd ? 2 : 1;
+    NodeContainer wifiApNodes(nBss);
+    NodeContainer wifiStaNodes(nBss);
+
+    auto spectrumChannel = CreateObject<MultiModelSpectrumChannel>();
+    spectrumChannel->AddPropagationLossModel(CreateObject<FriisPropagationLossModel>());
+    spectrumChannel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    SpectrumWifiPhyHelper phy;
+    phy.SetChannel(spectrumChannel);
+    phy.Set("RxAbstraction", BooleanValue(rxAbstraction));
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    // the PSDUs overlapping with an inter-BSS PPDU are transmitted with a robust MCS, so that
+    // they are received correctly despite the interference in both cases (the effective SINR of
+    // a partially interfered PSDU may otherwise yield a different outcome by design)
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue(m_obssPd ? "HeMcs2" : "HeMcs5"),
+                                 "ControlMode",
+                                 StringValue("OfdmRate24Mbps"));
+    if (m_obssPd)
+    {
+        wifi.SetObssPdAlgorithm("ns3::ConstantObssPdAlgorithm",
+                                "ObssPdLevel",
+                                DoubleValue(-62.0));
+    }
+
+    NetDeviceContainer apDevices;
+    NetDeviceContainer staDevices;
+    WifiMacHelper mac;
+    for (std::size_t bss = 0; bss < nBss; ++bss)
+    {
+        const Ssid ssid("abstraction-ssid-" + std::to_string(bss));
+        mac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid));
+        staDevices.Add(wifi.Install(phy, mac, wifiStaNodes.Get(bss)));
+        mac.SetType("ns3::ApWifiMac",
+                    "Ssid",
+                    SsidValue(ssid),
+                    "EnableBeaconJitter",
+                    BooleanValue(false));
+        apDevices.Add(wifi.Install(phy, mac, wifiApNodes.Get(bss)));
+        DynamicCast<WifiNetDevice>(apDevices.Get(bss))->GetHeConfiguration()->m_bssColor =
+            bss + 1;
+    }
+    const NetDeviceContainer devices(apDevices, staDevices);
+
+    WifiHelper::AssignStreams(devices, streamNumber);
+
+    // the STAs are 2 meters away from their AP and the APs are 50 meters away from each other,
+    // so that the inter-BSS PPDUs are received with an RSSI below the OBSS PD level
+    MobilityHelper mobility;
+    auto positionAlloc = CreateObject<ListPositionAllocator>();
+    for (std::size_t bss = 0; bss < nBss; ++bss)
+    {
+        positionAlloc->Add(Vector(50.0 * bss, 0.0, 0.0));
+    }
+    for (std::size_t bss = 0; bss < nBss; ++bss)
+    {
+        positionAlloc->Add(Vector(50.0 * bss + 2.0, 0.0, 0.0));
+    }
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(wifiApNodes);
+    mobility.Install(wifiStaNodes);
+
+    PacketSocketHelper packetSocket;
+    packetSocket.Install(wifiApNodes);
+    packetSocket.Install(wifiStaNodes);
+
+    MacOutcome outcome;
+    for (std::size_t bss = 0; bss < nBss; ++bss)
+    {
+        PacketSocketAddress socket;
+        socket.SetSingleDevice(apDevices.Get(bss)->GetIfIndex());
+        socket.SetPhysicalAddress(staDevices.Get(bss)->GetAddress());
+        socket.SetProtocol(1);
+
+        auto client = CreateObject<PacketSocketClient>();
+        client->SetAttribute("PacketSize", UintegerValue(1000));
+        client->SetAttribute("MaxPackets", UintegerValue(N_PACKETS));
+        client->SetAttribute("Interval", TimeValue(MicroSeconds(50)));
+        client->SetRemote(socket);
+        wifiApNodes.Get(bss)->AddApplication(client);
+        client->SetStartTime(MilliSeconds(500));
+
+        auto server = CreateObject<PacketSocketServer>();
+        server->SetLocal(socket);
+        wifiStaNodes.Get(bss)->AddApplication(server);
+        server->TraceConnectWithoutContext("Rx",
+                                           Callback<void, Ptr<const Packet>, const Address&>(
+                                               [&outcome](Ptr<const Packet>, const Address&) {
+                                                   outcome.nRxPackets++;
+                                               }));
+    }
+
+    for (std::size_t index = 0; index < devices.GetN(); ++index)
+    {
+        auto wifiPhy = DynamicCast<WifiNetDevice>(devices.Get(index))->GetPhy();
+        wifiPhy->TraceConnectWithoutContext(
+            "PhyTxPsduBegin",
+            Callback<void, WifiConstPsduMap, WifiTxVector, double>(
+                [&outcome, index](WifiConstPsduMap psduMap, WifiTxVector, double) {
+                    const auto& psdu = psduMap.cbegin()->second;
+                    outcome.txFrames.emplace_back(Simulator::Now(), index, psdu->GetSize());
+                    outcome.maxNMpdus = std::max(outcome.maxNMpdus, psdu->GetNMpdus());
+                }));
+        wifiPhy->TraceConnectWithoutContext(
+            "PhyRxDrop",
+            Callback<void, Ptr<const Packet>, WifiPhyRxfailureReason>(
+                [&outcome, index](Ptr<const Packet>, WifiPhyRxfailureReason reason) {
+                    if (reason == OBSS_PD_CCA_RESET)
+                    {
+                        outcome.ccaResets.emplace_back(Simulator::Now(), index);
+                    }
+                }));
+    }
+
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    return outcome;
+}
+
+void
+TestRxAbstractionMacOutcome::DoRun()
+{
+    const auto detailed = Run(false);
+    const auto abstracted = Run(true);
+    const uint32_t nBss = m_obssPd ? 2 : 1;
+
+    NS_TEST_EXPECT_MSG_EQ(detailed.nRxPackets,
+                          nBss * N_PACKETS,
+                          "Not all the packets have been received");
+    NS_TEST_EXPECT_MSG_GT(detailed.maxNMpdus, 1, "Expected the APs to transmit A-MPDUs");
+    NS_TEST_EXPECT_MSG_EQ(abstracted.nRxPackets,
+                          detailed.nRxPackets,
+                          "Not the same packets received with the abstracted reception");
+    NS_TEST_ASSERT_MSG_EQ(abstracted.txFrames.size(),
+                          detailed.txFrames.size(),
+                          "Not the same number of PSDUs transmitted with the abstracted reception");
+    for (std::size_t i = 0; i < detailed.txFrames.size(); ++i)
+    {
+        const auto& [detailedTime, detailedIndex, detailedSize] = detailed.txFrames[i];
+        const auto& [abstractedTime, abstractedIndex, abstractedSize] = abstracted.txFrames[i];
+        NS_TEST_EXPECT_MSG_EQ(abstractedTime,
+                              detailedTime,
+                              "PSDU #" << i << " not transmitted at the same time");
+        NS_TEST_EXPECT_MSG_EQ(abstractedIndex,
+                              detailedIndex,
+                              "PSDU #" << i << " not transmitted by the same device");
+        NS_TEST_EXPECT_MSG_EQ(abstractedSize,
+                              detailedSize,
+                              "PSDU #" << i << " does not have the same size");
+    }
+
+    NS_TEST_EXPECT_MSG_EQ(detailed.ccaResets.empty(),
+                          !m_obssPd,
+                          "Expected CCA resets if and only if OBSS PD is enabled");
+    NS_TEST_ASSERT_MSG_EQ(abstracted.ccaResets.size(),
+                          detailed.ccaResets.size(),
+                          "Not the same number of CCA resets with the abstracted reception");
+    for (std::size_t i = 0; i < detailed.ccaResets.size(); ++i)
+    {
+        const auto& [detailedTime, detailedIndex] = detailed.ccaResets[i];
+        const auto& [abstractedTime, abstractedIndex] = abstracted.ccaResets[i];
+        NS_TEST_EXPECT_MSG_EQ(abstractedTime,
+                              detailedTime,
+                              "CCA reset #" << i << " not performed at the same time");
+        NS_TEST_EXPECT_MSG_EQ(abstractedIndex,
+                              detailedIndex,
+                              "CCA reset #" << i << " not performed by the same device");
+    }
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -5040,6 +5495,9 @@ WifiPhyReceptionTestSuite::WifiPhyReceptionTestSuite()
     AddTestCase(new TestSimpleFrameCaptureModel, TestCase::Duration::QUICK);
     AddTestCase(new TestPhyHeadersReception, TestCase::Duration::QUICK);
     AddTestCase(new TestAmpduReception, TestCase::Duration::QUICK);
+    AddTestCase(new TestAbstractedAmpduReception, TestCase::Duration::QUICK);
+    AddTestCase(new TestRxAbstractionMacOutcome(false), TestCase::Duration::QUICK);
+    AddTestCase(new TestRxAbstractionMacOutcome(true), TestCase::Duration::QUICK);
     AddTestCase(new TestUnsupportedModulationReception(), TestCase::Duration::QUICK);
     AddTestCase(new TestUnsupportedBandwidthReception(), TestCase::Duration::QUICK);
     AddTestCase(new TestPrimary20CoveredByPpdu(), TestCase::Duration::QUICK);